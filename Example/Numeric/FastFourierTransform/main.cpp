@@ -0,0 +1,71 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::FastFourierTransform.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <kvs/FastFourierTransform>
+#include <kvs/MersenneTwister>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  error [in] max. error
+ *  @param  tolerance [in] tolerance of the error
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const double error, const double tolerance )
+{
+    const bool result = error <= tolerance;
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << " (max. error " << error << ")" << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+    kvs::MersenneTwister random( 1 );
+
+    // The inverse transform restores the data.
+    const size_t size = 1024;
+    const kvs::FastFourierTransform fft( size );
+    std::vector<kvs::FastFourierTransform::Complex> data( size );
+    for ( auto& d : data ) { d = kvs::FastFourierTransform::Complex( random() - 0.5, random() - 0.5 ); }
+    std::vector<kvs::FastFourierTransform::Complex> transformed = data;
+    fft.forward( transformed );
+    fft.inverse( transformed );
+    double error = 0.0;
+    for ( size_t i = 0; i < size; i++ ) { error = std::max( error, std::abs( transformed[i] - data[i] ) ); }
+    passed &= Check( "forward and inverse", error, 1.0e-12 );
+
+    // The correlation matches the direct sums for the sizes other than a power of two.
+    for ( const size_t n : { 1, 5, 100, 1000 } )
+    {
+        std::vector<double> x( n ), y( n );
+        for ( size_t i = 0; i < n; i++ ) { x[i] = random() - 0.5; y[i] = random() - 0.5; }
+
+        const std::vector<double> c = kvs::FastFourierTransform::Correlate( x, y );
+        double error = 0.0;
+        for ( size_t k = 0; k < n; k++ )
+        {
+            double sum = 0.0;
+            for ( size_t i = k; i < n; i++ ) { sum += x[i] * y[i-k]; }
+            error = std::max( error, std::abs( c[k] - sum ) );
+        }
+        passed &= Check( "correlation (n = " + std::to_string( n ) + ")", error, 1.0e-10 );
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::PoolAllocator, kvs::HugePageAllocator and kvs::FrameArena.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <kvs/ValueArray>
+#include <kvs/PoolAllocator>
+#include <kvs/HugePageAllocator>
+#include <kvs/FrameArena>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  result [in] result of the check
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const bool result )
+{
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if all the values of the array are equal to the value.
+ *  @param  values [in] array
+ *  @param  value [in] value
+ */
+/*===========================================================================*/
+template <typename T>
+bool AllOf( const kvs::ValueArray<T>& values, const T value )
+{
+    return std::all_of( values.begin(), values.end(), [&] ( const T v ) { return v == value; } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+
+    // The released buffers are reused by the next arrays of the same size.
+    kvs::PoolAllocator pool;
+    {
+        kvs::ArrayAllocator::Scope scope( &pool );
+        for ( int i = 0; i < 10; i++ )
+        {
+            kvs::ValueArray<float> values( 1000000 );
+            values.fill( float( i ) );
+        }
+    }
+    pool.print( std::cout );
+    passed &= Check( "pool reuse", pool.statistics().nhits >= 9 && pool.statistics().live_bytes == 0 );
+    pool.trim();
+    passed &= Check( "pool trim", pool.statistics().retained_bytes == 0 );
+
+    // The large arrays are aligned to the huge pages, and nothing is retained.
+    kvs::HugePageAllocator huge;
+    {
+        kvs::ArrayAllocator::Scope scope( &huge );
+        kvs::ValueArray<float> values( 4000000 );
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>( values.data() );
+        passed &= Check( "huge page alignment", address % kvs::HugePageAllocator::HugePageSize == 0 );
+    }
+    huge.print( std::cout );
+    passed &= Check( "huge page statistics", huge.statistics().nhits == 0 && huge.statistics().live_bytes == 0 );
+
+    // reset() does not invalidate the arrays still in use.
+    kvs::FrameArena arena( 1024 * 1024 );
+    kvs::ValueArray<double> kept;
+    {
+        kvs::ArrayAllocator::Scope scope( &arena );
+        bool valid = true;
+        for ( int frame = 0; frame < 5; frame++ )
+        {
+            kvs::ValueArray<double> small( 1000 );
+            kvs::ValueArray<double> large( 200000 );
+            small.fill( 1.0 );
+            large.fill( 2.0 );
+            if ( frame == 2 ) { kept = small; }
+
+            arena.reset();
+
+            // The arrays allocated after reset() must not overlap the live arrays.
+            kvs::ValueArray<double> next( 1000 );
+            next.fill( 3.0 );
+            valid &= AllOf( small, 1.0 ) && AllOf( large, 2.0 );
+        }
+        passed &= Check( "arena reset with live arrays", valid && AllOf( kept, 1.0 ) );
+    }
+    arena.print( std::cout );
+    kept.release();
+    arena.reset();
+    passed &= Check( "arena release", arena.statistics().live_bytes == 0 );
+
+    return passed ? 0 : 1;
+}
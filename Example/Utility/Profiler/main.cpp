@@ -0,0 +1,93 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::Profiler.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <kvs/Profiler>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  result [in] result of the check
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const bool result )
+{
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Records the nested zones.
+ *  @param  n [in] number of the outer zones
+ */
+/*===========================================================================*/
+void Work( const size_t n )
+{
+    // KVS_PROFILER_ZONE( category, name ) expands to a zone like these when
+    // KVS_ENABLE_PROFILER is defined.
+    for ( size_t i = 0; i < n; i++ )
+    {
+        kvs::Profiler::Zone outer( "example", "outer" );
+        kvs::Profiler::Zone inner( "example", "inner" );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+
+    kvs::Profiler& profiler = kvs::Profiler::Instance();
+    profiler.clear();
+    profiler.enable();
+
+    // Each thread records the zones into its own buffer.
+    const size_t nthreads = 4;
+    const size_t n = 1000;
+    std::vector<std::thread> threads;
+    for ( size_t i = 0; i < nthreads; i++ ) { threads.emplace_back( Work, n ); }
+    for ( auto& thread : threads ) { thread.join(); }
+    passed &= Check( "number of events", profiler.numberOfEvents() == nthreads * n * 2 );
+
+    // The inner zone is recorded first and lies within the outer zone.
+    bool nested = true;
+    for ( size_t i = 0; i < profiler.numberOfThreads(); i++ )
+    {
+        const auto events = profiler.events( i );
+        for ( size_t j = 0; j + 1 < events.size(); j += 2 )
+        {
+            const auto& inner = events[j];
+            const auto& outer = events[j+1];
+            nested &= std::string( inner.name ) == "inner" && std::string( outer.name ) == "outer";
+            nested &= outer.begin <= inner.begin && inner.end <= outer.end;
+        }
+    }
+    passed &= Check( "nested zones", nested );
+
+    std::ostringstream trace;
+    profiler.write( trace );
+    passed &= Check( "trace", trace.str().find( "\"name\":\"outer\"" ) != std::string::npos );
+    profiler.print( std::cout );
+
+    // No zone is recorded while disabled.
+    profiler.clear();
+    profiler.disable();
+    Work( n );
+    passed &= Check( "disabled", profiler.numberOfEvents() == 0 );
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the correlations and reductions of kvs::Stat.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <kvs/Stat>
+#include <kvs/ValueArray>
+#include <kvs/TaskScheduler>
+#include <kvs/MersenneTwister>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  result [in] result of the check
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const bool result )
+{
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a random walk with an offset.
+ *  @param  random [in] random number generator
+ *  @param  n [in] number of values
+ */
+/*===========================================================================*/
+kvs::ValueArray<double> RandomWalk( kvs::MersenneTwister& random, const size_t n )
+{
+    kvs::ValueArray<double> values( n );
+    double value = 1000.0;
+    for ( auto& v : values ) { value += random() - 0.5; v = value; }
+    return values;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *
+ *  AutoCorr and CrossCorr for all the lags use the FFT from 32 values, and
+ *  must match Corr for each lag.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+    kvs::MersenneTwister random( 1 );
+
+    for ( const size_t n : { 31, 32, 100, 1000 } )
+    {
+        const kvs::ValueArray<double> x = RandomWalk( random, n );
+        kvs::ValueArray<double> y( n );
+        for ( size_t i = 0; i < n; i++ ) { y[i] = 0.5 * x[i] + random(); }
+
+        const kvs::ValueArray<double> auto_corrs = kvs::Stat::AutoCorr( x );
+        const kvs::ValueArray<double> cross_corrs = kvs::Stat::CrossCorr( x, y );
+        double auto_error = 0.0;
+        double cross_error = 0.0;
+        for ( size_t k = 0; k + 1 < n; k++ )
+        {
+            auto_error = std::max( auto_error, std::abs( auto_corrs[k] - kvs::Stat::Corr( x, x, k ) ) );
+            cross_error = std::max( cross_error, std::abs( cross_corrs[k] - kvs::Stat::Corr( x, y, k ) ) );
+        }
+
+        const std::string suffix = " (n = " + std::to_string( n ) + ")";
+        passed &= Check( "AutoCorr" + suffix, auto_corrs.size() == n && auto_error < 1.0e-8 );
+        passed &= Check( "CrossCorr" + suffix, cross_corrs.size() == n && cross_error < 1.0e-8 );
+    }
+
+    // The reductions give the same results with a task scheduler.
+    const size_t n = 1000003;
+    kvs::ValueArray<float> x( n ), y( n );
+    for ( size_t i = 0; i < n; i++ ) { x[i] = 1.0e4f + float( random() ); y[i] = 2.0f * x[i] + float( random() ); }
+    const float sum = kvs::Stat::Sum( x );
+    const float var = kvs::Stat::Var( x );
+    const float cov = kvs::Stat::Cov( x, y );
+
+    kvs::TaskScheduler scheduler( 4 );
+    kvs::Stat::SetScheduler( &scheduler );
+    const bool same =
+        kvs::Stat::Sum( x ) == sum &&
+        kvs::Stat::Var( x ) == var &&
+        kvs::Stat::Cov( x, y ) == cov;
+    kvs::Stat::SetScheduler( nullptr );
+    passed &= Check( "reductions with a scheduler", same );
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::TaskScheduler.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <kvs/TaskScheduler>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  result [in] result of the check
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const bool result )
+{
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the sum of 1/(i+1) for i in [begin, end).
+ *  @param  begin [in] first index
+ *  @param  end [in] last index (not included)
+ *  @param  sum [in] initial value of the sum
+ */
+/*===========================================================================*/
+double HarmonicSum( const size_t begin, const size_t end, double sum )
+{
+    for ( size_t i = begin; i < end; i++ ) { sum += 1.0 / double( i + 1 ); }
+    return sum;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+
+    // The reduced result does not depend on the number of threads.
+    const auto add = [] ( const double a, const double b ) { return a + b; };
+    const double serial = kvs::TaskScheduler( 1 ).parallelReduce( 0, 1000000, 0.0, HarmonicSum, add, 1000 );
+
+    for ( const size_t nthreads : { 2, 4, 8 } )
+    {
+        kvs::TaskScheduler scheduler( nthreads );
+        const std::string prefix = std::to_string( nthreads ) + " threads: ";
+
+        // Each index is visited once.
+        std::vector<int> counts( 100000, 0 );
+        scheduler.parallelFor( 0, counts.size(), [&] ( const size_t begin, const size_t end )
+        {
+            for ( size_t i = begin; i < end; i++ ) { counts[i]++; }
+        } );
+        bool once = true;
+        for ( const int count : counts ) { once &= count == 1; }
+        passed &= Check( prefix + "parallelFor", once );
+
+        // The nested loops run on the same workers.
+        std::atomic<size_t> nested( 0 );
+        scheduler.parallelFor( 0, 64, [&] ( const size_t begin, const size_t end )
+        {
+            for ( size_t i = begin; i < end; i++ )
+            {
+                scheduler.parallelFor( 0, 1000, [&] ( const size_t b, const size_t e ) { nested += e - b; } );
+            }
+        }, 1 );
+        passed &= Check( prefix + "nested parallelFor", nested.load() == 64 * 1000 );
+
+        const double parallel = scheduler.parallelReduce( 0, 1000000, 0.0, HarmonicSum, add, 1000 );
+        passed &= Check( prefix + "parallelReduce", parallel == serial );
+
+        // The exception thrown by a task is rethrown by the waiting thread.
+        bool caught = false;
+        try
+        {
+            scheduler.parallelFor( 0, 100, [] ( const size_t begin, const size_t )
+            {
+                if ( begin == 50 ) { throw std::runtime_error( "task failed" ); }
+            }, 1 );
+        }
+        catch ( const std::runtime_error& ) { caught = true; }
+        passed &= Check( prefix + "exception", caught );
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for the growable construction of kvs::ValueArray.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <kvs/ValueArray>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  result [in] result of the check
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const bool result )
+{
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *
+ *  The arrays sharing a buffer (shallow copies) must not see the values
+ *  written by reserve, resize or push_back on the other arrays.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+
+    // The vector's buffer is adopted without copying.
+    std::vector<float> values( 1000, 1.5f );
+    const float* buffer = values.data();
+    kvs::ValueArray<float> a( std::move( values ) );
+    passed &= Check( "move from std::vector", a.data() == buffer && a.size() == 1000 && a.capacity() == 1000 );
+
+    // push_back on a copy reallocates, and the shared buffer is unchanged.
+    kvs::ValueArray<float> shared = a;
+    a.push_back( 2.0f );
+    passed &= Check( "push_back on a copy",
+        a.data() != buffer && a.size() == 1001 && a[1000] == 2.0f && a[0] == 1.5f &&
+        shared.data() == buffer && shared.size() == 1000 && shared[999] == 1.5f );
+
+    // push_back on the unique buffer grows the capacity geometrically.
+    const size_t capacity = a.capacity();
+    while ( a.size() < capacity ) { a.push_back( 3.0f ); }
+    const float* grown = a.data();
+    passed &= Check( "push_back within the capacity", a.data() == grown && a.capacity() == capacity && a.back() == 3.0f );
+    a.push_back( 4.0f );
+    passed &= Check( "push_back beyond the capacity", a.capacity() > capacity && a.back() == 4.0f && a[0] == 1.5f );
+
+    // shrink_to_fit keeps the values.
+    const size_t size = a.size();
+    a.shrink_to_fit();
+    passed &= Check( "shrink_to_fit", a.capacity() == size && a.size() == size && a.back() == 4.0f );
+
+    // resize on a copy does not write into the shared buffer.
+    kvs::ValueArray<float> b = a;
+    b.resize( 10 );
+    b.resize( 20 );
+    b[15] = 5.0f;
+    passed &= Check( "resize on a copy", b.data() != a.data() && b[9] == a[9] && a.size() == size && a[15] == 1.5f );
+
+    // reserve keeps the size and the values.
+    kvs::ValueArray<float> c = a;
+    c.reserve( 2 * size );
+    passed &= Check( "reserve", c.capacity() == 2 * size && c.size() == size && c[0] == 1.5f && c.data() != a.data() );
+
+    // The values of the non-trivial types are kept by the growth.
+    kvs::ValueArray<std::string> s;
+    for ( int i = 0; i < 100; i++ ) { s.push_back( std::to_string( i ) ); }
+    passed &= Check( "push_back of strings", s.size() == 100 && s[57] == "57" );
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::PointReordering.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <kvs/PointObject>
+#include <kvs/PointReordering>
+#include <kvs/MersenneTwister>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  result [in] result of the check
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const bool result )
+{
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the points with the colors derived from the coordinates.
+ *  @param  n [in] number of points
+ */
+/*===========================================================================*/
+kvs::PointObject* RandomPoints( const size_t n )
+{
+    kvs::MersenneTwister random( 1 );
+    kvs::ValueArray<kvs::Real32> coords( 3 * n );
+    kvs::ValueArray<kvs::UInt8> colors( 3 * n );
+    for ( size_t i = 0; i < 3 * n; i++ )
+    {
+        coords[i] = float( random() );
+        colors[i] = kvs::UInt8( coords[i] * 255.0f );
+    }
+
+    kvs::PointObject* point = new kvs::PointObject();
+    point->setCoords( coords );
+    point->setColors( colors );
+    point->setSize( 1.0f );
+    point->updateMinMaxCoords();
+    return point;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the points as the sorted tuples of the coordinates and colors.
+ *  @param  point [in] pointer to the point object
+ */
+/*===========================================================================*/
+std::vector<std::array<float,6>> Points( const kvs::PointObject* point )
+{
+    std::vector<std::array<float,6>> points( point->numberOfVertices() );
+    for ( size_t i = 0; i < points.size(); i++ )
+    {
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            points[i][k] = point->coords()[ 3 * i + k ];
+            points[i][ 3 + k ] = point->colors()[ 3 * i + k ];
+        }
+    }
+    std::sort( points.begin(), points.end() );
+    return points;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the total distance between the consecutive points.
+ *  @param  point [in] pointer to the point object
+ */
+/*===========================================================================*/
+double PathLength( const kvs::PointObject* point )
+{
+    double length = 0.0;
+    for ( size_t i = 1; i < point->numberOfVertices(); i++ )
+    {
+        length += ( point->coord( i ) - point->coord( i - 1 ) ).length();
+    }
+    return length;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+
+    kvs::PointObject* point = RandomPoints( 100000 );
+    const auto points = Points( point );
+    const double length = PathLength( point );
+
+    const kvs::PointReordering::CurveType types[] = { kvs::PointReordering::MortonCurve, kvs::PointReordering::HilbertCurve };
+    const std::string names[] = { "Morton", "Hilbert" };
+    for ( size_t i = 0; i < 2; i++ )
+    {
+        kvs::PointReordering* reordered = new kvs::PointReordering( point, types[i] );
+
+        // The points are permuted with their colors.
+        passed &= Check( names[i] + " permutation", Points( reordered ) == points );
+
+        // The consecutive points are close in space.
+        const double reordered_length = PathLength( reordered );
+        std::cout << names[i] << " path length: " << length << " -> " << reordered_length << std::endl;
+        passed &= Check( names[i] + " locality", reordered_length < 0.1 * length );
+
+        delete reordered;
+    }
+
+    delete point;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::PolygonReordering.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <kvs/PolygonObject>
+#include <kvs/PolygonReordering>
+#include <kvs/MersenneTwister>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  result [in] result of the check
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const bool result )
+{
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a triangulated grid of n x n points with shuffled triangles.
+ *  @param  n [in] number of the grid points along each axis
+ */
+/*===========================================================================*/
+kvs::PolygonObject* ShuffledGrid( const size_t n )
+{
+    kvs::ValueArray<kvs::Real32> coords( 3 * n * n );
+    for ( size_t j = 0; j < n; j++ )
+    {
+        for ( size_t i = 0; i < n; i++ )
+        {
+            kvs::Real32* coord = coords.data() + 3 * ( j * n + i );
+            coord[0] = float( i );
+            coord[1] = float( j );
+            coord[2] = 0.0f;
+        }
+    }
+
+    std::vector<std::array<kvs::UInt32,3>> triangles;
+    for ( size_t j = 0; j + 1 < n; j++ )
+    {
+        for ( size_t i = 0; i + 1 < n; i++ )
+        {
+            const kvs::UInt32 v = kvs::UInt32( j * n + i );
+            const kvs::UInt32 w = v + kvs::UInt32( n );
+            triangles.push_back( { { v, v + 1, w } } );
+            triangles.push_back( { { v + 1, w + 1, w } } );
+        }
+    }
+
+    kvs::MersenneTwister random( 1 );
+    for ( size_t i = triangles.size() - 1; i > 0; i-- )
+    {
+        std::swap( triangles[i], triangles[ random.randInteger( kvs::UInt32( i ) ) ] );
+    }
+
+    kvs::ValueArray<kvs::UInt32> connections( 3 * triangles.size() );
+    for ( size_t i = 0; i < triangles.size(); i++ )
+    {
+        std::copy( triangles[i].begin(), triangles[i].end(), connections.data() + 3 * i );
+    }
+
+    kvs::PolygonObject* polygon = new kvs::PolygonObject();
+    polygon->setCoords( coords );
+    polygon->setConnections( connections );
+    polygon->setPolygonTypeToTriangle();
+    polygon->setColorTypeToPolygon();
+    polygon->setNormalTypeToPolygon();
+    polygon->setColor( kvs::RGBColor::White() );
+    polygon->setOpacity( 255 );
+    polygon->updateMinMaxCoords();
+    return polygon;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the triangles as the sorted coordinates.
+ *
+ *  The vertices of each triangle are rotated to start from the smallest
+ *  coordinates, so that the orientation is kept in the comparison.
+ *
+ *  @param  polygon [in] pointer to the polygon object
+ */
+/*===========================================================================*/
+std::vector<std::array<float,9>> Triangles( const kvs::PolygonObject* polygon )
+{
+    std::vector<std::array<float,9>> triangles;
+    const kvs::ValueArray<kvs::UInt32>& connections = polygon->connections();
+    for ( size_t i = 0; i < connections.size(); i += 3 )
+    {
+        std::array<kvs::Vec3,3> v;
+        for ( size_t k = 0; k < 3; k++ ) { v[k] = polygon->coord( connections[ i + k ] ); }
+        const auto less = [] ( const kvs::Vec3& a, const kvs::Vec3& b )
+        {
+            return std::lexicographical_compare( a.data(), a.data() + 3, b.data(), b.data() + 3 );
+        };
+        std::rotate( v.begin(), std::min_element( v.begin(), v.end(), less ), v.end() );
+
+        std::array<float,9> triangle;
+        for ( size_t k = 0; k < 3; k++ ) { std::copy( v[k].data(), v[k].data() + 3, triangle.data() + 3 * k ); }
+        triangles.push_back( triangle );
+    }
+    std::sort( triangles.begin(), triangles.end() );
+    return triangles;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+
+    kvs::PolygonObject* polygon = ShuffledGrid( 64 );
+    kvs::PolygonReordering* reordered = new kvs::PolygonReordering( polygon, 16 );
+
+    // The geometry is unchanged.
+    passed &= Check( "triangles", Triangles( polygon ) == Triangles( reordered ) );
+
+    // The vertices are numbered in order of first reference.
+    const kvs::ValueArray<kvs::UInt32>& connections = reordered->connections();
+    kvs::UInt32 next = 0;
+    bool sequential = reordered->numberOfVertices() == polygon->numberOfVertices();
+    for ( const kvs::UInt32 index : connections )
+    {
+        if ( index == next ) { next++; }
+        else { sequential &= index < next; }
+    }
+    passed &= Check( "vertex order", sequential && next == reordered->numberOfVertices() );
+
+    // The vertex cache is reused better than for the shuffled triangles.
+    const double before = kvs::PolygonReordering::AverageCacheMissRatio( polygon, 16 );
+    const double after = kvs::PolygonReordering::AverageCacheMissRatio( reordered, 16 );
+    std::cout << "Average cache miss ratio: " << before << " -> " << after << std::endl;
+    passed &= Check( "cache miss ratio", after < before );
+
+    delete reordered;
+    delete polygon;
+
+    return passed ? 0 : 1;
+}
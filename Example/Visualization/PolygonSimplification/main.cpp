@@ -0,0 +1,119 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::PolygonSimplification.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <kvs/PolygonObject>
+#include <kvs/PolygonSimplification>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of the check and returns it.
+ *  @param  name [in] name of the check
+ *  @param  result [in] result of the check
+ */
+/*===========================================================================*/
+bool Check( const std::string& name, const bool result )
+{
+    std::cout << name << ": " << ( result ? "OK" : "FAILED" ) << std::endl;
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a triangulated height field on the n x n grid.
+ *  @param  n [in] number of the grid points along each axis
+ */
+/*===========================================================================*/
+kvs::PolygonObject* HeightField( const size_t n )
+{
+    kvs::ValueArray<kvs::Real32> coords( 3 * n * n );
+    for ( size_t j = 0; j < n; j++ )
+    {
+        for ( size_t i = 0; i < n; i++ )
+        {
+            const float x = float( i ) / float( n - 1 );
+            const float y = float( j ) / float( n - 1 );
+            kvs::Real32* coord = coords.data() + 3 * ( j * n + i );
+            coord[0] = x;
+            coord[1] = y;
+            coord[2] = 0.1f * std::sin( 6.0f * x ) * std::cos( 6.0f * y );
+        }
+    }
+
+    kvs::ValueArray<kvs::UInt32> connections;
+    connections.reserve( 6 * ( n - 1 ) * ( n - 1 ) );
+    for ( size_t j = 0; j + 1 < n; j++ )
+    {
+        for ( size_t i = 0; i + 1 < n; i++ )
+        {
+            const kvs::UInt32 v = kvs::UInt32( j * n + i );
+            const kvs::UInt32 triangles[6] = { v, v + 1, v + kvs::UInt32( n ), v + 1, v + kvs::UInt32( n ) + 1, v + kvs::UInt32( n ) };
+            for ( const auto index : triangles ) { connections.push_back( index ); }
+        }
+    }
+
+    kvs::PolygonObject* polygon = new kvs::PolygonObject();
+    polygon->setCoords( coords );
+    polygon->setConnections( connections );
+    polygon->setPolygonTypeToTriangle();
+    polygon->setColorTypeToPolygon();
+    polygon->setNormalTypeToPolygon();
+    polygon->setColor( kvs::RGBColor::White() );
+    polygon->setOpacity( 255 );
+    polygon->updateMinMaxCoords();
+    return polygon;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ */
+/*===========================================================================*/
+int main()
+{
+    bool passed = true;
+
+    const size_t n = 64;
+    kvs::PolygonObject* polygon = HeightField( n );
+    const size_t npolygons = polygon->numberOfConnections();
+    const size_t target = npolygons / 4;
+
+    kvs::PolygonSimplification* simplified = new kvs::PolygonSimplification( polygon, target );
+    const size_t nvertices = simplified->numberOfVertices();
+    const kvs::ValueArray<kvs::UInt32>& connections = simplified->connections();
+    std::cout << "Number of polygons: " << npolygons << " -> " << simplified->numberOfConnections() << std::endl;
+    passed &= Check( "number of polygons", simplified->numberOfConnections() <= target );
+
+    // The connections refer to the existing vertices, and no triangle is degenerate.
+    bool valid = connections.size() % 3 == 0;
+    for ( size_t i = 0; i + 2 < connections.size(); i += 3 )
+    {
+        const kvs::UInt32 a = connections[i];
+        const kvs::UInt32 b = connections[i+1];
+        const kvs::UInt32 c = connections[i+2];
+        valid &= a < nvertices && b < nvertices && c < nvertices;
+        valid &= a != b && b != c && c != a;
+    }
+    passed &= Check( "connections", valid );
+
+    // The boundary edges are kept fixed, so all the boundary vertices remain.
+    size_t nboundaries = 0;
+    for ( size_t i = 0; i < nvertices; i++ )
+    {
+        const kvs::Vec3 p = simplified->coord( i );
+        const bool boundary = p.x() == 0.0f || p.x() == 1.0f || p.y() == 0.0f || p.y() == 1.0f;
+        if ( boundary ) { nboundaries++; }
+    }
+    passed &= Check( "boundary", nboundaries == 4 * ( n - 1 ) );
+
+    delete simplified;
+    delete polygon;
+
+    return passed ? 0 : 1;
+}
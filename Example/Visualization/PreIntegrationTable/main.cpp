@@ -0,0 +1,103 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @brief  Example program for kvs::PreIntegrationTable2D and 3D.
+ */
+/*****************************************************************************/
+#include <iostream>
+#include <algorithm>
+#include <kvs/TransferFunction>
+#include <kvs/ColorMap>
+#include <kvs/OpacityMap>
+#include <kvs/ValueArray>
+#include <kvs/PreIntegrationTable2D>
+#include <kvs/PreIntegrationTable3D>
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a transfer function with a ramp opacity map.
+ *  @param  peak [in] scalar value of the additional opacity peak (< 0: none)
+ */
+/*===========================================================================*/
+kvs::TransferFunction CreateTransferFunction( const float peak )
+{
+    const size_t resolution = 256;
+    kvs::OpacityMap omap( resolution );
+    omap.addPoint( 0.0f, 0.0f );
+    if ( peak >= 0.0f ) { omap.addPoint( peak, 0.8f ); }
+    omap.addPoint( 255.0f, 0.5f );
+    omap.create();
+    return kvs::TransferFunction( kvs::ColorMap::BrewerSpectral( resolution ), omap );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the result of comparison and returns true if equal.
+ *  @param  name [in] name of the table
+ *  @param  updated [in] table updated incrementally
+ *  @param  created [in] table created from scratch
+ */
+/*===========================================================================*/
+bool Compare(
+    const std::string& name,
+    const kvs::ValueArray<kvs::Real32>& updated,
+    const kvs::ValueArray<kvs::Real32>& created )
+{
+    const bool equal =
+        updated.size() == created.size() &&
+        std::equal( updated.begin(), updated.end(), created.begin() );
+    std::cout << name << ": " << ( equal ? "identical" : "DIFFERENT" ) << std::endl;
+    return equal;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *
+ *  The tables incrementally updated after modifying a part of the transfer
+ *  function are compared with the tables created from scratch.
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    const auto tfunc0 = CreateTransferFunction( -1.0f );
+    const auto tfunc1 = CreateTransferFunction( 100.0f );
+    bool passed = true;
+
+    // 2D table.
+    {
+        kvs::PreIntegrationTable2D updated;
+        updated.setTransferFunction( tfunc0 );
+        updated.create();
+        updated.setTransferFunction( tfunc1 );
+        updated.update();
+
+        kvs::PreIntegrationTable2D created;
+        created.setTransferFunction( tfunc1 );
+        created.create();
+
+        passed &= Compare( "PreIntegrationTable2D", updated.table(), created.table() );
+    }
+
+    // 3D table.
+    {
+        const float min_value = 0.0f;
+        const float max_value = 255.0f;
+        const float max_size_of_cell = 2.0f;
+
+        kvs::PreIntegrationTable3D updated( 64, 32 );
+        updated.setTransferFunction( tfunc0, min_value, max_value );
+        updated.create( max_size_of_cell );
+        updated.setTransferFunction( tfunc1, min_value, max_value );
+        updated.update( max_size_of_cell );
+
+        kvs::PreIntegrationTable3D created( 64, 32 );
+        created.setTransferFunction( tfunc1, min_value, max_value );
+        created.create( max_size_of_cell );
+
+        passed &= Compare( "PreIntegrationTable3D", updated.table(), created.table() );
+    }
+
+    return passed ? 0 : 1;
+}
@@ -85,6 +85,7 @@ $(OUTDIR)/./FileFormat/KVSML/KVSMLTableObject.o \
 $(OUTDIR)/./FileFormat/KVSML/KVSMLTag.o \
 $(OUTDIR)/./FileFormat/KVSML/KVSMLTransferFunction.o \
 $(OUTDIR)/./FileFormat/KVSML/KVSMLUnstructuredVolumeObject.o \
+$(OUTDIR)/./FileFormat/KVSML/LevelTag.o \
 $(OUTDIR)/./FileFormat/KVSML/LineObjectTag.o \
 $(OUTDIR)/./FileFormat/KVSML/LineTag.o \
 $(OUTDIR)/./FileFormat/KVSML/NodeTag.o \
@@ -92,6 +93,7 @@ $(OUTDIR)/./FileFormat/KVSML/NormalTag.o \
 $(OUTDIR)/./FileFormat/KVSML/ObjectTag.o \
 $(OUTDIR)/./FileFormat/KVSML/OpacityMapTag.o \
 $(OUTDIR)/./FileFormat/KVSML/OpacityTag.o \
+$(OUTDIR)/./FileFormat/KVSML/PaletteTag.o \
 $(OUTDIR)/./FileFormat/KVSML/PixelTag.o \
 $(OUTDIR)/./FileFormat/KVSML/PointObjectTag.o \
 $(OUTDIR)/./FileFormat/KVSML/PolygonObjectTag.o \
@@ -124,6 +126,7 @@ $(OUTDIR)/./FileFormat/XML/XMLDeclaration.o \
 $(OUTDIR)/./FileFormat/XML/XMLDocument.o \
 $(OUTDIR)/./FileFormat/XML/XMLElement.o \
 $(OUTDIR)/./FileFormat/XML/XMLNode.o \
+$(OUTDIR)/./Image/AsyncImageWriter.o \
 $(OUTDIR)/./Image/BitImage.o \
 $(OUTDIR)/./Image/ColorImage.o \
 $(OUTDIR)/./Image/CubicImage.o \
@@ -176,6 +179,7 @@ $(OUTDIR)/./Numeric/BetaFunction.o \
 $(OUTDIR)/./Numeric/ChiSquaredDistribution.o \
 $(OUTDIR)/./Numeric/EigenDecomposition.o \
 $(OUTDIR)/./Numeric/ExponentialDistribution.o \
+$(OUTDIR)/./Numeric/FastFourierTransform.o \
 $(OUTDIR)/./Numeric/FastKMeans.o \
 $(OUTDIR)/./Numeric/FisherFDistribution.o \
 $(OUTDIR)/./Numeric/GammaFunction.o \
@@ -201,6 +205,7 @@ $(OUTDIR)/./Numeric/Xorshift128.o \
 $(OUTDIR)/./OpenGL/BufferObject.o \
 $(OUTDIR)/./OpenGL/FrameBuffer.o \
 $(OUTDIR)/./OpenGL/FrameBufferObject.o \
+$(OUTDIR)/./OpenGL/FrameReadbackBuffer.o \
 $(OUTDIR)/./OpenGL/GL.o \
 $(OUTDIR)/./OpenGL/OpenGL.o \
 $(OUTDIR)/./OpenGL/ProgramObject.o \
@@ -220,22 +225,30 @@ $(OUTDIR)/./Thread/MutexLocker.o \
 $(OUTDIR)/./Thread/ReadLocker.o \
 $(OUTDIR)/./Thread/ReadWriteLock.o \
 $(OUTDIR)/./Thread/Semaphore.o \
+$(OUTDIR)/./Thread/TaskScheduler.o \
 $(OUTDIR)/./Thread/Thread.o \
 $(OUTDIR)/./Thread/WriteLocker.o \
+$(OUTDIR)/./Utility/AllocationProfiler.o \
 $(OUTDIR)/./Utility/AnyValueArray.o \
 $(OUTDIR)/./Utility/AnyValueTable.o \
+$(OUTDIR)/./Utility/ArrayAllocator.o \
 $(OUTDIR)/./Utility/BitArray.o \
 $(OUTDIR)/./Utility/CommandLine.o \
 $(OUTDIR)/./Utility/Date.o \
 $(OUTDIR)/./Utility/Directory.o \
 $(OUTDIR)/./Utility/File.o \
+$(OUTDIR)/./Utility/FrameArena.o \
+$(OUTDIR)/./Utility/HugePageAllocator.o \
 $(OUTDIR)/./Utility/Indent.o \
 $(OUTDIR)/./Utility/MemoryTracer.o \
 $(OUTDIR)/./Utility/Message.o \
+$(OUTDIR)/./Utility/PoolAllocator.o \
+$(OUTDIR)/./Utility/Profiler.o \
 $(OUTDIR)/./Utility/Program.o \
 $(OUTDIR)/./Utility/Range.o \
 $(OUTDIR)/./Utility/Rectangle.o \
 $(OUTDIR)/./Utility/ReferenceCounter.o \
+$(OUTDIR)/./Utility/Stat.o \
 $(OUTDIR)/./Utility/String.o \
 $(OUTDIR)/./Utility/SystemInformation.o \
 $(OUTDIR)/./Utility/Time.o \
@@ -260,6 +273,9 @@ $(OUTDIR)/./Visualization/Filter/FieldSimilarity.o \
 $(OUTDIR)/./Visualization/Filter/InverseDistanceWeighting.o \
 $(OUTDIR)/./Visualization/Filter/KMeansClustering.o \
 $(OUTDIR)/./Visualization/Filter/LineIntegralConvolution.o \
+$(OUTDIR)/./Visualization/Filter/PointReordering.o \
+$(OUTDIR)/./Visualization/Filter/PolygonReordering.o \
+$(OUTDIR)/./Visualization/Filter/PolygonSimplification.o \
 $(OUTDIR)/./Visualization/Filter/PolygonToPolygon.o \
 $(OUTDIR)/./Visualization/Filter/ProbabilisticMarchingCubes.o \
 $(OUTDIR)/./Visualization/Filter/ProjectedFieldSimilarity.o \
@@ -330,6 +346,7 @@ $(OUTDIR)/./Visualization/Mapper/StreamlineBase.o \
 $(OUTDIR)/./Visualization/Mapper/TetrahedralCell.o \
 $(OUTDIR)/./Visualization/Mapper/TransferFunction.o \
 $(OUTDIR)/./Visualization/Mapper/UniformGrid.o \
+$(OUTDIR)/./Visualization/Object/BrickedVolumeObject.o \
 $(OUTDIR)/./Visualization/Object/GeometryObjectBase.o \
 $(OUTDIR)/./Visualization/Object/ImageObject.o \
 $(OUTDIR)/./Visualization/Object/LineObject.o \
@@ -85,6 +85,7 @@ $(OUTDIR)\.\FileFormat\KVSML\KVSMLTableObject.obj \
 $(OUTDIR)\.\FileFormat\KVSML\KVSMLTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\KVSMLTransferFunction.obj \
 $(OUTDIR)\.\FileFormat\KVSML\KVSMLUnstructuredVolumeObject.obj \
+$(OUTDIR)\.\FileFormat\KVSML\LevelTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\LineObjectTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\LineTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\NodeTag.obj \
@@ -92,6 +93,7 @@ $(OUTDIR)\.\FileFormat\KVSML\NormalTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\ObjectTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\OpacityMapTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\OpacityTag.obj \
+$(OUTDIR)\.\FileFormat\KVSML\PaletteTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\PixelTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\PointObjectTag.obj \
 $(OUTDIR)\.\FileFormat\KVSML\PolygonObjectTag.obj \
@@ -124,6 +126,7 @@ $(OUTDIR)\.\FileFormat\XML\XMLDeclaration.obj \
 $(OUTDIR)\.\FileFormat\XML\XMLDocument.obj \
 $(OUTDIR)\.\FileFormat\XML\XMLElement.obj \
 $(OUTDIR)\.\FileFormat\XML\XMLNode.obj \
+$(OUTDIR)\.\Image\AsyncImageWriter.obj \
 $(OUTDIR)\.\Image\BitImage.obj \
 $(OUTDIR)\.\Image\ColorImage.obj \
 $(OUTDIR)\.\Image\CubicImage.obj \
@@ -176,6 +179,7 @@ $(OUTDIR)\.\Numeric\BetaFunction.obj \
 $(OUTDIR)\.\Numeric\ChiSquaredDistribution.obj \
 $(OUTDIR)\.\Numeric\EigenDecomposition.obj \
 $(OUTDIR)\.\Numeric\ExponentialDistribution.obj \
+$(OUTDIR)\.\Numeric\FastFourierTransform.obj \
 $(OUTDIR)\.\Numeric\FastKMeans.obj \
 $(OUTDIR)\.\Numeric\FisherFDistribution.obj \
 $(OUTDIR)\.\Numeric\GammaFunction.obj \
@@ -201,6 +205,7 @@ $(OUTDIR)\.\Numeric\Xorshift128.obj \
 $(OUTDIR)\.\OpenGL\BufferObject.obj \
 $(OUTDIR)\.\OpenGL\FrameBuffer.obj \
 $(OUTDIR)\.\OpenGL\FrameBufferObject.obj \
+$(OUTDIR)\.\OpenGL\FrameReadbackBuffer.obj \
 $(OUTDIR)\.\OpenGL\GL.obj \
 $(OUTDIR)\.\OpenGL\OpenGL.obj \
 $(OUTDIR)\.\OpenGL\ProgramObject.obj \
@@ -220,22 +225,30 @@ $(OUTDIR)\.\Thread\MutexLocker.obj \
 $(OUTDIR)\.\Thread\ReadLocker.obj \
 $(OUTDIR)\.\Thread\ReadWriteLock.obj \
 $(OUTDIR)\.\Thread\Semaphore.obj \
+$(OUTDIR)\.\Thread\TaskScheduler.obj \
 $(OUTDIR)\.\Thread\Thread.obj \
 $(OUTDIR)\.\Thread\WriteLocker.obj \
+$(OUTDIR)\.\Utility\AllocationProfiler.obj \
 $(OUTDIR)\.\Utility\AnyValueArray.obj \
 $(OUTDIR)\.\Utility\AnyValueTable.obj \
+$(OUTDIR)\.\Utility\ArrayAllocator.obj \
 $(OUTDIR)\.\Utility\BitArray.obj \
 $(OUTDIR)\.\Utility\CommandLine.obj \
 $(OUTDIR)\.\Utility\Date.obj \
 $(OUTDIR)\.\Utility\Directory.obj \
 $(OUTDIR)\.\Utility\File.obj \
+$(OUTDIR)\.\Utility\FrameArena.obj \
+$(OUTDIR)\.\Utility\HugePageAllocator.obj \
 $(OUTDIR)\.\Utility\Indent.obj \
 $(OUTDIR)\.\Utility\MemoryTracer.obj \
 $(OUTDIR)\.\Utility\Message.obj \
+$(OUTDIR)\.\Utility\PoolAllocator.obj \
+$(OUTDIR)\.\Utility\Profiler.obj \
 $(OUTDIR)\.\Utility\Program.obj \
 $(OUTDIR)\.\Utility\Range.obj \
 $(OUTDIR)\.\Utility\Rectangle.obj \
 $(OUTDIR)\.\Utility\ReferenceCounter.obj \
+$(OUTDIR)\.\Utility\Stat.obj \
 $(OUTDIR)\.\Utility\String.obj \
 $(OUTDIR)\.\Utility\SystemInformation.obj \
 $(OUTDIR)\.\Utility\Time.obj \
@@ -260,6 +273,9 @@ $(OUTDIR)\.\Visualization\Filter\FieldSimilarity.obj \
 $(OUTDIR)\.\Visualization\Filter\InverseDistanceWeighting.obj \
 $(OUTDIR)\.\Visualization\Filter\KMeansClustering.obj \
 $(OUTDIR)\.\Visualization\Filter\LineIntegralConvolution.obj \
+$(OUTDIR)\.\Visualization\Filter\PointReordering.obj \
+$(OUTDIR)\.\Visualization\Filter\PolygonReordering.obj \
+$(OUTDIR)\.\Visualization\Filter\PolygonSimplification.obj \
 $(OUTDIR)\.\Visualization\Filter\PolygonToPolygon.obj \
 $(OUTDIR)\.\Visualization\Filter\ProbabilisticMarchingCubes.obj \
 $(OUTDIR)\.\Visualization\Filter\ProjectedFieldSimilarity.obj \
@@ -330,6 +346,7 @@ $(OUTDIR)\.\Visualization\Mapper\StreamlineBase.obj \
 $(OUTDIR)\.\Visualization\Mapper\TetrahedralCell.obj \
 $(OUTDIR)\.\Visualization\Mapper\TransferFunction.obj \
 $(OUTDIR)\.\Visualization\Mapper\UniformGrid.obj \
+$(OUTDIR)\.\Visualization\Object\BrickedVolumeObject.obj \
 $(OUTDIR)\.\Visualization\Object\GeometryObjectBase.obj \
 $(OUTDIR)\.\Visualization\Object\ImageObject.obj \
 $(OUTDIR)\.\Visualization\Object\LineObject.obj \
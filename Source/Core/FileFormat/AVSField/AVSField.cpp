@@ -458,17 +458,19 @@ bool AVSField::read_coord_data(  FILE* ifs, const size_t nvertices )
 {
     m_coords.allocate( nvertices * m_nspace );
 
+    // Coordinate values are stored component by component, so each
+    // component is read at once and then interleaved.
+    kvs::ValueArray<T> data( nvertices );
     const size_t nspace = static_cast<size_t>( m_nspace );
     for( size_t nsp = 0; nsp < nspace; nsp++ )
     {
-        for( size_t i = 0; i < nvertices; i++ )
+        const size_t nread = fread( data.data(), sizeof(T), nvertices, ifs );
+        for( size_t i = 0; i < nread; i++ )
         {
-            T data = T(0);
-            if ( fread( &data, sizeof(T), 1, ifs ) == 1 )
-            {
-                m_coords[ i * m_nspace + nsp ] = static_cast<float>( data );
-            }
+            m_coords[ i * m_nspace + nsp ] = static_cast<float>( data[i] );
         }
+
+        if ( nread != nvertices ) { return false; }
     }
 
     return true;
@@ -19,6 +19,8 @@
 #include <kvs/IgnoreUnusedVariable>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
+#include <vector>
 
 
 namespace
@@ -33,6 +35,8 @@ namespace
 
 const size_t MaxLineLength = 512;
 
+const size_t ChunkSize = 65536; // number of records read at once from binary files
+
 const char* const Delimiter = " \n\r";
 
 const std::string CycleTypeToString[ kvs::AVSUcd::CycleTypeSize ] =
@@ -129,6 +133,212 @@ inline bool IsControlFile( FILE* const ifs )
     return result;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Skips a token separated by white spaces.
+ *  @param  p [in] pointer to the string
+ *  @return pointer to the next character of the token
+ */
+/*===========================================================================*/
+inline const char* SkipToken( const char* p )
+{
+    while ( *p == ' ' || *p == '\t' ) { ++p; }
+    while ( *p != '\0' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r' ) { ++p; }
+    return p;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses an integer value.
+ *  @param  p [in/out] pointer to the string (moved to the end of the value)
+ *  @return parsed value
+ */
+/*===========================================================================*/
+inline kvs::Int64 ParseInt( const char*& p )
+{
+    char* end = nullptr;
+    const kvs::Int64 value = std::strtoll( p, &end, 10 );
+    p = end;
+    return value;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Parses a real value.
+ *  @param  p [in/out] pointer to the string (moved to the end of the value)
+ *  @return parsed value
+ *
+ *  The decimal digits are accumulated in an integer and scaled by a power
+ *  of ten at once, which is much faster than atof. Values that cannot be
+ *  handled in this way (too many digits, large exponent, inf, nan, etc.)
+ *  are parsed with strtod.
+ */
+/*===========================================================================*/
+inline kvs::Real32 ParseReal( const char*& p )
+{
+    static const double Pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    while ( *p == ' ' || *p == '\t' ) { ++p; }
+    const char* const head = p;
+
+    const char* q = p;
+    const bool negative = ( *q == '-' );
+    if ( *q == '-' || *q == '+' ) { ++q; }
+
+    kvs::UInt64 mantissa = 0;
+    int ndigits = 0;
+    int exponent = 0;
+    while ( *q >= '0' && *q <= '9' )
+    {
+        mantissa = mantissa * 10 + static_cast<kvs::UInt64>( *q++ - '0' );
+        ndigits++;
+    }
+    if ( *q == '.' )
+    {
+        ++q;
+        while ( *q >= '0' && *q <= '9' )
+        {
+            mantissa = mantissa * 10 + static_cast<kvs::UInt64>( *q++ - '0' );
+            ndigits++;
+            exponent--;
+        }
+    }
+
+    bool valid = ( ndigits > 0 && ndigits <= 18 );
+    if ( valid && ( *q == 'e' || *q == 'E' ) )
+    {
+        ++q;
+        const bool negative_exponent = ( *q == '-' );
+        if ( *q == '-' || *q == '+' ) { ++q; }
+        if ( *q < '0' || *q > '9' ) { valid = false; }
+
+        int e = 0;
+        while ( *q >= '0' && *q <= '9' && e < 1000 ) { e = e * 10 + ( *q++ - '0' ); }
+        exponent += negative_exponent ? -e : e;
+    }
+
+    if ( !valid || exponent < -22 || exponent > 22 )
+    {
+        char* end = nullptr;
+        const double value = std::strtod( head, &end );
+        p = end;
+        return static_cast<kvs::Real32>( value );
+    }
+
+    double value = static_cast<double>( mantissa );
+    value = exponent < 0 ? value / Pow10[ -exponent ] : value * Pow10[ exponent ];
+    p = q;
+    return static_cast<kvs::Real32>( negative ? -value : value );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads node coordinates stored with the node numbers in bulk.
+ *  @param  ifs [in] file pointer
+ *  @param  nnodes [in] number of nodes
+ *  @param  coords [out] pointer to the coordinate array
+ */
+/*===========================================================================*/
+template <typename Index>
+inline void ReadNodeCoords( FILE* const ifs, const size_t nnodes, kvs::Real32* coords )
+{
+    // Each node is stored as a node number followed by XYZ coordinates.
+    // The records are read in chunks instead of one by one.
+    const size_t record_size = sizeof( Index ) + 3 * sizeof( kvs::Real32 );
+    const size_t chunk_size = std::min( nnodes, ::ChunkSize );
+    std::vector<char> buffer( chunk_size * record_size );
+    for ( size_t i = 0; i < nnodes; i += chunk_size )
+    {
+        const size_t n = std::min( chunk_size, nnodes - i );
+        if ( ::Read( buffer.data(), record_size, n, ifs ) != n ) { throw "Cannot read node coordinates."; }
+
+        const char* record = buffer.data();
+        for ( size_t j = 0; j < n; j++, record += record_size )
+        {
+            Index node_number = 0; // 1, 2, 3, ...
+            std::memcpy( &node_number, record, sizeof( Index ) );
+
+            const Index node_id = node_number - 1; // 0, 1, 2, ...
+            if ( node_id < 0 || size_t( node_id ) >= nnodes ) { throw "Invalid node number."; }
+            std::memcpy( coords + 3 * node_id, record + sizeof( Index ), 3 * sizeof( kvs::Real32 ) );
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the node numbers and the separated coordinate arrays in bulk.
+ *  @param  ifs [in] file pointer
+ *  @param  nnodes [in] number of nodes
+ *  @param  coords [out] pointer to the coordinate array
+ */
+/*===========================================================================*/
+template <typename Index>
+inline void ReadSeparatedNodeCoords( FILE* const ifs, const size_t nnodes, kvs::Real32* coords )
+{
+    kvs::ValueArray<Index> node_numbers( nnodes );
+    if ( ::Read( node_numbers.data(), sizeof( Index ), nnodes, ifs ) != nnodes ) { throw "Cannot read node numbers."; }
+    for ( size_t i = 0; i < nnodes; i++ )
+    {
+        if ( node_numbers[i] < 1 || size_t( node_numbers[i] ) > nnodes ) { throw "Invalid node number."; }
+    }
+
+    kvs::ValueArray<kvs::Real32> values( nnodes );
+    for ( size_t k = 0; k < 3; k++ )
+    {
+        if ( ::Read( values.data(), sizeof( kvs::Real32 ), nnodes, ifs ) != nnodes ) { throw "Cannot read node coordinates."; }
+        for ( size_t i = 0; i < nnodes; i++ )
+        {
+            const Index node_id = node_numbers[i] - 1;
+            coords[ 3 * node_id + k ] = values[i];
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads element numbers and connections in bulk.
+ *  @param  ifs [in] file pointer
+ *  @param  nelements [in] number of elements
+ *  @param  element_ids [in] element IDs
+ *  @param  nnodes_per_element [in] number of nodes per element
+ *  @param  connections [out] pointer to the connection array
+ */
+/*===========================================================================*/
+template <typename Index>
+inline void ReadConnections(
+    FILE* const ifs,
+    const size_t nelements,
+    const kvs::ValueArray<Index>& element_ids,
+    const size_t nnodes_per_element,
+    kvs::UInt32* connections )
+{
+    const size_t chunk_size = std::min( nelements, ::ChunkSize );
+    kvs::ValueArray<Index> buffer( chunk_size * nnodes_per_element );
+    for ( size_t i = 0; i < nelements; i += chunk_size )
+    {
+        const size_t n = std::min( chunk_size, nelements - i );
+        const size_t size = n * nnodes_per_element;
+        if ( ::Read( buffer.data(), sizeof( Index ), size, ifs ) != size ) { throw "Cannot read connections."; }
+
+        const Index* connection_number = buffer.data();
+        for ( size_t j = 0; j < n; j++ )
+        {
+            const Index element_id = element_ids[ i + j ];
+            if ( element_id < 0 || size_t( element_id ) >= nelements ) { throw "Invalid element number."; }
+            kvs::UInt32* target = connections + nnodes_per_element * element_id;
+            for ( size_t k = 0; k < nnodes_per_element; k++ )
+            {
+                const Index connection_id = *(connection_number++) - 1;
+                *(target++) = static_cast<kvs::UInt32>( connection_id );
+            }
+        }
+    }
+}
+
 inline int StepNumber( const std::string& filename )
 {
     int result = -1;
@@ -401,6 +611,22 @@ void AVSUcd::read_binary_file( const std::string& filename )
         return;
     }
 
+    // The error in reading the data is passed to read() after closing the file.
+    try
+    {
+        this->read_binary_data( ifs );
+    }
+    catch ( const char* const )
+    {
+        fclose( ifs );
+        throw;
+    }
+
+    fclose( ifs );
+}
+
+void AVSUcd::read_binary_data( FILE* const ifs )
+{
     // File information.
     char keyword[8] = {'\0'};
     ::Read( keyword, 7, 1, ifs );
@@ -432,7 +658,7 @@ void AVSUcd::read_binary_file( const std::string& filename )
     else if ( std::string( keyword ) == "AVSUC64" )
     {
         // 64bit data.
-        long nnodes = 0;
+        kvs::Int64 nnodes = 0;
         ::Read( &nnodes, 8, 1, ifs );
         m_nnodes = static_cast<size_t>( nnodes );
     }
@@ -446,88 +672,22 @@ void AVSUcd::read_binary_file( const std::string& filename )
     {
         if ( std::string( keyword ) == "AVS UCD" )
         {
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                int node_number = 0; // 1, 2, 3, ...
-                ::Read( &node_number, 4, 1, ifs );
-
-                int node_id = node_number - 1; // 0, 1, 2, ...
-                ::Read( pcoords + 3 * node_id, 4, 3, ifs );
-            }
+            ::ReadNodeCoords<int>( ifs, m_nnodes, pcoords );
         }
         else if ( std::string( keyword ) == "AVSUC64" )
         {
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                long node_number = 0; // 1, 2, 3, ...
-                ::Read( &node_number, 8, 1, ifs );
-
-                long node_id = node_number - 1; // 0, 1, 2, ...
-                ::Read( pcoords + 3 * node_id, 4, 3, ifs );
-            }
+            ::ReadNodeCoords<kvs::Int64>( ifs, m_nnodes, pcoords );
         }
     }
     else if ( description_type == 2 )
     {
         if ( std::string( keyword ) == "AVS UCD" )
         {
-            kvs::ValueArray<int> node_ids( m_nnodes );
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                int node_number = 0;
-                ::Read( &node_number, 4, 1, ifs );
-
-                int node_id = node_number - 1;
-                node_ids[i] = node_id;
-            }
-
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                int node_id = node_ids[i];
-                ::Read( pcoords + 3 * node_id, 4, 1, ifs );
-            }
-
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                int node_id = node_ids[i];
-                ::Read( pcoords + 3 * node_id + 1, 4, 1, ifs );
-            }
-
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                int node_id = node_ids[i];
-                ::Read( pcoords + 3 * node_id + 2, 4, 1, ifs );
-            }
+            ::ReadSeparatedNodeCoords<int>( ifs, m_nnodes, pcoords );
         }
         else if ( std::string( keyword ) == "AVSUC64" )
         {
-            kvs::ValueArray<long> node_ids( m_nnodes );
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                long node_number = 0;
-                ::Read( &node_number, 8, 1, ifs );
-
-                long node_id = node_number - 1;
-                node_ids[i] = node_id;
-            }
-
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                long node_id = node_ids[i];
-                ::Read( pcoords + 3 * node_id, 4, 1, ifs );
-            }
-
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                long node_id = node_ids[i];
-                ::Read( pcoords + 3 * node_id + 1, 4, 1, ifs );
-            }
-
-            for ( size_t i = 0; i < m_nnodes; i++ )
-            {
-                long node_id = node_ids[i];
-                ::Read( pcoords + 3 * node_id + 2, 4, 1, ifs );
-            }
+            ::ReadSeparatedNodeCoords<kvs::Int64>( ifs, m_nnodes, pcoords );
         }
     }
 
@@ -540,13 +700,10 @@ void AVSUcd::read_binary_file( const std::string& filename )
         m_nelements = static_cast<size_t>( nelements );
 
         kvs::ValueArray<int> element_ids( m_nelements );
+        if ( ::Read( element_ids.data(), 4, m_nelements, ifs ) != m_nelements ) { throw "Cannot read element numbers."; }
         for ( size_t i = 0; i < m_nelements; i++ )
         {
-            int element_number = 0;
-            ::Read( &element_number, 4, 1, ifs );
-
-            int element_id = element_number - 1;
-            element_ids[i] = element_id;
+            element_ids[i] -= 1; // element number to element ID
         }
 
         // Material numbers.
@@ -568,35 +725,20 @@ void AVSUcd::read_binary_file( const std::string& filename )
 
         m_connections.allocate( m_nelements * nnodes_per_element );
         kvs::UInt32* pconnections = m_connections.data();
-        for ( size_t i = 0; i < m_nelements; i++ )
-        {
-            int element_id = element_ids[i];
-            kvs::UInt32* target = pconnections + nnodes_per_element * element_id;
-            for ( size_t j = 0; j < nnodes_per_element; j++ )
-            {
-                int connection_number = 0;
-                ::Read( &connection_number, 4, 1, ifs );
-
-                int connection_id = connection_number - 1;
-                *(target++) = static_cast<kvs::UInt32>( connection_id );
-            }
-        }
+        ::ReadConnections<int>( ifs, m_nelements, element_ids, nnodes_per_element, pconnections );
     }
     else if ( std::string( keyword ) == "AVSUC64" )
     {
         // 64bit data.
-        long nelements = 0;
+        kvs::Int64 nelements = 0;
         ::Read( &nelements, 8, 1, ifs );
         m_nelements = static_cast<size_t>( nelements );
 
-        kvs::ValueArray<long> element_ids( m_nelements );
+        kvs::ValueArray<kvs::Int64> element_ids( m_nelements );
+        if ( ::Read( element_ids.data(), 8, m_nelements, ifs ) != m_nelements ) { throw "Cannot read element numbers."; }
         for ( size_t i = 0; i < m_nelements; i++ )
         {
-            long element_number = 0;
-            ::Read( &element_number, 8, 1, ifs );
-
-            long element_id = element_number - 1;
-            element_ids[i] = element_id;
+            element_ids[i] -= 1; // element number to element ID
         }
 
         // Material numbers.
@@ -618,19 +760,7 @@ void AVSUcd::read_binary_file( const std::string& filename )
 
         m_connections.allocate( m_nelements * nnodes_per_element );
         kvs::UInt32* pconnections = m_connections.data();
-        for ( size_t i = 0; i < m_nelements; i++ )
-        {
-            long element_id = element_ids[i];
-            kvs::UInt32* target = pconnections + nnodes_per_element * element_id;
-            for ( size_t j = 0; j < nnodes_per_element; j++ )
-            {
-                long connection_number = 0;
-                ::Read( &connection_number, 8, 1, ifs );
-
-                long connection_id = connection_number - 1;
-                *(target++) = static_cast<kvs::UInt32>( connection_id );
-            }
-        }
+        ::ReadConnections<kvs::Int64>( ifs, m_nelements, element_ids, nnodes_per_element, pconnections );
     }
 
     // Node data.
@@ -673,21 +803,27 @@ void AVSUcd::read_binary_file( const std::string& filename )
                 m_nvalues_per_node += m_veclens[i];
             }
 
+            // Only the values of the selected component are extracted from
+            // the node values read in chunks.
             size_t veclen = m_veclens[ m_component_id ];
             size_t offset = 0; for ( size_t i = 0; i < m_component_id; i++ ) { offset += m_veclens[i]; }
-            float* one_node = new float [ m_nvalues_per_node ];
+            const size_t chunk_size = std::min( m_nnodes, ::ChunkSize );
+            kvs::ValueArray<float> buffer( chunk_size * m_nvalues_per_node );
             m_values.allocate( veclen * m_nnodes );
             kvs::Real32* pvalues = m_values.data();
-            for ( size_t i = 0; i < m_nnodes; i++ )
+            for ( size_t i = 0; i < m_nnodes; i += chunk_size )
             {
-                ::Read( one_node, 4, m_nvalues_per_node, ifs );
-                float* v = one_node + offset;
-                for ( size_t j = 0; j < veclen; j++ )
+                const size_t n = std::min( chunk_size, m_nnodes - i );
+                if ( ::Read( buffer.data(), 4, n * m_nvalues_per_node, ifs ) != n * m_nvalues_per_node ) { throw "Cannot read node data."; }
+                for ( size_t j = 0; j < n; j++ )
                 {
-                    *(pvalues++) = *(v++);
+                    const float* v = buffer.data() + j * m_nvalues_per_node + offset;
+                    for ( size_t k = 0; k < veclen; k++ )
+                    {
+                        *(pvalues++) = *(v++);
+                    }
                 }
             }
-            delete [] one_node;
         }
         else
         {
@@ -696,8 +832,6 @@ void AVSUcd::read_binary_file( const std::string& filename )
     }
 
     // Element data. (Currently ignored)
-
-    fclose( ifs );
 }
 
 void AVSUcd::read_single_step_format( FILE* const ifs )
@@ -877,11 +1011,12 @@ void AVSUcd::read_coords( FILE* const ifs )
         if ( fgets( buffer, ::MaxLineLength, ifs ) )
         {
             // Node index.
-            const int index = atoi( strtok( buffer, ::Delimiter ) ) - 1;
+            const char* p = buffer;
+            const kvs::Int64 index = ::ParseInt( p ) - 1;
 
-            coord[ index * 3 + 0 ] = static_cast<float>( atof( strtok( 0, ::Delimiter ) ) );
-            coord[ index * 3 + 1 ] = static_cast<float>( atof( strtok( 0, ::Delimiter ) ) );
-            coord[ index * 3 + 2 ] = static_cast<float>( atof( strtok( 0, ::Delimiter ) ) );
+            coord[ index * 3 + 0 ] = ::ParseReal( p );
+            coord[ index * 3 + 1 ] = ::ParseReal( p );
+            coord[ index * 3 + 2 ] = ::ParseReal( p );
         }
     }
 }
@@ -1285,17 +1420,18 @@ void AVSUcd::read_values( FILE* const ifs )
         if ( fgets( buffer, ::MaxLineLength, ifs ) )
         {
             // Node index
-            const int index = atoi( strtok( buffer, ::Delimiter ) ) - 1;
+            const char* p = buffer;
+            const kvs::Int64 index = ::ParseInt( p ) - 1;
 
             // Skip other components
             for ( size_t j = 0; j < nskips; ++j )
             {
-                strtok( 0, ::Delimiter );
+                p = ::SkipToken( p );
             }
 
             for ( size_t j = 0; j < veclen; ++j )
             {
-                value[ index * veclen + j ] = static_cast<kvs::Real32>( atof( strtok( 0, ::Delimiter ) ) );
+                value[ index * veclen + j ] = ::ParseReal( p );
             }
         }
     }
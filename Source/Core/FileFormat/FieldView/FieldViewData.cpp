@@ -7,11 +7,16 @@
 #include "FieldViewData.h"
 #include "FVReaderTags.h"
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
 #include <kvs/String>
 #include <kvs/Message>
 #include <kvs/Endian>
 #include <kvs/ValueArray>
 #include <kvs/File>
+#include <kvs/Math>
 
 
 namespace
@@ -92,6 +97,12 @@ public:
     size_t length() const { return m_length; }
     //void skip() { if ( fseek( m_fp, m_length, SEEK_CUR ) != 0 ) Error(); }
 
+    template <typename T>
+    void skipValues( size_t size )
+    {
+        if ( fseek( m_fp, static_cast<long>( sizeof(T) * size ), SEEK_CUR ) != 0 ) Error();
+    }
+
     template <typename T>
     T readValue()
     {
@@ -134,6 +145,82 @@ private:
     }
 };
 
+/*===========================================================================*/
+/**
+ *  @brief  Real value reader class for ascii file.
+ *
+ *  The values separated by white spaces are read line by line with fgets()
+ *  and parsed with strtof(), instead of calling fscanf() for each value. The
+ *  rest of the line following the last value read by the reader is skipped.
+ */
+/*===========================================================================*/
+class RealReader
+{
+    static const size_t BufferSize = 4096;
+    FILE* m_fp = nullptr; ///< file pointer
+    char m_buffer[ BufferSize ]; ///< line buffer
+    size_t m_head = 0; ///< position of the next value in the buffer
+    size_t m_tail = 0; ///< end of the complete values in the buffer
+    size_t m_size = 0; ///< number of characters in the buffer
+
+public:
+    RealReader( FILE* fp ): m_fp( fp ) { m_buffer[0] = '\0'; }
+
+    size_t read( const size_t nvalues, kvs::Real32* values )
+    {
+        size_t count = 0;
+        while ( count < nvalues )
+        {
+            const char saved = m_buffer[ m_tail ];
+            m_buffer[ m_tail ] = '\0';
+            char* p = m_buffer + m_head;
+            while ( count < nvalues )
+            {
+                char* end = nullptr;
+                const kvs::Real32 value = std::strtof( p, &end );
+                if ( end == p ) { break; }
+                values[ count++ ] = value;
+                p = end;
+            }
+            m_buffer[ m_tail ] = saved;
+            m_head = p - m_buffer;
+            if ( count == nvalues ) { break; }
+
+            // A remaining token, which is not a number, is an error.
+            while ( m_head < m_tail && std::isspace( static_cast<unsigned char>( m_buffer[ m_head ] ) ) ) { m_head++; }
+            if ( m_head < m_tail ) { break; }
+            if ( !this->fill() ) { break; }
+        }
+
+        return count;
+    }
+
+private:
+    bool fill()
+    {
+        // The incomplete value at the end of the truncated line is moved to the
+        // head, and the rest of the line is appended to it.
+        const size_t kept = m_size - m_head;
+        std::memmove( m_buffer, m_buffer + m_head, kept );
+        m_head = 0;
+        m_size = kept;
+        m_tail = kept;
+        m_buffer[ m_size ] = '\0';
+        if ( kept >= BufferSize - 1 ) { return false; }
+        if ( !std::fgets( m_buffer + kept, int( BufferSize - kept ), m_fp ) ) { return kept > 0; }
+
+        m_size = kept + std::strlen( m_buffer + kept );
+        m_tail = m_size;
+        const bool truncated = m_size == BufferSize - 1 && m_buffer[ m_size - 1 ] != '\n';
+        if ( truncated )
+        {
+            while ( m_tail > 0 && !std::isspace( static_cast<unsigned char>( m_buffer[ m_tail - 1 ] ) ) ) { m_tail--; }
+        }
+
+        return true;
+    }
+};
+
 /*===========================================================================*/
 /**
  *  @brief  Format check class.
@@ -248,6 +335,25 @@ size_t FieldViewData::totalNumberOfElements( const size_t etype ) const
     return nelements;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the specified variable is read from the file.
+ *  @param  vindex [in] variable index
+ *  @return true, if the variable is read
+ */
+/*===========================================================================*/
+bool FieldViewData::is_reading_variable( const size_t vindex ) const
+{
+    if ( m_reading_variable_indices.empty() ) { return true; }
+
+    for ( const auto index : m_reading_variable_indices )
+    {
+        if ( index == vindex ) { return true; }
+    }
+
+    return false;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Print data information.
@@ -778,25 +884,21 @@ void FieldViewData::read_nodes( FILE* fp, size_t gindex )
                 kvsMessageError() << "Cannot read nnodes in NODES." << std::endl;
             }
 
-            for ( int i = 0; i < nnodes; i++ )
+            ::RealReader reader( fp );
+            kvs::ValueArray<kvs::Real32> coords( 3 * size_t( kvs::Math::Max( nnodes, 0 ) ) );
+            const size_t ncoords = reader.read( coords.size(), coords.data() );
+            if ( ncoords != coords.size() )
             {
-                Node node;
-                if ( fscanf( fp, "%f", &node.x ) == -1 )
-                {
-                    kvsMessageError() << "Cannot read node.x in NODES." << std::endl;
-                }
-
-                if ( fscanf( fp, "%f", &node.y ) == -1 )
-                {
-                    kvsMessageError() << "Cannot read node.y in NODES." << std::endl;
-                }
-
-                if ( fscanf( fp, "%f", &node.z ) == -1 )
-                {
-                    kvsMessageError() << "Cannot read node.z in NODES." << std::endl;
-                }
+                kvsMessageError() << "Cannot read nodes in NODES." << std::endl;
+                std::fill( coords.begin() + ncoords, coords.end(), 0.0f );
+            }
 
-                grid.nodes.push_back( node );
+            grid.nodes.resize( coords.size() / 3 );
+            for ( size_t i = 0; i < grid.nodes.size(); i++ )
+            {
+                grid.nodes[i].x = coords[ 3 * i + 0 ];
+                grid.nodes[i].y = coords[ 3 * i + 1 ];
+                grid.nodes[i].z = coords[ 3 * i + 2 ];
             }
 
             break;
@@ -891,18 +993,23 @@ void FieldViewData::read_variables( FILE* fp, size_t gindex )
     {
         if ( kvs::String::ToUpper( std::string( buffer ) ) == "VARIABLES" )
         {
+            // The values of the unselected variables are read into the
+            // buffer to be discarded.
+            ::RealReader reader( fp );
+            kvs::ValueArray<kvs::Real32> skipped;
             for ( size_t i = 0; i < m_nvariables; i++ )
             {
                 Variable variable;
-                variable.data.allocate( grid.nodes.size() );
-                for ( size_t j = 0; j < grid.nodes.size(); j++ )
+                const bool reading = this->is_reading_variable( i );
+                if ( reading ) { variable.data.allocate( grid.nodes.size() ); }
+                else if ( skipped.size() != grid.nodes.size() ) { skipped.allocate( grid.nodes.size() ); }
+
+                kvs::Real32* data = reading ? variable.data.data() : skipped.data();
+                const size_t ndata = reader.read( grid.nodes.size(), data );
+                if ( ndata != grid.nodes.size() )
                 {
-                    float data = 0.0f;
-                    if ( fscanf( fp, "%f", &data ) == -1 )
-                    {
-                        kvsMessageError() << "Cannot read data in VARIABLES." << std::endl;
-                    }
-                    variable.data[j] = data;
+                    kvsMessageError() << "Cannot read data in VARIABLES." << std::endl;
+                    std::fill( data + ndata, data + grid.nodes.size(), 0.0f );
                 }
 
                 grid.variables.push_back( variable );
@@ -1196,6 +1303,7 @@ void FieldViewData::read_elements( FILE* fp, bool swap, size_t offset, size_t gi
     while ( ::Record::PeekValue<int>( fp, swap, offset ) == FV_ELEMENTS )
     {
         int total_count = 0;
+        size_t total_size = 0; // number of headers and node IDs
         {
             ::Record record( fp, swap, offset );
             kvs::ValueArray<int> temp = record.readValues<int>( 5 );
@@ -1207,50 +1315,42 @@ void FieldViewData::read_elements( FILE* fp, bool swap, size_t offset, size_t gi
             //     temp[3]: prism count
             //     temp[4]: pyramid count
             total_count = temp[1] + temp[2] + temp[3] + temp[4];
+            total_size =
+                static_cast<size_t>( temp[1] ) * 5 + static_cast<size_t>( temp[2] ) * 9 +
+                static_cast<size_t>( temp[3] ) * 7 + static_cast<size_t>( temp[4] ) * 6;
         }
 
+        // All of the element headers and node IDs in the record are read at
+        // once, and then split into the elements.
         ::Record record( fp, swap, offset );
-        for ( int i = 0; i < total_count; i++ )
+        const kvs::ValueArray<int> values = record.readValues<int>( total_size );
+        const int* value = values.data();
+        const int* const end = value + values.size();
+
+        grid.elements.reserve( grid.elements.size() + total_count );
+        for ( int i = 0; i < total_count && value < end; i++ )
         {
             Element element;
 
-            int header = record.readValue<int>();
+            int header = *(value++);
             header = header >> 18;
+
+            size_t nnodes = 0;
             switch ( header )
             {
-            case 1:
-            {
-                element.type = FieldViewData::Tet;
-                element.id = record.readValues<int>( 4 );
-                grid.nelements[0]++;
-                grid.nelements[FieldViewData::Tet]++;
-                break;
-            }
-            case 4:
-            {
-                element.type = FieldViewData::Hex;
-                element.id = record.readValues<int>( 8 );
-                grid.nelements[0]++;
-                grid.nelements[FieldViewData::Hex]++;
-                break;
-            }
-            case 3:
-            {
-                element.type = FieldViewData::Pri;
-                element.id = record.readValues<int>( 6 );
-                grid.nelements[0]++;
-                grid.nelements[FieldViewData::Pri]++;
-                break;
+            case 1: element.type = FieldViewData::Tet; nnodes = 4; break;
+            case 4: element.type = FieldViewData::Hex; nnodes = 8; break;
+            case 3: element.type = FieldViewData::Pri; nnodes = 6; break;
+            case 2: element.type = FieldViewData::Pyr; nnodes = 5; break;
+            default: break;
             }
-            case 2:
+
+            if ( nnodes > 0 && value + nnodes <= end )
             {
-                element.type = FieldViewData::Pyr;
-                element.id = record.readValues<int>( 5 );
+                element.id = kvs::ValueArray<int>( value, nnodes );
+                value += nnodes;
                 grid.nelements[0]++;
-                grid.nelements[FieldViewData::Pyr]++;
-                break;
-            }
-            default: break;
+                grid.nelements[ element.type ]++;
             }
 
             grid.elements.push_back( element );
@@ -1280,8 +1380,16 @@ void FieldViewData::read_variables( FILE* fp, bool swap, size_t offset, size_t g
     ::Record record( fp, swap, offset );
     for ( size_t i = 0; i < m_nvariables; i++ )
     {
+        // The unselected variables are skipped without reading the values.
         Variable variable;
-        variable.data = record.readValues<float>( grid.nodes.size() );
+        if ( this->is_reading_variable( i ) )
+        {
+            variable.data = record.readValues<float>( grid.nodes.size() );
+        }
+        else
+        {
+            record.skipValues<float>( grid.nodes.size() );
+        }
         grid.variables.push_back( variable );
     }
 
@@ -1324,21 +1432,17 @@ void FieldViewData::read_variables_on_face( FILE* fp, bool swap, size_t offset,
 
     if ( nvariables_on_face > 0 )
     {
+        size_t nvalues = 0;
+        for ( size_t j = 0; j < nfaces; j++ )
+        {
+            if ( m_boundary_condition.results[j] == 1 ) { nvalues++; }
+        }
+
         ::Record record( fp, swap, offset );
         for ( size_t i = 0; i < nvariables_on_face; i++ )
         {
-            std::vector<float> data;
-            for ( size_t j = 0; j < nfaces; j++ )
-            {
-                if ( m_boundary_condition.results[j] == 1 )
-                {
-                    float var = record.readValue<float>();
-                    data.push_back( var );
-                }
-            }
-
             Variable variable;
-            variable.data = kvs::ValueArray<float>( data );
+            variable.data = record.readValues<float>( nvalues );
             grid.variables_on_face.push_back( variable );
         }
 
@@ -99,6 +99,7 @@ private:
     std::vector<std::string> m_variable_names{}; ///< variable names
     std::vector<std::string> m_variable_names_on_face{}; ///< variable names on the boundary face
     std::vector<Grid> m_grids{}; ///< grid data
+    std::vector<size_t> m_reading_variable_indices{}; ///< indices of variables to be read (all if empty)
     mutable int m_importing_element_type = 0; ///< importing element type
     mutable size_t m_importing_grid_index = 0; ///< importing grid index
     mutable size_t m_importing_variable_index = 0; ///< importing variable index
@@ -137,6 +138,9 @@ public:
     void setImportingGridIndex( const size_t gindex ) const { m_importing_grid_index = gindex; }
     void setImportingVariableIndex( const size_t vindex ) const { m_importing_variable_index = vindex; }
 
+    const std::vector<size_t>& readingVariableIndices() const { return m_reading_variable_indices; }
+    void setReadingVariableIndices( const std::vector<size_t>& indices ) { m_reading_variable_indices = indices; }
+
     void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
     bool read( const std::string& filename );
     bool read( const std::string& gfilename, const std::string& rfilename );
@@ -150,6 +154,7 @@ public:
 
 private:
     bool write( const std::string& ) { return false; }
+    bool is_reading_variable( const size_t vindex ) const;
 
     void read_version( FILE* fp );
     void read_constants( FILE* fp );
@@ -118,6 +118,12 @@ std::string ReplaceMinute( const std::string& filename, const int minute )
     return filename;
 }
 
+size_t NumberOfLevels( const kvs::grads::Vars::Var& var )
+{
+    // The number of levels is specified as 0 for the surface variables.
+    return var.levs > 0 ? static_cast<size_t>( var.levs ) : 1;
+}
+
 }
 
 
@@ -135,6 +141,68 @@ bool GrADS::CheckExtension( const std::string& filename )
     return false;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the hyperslab that covers the whole region of the variable.
+ *  @param  varname [in] variable name
+ *  @return hyperslab
+ */
+/*===========================================================================*/
+GrADS::Hyperslab GrADS::hyperslab( const std::string& varname ) const
+{
+    Hyperslab slab;
+    slab.varname = varname;
+
+    const auto& vars = m_data_descriptor.vars().values;
+    for ( const auto& var : vars )
+    {
+        if ( var.varname == varname )
+        {
+            const auto nx = static_cast<unsigned int>( m_data_descriptor.xdef().num );
+            const auto ny = static_cast<unsigned int>( m_data_descriptor.ydef().num );
+            const auto nz = static_cast<unsigned int>( ::NumberOfLevels( var ) );
+            const auto nt = static_cast<unsigned int>( m_data_descriptor.tdef().num );
+            slab.xrange = kvs::Vec2ui( 0, nx > 0 ? nx - 1 : 0 );
+            slab.yrange = kvs::Vec2ui( 0, ny > 0 ? ny - 1 : 0 );
+            slab.zrange = kvs::Vec2ui( 0, nz - 1 );
+            slab.trange = kvs::Vec2ui( 0, nt > 0 ? nt - 1 : 0 );
+            break;
+        }
+    }
+
+    return slab;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads data values in the specified hyperslab.
+ *  @param  slab [in] hyperslab
+ *  @return data values ordered in X, Y, Z and T (empty if failed)
+ *
+ *  Only the bytes in the hyperslab are read from the binary data files,
+ *  so that the whole data need not be loaded into the memory.
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> GrADS::readHyperslab( const Hyperslab& slab ) const
+{
+    return this->read_hyperslab( slab, false, 0.0f );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads data values in the specified hyperslab with undef masking.
+ *  @param  slab [in] hyperslab
+ *  @param  undef_value [in] value substituted for the undefined values
+ *  @return data values ordered in X, Y, Z and T (empty if failed)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> GrADS::readHyperslab(
+    const Hyperslab& slab,
+    const kvs::Real32 undef_value ) const
+{
+    return this->read_hyperslab( slab, true, undef_value );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Prints data information.
@@ -250,6 +318,113 @@ void GrADS::print( std::ostream& os, const kvs::Indent& indent ) const
     return true;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Checks whether the hyperslab is inside the data region.
+ *  @param  slab [in] hyperslab
+ *  @return true, if the hyperslab is valid
+ */
+/*===========================================================================*/
+bool GrADS::check_hyperslab( const Hyperslab& slab ) const
+{
+    const int vindex = m_data_descriptor.vars().indexOf( slab.varname );
+    if ( vindex < 0 )
+    {
+        kvsMessageError( "Cannot find the variable %s.", slab.varname.c_str() );
+        return false;
+    }
+
+    const Hyperslab whole = this->hyperslab( slab.varname );
+    const auto check = [] ( const kvs::Vec2ui& range, const kvs::Vec2ui& limit )
+    {
+        return range[0] <= range[1] && range[1] <= limit[1];
+    };
+
+    if ( !check( slab.xrange, whole.xrange ) ||
+         !check( slab.yrange, whole.yrange ) ||
+         !check( slab.zrange, whole.zrange ) ||
+         !check( slab.trange, whole.trange ) )
+    {
+        kvsMessageError( "The hyperslab is out of range for the variable %s.", slab.varname.c_str() );
+        return false;
+    }
+
+    const bool templated = m_data_descriptor.options().find( kvs::grads::Options::Template );
+    const size_t nfiles = templated ? slab.trange[1] + 1 : 1;
+    if ( m_data_list.size() < nfiles )
+    {
+        kvsMessageError( "Cannot find the binary data file for the time step %u.", slab.trange[1] );
+        return false;
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads data values in the specified hyperslab.
+ *  @param  slab [in] hyperslab
+ *  @param  replace_undef [in] if true, the undefined values are replaced
+ *  @param  undef_value [in] value substituted for the undefined values
+ *  @return data values ordered in X, Y, Z and T (empty if failed)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> GrADS::read_hyperslab(
+    const Hyperslab& slab,
+    const bool replace_undef,
+    const kvs::Real32 undef_value ) const
+{
+    if ( !this->check_hyperslab( slab ) ) { return kvs::ValueArray<kvs::Real32>(); }
+
+    // Offset to the first value of the variable and number of values in
+    // one time step. The variables are stored sequentially in the order of
+    // VARS, and each variable consists of the XY planes for all levels.
+    const size_t nx = m_data_descriptor.xdef().num;
+    const size_t ny = m_data_descriptor.ydef().num;
+    size_t var_offset = 0;
+    size_t step_size = 0;
+    for ( const auto& var : m_data_descriptor.vars().values )
+    {
+        if ( var.varname == slab.varname ) { var_offset = step_size; }
+        step_size += nx * ny * ::NumberOfLevels( var );
+    }
+
+    const kvs::Vec3ui min_index( slab.xrange[0], slab.yrange[0], slab.zrange[0] );
+    const kvs::Vec3ui max_index( slab.xrange[1], slab.yrange[1], slab.zrange[1] );
+    const kvs::Vec3ui dim = max_index - min_index + kvs::Vec3ui::Constant( 1 );
+    const size_t size = size_t( dim.x() ) * dim.y() * dim.z();
+    const size_t nsteps = slab.trange[1] - slab.trange[0] + 1;
+
+    // In case of the templated data, each time step is stored in each file.
+    // Otherwise, all time steps are stored in one file.
+    const bool templated = m_data_descriptor.options().find( kvs::grads::Options::Template );
+    const kvs::Real32 undef = m_data_descriptor.undef().value;
+
+    kvs::ValueArray<kvs::Real32> values( size * nsteps );
+    for ( size_t i = 0; i < nsteps; i++ )
+    {
+        const size_t t = slab.trange[0] + i;
+        const GriddedBinaryDataFile& data = m_data_list[ templated ? t : 0 ];
+        const size_t offset = templated ? var_offset : t * step_size + var_offset;
+
+        kvs::Real32* dst = values.data() + i * size;
+        if ( !data.read( dst, offset, kvs::Vec2ui( nx, ny ), min_index, max_index ) )
+        {
+            return kvs::ValueArray<kvs::Real32>();
+        }
+
+        if ( replace_undef )
+        {
+            for ( size_t j = 0; j < size; j++ )
+            {
+                if ( dst[j] == undef ) { dst[j] = undef_value; }
+            }
+        }
+    }
+
+    return values;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Writes GrADS data.
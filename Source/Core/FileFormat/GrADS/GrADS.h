@@ -8,6 +8,8 @@
 #include <iostream>
 #include <kvs/FileFormatBase>
 #include <kvs/Indent>
+#include <kvs/ValueArray>
+#include <kvs/Vector2>
 #include "DataDescriptorFile.h"
 #include "GriddedBinaryDataFile.h"
 
@@ -28,6 +30,22 @@ public:
     using GriddedBinaryDataFile = kvs::grads::GriddedBinaryDataFile;
     using GriddedBinaryDataFileList = std::vector<GriddedBinaryDataFile>;
 
+    /*=======================================================================*/
+    /**
+     *  @brief  Sub-region of a variable specified by grid index ranges.
+     *
+     *  Each range is given by the first and last grid index (inclusive).
+     */
+    /*=======================================================================*/
+    struct Hyperslab
+    {
+        std::string varname = ""; ///< variable name
+        kvs::Vec2ui xrange{ 0, 0 }; ///< index range in X direction
+        kvs::Vec2ui yrange{ 0, 0 }; ///< index range in Y direction
+        kvs::Vec2ui zrange{ 0, 0 }; ///< index range of the levels
+        kvs::Vec2ui trange{ 0, 0 }; ///< index range of the time steps
+    };
+
 private:
     DataDescriptorFile m_data_descriptor{}; ///< data descriptor file
     GriddedBinaryDataFileList m_data_list{}; ///< gridded binary data file list
@@ -44,11 +62,19 @@ public:
     const GriddedBinaryDataFileList& dataList() const { return m_data_list; }
     const GriddedBinaryDataFile& data( const size_t index ) const { return m_data_list[index]; }
 
+    Hyperslab hyperslab( const std::string& varname ) const;
+    kvs::ValueArray<kvs::Real32> readHyperslab( const Hyperslab& slab ) const;
+    kvs::ValueArray<kvs::Real32> readHyperslab( const Hyperslab& slab, const kvs::Real32 undef_value ) const;
+
     void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
     bool read( const std::string& filename );
 
 private:
-
+    bool check_hyperslab( const Hyperslab& slab ) const;
+    kvs::ValueArray<kvs::Real32> read_hyperslab(
+        const Hyperslab& slab,
+        const bool replace_undef,
+        const kvs::Real32 undef_value ) const;
     bool write( const std::string& filename );
 };
 
@@ -6,7 +6,10 @@
 /*****************************************************************************/
 #include "GriddedBinaryDataFile.h"
 #include <fstream>
+#include <vector>
+#include <cstring>
 #include <kvs/Endian>
+#include <kvs/Message>
 
 
 namespace kvs
@@ -26,7 +29,7 @@ const kvs::ValueArray<kvs::Real32> GriddedBinaryDataFile::values(
     const size_t vindex,
     const kvs::Vec3ui& dim ) const
 {
-    const size_t size = dim.x() * dim.y() * dim.z();
+    const size_t size = size_t( dim.x() ) * dim.y() * dim.z();
     if ( m_values.size() < ( vindex + 1 ) * size ) return kvs::ValueArray<kvs::Real32>();
 
     kvs::ValueArray<kvs::Real32> dst( size );
@@ -101,6 +104,98 @@ bool GriddedBinaryDataFile::load() const
     return true;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Reads data values in the specified sub-region from the data file.
+ *  @param  values [out] pointer to the buffer for the read values
+ *  @param  offset [in] offset to the first value of the region (z = 0) in number of values
+ *  @param  dim [in] number of grid points in X and Y direction
+ *  @param  min_index [in] minimum grid index of the region
+ *  @param  max_index [in] maximum grid index of the region
+ *  @return true, if the reading process is done successfully
+ *
+ *  Only the bytes in the region are read from the file by seeking to each
+ *  row. The values are stored in the order of X, Y and Z into the buffer,
+ *  which must have enough space for the region.
+ */
+/*===========================================================================*/
+bool GriddedBinaryDataFile::read(
+    kvs::Real32* values,
+    const size_t offset,
+    const kvs::Vec2ui& dim,
+    const kvs::Vec3ui& min_index,
+    const kvs::Vec3ui& max_index ) const
+{
+    if ( m_filename.length() == 0 )
+    {
+        kvsMessageError("Filename of binary data has not been specified.");
+        return false;
+    }
+
+    std::ifstream ifs( m_filename.c_str(), std::ios::binary | std::ios::in );
+    if( !ifs.is_open() )
+    {
+        kvsMessageError( "Cannot open %s.", m_filename.c_str() );
+        return false;
+    }
+
+    // In the sequential data, each value is enclosed by the paddings.
+    const size_t padding_size = 2 * sizeof( kvs::Int16 );
+    const size_t element_size = m_sequential ?
+        sizeof( kvs::Real32 ) + 2 * padding_size :
+        sizeof( kvs::Real32 );
+
+    const size_t nx = max_index.x() - min_index.x() + 1;
+    const size_t ny = max_index.y() - min_index.y() + 1;
+
+    // The rows covering the whole X range are contiguous in the file, so the
+    // XY window on each level can be read at once.
+    const bool whole_row = ( nx == dim.x() );
+    const size_t nrows = whole_row ? 1 : ny;
+    const size_t length = whole_row ? nx * ny : nx;
+
+    std::vector<char> buffer( m_sequential ? length * element_size : 0 );
+    const bool swap = ( m_big_endian != kvs::Endian::IsBig() );
+
+    kvs::Real32* dst = values;
+    for ( size_t k = min_index.z(); k <= max_index.z(); k++ )
+    {
+        for ( size_t j = 0; j < nrows; j++ )
+        {
+            const size_t y = min_index.y() + j;
+            const size_t index = offset + ( k * dim.y() + y ) * dim.x() + min_index.x();
+            ifs.seekg( static_cast<std::streamoff>( index * element_size ), std::ios::beg );
+
+            if ( m_sequential )
+            {
+                ifs.read( buffer.data(), length * element_size );
+                const char* src = buffer.data() + padding_size;
+                for ( size_t i = 0; i < length; i++, src += element_size )
+                {
+                    std::memcpy( dst + i, src, sizeof( kvs::Real32 ) );
+                }
+            }
+            else
+            {
+                ifs.read( (char*)( dst ), length * element_size );
+            }
+
+            if ( !ifs )
+            {
+                kvsMessageError( "Cannot read the data values from %s.", m_filename.c_str() );
+                return false;
+            }
+
+            if ( swap ) { kvs::Endian::Swap( dst, length ); }
+            dst += length;
+        }
+    }
+
+    ifs.close();
+
+    return true;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Free loaded data values.
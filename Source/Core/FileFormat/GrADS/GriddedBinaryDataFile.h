@@ -8,6 +8,7 @@
 #include <string>
 #include <kvs/ValueArray>
 #include <kvs/Type>
+#include <kvs/Vector2>
 #include <kvs/Vector3>
 
 
@@ -55,6 +56,12 @@ public:
     const kvs::ValueArray<kvs::Real32>& values() const { return m_values; }
     const kvs::ValueArray<kvs::Real32> values( const size_t vindex, const kvs::Vec3ui& dim ) const;
     bool load() const;
+    bool read(
+        kvs::Real32* values,
+        const size_t offset,
+        const kvs::Vec2ui& dim,
+        const kvs::Vec3ui& min_index,
+        const kvs::Vec3ui& max_index ) const;
     void free() const;
 };
 
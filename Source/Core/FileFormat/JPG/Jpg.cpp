@@ -158,7 +158,7 @@ bool Jpg::write( const std::string& filename )
     auto ret = stbi_write_png( filename.c_str(), width, height, bpp, pixels, m_quality );
     if ( !ret )
     {
-        kvsMessageError() << std::string( stbi_failure_reason() ) << std::endl;
+        kvsMessageError() << "Cannot write " << filename << "." << std::endl;
         BaseClass::setSuccess( false );
         return false;
     }
@@ -5,6 +5,8 @@
  */
 /*****************************************************************************/
 #pragma once
+#include <string>
+#include <kvs/XMLNode>
 #include "TagBase.h"
 
 
@@ -24,8 +26,19 @@ class CoordTag : public kvs::kvsml::TagBase
 public:
     using BaseClass = kvs::kvsml::TagBase;
 
+private:
+    bool m_has_encoding = false; ///< flag to check whether 'encoding' is specified or not
+    std::string m_encoding{}; ///< encoding of the compressed data
+
 public:
     CoordTag();
+
+    bool hasEncoding() const { return m_has_encoding; }
+    const std::string& encoding() const { return m_encoding; }
+    void setEncoding( const std::string& encoding ) { m_has_encoding = true; m_encoding = encoding; }
+
+    bool read( const kvs::XMLNode::SuperClass* parent );
+    bool write( kvs::XMLNode::SuperClass* parent );
 };
 
 } // end of namespace kvsml
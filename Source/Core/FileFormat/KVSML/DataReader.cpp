@@ -12,6 +12,7 @@
 #include "SizeTag.h"
 #include "ConnectionTag.h"
 #include "OpacityTag.h"
+#include "PaletteTag.h"
 #include "DataArrayTag.h"
 #include "DataValueTag.h"
 #include <kvs/Message>
@@ -49,6 +50,9 @@ bool ReadCoordData(
             return false;
         }
 
+        // Encoded data is read with the corresponding Read*Data function.
+        if ( coord_tag.hasEncoding() ) { return true; }
+
         // <DataArray>
         const size_t dimension = 3;
         const size_t nelements = ncoords * dimension;
@@ -89,6 +93,9 @@ bool ReadColorData(
             return false;
         }
 
+        // Encoded data is read with the corresponding Read*Data function.
+        if ( color_tag.hasEncoding() ) { return true; }
+
         // <DataValue>
         if ( kvs::XMLNode::FindChildNode( color_tag.node(), "DataValue" ) )
         {
@@ -147,6 +154,9 @@ bool ReadNormalData(
             return false;
         }
 
+        // Encoded data is read with the corresponding Read*Data function.
+        if ( normal_tag.hasEncoding() ) { return true; }
+
         // <DataValue>
         if ( kvs::XMLNode::FindChildNode( normal_tag.node(), "DataValue" ) )
         {
@@ -331,6 +341,171 @@ bool ReadOpacityData(
     return true;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Reads 16-bit quantized coordinate data from <Coord encoding="quantized16">.
+ *  @param  parent  [in] pointer to the parent node
+ *  @param  ncoords [in] number of coordinates
+ *  @param  coords [out] pointer to the quantized coordinate value array
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadQuantizedCoordData(
+    const kvs::XMLNode::SuperClass* parent,
+    const size_t ncoords,
+    kvs::ValueArray<kvs::UInt16>* coords )
+{
+    // <Coord encoding="quantized16">
+    kvs::kvsml::CoordTag coord_tag;
+    if ( coord_tag.isExisted( parent ) )
+    {
+        if ( !coord_tag.read( parent ) )
+        {
+            kvsMessageError( "Cannot read <%s>.", coord_tag.name().c_str() );
+            return false;
+        }
+
+        if ( !coord_tag.hasEncoding() ) { return true; }
+        if ( coord_tag.encoding() != "quantized16" )
+        {
+            kvsMessageError( "Unknown encoding '%s' in <%s>.",
+                             coord_tag.encoding().c_str(),
+                             coord_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        const size_t dimension = 3;
+        const size_t nelements = ncoords * dimension;
+        kvs::kvsml::DataArrayTag data_tag;
+        if ( !data_tag.read( coord_tag.node(), nelements, coords ) )
+        {
+            kvsMessageError( "Cannot read <%s> for <%s>.",
+                             data_tag.name().c_str(),
+                             coord_tag.name().c_str() );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads indexed color data from <Color encoding="palette">.
+ *  @param  parent  [in] pointer to the parent node
+ *  @param  ncolors [in] number of color indices
+ *  @param  indices [out] pointer to the color index array
+ *  @param  palette [out] pointer to the color(r,g,b) palette
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadIndexedColorData(
+    const kvs::XMLNode::SuperClass* parent,
+    const size_t ncolors,
+    kvs::ValueArray<kvs::UInt8>* indices,
+    kvs::ValueArray<kvs::UInt8>* palette )
+{
+    // <Color encoding="palette">
+    kvs::kvsml::ColorTag color_tag;
+    if ( color_tag.isExisted( parent ) )
+    {
+        if ( !color_tag.read( parent ) )
+        {
+            kvsMessageError( "Cannot read <%s>.", color_tag.name().c_str() );
+            return false;
+        }
+
+        if ( !color_tag.hasEncoding() ) { return true; }
+        if ( color_tag.encoding() != "palette" )
+        {
+            kvsMessageError( "Unknown encoding '%s' in <%s>.",
+                             color_tag.encoding().c_str(),
+                             color_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        kvs::kvsml::DataArrayTag data_tag;
+        if ( !data_tag.read( color_tag.node(), ncolors, indices ) )
+        {
+            kvsMessageError( "Cannot read <%s> for <%s>.",
+                             data_tag.name().c_str(),
+                             color_tag.name().c_str() );
+            return false;
+        }
+
+        // <Palette ncolors="xxx">
+        kvs::kvsml::PaletteTag palette_tag;
+        if ( !palette_tag.read( color_tag.node() ) || !palette_tag.hasNColors() )
+        {
+            kvsMessageError( "Cannot read <%s>.", palette_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        const size_t nchannels = 3; // RGB
+        const size_t nelements = palette_tag.ncolors() * nchannels;
+        kvs::kvsml::DataArrayTag palette_data_tag;
+        if ( !palette_data_tag.read( palette_tag.node(), nelements, palette ) )
+        {
+            kvsMessageError( "Cannot read <%s> for <%s>.",
+                             palette_data_tag.name().c_str(),
+                             palette_tag.name().c_str() );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads octahedral-packed normal data from <Normal encoding="octahedral16">.
+ *  @param  parent  [in] pointer to the parent node
+ *  @param  nnormals [in] number of normals
+ *  @param  normals [out] pointer to the packed normal value array
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool ReadPackedNormalData(
+    const kvs::XMLNode::SuperClass* parent,
+    const size_t nnormals,
+    kvs::ValueArray<kvs::UInt16>* normals )
+{
+    // <Normal encoding="octahedral16">
+    kvs::kvsml::NormalTag normal_tag;
+    if ( normal_tag.isExisted( parent ) )
+    {
+        if ( !normal_tag.read( parent ) )
+        {
+            kvsMessageError( "Cannot read <%s>.", normal_tag.name().c_str() );
+            return false;
+        }
+
+        if ( !normal_tag.hasEncoding() ) { return true; }
+        if ( normal_tag.encoding() != "octahedral16" )
+        {
+            kvsMessageError( "Unknown encoding '%s' in <%s>.",
+                             normal_tag.encoding().c_str(),
+                             normal_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        kvs::kvsml::DataArrayTag data_tag;
+        if ( !data_tag.read( normal_tag.node(), nnormals, normals ) )
+        {
+            kvsMessageError( "Cannot read <%s> for <%s>.",
+                             data_tag.name().c_str(),
+                             normal_tag.name().c_str() );
+            return false;
+        }
+    }
+
+    return true;
+}
+
 } // end of namespace kvsml
 
 } // end of namespace kvs
@@ -46,6 +46,22 @@ bool ReadOpacityData(
     const size_t nopacities,
     kvs::ValueArray<kvs::UInt8>* opacities );
 
+bool ReadQuantizedCoordData(
+    const kvs::XMLNode::SuperClass* parent,
+    const size_t ncoords,
+    kvs::ValueArray<kvs::UInt16>* coords );
+
+bool ReadIndexedColorData(
+    const kvs::XMLNode::SuperClass* parent,
+    const size_t ncolors,
+    kvs::ValueArray<kvs::UInt8>* indices,
+    kvs::ValueArray<kvs::UInt8>* palette );
+
+bool ReadPackedNormalData(
+    const kvs::XMLNode::SuperClass* parent,
+    const size_t nnormals,
+    kvs::ValueArray<kvs::UInt16>* normals );
+
 } // end of namespace kvsml
 
 } // end of namespace kvs
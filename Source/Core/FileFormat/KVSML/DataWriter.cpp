@@ -12,12 +12,61 @@
 #include "SizeTag.h"
 #include "ConnectionTag.h"
 #include "OpacityTag.h"
+#include "PaletteTag.h"
 #include "DataArrayTag.h"
 #include "DataValueTag.h"
 #include <kvs/Message>
 #include <kvs/ValueArray>
 #include <kvs/XMLNode>
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the data array to <DataArray> under the given tag.
+ *  @param  tag [in] tag written in advance
+ *  @param  writing_type [in] writing data type
+ *  @param  filename [in] filename
+ *  @param  suffix [in] suffix of the external data filename
+ *  @param  values [in] value array
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+template <typename T>
+bool WriteDataArray(
+    kvs::kvsml::TagBase& tag,
+    const kvs::kvsml::WritingDataType writing_type,
+    const std::string& filename,
+    const std::string& suffix,
+    const kvs::ValueArray<T>& values )
+{
+    kvs::kvsml::DataArrayTag data_tag;
+    if ( writing_type == kvs::kvsml::ExternalAscii )
+    {
+        data_tag.setFile( kvs::kvsml::DataArray::GetDataFilename( filename, suffix ) );
+        data_tag.setFormat( "ascii" );
+    }
+    else if ( writing_type == kvs::kvsml::ExternalBinary )
+    {
+        data_tag.setFile( kvs::kvsml::DataArray::GetDataFilename( filename, suffix ) );
+        data_tag.setFormat( "binary" );
+    }
+
+    const std::string pathname = kvs::File( filename ).pathName();
+    if ( !data_tag.write( tag.node(), values, pathname ) )
+    {
+        kvsMessageError( "Cannot write <%s> for <%s>.",
+                         data_tag.name().c_str(),
+                         tag.name().c_str() );
+        return false;
+    }
+
+    return true;
+}
+
+} // end of namespace
+
 
 namespace kvs
 {
@@ -398,6 +447,134 @@ bool WriteOpacityData(
     return true;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Writes 16-bit quantized coordinate data to <Coord encoding="quantized16">.
+ *  @param  parent [out] pointer to the parent node
+ *  @param  writing_type [in] writing data type
+ *  @param  filename [in] filename
+ *  @param  coords [in] quantized coordinate value array
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+bool WriteQuantizedCoordData(
+    kvs::XMLNode::SuperClass* parent,
+    const kvs::kvsml::WritingDataType writing_type,
+    const std::string& filename,
+    const kvs::ValueArray<kvs::UInt16>& coords )
+{
+    // <Coord encoding="quantized16">
+    if ( coords.size() > 0 )
+    {
+        kvs::kvsml::CoordTag coord_tag;
+        coord_tag.setEncoding( "quantized16" );
+        if ( !coord_tag.write( parent ) )
+        {
+            kvsMessageError( "Cannot write <%s>.", coord_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        if ( !::WriteDataArray( coord_tag, writing_type, filename, "coord", coords ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes indexed color data to <Color encoding="palette">.
+ *  @param  parent [out] pointer to the parent node
+ *  @param  writing_type [in] writing data type
+ *  @param  filename [in] filename
+ *  @param  indices [in] color index array
+ *  @param  palette [in] color(r,g,b) palette
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+bool WriteIndexedColorData(
+    kvs::XMLNode::SuperClass* parent,
+    const kvs::kvsml::WritingDataType writing_type,
+    const std::string& filename,
+    const kvs::ValueArray<kvs::UInt8>& indices,
+    const kvs::ValueArray<kvs::UInt8>& palette )
+{
+    // <Color encoding="palette">
+    if ( indices.size() > 0 )
+    {
+        kvs::kvsml::ColorTag color_tag;
+        color_tag.setEncoding( "palette" );
+        if ( !color_tag.write( parent ) )
+        {
+            kvsMessageError( "Cannot write <%s>.", color_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        if ( !::WriteDataArray( color_tag, writing_type, filename, "color", indices ) )
+        {
+            return false;
+        }
+
+        // <Palette ncolors="xxx">
+        kvs::kvsml::PaletteTag palette_tag;
+        palette_tag.setNColors( palette.size() / 3 );
+        if ( !palette_tag.write( color_tag.node() ) )
+        {
+            kvsMessageError( "Cannot write <%s>.", palette_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        if ( !::WriteDataArray( palette_tag, writing_type, filename, "palette", palette ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes octahedral-packed normal data to <Normal encoding="octahedral16">.
+ *  @param  parent [out] pointer to the parent node
+ *  @param  writing_type [in] writing data type
+ *  @param  filename [in] filename
+ *  @param  normals [in] packed normal value array
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+bool WritePackedNormalData(
+    kvs::XMLNode::SuperClass* parent,
+    const kvs::kvsml::WritingDataType writing_type,
+    const std::string& filename,
+    const kvs::ValueArray<kvs::UInt16>& normals )
+{
+    // <Normal encoding="octahedral16">
+    if ( normals.size() > 0 )
+    {
+        kvs::kvsml::NormalTag normal_tag;
+        normal_tag.setEncoding( "octahedral16" );
+        if ( !normal_tag.write( parent ) )
+        {
+            kvsMessageError( "Cannot write <%s>.", normal_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        if ( !::WriteDataArray( normal_tag, writing_type, filename, "normal", normals ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 } // end of namespace kvsml
 
 } // end of namespace kvs
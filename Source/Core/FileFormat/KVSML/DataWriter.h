@@ -59,6 +59,25 @@ bool WriteOpacityData(
     const std::string& filename,
     const kvs::ValueArray<kvs::UInt8>& opacities );
 
+bool WriteQuantizedCoordData(
+    kvs::XMLNode::SuperClass* parent,
+    const kvs::kvsml::WritingDataType writing_type,
+    const std::string& filename,
+    const kvs::ValueArray<kvs::UInt16>& coords );
+
+bool WriteIndexedColorData(
+    kvs::XMLNode::SuperClass* parent,
+    const kvs::kvsml::WritingDataType writing_type,
+    const std::string& filename,
+    const kvs::ValueArray<kvs::UInt8>& indices,
+    const kvs::ValueArray<kvs::UInt8>& palette );
+
+bool WritePackedNormalData(
+    kvs::XMLNode::SuperClass* parent,
+    const kvs::kvsml::WritingDataType writing_type,
+    const std::string& filename,
+    const kvs::ValueArray<kvs::UInt16>& normals );
+
 } // end of namespace kvsml
 
 } // end of namespace kvs
@@ -113,7 +113,8 @@ KVSMLPointObject::KVSMLPointObject( const std::string& filename ):
 void KVSMLPointObject::print( std::ostream& os, const kvs::Indent& indent ) const
 {
     os << indent << "Filename : " << BaseClass::filename() << std::endl;
-    os << indent << "Number of vertices: " << m_coords.size() / 3;
+    const size_t ncoords = m_quantized_coords.size() > 0 ? m_quantized_coords.size() : m_coords.size();
+    os << indent << "Number of vertices: " << ncoords / 3;
     if ( m_object_tag.hasObjectCoord() )
     {
         os << indent << "Min object coord : " << m_object_tag.minObjectCoord() << std::endl;
@@ -183,12 +184,24 @@ bool KVSMLPointObject::read( const std::string& filename )
             return false;
         }
 
-        if ( m_coords.size() == 0 )
+        // <Coord encoding="quantized16">
+        if ( !kvs::kvsml::ReadQuantizedCoordData( parent, ncoords, &m_quantized_coords ) )
+        {
+            return false;
+        }
+
+        if ( m_coords.size() == 0 && m_quantized_coords.size() == 0 )
         {
             kvsMessageError( "Cannot read the coord data." );
             return false;
         }
 
+        if ( m_quantized_coords.size() > 0 && !m_object_tag.hasObjectCoord() )
+        {
+            kvsMessageError( "Quantized coord data requires 'object_coord' in <%s>.", m_object_tag.name().c_str() );
+            return false;
+        }
+
         // <Color>
         const size_t ncolors = vertex_tag.nvertices();
         if ( !kvs::kvsml::ReadColorData( parent, ncolors, &m_colors ) )
@@ -196,7 +209,13 @@ bool KVSMLPointObject::read( const std::string& filename )
             return false;
         }
 
-        if ( m_colors.size() == 0 )
+        // <Color encoding="palette">
+        if ( !kvs::kvsml::ReadIndexedColorData( parent, ncolors, &m_color_indices, &m_color_palette ) )
+        {
+            return false;
+        }
+
+        if ( m_colors.size() == 0 && m_color_indices.size() == 0 )
         {
             // default value (black).
             m_colors.allocate(3);
@@ -212,6 +231,12 @@ bool KVSMLPointObject::read( const std::string& filename )
             return false;
         }
 
+        // <Normal encoding="octahedral16">
+        if ( !kvs::kvsml::ReadPackedNormalData( parent, nnormals, &m_packed_normals ) )
+        {
+            return false;
+        }
+
         // <Size>
         const size_t nsizes = vertex_tag.nvertices();
         if ( !kvs::kvsml::ReadSizeData( parent, nsizes, &m_sizes ) )
@@ -266,7 +291,8 @@ bool KVSMLPointObject::write( const std::string& filename )
     // <Vertex nvertices="xxx">
     const size_t dimension = 3;
     kvs::kvsml::VertexTag vertex_tag;
-    vertex_tag.setNVertices( m_coords.size() / dimension );
+    const size_t ncoords = m_quantized_coords.size() > 0 ? m_quantized_coords.size() : m_coords.size();
+    vertex_tag.setNVertices( ncoords / dimension );
     if ( !vertex_tag.write( point_tag.node() ) )
     {
         kvsMessageError( "Cannot write <%s>.", vertex_tag.name().c_str() );
@@ -279,21 +305,51 @@ bool KVSMLPointObject::write( const std::string& filename )
         const kvs::kvsml::WritingDataType type = static_cast<kvs::kvsml::WritingDataType>(m_writing_type);
 
         // <Coord>
-        if ( !kvs::kvsml::WriteCoordData( parent, type, filename, m_coords ) )
+        if ( m_quantized_coords.size() > 0 )
         {
-            return false;
+            if ( !kvs::kvsml::WriteQuantizedCoordData( parent, type, filename, m_quantized_coords ) )
+            {
+                return false;
+            }
+        }
+        else
+        {
+            if ( !kvs::kvsml::WriteCoordData( parent, type, filename, m_coords ) )
+            {
+                return false;
+            }
         }
 
         // <Color>
-        if ( !kvs::kvsml::WriteColorData( parent, type, filename, m_colors ) )
+        if ( m_color_indices.size() > 0 )
         {
-            return false;
+            if ( !kvs::kvsml::WriteIndexedColorData( parent, type, filename, m_color_indices, m_color_palette ) )
+            {
+                return false;
+            }
+        }
+        else
+        {
+            if ( !kvs::kvsml::WriteColorData( parent, type, filename, m_colors ) )
+            {
+                return false;
+            }
         }
 
         // <Normal>
-        if ( !kvs::kvsml::WriteNormalData( parent, type, filename, m_normals ) )
+        if ( m_packed_normals.size() > 0 )
         {
-            return false;
+            if ( !kvs::kvsml::WritePackedNormalData( parent, type, filename, m_packed_normals ) )
+            {
+                return false;
+            }
+        }
+        else
+        {
+            if ( !kvs::kvsml::WriteNormalData( parent, type, filename, m_normals ) )
+            {
+                return false;
+            }
         }
 
         // <Size>
@@ -42,6 +42,10 @@ private:
     kvs::ValueArray<kvs::UInt8> m_colors; ///< color(r,g,b) array
     kvs::ValueArray<kvs::Real32> m_normals; ///< normal array
     kvs::ValueArray<kvs::Real32> m_sizes; ///< size array
+    kvs::ValueArray<kvs::UInt16> m_quantized_coords; ///< 16-bit quantized coordinate array
+    kvs::ValueArray<kvs::UInt16> m_packed_normals; ///< octahedral-packed normal array
+    kvs::ValueArray<kvs::UInt8> m_color_indices; ///< color index array
+    kvs::ValueArray<kvs::UInt8> m_color_palette; ///< color(r,g,b) palette
 
 public:
     static bool CheckExtension( const std::string& filename );
@@ -57,6 +61,10 @@ public:
     const kvs::ValueArray<kvs::UInt8>& colors() const { return m_colors; }
     const kvs::ValueArray<kvs::Real32>& normals() const { return m_normals; }
     const kvs::ValueArray<kvs::Real32>& sizes() const { return m_sizes; }
+    const kvs::ValueArray<kvs::UInt16>& quantizedCoords() const { return m_quantized_coords; }
+    const kvs::ValueArray<kvs::UInt16>& packedNormals() const { return m_packed_normals; }
+    const kvs::ValueArray<kvs::UInt8>& colorIndices() const { return m_color_indices; }
+    const kvs::ValueArray<kvs::UInt8>& colorPalette() const { return m_color_palette; }
     bool hasObjectCoord() const { return m_object_tag.hasObjectCoord(); }
     bool hasExternalCoord() const { return m_object_tag.hasExternalCoord(); }
     const kvs::Vec3& minObjectCoord() const { return m_object_tag.minObjectCoord(); }
@@ -72,6 +80,13 @@ public:
     void setColors( const kvs::ValueArray<kvs::UInt8>& colors ) { m_colors = colors; }
     void setNormals( const kvs::ValueArray<kvs::Real32>& normals ) { m_normals = normals; }
     void setSizes( const kvs::ValueArray<kvs::Real32>& sizes ) { m_sizes = sizes; }
+    void setQuantizedCoords( const kvs::ValueArray<kvs::UInt16>& coords ) { m_quantized_coords = coords; }
+    void setPackedNormals( const kvs::ValueArray<kvs::UInt16>& normals ) { m_packed_normals = normals; }
+    void setColorIndices( const kvs::ValueArray<kvs::UInt8>& indices, const kvs::ValueArray<kvs::UInt8>& palette )
+    {
+        m_color_indices = indices;
+        m_color_palette = palette;
+    }
     void setMinMaxObjectCoords( const kvs::Vec3& min_coord, const kvs::Vec3& max_coord )
     {
         m_object_tag.setMinMaxObjectCoords( min_coord, max_coord );
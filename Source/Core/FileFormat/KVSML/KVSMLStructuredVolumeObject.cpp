@@ -10,6 +10,7 @@
 #include "ValueTag.h"
 #include "DataArrayTag.h"
 #include "CoordTag.h"
+#include "LevelTag.h"
 #include <kvs/File>
 #include <kvs/XMLDocument>
 #include <kvs/XMLDeclaration>
@@ -92,7 +93,8 @@ KVSMLStructuredVolumeObject::KVSMLStructuredVolumeObject():
     m_veclen( 0 ),
     m_resolution( 0, 0, 0 ),
     m_min_value( 0.0 ),
-    m_max_value( 0.0 )
+    m_max_value( 0.0 ),
+    m_level_reduction( "" )
 {
 }
 
@@ -114,7 +116,8 @@ KVSMLStructuredVolumeObject::KVSMLStructuredVolumeObject( const std::string& fil
     m_veclen( 0 ),
     m_resolution( 0, 0, 0 ),
     m_min_value( 0.0 ),
-    m_max_value( 0.0 )
+    m_max_value( 0.0 ),
+    m_level_reduction( "" )
 {
     this->read( filename );
 }
@@ -147,6 +150,11 @@ void KVSMLStructuredVolumeObject::print( std::ostream& os, const kvs::Indent& in
         os << indent << "Min external coord : " << m_object_tag.minExternalCoord() << std::endl;
         os << indent << "Max external coord : " << m_object_tag.maxExternalCoord() << std::endl;
     }
+    if ( !m_level_values.empty() )
+    {
+        os << indent << "Number of levels : " << m_level_values.size() + 1 << std::endl;
+        os << indent << "Level reduction : " << m_level_reduction << std::endl;
+    }
 }
 
 /*===========================================================================*/
@@ -295,6 +303,45 @@ bool KVSMLStructuredVolumeObject::read( const std::string& filename )
         }
     }
 
+    // <Level>
+    m_level_reduction = "";
+    m_level_resolutions.clear();
+    m_level_values.clear();
+    kvs::kvsml::LevelTag level_tag;
+    kvs::XMLNode::SuperClass* level_node = kvs::XMLNode::FindChildNode( node_tag.node(), level_tag.name() );
+    while ( level_node )
+    {
+        if ( !level_tag.read( kvs::XMLNode::ToElement( level_node ) ) )
+        {
+            kvsMessageError( "Cannot read <%s>.", level_tag.name().c_str() );
+            return false;
+        }
+
+        if ( !level_tag.hasResolution() )
+        {
+            kvsMessageError( "'resolution' is not specified in <%s>.", level_tag.name().c_str() );
+            return false;
+        }
+
+        if ( level_tag.hasReduction() ) { m_level_reduction = level_tag.reduction(); }
+
+        // <DataArray>
+        const kvs::Vec3ui level_resolution = level_tag.resolution();
+        const size_t level_nelements = level_resolution.x() * level_resolution.y() * level_resolution.z() * veclen;
+        kvs::AnyValueArray level_values;
+        kvs::kvsml::DataArrayTag level_data_array;
+        if ( !level_data_array.read( level_node, level_nelements, &level_values ) )
+        {
+            kvsMessageError( "Cannot read <%s> for <%s>.",
+                             level_data_array.name().c_str(),
+                             level_tag.name().c_str() );
+            return false;
+        }
+
+        this->addLevel( level_resolution, level_values );
+        level_node = node_tag.node()->IterateChildren( level_tag.name(), level_node );
+    }
+
     BaseClass::setSuccess( true );
     return true;
 }
@@ -417,6 +464,41 @@ bool KVSMLStructuredVolumeObject::write( const std::string& filename )
         }
     }
 
+    for ( size_t i = 0; i < m_level_values.size(); i++ )
+    {
+        // <Level resolution="xxx xxx xxx" reduction="xxx">
+        kvs::kvsml::LevelTag level_tag;
+        level_tag.setResolution( m_level_resolutions[i] );
+        if ( m_level_reduction != "" ) { level_tag.setReduction( m_level_reduction ); }
+        if ( !level_tag.write( node_tag.node() ) )
+        {
+            kvsMessageError( "Cannot write <%s>.", level_tag.name().c_str() );
+            return false;
+        }
+
+        // <DataArray>
+        kvs::kvsml::DataArrayTag level_values;
+        const std::string level_name = "value_level" + kvs::String::ToString( i + 1 );
+        if ( m_writing_type == ExternalAscii )
+        {
+            level_values.setFile( kvs::kvsml::DataArray::GetDataFilename( filename, level_name ) );
+            level_values.setFormat( "ascii" );
+        }
+        else if ( m_writing_type == ExternalBinary )
+        {
+            level_values.setFile( kvs::kvsml::DataArray::GetDataFilename( filename, level_name ) );
+            level_values.setFormat( "binary" );
+        }
+
+        if ( !level_values.write( level_tag.node(), m_level_values[i], pathname ) )
+        {
+            kvsMessageError( "Cannot write <%s> for <%s>.",
+                             level_values.name().c_str(),
+                             level_tag.name().c_str() );
+            return false;
+        }
+    }
+
     const bool success = document.write( filename );
     BaseClass::setSuccess( success );
 
@@ -12,6 +12,7 @@
 #include <kvs/Vector3>
 #include <kvs/Indent>
 #include <string>
+#include <vector>
 #include "KVSMLTag.h"
 #include "ObjectTag.h"
 
@@ -53,6 +54,9 @@ private:
     double m_max_value; ///< max. value
     kvs::AnyValueArray m_values; ///< field value array
     kvs::ValueArray<float> m_coords; ///< coordinate array
+    std::string m_level_reduction; ///< reduction method of the coarse levels
+    std::vector<kvs::Vec3ui> m_level_resolutions; ///< grid resolutions of the coarse levels
+    std::vector<kvs::AnyValueArray> m_level_values; ///< field value arrays of the coarse levels
 
 public:
     static bool CheckExtension( const std::string& filename );
@@ -83,6 +87,9 @@ public:
     const kvs::Vec3& maxExternalCoord() const { return m_object_tag.maxExternalCoord(); }
     const kvs::AnyValueArray& values() const { return m_values; }
     const kvs::ValueArray<float>& coords() const { return m_coords; }
+    const std::string& levelReduction() const { return m_level_reduction; }
+    const std::vector<kvs::Vec3ui>& levelResolutions() const { return m_level_resolutions; }
+    const std::vector<kvs::AnyValueArray>& levelValues() const { return m_level_values; }
 
     void setWritingDataType( const WritingDataType type ) { m_writing_type = type; }
     void setWritingDataTypeToAscii() { this->setWritingDataType( Ascii ); }
@@ -97,6 +104,12 @@ public:
     void setMaxValue( const double value ) { m_has_max_value = true; m_max_value = value; }
     void setValues( const kvs::AnyValueArray& values ) { m_values = values; }
     void setCoords( const kvs::ValueArray<float>& coords ) { m_coords = coords; }
+    void setLevelReduction( const std::string& reduction ) { m_level_reduction = reduction; }
+    void addLevel( const kvs::Vec3ui& resolution, const kvs::AnyValueArray& values )
+    {
+        m_level_resolutions.push_back( resolution );
+        m_level_values.push_back( values );
+    }
     void setMinMaxObjectCoords( const kvs::Vec3& min_coord, const kvs::Vec3& max_coord )
     {
         m_object_tag.setMinMaxObjectCoords( min_coord, max_coord );
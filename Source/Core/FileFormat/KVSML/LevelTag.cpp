@@ -0,0 +1,117 @@
+/*****************************************************************************/
+/**
+ *  @file   LevelTag.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "LevelTag.h"
+#include <kvs/Message>
+#include <kvs/String>
+#include <kvs/Tokenizer>
+#include <kvs/XMLNode>
+#include <kvs/XMLElement>
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new LevelTag class.
+ */
+/*===========================================================================*/
+LevelTag::LevelTag():
+    kvs::kvsml::TagBase( "Level" ),
+    m_has_resolution( false ),
+    m_has_reduction( false ),
+    m_resolution( 0, 0, 0 ),
+    m_reduction("")
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads level data.
+ *  @param  parent [in] pointer to the parent node
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool LevelTag::read( const kvs::XMLNode::SuperClass* parent )
+{
+    BaseClass::read( parent );
+    const auto* element = kvs::XMLNode::ToElement( BaseClass::m_node );
+
+    return this->read( element );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the data from the element.
+ *  @param  element [in] pointer to the element
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool LevelTag::read( const kvs::XMLElement::SuperClass* element )
+{
+    m_has_resolution = false;
+    m_has_reduction = false;
+    m_resolution = kvs::Vec3ui( 0, 0, 0 );
+    m_reduction = "";
+
+    // resolution="xxx xxx xxx"
+    const auto resolution = kvs::XMLElement::AttributeValue( element, "resolution" );
+    if ( resolution != "" )
+    {
+        const std::string delim(" \n");
+        kvs::Tokenizer t( resolution, delim );
+
+        unsigned int values[3];
+        for ( size_t i = 0; i < 3; i++ )
+        {
+            if ( t.isLast() )
+            {
+                kvsMessageError( "3 components are required for 'resolution' in <%s>", this->name().c_str() );
+                return false;
+            }
+
+            values[i] = static_cast<unsigned int>( atoi( t.token().c_str() ) );
+        }
+
+        this->setResolution( kvs::Vec3ui( values[0], values[1], values[2] ) );
+    }
+
+    // reduction="xxx"
+    const auto reduction = kvs::XMLElement::AttributeValue( element, "reduction" );
+    if ( reduction != "" ) { this->setReduction( reduction ); }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the level data.
+ *  @param  parent [in] pointer to the parent node
+ *  @return true, if the writting process is done successfully
+ */
+/*===========================================================================*/
+bool LevelTag::write( kvs::XMLNode::SuperClass* parent )
+{
+    kvs::XMLElement element( BaseClass::name() );
+    if ( m_has_resolution )
+    {
+        const std::string x = kvs::String::ToString( m_resolution.x() );
+        const std::string y = kvs::String::ToString( m_resolution.y() );
+        const std::string z = kvs::String::ToString( m_resolution.z() );
+        element.setAttribute( "resolution", x + " " + y + " " + z );
+    }
+    if ( m_has_reduction ) { element.setAttribute( "reduction", m_reduction ); }
+
+    return BaseClass::write_with_element( parent, element );
+}
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
@@ -0,0 +1,55 @@
+/*****************************************************************************/
+/**
+ *  @file   LevelTag.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <kvs/XMLNode>
+#include <kvs/XMLElement>
+#include <kvs/Vector3>
+#include <Core/FileFormat/KVSML/TagBase.h>
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Level tag class for the coarse levels of the structured volume.
+ */
+/*===========================================================================*/
+class LevelTag : public kvs::kvsml::TagBase
+{
+public:
+    using BaseClass = kvs::kvsml::TagBase;
+
+private:
+    bool m_has_resolution; ///< flag to check whether the resolution is spcified or not
+    bool m_has_reduction; ///< flag to check whether the reduction is spcified or not
+    kvs::Vec3ui m_resolution; ///< node resolution of the level
+    std::string m_reduction; ///< reduction method (box, max or min)
+
+public:
+    LevelTag();
+
+    bool hasResolution() const { return m_has_resolution; }
+    bool hasReduction() const { return m_has_reduction; }
+    const kvs::Vec3ui& resolution() const { return m_resolution; }
+    const std::string& reduction() const { return m_reduction; }
+
+    void setResolution( const kvs::Vec3ui& resolution ) { m_has_resolution = true; m_resolution = resolution; }
+    void setReduction( const std::string& reduction ) { m_has_reduction = true; m_reduction = reduction; }
+
+    bool read( const kvs::XMLNode::SuperClass* parent );
+    bool read( const kvs::XMLElement::SuperClass* element );
+    bool write( kvs::XMLNode::SuperClass* parent );
+};
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
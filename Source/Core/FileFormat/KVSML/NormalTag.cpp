@@ -5,6 +5,8 @@
  */
 /*****************************************************************************/
 #include "NormalTag.h"
+#include <kvs/XMLNode>
+#include <kvs/XMLElement>
 
 
 namespace kvs
@@ -23,6 +25,50 @@ NormalTag::NormalTag():
 {
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Reads the normal tag.
+ *  @param  parent [in] pointer to the parent node
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool NormalTag::read( const kvs::XMLNode::SuperClass* parent )
+{
+    BaseClass::read( parent );
+
+    // Element
+    const kvs::XMLElement::SuperClass* element = kvs::XMLNode::ToElement( BaseClass::m_node );
+
+    // encoding="xxx"
+    const std::string encoding = kvs::XMLElement::AttributeValue( element, "encoding" );
+    if ( encoding != "" )
+    {
+        m_has_encoding = true;
+        m_encoding = encoding;
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the normal tag.
+ *  @param  parent [in] pointer to the parent node
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+bool NormalTag::write( kvs::XMLNode::SuperClass* parent )
+{
+    kvs::XMLElement element( BaseClass::name() );
+
+    if ( m_has_encoding )
+    {
+        element.setAttribute( "encoding", m_encoding );
+    }
+
+    return BaseClass::write_with_element( parent, element );
+}
+
 } // end of namespace kvsml
 
 } // end of namespace kvs
@@ -5,6 +5,8 @@
  */
 /*****************************************************************************/
 #pragma once
+#include <string>
+#include <kvs/XMLNode>
 #include "TagBase.h"
 
 
@@ -24,9 +26,19 @@ class NormalTag : public kvs::kvsml::TagBase
 public:
     typedef kvs::kvsml::TagBase BaseClass;
 
+private:
+    bool m_has_encoding = false; ///< flag to check whether 'encoding' is specified or not
+    std::string m_encoding{}; ///< encoding of the compressed data
+
 public:
     NormalTag();
 
+    bool hasEncoding() const { return m_has_encoding; }
+    const std::string& encoding() const { return m_encoding; }
+    void setEncoding( const std::string& encoding ) { m_has_encoding = true; m_encoding = encoding; }
+
+    bool read( const kvs::XMLNode::SuperClass* parent );
+    bool write( kvs::XMLNode::SuperClass* parent );
 };
 
 } // end of namespace kvsml
@@ -0,0 +1,75 @@
+/*****************************************************************************/
+/**
+ *  @file   PaletteTag.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "PaletteTag.h"
+#include <kvs/XMLNode>
+#include <kvs/XMLElement>
+#include <cstdlib>
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new palette tag class.
+ */
+/*===========================================================================*/
+PaletteTag::PaletteTag():
+    kvs::kvsml::TagBase( "Palette" )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the palette tag.
+ *  @param  parent [in] pointer to the parent node
+ *  @return true, if the reading process is done successfully
+ */
+/*===========================================================================*/
+bool PaletteTag::read( const kvs::XMLNode::SuperClass* parent )
+{
+    BaseClass::read( parent );
+
+    // Element
+    const kvs::XMLElement::SuperClass* element = kvs::XMLNode::ToElement( BaseClass::m_node );
+
+    // ncolors="xxx"
+    const std::string ncolors = kvs::XMLElement::AttributeValue( element, "ncolors" );
+    if ( ncolors != "" )
+    {
+        m_has_ncolors = true;
+        m_ncolors = static_cast<size_t>( atoi( ncolors.c_str() ) );
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the palette tag.
+ *  @param  parent [in] pointer to the parent node
+ *  @return true, if the writing process is done successfully
+ */
+/*===========================================================================*/
+bool PaletteTag::write( kvs::XMLNode::SuperClass* parent )
+{
+    kvs::XMLElement element( BaseClass::name() );
+
+    if ( m_has_ncolors )
+    {
+        element.setAttribute( "ncolors", m_ncolors );
+    }
+
+    return BaseClass::write_with_element( parent, element );
+}
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
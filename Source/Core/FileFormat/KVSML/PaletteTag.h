@@ -0,0 +1,45 @@
+/*****************************************************************************/
+/**
+ *  @file   PaletteTag.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/XMLNode>
+#include "TagBase.h"
+
+
+namespace kvs
+{
+
+namespace kvsml
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Tag class for <Palette>
+ */
+/*===========================================================================*/
+class PaletteTag : public kvs::kvsml::TagBase
+{
+public:
+    using BaseClass = kvs::kvsml::TagBase;
+
+private:
+    bool m_has_ncolors = false; ///< flag to check whether 'ncolors' is specified or not
+    size_t m_ncolors = 0; ///< number of colors in the palette
+
+public:
+    PaletteTag();
+
+    bool hasNColors() const { return m_has_ncolors; }
+    size_t ncolors() const { return m_ncolors; }
+    void setNColors( const size_t ncolors ) { m_has_ncolors = true; m_ncolors = ncolors; }
+
+    bool read( const kvs::XMLNode::SuperClass* parent );
+    bool write( kvs::XMLNode::SuperClass* parent );
+};
+
+} // end of namespace kvsml
+
+} // end of namespace kvs
@@ -161,7 +161,7 @@ bool Png::write( const std::string& filename )
     auto ret = stbi_write_png( filename.c_str(), width, height, bpp, pixels, width * bpp );
     if ( !ret )
     {
-        kvsMessageError() << std::string( stbi_failure_reason() ) << std::endl;
+        kvsMessageError() << "Cannot write " << filename << "." << std::endl;
         BaseClass::setSuccess( false );
         return false;
     }
@@ -0,0 +1,252 @@
+/*****************************************************************************/
+/**
+ *  @file   AsyncImageWriter.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "AsyncImageWriter.h"
+#include <kvs/Thread>
+#include <kvs/MutexLocker>
+#include <kvs/Message>
+#include <algorithm>
+#include <cstring>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Worker thread class.
+ */
+/*===========================================================================*/
+class AsyncImageWriter::Worker : public kvs::Thread
+{
+private:
+    kvs::AsyncImageWriter* m_writer; ///< pointer to the writer
+
+public:
+    Worker( kvs::AsyncImageWriter* writer ): m_writer( writer ) {}
+    void run() { m_writer->process(); }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new AsyncImageWriter class.
+ *  @param  nthreads [in] number of worker threads (0: write on the caller's thread)
+ *  @param  max_queue_size [in] maximum number of queued images
+ */
+/*===========================================================================*/
+AsyncImageWriter::AsyncImageWriter( const size_t nthreads, const size_t max_queue_size ):
+    m_nthreads( nthreads ),
+    m_max_queue_size( std::max( max_queue_size, size_t(1) ) )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the AsyncImageWriter class after writing the queued images.
+ */
+/*===========================================================================*/
+AsyncImageWriter::~AsyncImageWriter()
+{
+    this->wait();
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        m_quit = true;
+    }
+    m_not_empty.wakeUpAll();
+    for ( auto& worker : m_workers ) { worker->wait(); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of written images.
+ *  @return number of written images
+ */
+/*===========================================================================*/
+size_t AsyncImageWriter::numberOfWrittenImages()
+{
+    kvs::MutexLocker locker( &m_mutex );
+    return m_nwritten;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of images failed to write.
+ *  @return number of failures
+ */
+/*===========================================================================*/
+size_t AsyncImageWriter::numberOfFailures()
+{
+    kvs::MutexLocker locker( &m_mutex );
+    return m_nfailures;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Queues the color image.
+ *  @param  image [in] color image
+ *  @param  filename [in] output filename
+ */
+/*===========================================================================*/
+void AsyncImageWriter::write( const kvs::ColorImage& image, const std::string& filename )
+{
+    Job job;
+    job.width = image.width();
+    job.height = image.height();
+    job.ncomponents = 3;
+    job.pixels = image.pixels();
+    job.filename = filename;
+    this->push( job );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Queues the RGBA pixels read back from the frame buffer.
+ *  @param  width [in] image width
+ *  @param  height [in] image height
+ *  @param  rgba [in] RGBA pixels
+ *  @param  filename [in] output filename
+ *  @param  flip [in] if true, the rows are flipped on the worker thread
+ */
+/*===========================================================================*/
+void AsyncImageWriter::write(
+    const size_t width,
+    const size_t height,
+    const kvs::ValueArray<kvs::UInt8>& rgba,
+    const std::string& filename,
+    const bool flip )
+{
+    Job job;
+    job.width = width;
+    job.height = height;
+    job.ncomponents = 4;
+    job.flip = flip;
+    job.pixels = rgba;
+    job.filename = filename;
+    this->push( job );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Waits until all the queued images have been written.
+ */
+/*===========================================================================*/
+void AsyncImageWriter::wait()
+{
+    kvs::MutexLocker locker( &m_mutex );
+    while ( !m_queue.empty() || m_nbusy > 0 ) { m_idle.wait( &m_mutex ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Pushes the job to the queue, blocking while the queue is full.
+ *  @param  job [in] job
+ */
+/*===========================================================================*/
+void AsyncImageWriter::push( const Job& job )
+{
+    {
+        kvs::MutexLocker locker( &m_mutex );
+
+        // The worker threads are started on the first image.
+        while ( m_workers.size() < m_nthreads )
+        {
+            std::unique_ptr<Worker> worker( new Worker( this ) );
+            if ( !worker->start() ) { break; }
+            m_workers.push_back( std::move( worker ) );
+        }
+
+        if ( !m_workers.empty() )
+        {
+            while ( m_queue.size() >= m_max_queue_size ) { m_not_full.wait( &m_mutex ); }
+            m_queue.push_back( job );
+            m_not_empty.wakeUpOne();
+            return;
+        }
+    }
+
+    // Without worker threads, the image is written synchronously.
+    const bool success = this->encode( job );
+    kvs::MutexLocker locker( &m_mutex );
+    if ( success ) { m_nwritten++; } else { m_nfailures++; }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the queued images until the writer quits (worker thread).
+ */
+/*===========================================================================*/
+void AsyncImageWriter::process()
+{
+    for ( ;; )
+    {
+        Job job;
+        {
+            kvs::MutexLocker locker( &m_mutex );
+            while ( m_queue.empty() && !m_quit ) { m_not_empty.wait( &m_mutex ); }
+            if ( m_queue.empty() ) { return; }
+
+            job = m_queue.front();
+            m_queue.pop_front();
+            m_nbusy++;
+            m_not_full.wakeUpOne();
+        }
+
+        const bool success = this->encode( job );
+
+        kvs::MutexLocker locker( &m_mutex );
+        if ( success ) { m_nwritten++; } else { m_nfailures++; }
+        m_nbusy--;
+        if ( m_queue.empty() && m_nbusy == 0 ) { m_idle.wakeUpAll(); }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Converts the pixels to RGB and writes the image.
+ *  @param  job [in] job
+ *  @return true if the image has been written
+ */
+/*===========================================================================*/
+bool AsyncImageWriter::encode( const Job& job )
+{
+    const size_t width = job.width;
+    const size_t height = job.height;
+    if ( job.pixels.size() < width * height * job.ncomponents )
+    {
+        kvsMessageError() << "Invalid pixel data for " << job.filename << "." << std::endl;
+        return false;
+    }
+
+    kvs::ValueArray<kvs::UInt8> pixels = job.pixels;
+    if ( job.ncomponents != 3 || job.flip )
+    {
+        const size_t stride = width * 3;
+        pixels.allocate( stride * height );
+        for ( size_t i = 0; i < height; i++ )
+        {
+            const size_t j = job.flip ? height - i - 1 : i;
+            const kvs::UInt8* src = job.pixels.data() + i * width * job.ncomponents;
+            kvs::UInt8* dst = pixels.data() + j * stride;
+            if ( job.ncomponents == 3 ) { std::memcpy( dst, src, stride ); continue; }
+            for ( size_t k = 0; k < width; k++, src += job.ncomponents, dst += 3 )
+            {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+            }
+        }
+    }
+
+    const kvs::ColorImage image( width, height, pixels );
+    if ( !image.write( job.filename ) )
+    {
+        kvsMessageError() << "Cannot write " << job.filename << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // end of namespace kvs
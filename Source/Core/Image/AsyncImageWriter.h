@@ -0,0 +1,87 @@
+/*****************************************************************************/
+/**
+ *  @file   AsyncImageWriter.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/ColorImage>
+#include <kvs/ValueArray>
+#include <kvs/Type>
+#include <kvs/Mutex>
+#include <kvs/Condition>
+#include <string>
+#include <deque>
+#include <vector>
+#include <memory>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Background image writer with a bounded queue of worker threads.
+ *
+ *  The images are encoded and written by kvs::ColorImage::write (the format
+ *  is selected by the file extension, e.g. PNG, BMP or PPM) on the worker
+ *  threads, so that the caller can render the next frame in the meantime.
+ *  write() blocks while the queue is full. The pixel arrays are shared with
+ *  the queue and must not be modified until the images have been written.
+ */
+/*===========================================================================*/
+class AsyncImageWriter
+{
+private:
+    class Worker;
+
+    struct Job
+    {
+        size_t width = 0; ///< image width
+        size_t height = 0; ///< image height
+        size_t ncomponents = 3; ///< number of components per pixel (3: RGB, 4: RGBA)
+        bool flip = false; ///< flip the rows before writing
+        kvs::ValueArray<kvs::UInt8> pixels{}; ///< pixel data
+        std::string filename = ""; ///< output filename
+    };
+
+    size_t m_nthreads = 2; ///< number of worker threads
+    size_t m_max_queue_size = 4; ///< maximum number of queued images
+    std::deque<Job> m_queue{}; ///< queued images
+    size_t m_nbusy = 0; ///< number of images being written
+    size_t m_nwritten = 0; ///< number of written images
+    size_t m_nfailures = 0; ///< number of images failed to write
+    bool m_quit = false; ///< quit flag for the worker threads
+    kvs::Mutex m_mutex{}; ///< mutex for the above members
+    kvs::Condition m_not_empty{}; ///< signaled when an image is queued
+    kvs::Condition m_not_full{}; ///< signaled when an image is dequeued
+    kvs::Condition m_idle{}; ///< signaled when all the images are written
+    std::vector<std::unique_ptr<Worker>> m_workers{}; ///< worker threads
+
+public:
+    AsyncImageWriter( const size_t nthreads = 2, const size_t max_queue_size = 4 );
+    ~AsyncImageWriter();
+    AsyncImageWriter( const AsyncImageWriter& ) = delete;
+    AsyncImageWriter& operator =( const AsyncImageWriter& ) = delete;
+
+    size_t numberOfThreads() const { return m_nthreads; }
+    size_t maxQueueSize() const { return m_max_queue_size; }
+    size_t numberOfWrittenImages();
+    size_t numberOfFailures();
+
+    void write( const kvs::ColorImage& image, const std::string& filename );
+    void write(
+        const size_t width,
+        const size_t height,
+        const kvs::ValueArray<kvs::UInt8>& rgba,
+        const std::string& filename,
+        const bool flip = false );
+    void wait();
+
+private:
+    void push( const Job& job );
+    void process();
+    bool encode( const Job& job );
+};
+
+} // end of namespace kvs
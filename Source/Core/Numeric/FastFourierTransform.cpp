@@ -0,0 +1,197 @@
+/*****************************************************************************/
+/**
+ *  @file   FastFourierTransform.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "FastFourierTransform.h"
+#include <kvs/Assert>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the product of the complex numbers.
+ *
+ *  The operator of std::complex checks the infinities and NaNs (C99 Annex G),
+ *  which prevents the butterflies from being inlined and vectorized.
+ *
+ *  @param  a [in] complex number
+ *  @param  b [in] complex number
+ *  @return product
+ */
+/*===========================================================================*/
+inline kvs::FastFourierTransform::Complex Multiply(
+    const kvs::FastFourierTransform::Complex& a,
+    const kvs::FastFourierTransform::Complex& b )
+{
+    return kvs::FastFourierTransform::Complex(
+        a.real() * b.real() - a.imag() * b.imag(),
+        a.real() * b.imag() + a.imag() * b.real() );
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the smallest power of two that is not less than n.
+ *  @param  n [in] number
+ *  @return power of two
+ */
+/*===========================================================================*/
+size_t FastFourierTransform::PowerOfTwo( const size_t n )
+{
+    size_t size = 1;
+    while ( size < n ) { size <<= 1; }
+    return size;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the linear correlation of the given sequences.
+ *
+ *  The k-th element of the result is sum_{i=k}^{n-1} x[i] * y[i-k] for
+ *  k = 0, ..., n-1. The sequences are zero-padded to a power of two not less
+ *  than 2n-1 (so that the circular correlation does not wrap around), and
+ *  both spectra are computed by one complex transform of x + iy.
+ *
+ *  @param  x [in] sequence 1
+ *  @param  y [in] sequence 2 (same length as x)
+ *  @return correlation for the lags 0, ..., n-1
+ */
+/*===========================================================================*/
+std::vector<double> FastFourierTransform::Correlate(
+    const std::vector<double>& x,
+    const std::vector<double>& y )
+{
+    KVS_ASSERT( x.size() == y.size() );
+
+    const size_t n = x.size();
+    if ( n == 0 ) { return std::vector<double>(); }
+
+    const FastFourierTransform fft( PowerOfTwo( 2 * n - 1 ) );
+    const size_t size = fft.size();
+
+    std::vector<Complex> z( size, Complex( 0.0, 0.0 ) );
+    for ( size_t i = 0; i < n; i++ ) { z[i] = Complex( x[i], y[i] ); }
+    fft.forward( z );
+
+    // X[k] = ( Z[k] + conj(Z[-k]) ) / 2 and Y[k] = ( Z[k] - conj(Z[-k]) ) / 2i,
+    // and the spectrum of the correlation is X[k] * conj(Y[k]).
+    std::vector<Complex> c( size );
+    for ( size_t k = 0; k < size; k++ )
+    {
+        const Complex zk = z[k];
+        const Complex zn = std::conj( z[ ( size - k ) & ( size - 1 ) ] );
+        const Complex xk = ( zk + zn ) * 0.5;
+        const Complex yk = ::Multiply( zk - zn, Complex( 0.0, -0.5 ) );
+        c[k] = ::Multiply( xk, std::conj( yk ) );
+    }
+    fft.inverse( c );
+
+    std::vector<double> result( n );
+    for ( size_t k = 0; k < n; k++ ) { result[k] = c[k].real(); }
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new FastFourierTransform class.
+ *  @param  size [in] transform size (power of two)
+ */
+/*===========================================================================*/
+FastFourierTransform::FastFourierTransform( const size_t size ):
+    m_size( size )
+{
+    KVS_ASSERT( size > 0 && ( size & ( size - 1 ) ) == 0 );
+
+    size_t bits = 0;
+    while ( ( size_t(1) << bits ) < size ) { bits++; }
+
+    m_reversed.resize( size );
+    for ( size_t i = 0; i < size; i++ )
+    {
+        size_t r = 0;
+        for ( size_t b = 0; b < bits; b++ ) { r |= ( ( i >> b ) & 1 ) << ( bits - 1 - b ); }
+        m_reversed[i] = r;
+    }
+
+    // The twiddle factors are computed directly (not by the recurrence) to
+    // avoid the accumulation of the roundoff errors.
+    const double pi = 3.14159265358979323846;
+    m_twiddles.resize( size / 2 );
+    for ( size_t k = 0; k < size / 2; k++ )
+    {
+        const double theta = -2.0 * pi * k / size;
+        m_twiddles[k] = Complex( std::cos( theta ), std::sin( theta ) );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the forward transform in place.
+ *  @param  data [in/out] data of the transform size
+ */
+/*===========================================================================*/
+void FastFourierTransform::forward( std::vector<Complex>& data ) const
+{
+    KVS_ASSERT( data.size() == m_size );
+    this->transform( data.data(), false );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the inverse transform (scaled by 1/size) in place.
+ *  @param  data [in/out] data of the transform size
+ */
+/*===========================================================================*/
+void FastFourierTransform::inverse( std::vector<Complex>& data ) const
+{
+    KVS_ASSERT( data.size() == m_size );
+    this->transform( data.data(), true );
+
+    const double scale = 1.0 / m_size;
+    for ( auto& value : data ) { value *= scale; }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the unscaled transform in place.
+ *  @param  data [in/out] data of the transform size
+ *  @param  inverse [in] if true, the inverse transform is executed
+ */
+/*===========================================================================*/
+void FastFourierTransform::transform( Complex* data, const bool inverse ) const
+{
+    for ( size_t i = 0; i < m_size; i++ )
+    {
+        const size_t j = m_reversed[i];
+        if ( i < j ) { std::swap( data[i], data[j] ); }
+    }
+
+    for ( size_t half = 1; half < m_size; half <<= 1 )
+    {
+        const size_t step = m_size / ( 2 * half );
+        for ( size_t begin = 0; begin < m_size; begin += 2 * half )
+        {
+            for ( size_t k = 0; k < half; k++ )
+            {
+                const Complex w = inverse ? std::conj( m_twiddles[ k * step ] ) : m_twiddles[ k * step ];
+                const Complex u = data[ begin + k ];
+                const Complex v = ::Multiply( data[ begin + k + half ], w );
+                data[ begin + k ] = u + v;
+                data[ begin + k + half ] = u - v;
+            }
+        }
+    }
+}
+
+} // end of namespace kvs
@@ -0,0 +1,50 @@
+/*****************************************************************************/
+/**
+ *  @file   FastFourierTransform.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <complex>
+#include <vector>
+#include <cstddef>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Radix-2 fast Fourier transform class.
+ *
+ *  The transform is the iterative Cooley-Tukey algorithm for the power-of-two
+ *  sizes, where the bit-reversal permutation and the twiddle factors are
+ *  computed once in the constructor and shared by the transforms.
+ */
+/*===========================================================================*/
+class FastFourierTransform
+{
+public:
+    using Complex = std::complex<double>;
+
+private:
+    size_t m_size = 0; ///< transform size (power of two)
+    std::vector<size_t> m_reversed{}; ///< bit-reversed indices
+    std::vector<Complex> m_twiddles{}; ///< twiddle factors exp(-2 pi i k / size) for k < size / 2
+
+public:
+    static size_t PowerOfTwo( const size_t n );
+    static std::vector<double> Correlate( const std::vector<double>& x, const std::vector<double>& y );
+
+    explicit FastFourierTransform( const size_t size );
+
+    size_t size() const { return m_size; }
+
+    void forward( std::vector<Complex>& data ) const;
+    void inverse( std::vector<Complex>& data ) const;
+
+private:
+    void transform( Complex* data, const bool inverse ) const;
+};
+
+} // end of namespace kvs
@@ -49,4 +49,44 @@ void Xorshift128::setSeed( kvs::UInt32 seed )
     m_w = seed = 1812433253UL * ( seed ^ ( seed >> 30 ) ) + 4;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Advances the internal state by 2^64 steps.
+ *
+ *  The jump is calculated as a polynomial of the state transition, so that it
+ *  costs only 128 steps. Jumping a generator n times from a seeded state gives
+ *  the n-th of non-overlapping random number streams with 2^64 numbers each,
+ *  which can be assigned to the parallel tasks reproducibly.
+ */
+/*===========================================================================*/
+void Xorshift128::jump()
+{
+    // Coefficients of x^(2^64) modulo the characteristic polynomial.
+    const kvs::UInt32 Jump[4] = { 0x35aac71c, 0x821e5343, 0xf52e65c4, 0xd8cd644e };
+
+    kvs::UInt32 x = 0;
+    kvs::UInt32 y = 0;
+    kvs::UInt32 z = 0;
+    kvs::UInt32 w = 0;
+    for ( int i = 0; i < 4; i++ )
+    {
+        for ( int b = 0; b < 32; b++ )
+        {
+            if ( Jump[i] & ( kvs::UInt32(1) << b ) )
+            {
+                x ^= m_x;
+                y ^= m_y;
+                z ^= m_z;
+                w ^= m_w;
+            }
+            this->randInteger();
+        }
+    }
+
+    m_x = x;
+    m_y = y;
+    m_z = z;
+    m_w = w;
+}
+
 } // end of namespace kvs
@@ -29,6 +29,7 @@ public:
     Xorshift128( const kvs::UInt32 seed );
 
     void setSeed( kvs::UInt32 seed );
+    void jump();
     float rand();
     kvs::UInt32 randInteger();
     float operator ()();
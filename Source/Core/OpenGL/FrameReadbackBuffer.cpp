@@ -0,0 +1,152 @@
+/*****************************************************************************/
+/**
+ *  @file   FrameReadbackBuffer.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "FrameReadbackBuffer.h"
+#include <kvs/OpenGL>
+#include <kvs/Message>
+#include <algorithm>
+#include <cstring>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new FrameReadbackBuffer class.
+ *  @param  nbuffers [in] number of buffers in the ring
+ */
+/*===========================================================================*/
+FrameReadbackBuffer::FrameReadbackBuffer( const size_t nbuffers ):
+    m_nbuffers( std::max( nbuffers, size_t(1) ) )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the number of buffers. The pending frames are discarded.
+ *  @param  nbuffers [in] number of buffers in the ring (2 or 3 is typical)
+ */
+/*===========================================================================*/
+void FrameReadbackBuffer::setNumberOfBuffers( const size_t nbuffers )
+{
+    this->release();
+    m_nbuffers = std::max( nbuffers, size_t(1) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Starts reading the RGBA pixels of the current read buffer.
+ *  @param  width [in] frame width
+ *  @param  height [in] frame height
+ *  @param  pixels [out] RGBA pixels of the oldest pending frame
+ *  @return true if the oldest pending frame has been returned to pixels
+ */
+/*===========================================================================*/
+bool FrameReadbackBuffer::read(
+    const size_t width,
+    const size_t height,
+    kvs::ValueArray<kvs::UInt8>* pixels )
+{
+    if ( m_slots.empty() ) { m_slots.resize( m_nbuffers ); }
+
+    Slot& slot = m_slots[ ( m_head + m_npending ) % m_nbuffers ];
+    const size_t size = width * height * 4;
+    if ( !slot.buffer )
+    {
+        slot.buffer.reset( new kvs::PixelPackBufferObject() );
+        slot.buffer->setUsage( kvs::BufferObject::StreamRead );
+    }
+    if ( !slot.buffer->isCreated() || slot.buffer->size() != size )
+    {
+        slot.buffer->release();
+        slot.buffer->create( size );
+    }
+
+    {
+        // The pixels are transferred into the bound buffer without stalling.
+        kvs::PixelPackBufferObject::Binder binder( *slot.buffer );
+        kvs::OpenGL::SetPixelStorageMode( GL_PACK_ALIGNMENT, GLint(4) );
+        kvs::OpenGL::ReadPixels( 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0 );
+    }
+    slot.width = width;
+    slot.height = height;
+    m_npending++;
+
+    if ( m_npending < m_nbuffers ) { return false; }
+    return this->copy_oldest( pixels );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the oldest pending frame without starting a new readback.
+ *  @param  pixels [out] RGBA pixels of the oldest pending frame
+ *  @return true if a pending frame has been returned to pixels
+ */
+/*===========================================================================*/
+bool FrameReadbackBuffer::flush( kvs::ValueArray<kvs::UInt8>* pixels )
+{
+    if ( m_npending == 0 ) { return false; }
+    return this->copy_oldest( pixels );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the buffers and discards the pending frames.
+ */
+/*===========================================================================*/
+void FrameReadbackBuffer::release()
+{
+    for ( auto& slot : m_slots )
+    {
+        if ( slot.buffer ) { slot.buffer->release(); }
+    }
+    m_slots.clear();
+    m_head = 0;
+    m_npending = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Copies the oldest pending frame from the mapped buffer.
+ *  @param  pixels [out] RGBA pixels
+ *  @return true if the buffer has been mapped
+ */
+/*===========================================================================*/
+bool FrameReadbackBuffer::copy_oldest( kvs::ValueArray<kvs::UInt8>* pixels )
+{
+    Slot& slot = m_slots[ m_head ];
+    m_head = ( m_head + 1 ) % m_nbuffers;
+    m_npending--;
+
+    kvs::PixelPackBufferObject::Binder binder( *slot.buffer );
+    const void* data = slot.buffer->map( kvs::BufferObject::ReadOnly );
+    if ( !data )
+    {
+        kvsMessageError( "Cannot map the pixel pack buffer." );
+        return false;
+    }
+
+    // The flip is folded into the copy from the mapped buffer, one row at a time.
+    const size_t width = slot.width;
+    const size_t height = slot.height;
+    const size_t stride = width * 4;
+    const kvs::UInt8* src = static_cast<const kvs::UInt8*>( data );
+    pixels->allocate( stride * height );
+    kvs::UInt8* dst = pixels->data();
+    for ( size_t i = 0; i < height; i++ )
+    {
+        const size_t j = m_enable_flip ? height - i - 1 : i;
+        std::memcpy( dst + j * stride, src + i * stride, stride );
+    }
+    slot.buffer->unmap();
+
+    m_width = width;
+    m_height = height;
+    return true;
+}
+
+} // end of namespace kvs
@@ -0,0 +1,72 @@
+/*****************************************************************************/
+/**
+ *  @file   FrameReadbackBuffer.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/PixelPackBufferObject>
+#include <kvs/ValueArray>
+#include <kvs/Type>
+#include <vector>
+#include <memory>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Multi-buffered asynchronous color buffer readback.
+ *
+ *  Each call of read() starts an asynchronous glReadPixels into one of the
+ *  pixel pack buffer objects of the ring and returns the oldest pending frame
+ *  once all the buffers are in use, so that the transfer of a frame overlaps
+ *  the rendering of the following frames. With N buffers, the frames are
+ *  returned N-1 frames late; a single buffer reads the frames synchronously.
+ */
+/*===========================================================================*/
+class FrameReadbackBuffer
+{
+private:
+    struct Slot
+    {
+        std::unique_ptr<kvs::PixelPackBufferObject> buffer; ///< pixel pack buffer object
+        size_t width = 0; ///< width of the frame in the buffer
+        size_t height = 0; ///< height of the frame in the buffer
+    };
+
+    size_t m_nbuffers = 2; ///< number of buffers in the ring
+    bool m_enable_flip = false; ///< flip the rows of the returned frames
+    std::vector<Slot> m_slots{}; ///< ring of buffers
+    size_t m_head = 0; ///< index of the oldest pending frame
+    size_t m_npending = 0; ///< number of pending frames
+    size_t m_width = 0; ///< width of the last returned frame
+    size_t m_height = 0; ///< height of the last returned frame
+
+public:
+    FrameReadbackBuffer( const size_t nbuffers = 2 );
+    ~FrameReadbackBuffer() { this->release(); }
+    FrameReadbackBuffer( const FrameReadbackBuffer& ) = delete;
+    FrameReadbackBuffer& operator =( const FrameReadbackBuffer& ) = delete;
+
+    size_t numberOfBuffers() const { return m_nbuffers; }
+    size_t numberOfPendingFrames() const { return m_npending; }
+    bool isEnabledFlip() const { return m_enable_flip; }
+    size_t width() const { return m_width; }
+    size_t height() const { return m_height; }
+
+    void setNumberOfBuffers( const size_t nbuffers );
+    void setEnabledFlip( const bool enable ) { m_enable_flip = enable; }
+    void enableFlip() { this->setEnabledFlip( true ); }
+    void disableFlip() { this->setEnabledFlip( false ); }
+
+    bool read( const size_t width, const size_t height, kvs::ValueArray<kvs::UInt8>* pixels );
+    bool flush( kvs::ValueArray<kvs::UInt8>* pixels );
+    void release();
+
+private:
+    bool copy_oldest( kvs::ValueArray<kvs::UInt8>* pixels );
+};
+
+} // end of namespace kvs
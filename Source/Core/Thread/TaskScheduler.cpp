@@ -0,0 +1,371 @@
+/*****************************************************************************/
+/**
+ *  @file   TaskScheduler.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "TaskScheduler.h"
+#include <kvs/Platform>
+#include <kvs/Thread>
+#include <kvs/MutexLocker>
+#include <kvs/SystemInformation>
+#if defined( KVS_PLATFORM_WINDOWS )
+#include <windows.h>
+#elif defined( KVS_PLATFORM_LINUX )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace
+{
+
+thread_local const kvs::TaskScheduler* CurrentScheduler = nullptr; ///< scheduler of the worker
+thread_local size_t CurrentIndex = 0; ///< index of the worker
+
+/*===========================================================================*/
+/**
+ *  @brief  Pins the calling thread to the processors.
+ *  @param  processors [in] processor indices
+ */
+/*===========================================================================*/
+void PinThread( const std::vector<size_t>& processors )
+{
+    if ( processors.empty() ) { return; }
+#if defined( KVS_PLATFORM_WINDOWS )
+    DWORD_PTR mask = 0;
+    for ( auto p : processors ) { if ( p < sizeof( mask ) * 8 ) { mask |= DWORD_PTR(1) << p; } }
+    if ( mask ) { SetThreadAffinityMask( GetCurrentThread(), mask ); }
+#elif defined( KVS_PLATFORM_LINUX ) && defined( __GLIBC__ )
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    for ( auto p : processors ) { if ( p < CPU_SETSIZE ) { CPU_SET( p, &set ); } }
+    pthread_setaffinity_np( pthread_self(), sizeof( set ), &set );
+#endif
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Queued task.
+ */
+/*===========================================================================*/
+struct TaskScheduler::Item
+{
+    Task task; ///< task
+    TaskGroup* group; ///< group of the task
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Task deque.
+ */
+/*===========================================================================*/
+struct TaskScheduler::Queue
+{
+    std::deque<Item> items{}; ///< tasks
+    kvs::Mutex mutex{}; ///< mutex for the tasks
+    std::vector<size_t> processors{}; ///< processors of the NUMA node of the worker
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Worker thread class.
+ */
+/*===========================================================================*/
+class TaskScheduler::Worker : public kvs::Thread
+{
+private:
+    kvs::TaskScheduler* m_scheduler; ///< pointer to the scheduler
+    size_t m_index; ///< index of the worker
+
+public:
+    Worker( kvs::TaskScheduler* scheduler, const size_t index ): m_scheduler( scheduler ), m_index( index ) {}
+    void run() { m_scheduler->process( m_index ); }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the shared task scheduler with a thread per processor.
+ *  @return task scheduler
+ */
+/*===========================================================================*/
+TaskScheduler& TaskScheduler::Instance()
+{
+    static TaskScheduler instance;
+    return instance;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new TaskScheduler class.
+ *  @param  nthreads [in] number of threads including the waiting thread (0: number of processors)
+ *  @param  pinning [in] if true, the workers are pinned to the NUMA nodes in round-robin order
+ */
+/*===========================================================================*/
+TaskScheduler::TaskScheduler( const size_t nthreads, const bool pinning ):
+    m_nthreads( nthreads > 0 ? nthreads : std::max( kvs::SystemInformation::NumberOfProcessors(), size_t(1) ) ),
+    m_pinning( pinning )
+{
+    const size_t nworkers = this->numberOfWorkers();
+    const size_t nnodes = std::max( kvs::SystemInformation::NumberOfNUMANodes(), size_t(1) );
+    for ( size_t i = 0; i <= nworkers; i++ )
+    {
+        m_queues.emplace_back( new Queue() );
+        if ( i < nworkers ) { m_queues.back()->processors = kvs::SystemInformation::NUMANodeProcessors( i % nnodes ); }
+    }
+
+    // The workers try the victims on the same NUMA node first and the shared
+    // deque last, and the other threads try the shared deque first.
+    for ( size_t i = 0; i < nworkers; i++ )
+    {
+        std::vector<size_t> victims;
+        for ( size_t k = 1; k < nworkers; k++ )
+        {
+            const size_t j = ( i + k ) % nworkers;
+            if ( j % nnodes == i % nnodes ) { victims.push_back( j ); }
+        }
+        for ( size_t k = 1; k < nworkers; k++ )
+        {
+            const size_t j = ( i + k ) % nworkers;
+            if ( j % nnodes != i % nnodes ) { victims.push_back( j ); }
+        }
+        victims.push_back( nworkers );
+        m_victims.push_back( victims );
+    }
+
+    std::vector<size_t> victims( 1, nworkers );
+    for ( size_t j = 0; j < nworkers; j++ ) { victims.push_back( j ); }
+    m_victims.push_back( victims );
+
+    for ( size_t i = 0; i < nworkers; i++ )
+    {
+        m_workers.emplace_back( new Worker( this, i ) );
+        m_workers.back()->start();
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the TaskScheduler class after the workers finish.
+ */
+/*===========================================================================*/
+TaskScheduler::~TaskScheduler()
+{
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        m_quit = true;
+    }
+    m_wakeup.wakeUpAll();
+    for ( auto& worker : m_workers ) { worker->wait(); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the calling thread is a worker of the scheduler.
+ *  @return true if the calling thread is a worker
+ */
+/*===========================================================================*/
+bool TaskScheduler::isWorkerThread() const
+{
+    return ::CurrentScheduler == this;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Queues the task on the deque of the calling worker or the shared deque.
+ *  @param  item [in] task
+ */
+/*===========================================================================*/
+void TaskScheduler::push( Item&& item )
+{
+    // The sleeping workers check m_npending under the mutex before waiting,
+    // so the wakeup cannot be lost.
+    m_npending.fetch_add( 1 );
+
+    const size_t index = this->isWorkerThread() ? ::CurrentIndex : this->numberOfWorkers();
+    {
+        Queue& queue = *m_queues[ index ];
+        kvs::MutexLocker locker( &queue.mutex );
+        queue.items.push_back( std::move( item ) );
+    }
+
+    if ( m_nsleeping.load() > 0 )
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        m_wakeup.wakeUpOne();
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes a queued task on the calling thread.
+ *  @return true if a task has been executed
+ */
+/*===========================================================================*/
+bool TaskScheduler::execute_one()
+{
+    if ( m_npending.load( std::memory_order_acquire ) == 0 ) { return false; }
+
+    const size_t nworkers = this->numberOfWorkers();
+    const size_t index = this->isWorkerThread() ? ::CurrentIndex : nworkers;
+
+    Item item{ Task(), nullptr };
+    bool found = false;
+    if ( index < nworkers )
+    {
+        Queue& queue = *m_queues[ index ];
+        kvs::MutexLocker locker( &queue.mutex );
+        if ( !queue.items.empty() )
+        {
+            item = std::move( queue.items.back() );
+            queue.items.pop_back();
+            found = true;
+        }
+    }
+
+    const std::vector<size_t>& victims = m_victims[ index ];
+    for ( size_t i = 0; i < victims.size() && !found; i++ )
+    {
+        Queue& queue = *m_queues[ victims[i] ];
+        kvs::MutexLocker locker( &queue.mutex );
+        if ( !queue.items.empty() )
+        {
+            item = std::move( queue.items.front() );
+            queue.items.pop_front();
+            found = true;
+        }
+    }
+
+    if ( !found ) { return false; }
+    m_npending.fetch_sub( 1 );
+
+    TaskGroup* group = item.group;
+    try
+    {
+        item.task();
+    }
+    catch ( ... )
+    {
+        kvs::MutexLocker locker( &group->m_mutex );
+        if ( !group->m_exception ) { group->m_exception = std::current_exception(); }
+    }
+
+    // The task is destroyed before the group is notified.
+    item.task = nullptr;
+    group->finish_task();
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the tasks on the worker thread until the scheduler quits.
+ *  @param  index [in] index of the worker
+ */
+/*===========================================================================*/
+void TaskScheduler::process( const size_t index )
+{
+    ::CurrentScheduler = this;
+    ::CurrentIndex = index;
+    if ( m_pinning ) { ::PinThread( m_queues[ index ]->processors ); }
+
+    while ( !m_quit.load() )
+    {
+        if ( this->execute_one() ) { continue; }
+
+        kvs::MutexLocker locker( &m_mutex );
+        m_nsleeping.fetch_add( 1 );
+        while ( m_npending.load() == 0 && !m_quit.load() ) { m_wakeup.wait( &m_mutex ); }
+        m_nsleeping.fetch_sub( 1 );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the TaskGroup class after the tasks finish.
+ */
+/*===========================================================================*/
+TaskScheduler::TaskGroup::~TaskGroup()
+{
+    // The exception is not rethrown from the destructor.
+    this->wait_tasks();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Queues the task.
+ *  @param  task [in] task
+ */
+/*===========================================================================*/
+void TaskScheduler::TaskGroup::run( Task task )
+{
+    m_npending.fetch_add( 1, std::memory_order_relaxed );
+    m_scheduler.push( Item{ std::move( task ), this } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Waits for the tasks, executing the queued tasks in the meantime.
+ *
+ *  The first exception thrown by the tasks is rethrown.
+ */
+/*===========================================================================*/
+void TaskScheduler::TaskGroup::wait()
+{
+    this->wait_tasks();
+
+    std::exception_ptr exception;
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        std::swap( exception, m_exception );
+    }
+    if ( exception ) { std::rethrow_exception( exception ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Decrements the number of unfinished tasks and signals the last one.
+ */
+/*===========================================================================*/
+void TaskScheduler::TaskGroup::finish_task()
+{
+    size_t npending = m_npending.load( std::memory_order_relaxed );
+    while ( npending > 1 )
+    {
+        if ( m_npending.compare_exchange_weak( npending, npending - 1, std::memory_order_release ) ) { return; }
+    }
+
+    // The count reaches 0 under the mutex, so that the waiting thread cannot
+    // miss the signal or destroy the group before the mutex is released.
+    kvs::MutexLocker locker( &m_mutex );
+    m_npending.fetch_sub( 1, std::memory_order_release );
+    m_done.wakeUpAll();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the queued tasks, and blocks while the last tasks are running.
+ */
+/*===========================================================================*/
+void TaskScheduler::TaskGroup::wait_tasks()
+{
+    while ( m_npending.load( std::memory_order_acquire ) > 0 )
+    {
+        if ( m_scheduler.execute_one() ) { continue; }
+
+        // No task can be stolen, so the remaining tasks are running on the other
+        // threads. The wait times out to steal the tasks they queue meanwhile.
+        kvs::MutexLocker locker( &m_mutex );
+        if ( m_npending.load( std::memory_order_acquire ) > 0 ) { m_done.wait( &m_mutex, 1 ); }
+    }
+
+    // Synchronizes with the thread that has finished the last task.
+    kvs::MutexLocker locker( &m_mutex );
+}
+
+} // end of namespace kvs
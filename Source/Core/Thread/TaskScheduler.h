@@ -0,0 +1,214 @@
+/*****************************************************************************/
+/**
+ *  @file   TaskScheduler.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/Mutex>
+#include <kvs/Condition>
+#include <kvs/Noncopyable>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Work-stealing task scheduler.
+ *
+ *  Each worker thread has its own task deque. A worker pushes and pops the
+ *  tasks at the back of its deque (depth-first), and steals the tasks from
+ *  the front of the other deques (the oldest, that is the largest, tasks),
+ *  trying the workers on the same NUMA node first. The tasks submitted from
+ *  the other threads are queued on a shared deque.
+ *
+ *  A thread waiting for a task group executes the pending tasks instead of
+ *  blocking, so that the nested parallel loops run on the same workers
+ *  without creating threads (no oversubscription) and without deadlock.
+ */
+/*===========================================================================*/
+class TaskScheduler : private kvs::Noncopyable
+{
+public:
+    using Task = std::function<void()>;
+    class TaskGroup;
+
+private:
+    class Worker;
+    struct Item;
+    struct Queue;
+
+    size_t m_nthreads = 1; ///< number of threads including the waiting thread
+    bool m_pinning = false; ///< flag for pinning the workers to the NUMA nodes
+    std::vector<std::unique_ptr<Queue>> m_queues{}; ///< deques of the workers and the shared deque (last)
+    std::vector<std::vector<size_t>> m_victims{}; ///< victim order of each deque
+    std::vector<std::unique_ptr<Worker>> m_workers{}; ///< worker threads
+    std::atomic<size_t> m_npending{ 0 }; ///< number of queued tasks
+    std::atomic<size_t> m_nsleeping{ 0 }; ///< number of sleeping workers
+    std::atomic<bool> m_quit{ false }; ///< quit flag for the workers
+    kvs::Mutex m_mutex{}; ///< mutex for the wakeup condition
+    kvs::Condition m_wakeup{}; ///< signaled when a task is queued
+
+public:
+    static TaskScheduler& Instance();
+
+    TaskScheduler( const size_t nthreads = 0, const bool pinning = false );
+    ~TaskScheduler();
+
+    size_t numberOfThreads() const { return m_nthreads; }
+    size_t numberOfWorkers() const { return m_nthreads - 1; } // the waiting thread executes the tasks too
+    bool isPinned() const { return m_pinning; }
+    bool isWorkerThread() const;
+
+    template <typename Function>
+    void parallelFor( const size_t begin, const size_t end, Function function, const size_t grain = 0 );
+
+    template <typename T, typename Function, typename Reduction>
+    T parallelReduce( const size_t begin, const size_t end, const T& identity, Function function, Reduction reduction, const size_t grain = 0 );
+
+private:
+    void push( Item&& item );
+    bool execute_one();
+    void process( const size_t index );
+    size_t default_grain( const size_t n ) const { return std::max( n / ( 8 * m_nthreads ), size_t(1) ); }
+
+    template <typename Function>
+    void split( TaskGroup& group, size_t begin, size_t end, const size_t grain, const Function& function );
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Group of tasks that can be waited for.
+ */
+/*===========================================================================*/
+class TaskScheduler::TaskGroup : private kvs::Noncopyable
+{
+    friend class TaskScheduler;
+
+private:
+    TaskScheduler& m_scheduler; ///< scheduler
+    std::atomic<size_t> m_npending{ 0 }; ///< number of unfinished tasks
+    std::exception_ptr m_exception{}; ///< first exception thrown by the tasks
+    kvs::Mutex m_mutex{}; ///< mutex for the exception and the completion
+    kvs::Condition m_done{}; ///< signaled when the last task finishes
+
+public:
+    TaskGroup( TaskScheduler& scheduler = TaskScheduler::Instance() ): m_scheduler( scheduler ) {}
+    ~TaskGroup();
+
+    void run( Task task );
+    void wait();
+
+private:
+    void finish_task();
+    void wait_tasks();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes the function for the sub-ranges of [begin, end) in parallel.
+ *  @param  begin [in] first index
+ *  @param  end [in] last index (not included)
+ *  @param  function [in] function called as function( sub_begin, sub_end )
+ *  @param  grain [in] maximum size of the sub-ranges (0: automatic)
+ */
+/*===========================================================================*/
+template <typename Function>
+inline void TaskScheduler::parallelFor(
+    const size_t begin,
+    const size_t end,
+    Function function,
+    const size_t grain )
+{
+    if ( begin >= end ) { return; }
+
+    TaskGroup group( *this );
+    this->split( group, begin, end, grain > 0 ? grain : this->default_grain( end - begin ), function );
+    group.wait();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reduces the results of the function for the sub-ranges in parallel.
+ *
+ *  The range is divided into the chunks of the grain size, and the partial
+ *  results are reduced in the order of the chunks, so that the result does
+ *  not depend on the scheduling of the tasks.
+ *
+ *  @param  begin [in] first index
+ *  @param  end [in] last index (not included)
+ *  @param  identity [in] identity of the reduction
+ *  @param  function [in] function called as function( sub_begin, sub_end, identity )
+ *  @param  reduction [in] function called as reduction( result, partial_result )
+ *  @param  grain [in] size of the chunks (0: automatic)
+ *  @return reduced result
+ */
+/*===========================================================================*/
+template <typename T, typename Function, typename Reduction>
+inline T TaskScheduler::parallelReduce(
+    const size_t begin,
+    const size_t end,
+    const T& identity,
+    Function function,
+    Reduction reduction,
+    const size_t grain )
+{
+    if ( begin >= end ) { return identity; }
+
+    const size_t chunk = grain > 0 ? grain : this->default_grain( end - begin );
+    const size_t nchunks = ( end - begin + chunk - 1 ) / chunk;
+    std::deque<T> partials( nchunks, identity ); // not std::vector because of vector<bool>
+    this->parallelFor( 0, nchunks, [&] ( const size_t first, const size_t last )
+    {
+        for ( size_t i = first; i < last; i++ )
+        {
+            const size_t b = begin + i * chunk;
+            partials[i] = function( b, std::min( b + chunk, end ), identity );
+        }
+    }, 1 );
+
+    T result = identity;
+    for ( const auto& partial : partials ) { result = reduction( result, partial ); }
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Splits the range recursively and spawns the right halves.
+ *  @param  group [in] task group
+ *  @param  begin [in] first index
+ *  @param  end [in] last index (not included)
+ *  @param  grain [in] maximum size of the sub-ranges
+ *  @param  function [in] function called for the sub-ranges
+ */
+/*===========================================================================*/
+template <typename Function>
+inline void TaskScheduler::split(
+    TaskGroup& group,
+    size_t begin,
+    size_t end,
+    const size_t grain,
+    const Function& function )
+{
+    // The halves are spawned lazily, so that a thief steals the largest range.
+    while ( end - begin > grain )
+    {
+        const size_t middle = begin + ( end - begin ) / 2;
+        group.run( [this, &group, middle, end, grain, &function]
+        {
+            this->split( group, middle, end, grain, function );
+        } );
+        end = middle;
+    }
+    function( begin, end );
+}
+
+} // end of namespace kvs
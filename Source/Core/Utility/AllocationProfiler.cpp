@@ -0,0 +1,506 @@
+/*****************************************************************************/
+/**
+ *  @file   AllocationProfiler.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "AllocationProfiler.h"
+#include <kvs/Platform>
+#include <kvs/Compiler>
+#include <kvs/Mutex>
+#include <kvs/MutexLocker>
+#include <kvs/Message>
+#include <atomic>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <ctime>
+#if defined( KVS_PLATFORM_WINDOWS )
+#include <windows.h>
+#elif defined( __GLIBC__ ) || defined( KVS_PLATFORM_MACOSX )
+#define KVS_ALLOCATION_PROFILER_BACKTRACE
+#include <execinfo.h>
+#if defined( KVS_COMPILER_GCC ) || defined( __clang__ )
+#include <cxxabi.h>
+#endif
+#endif
+
+
+namespace
+{
+
+const size_t DefaultSamplingInterval = 512 * 1024;
+const int MaxFrames = 32;
+
+/*===========================================================================*/
+/**
+ *  @brief  Sampling state of a thread.
+ */
+/*===========================================================================*/
+struct ThreadState
+{
+    std::ptrdiff_t countdown; ///< bytes until the next sampled allocation
+    std::uint64_t random; ///< state of the random number generator (0: not initialized)
+};
+
+std::atomic<bool> Enabled( false );
+thread_local ThreadState State = { 0, 0 };
+thread_local const char* CurrentScope = nullptr;
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the next sampling interval.
+ *  @param  state [in/out] sampling state of the thread
+ *  @param  mean [in] mean sampling interval in bytes
+ *  @return interval drawn from the exponential distribution
+ */
+/*===========================================================================*/
+std::ptrdiff_t NextInterval( ThreadState& state, const size_t mean )
+{
+    // xorshift64* generator
+    std::uint64_t& x = state.random;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    const double u = double( ( ( x * 0x2545F4914F6CDD1DULL ) >> 11 ) + 1 ) / 9007199254740992.0; // (0,1]
+    const double interval = -std::log( u ) * double( mean );
+    return static_cast<std::ptrdiff_t>( std::min( interval, 1.0e15 ) ) + 1;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Captures the call stack.
+ *  @param  frames [out] return addresses
+ *  @param  skip [in] number of the innermost frames to be skipped
+ */
+/*===========================================================================*/
+void CaptureStack( std::vector<void*>& frames, const int skip )
+{
+    void* buffer[ MaxFrames ];
+    int nframes = 0;
+#if defined( KVS_PLATFORM_WINDOWS )
+    nframes = CaptureStackBackTrace( 0, MaxFrames, buffer, NULL );
+#elif defined( KVS_ALLOCATION_PROFILER_BACKTRACE )
+    nframes = backtrace( buffer, MaxFrames );
+#endif
+    if ( nframes > skip ) { frames.assign( buffer + skip, buffer + nframes ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the symbol names of the return addresses.
+ *  @param  frames [in] return addresses
+ *  @return symbol names (the addresses if the symbols are not available)
+ */
+/*===========================================================================*/
+std::vector<std::string> Symbolize( const std::vector<void*>& frames )
+{
+    std::vector<std::string> names;
+#if defined( KVS_ALLOCATION_PROFILER_BACKTRACE )
+    char** symbols = backtrace_symbols( frames.data(), static_cast<int>( frames.size() ) );
+    for ( size_t i = 0; i < frames.size(); i++ )
+    {
+        std::string name = symbols ? symbols[i] : "";
+#if defined( KVS_COMPILER_GCC ) || defined( __clang__ )
+        // "binary(mangled+offset) [address]" on Linux
+        const size_t begin = name.find( '(' );
+        const size_t end = name.find( '+', begin );
+        if ( begin != std::string::npos && end != std::string::npos && end > begin + 1 )
+        {
+            int status = 0;
+            const std::string mangled = name.substr( begin + 1, end - begin - 1 );
+            char* demangled = abi::__cxa_demangle( mangled.c_str(), nullptr, nullptr, &status );
+            if ( status == 0 && demangled ) { name = demangled; }
+            std::free( demangled );
+        }
+#endif
+        names.push_back( name );
+    }
+    std::free( symbols );
+#else
+    for ( auto* frame : frames )
+    {
+        std::ostringstream address; address << frame;
+        names.push_back( address.str() );
+    }
+#endif
+    return names;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Counters of the sampled allocations.
+ */
+/*===========================================================================*/
+struct Counter
+{
+    size_t nsamples = 0;
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+    size_t total_bytes = 0;
+
+    void add( const size_t bytes )
+    {
+        nsamples++;
+        live_bytes += bytes;
+        total_bytes += bytes;
+        peak_bytes = std::max( peak_bytes, live_bytes );
+    }
+
+    void remove( const size_t bytes )
+    {
+        live_bytes -= std::min( live_bytes, bytes );
+    }
+
+    void reset()
+    {
+        nsamples = 0;
+        total_bytes = 0;
+        peak_bytes = live_bytes;
+    }
+
+    kvs::AllocationProfiler::Statistics statistics( const std::string& type ) const
+    {
+        kvs::AllocationProfiler::Statistics s;
+        s.type = type;
+        s.nsamples = nsamples;
+        s.live_bytes = live_bytes;
+        s.peak_bytes = peak_bytes;
+        s.total_bytes = total_bytes;
+        return s;
+    }
+};
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Statistics of the sampled allocations.
+ *
+ *  The call sites are never removed, since the live samples refer to them.
+ */
+/*===========================================================================*/
+class AllocationProfiler::Impl
+{
+public:
+    using SiteKey = std::pair<std::string,std::vector<void*>>;
+
+    struct Site
+    {
+        const SiteKey* key = nullptr; ///< type and call stack
+        ::Counter counter{}; ///< counters of the call site
+        ::Counter* type_counter = nullptr; ///< counters of the type
+    };
+
+    std::atomic<size_t> interval{ ::DefaultSamplingInterval }; ///< mean sampling interval
+    mutable kvs::Mutex mutex{}; ///< mutex for the statistics
+    std::map<SiteKey,Site> sites{}; ///< statistics per call site
+    std::map<std::string,::Counter> types{}; ///< statistics per type
+    ::Counter total{}; ///< statistics of all the allocations
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Sampled allocation.
+ */
+/*===========================================================================*/
+class AllocationProfiler::Sample
+{
+public:
+    Impl::Site* site; ///< call site
+    size_t weight; ///< estimated bytes represented by the sample
+};
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the allocation profiler instance.
+ *  @return allocation profiler
+ */
+/*===========================================================================*/
+AllocationProfiler& AllocationProfiler::Instance()
+{
+    // The instance is never destroyed, since the arrays in the static objects
+    // may be released after the static objects of this file.
+    static AllocationProfiler* instance = new AllocationProfiler();
+    return *instance;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new AllocationProfiler class.
+ */
+/*===========================================================================*/
+AllocationProfiler::AllocationProfiler():
+    m_impl( new Impl() )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the allocations are sampled.
+ *  @return true if enabled
+ */
+/*===========================================================================*/
+bool AllocationProfiler::IsEnabled()
+{
+    return ::Enabled.load( std::memory_order_relaxed );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the flag for sampling the allocations (disabled by default).
+ *  @param  enabled [in] true if the allocations are sampled
+ */
+/*===========================================================================*/
+void AllocationProfiler::setEnabled( const bool enabled )
+{
+    ::Enabled.store( enabled, std::memory_order_relaxed );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the mean sampling interval.
+ *  @param  bytes [in] mean interval in bytes (0: every allocation is sampled)
+ */
+/*===========================================================================*/
+void AllocationProfiler::setSamplingInterval( const size_t bytes )
+{
+    m_impl->interval.store( bytes, std::memory_order_relaxed );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the mean sampling interval.
+ *  @return mean interval in bytes
+ */
+/*===========================================================================*/
+size_t AllocationProfiler::samplingInterval() const
+{
+    return m_impl->interval.load( std::memory_order_relaxed );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Resets the number of samples, total and peak bytes.
+ *
+ *  The live bytes are kept, since the live allocations are released later.
+ */
+/*===========================================================================*/
+void AllocationProfiler::clear()
+{
+    kvs::MutexLocker locker( &m_impl->mutex );
+    for ( auto& site : m_impl->sites ) { site.second.counter.reset(); }
+    for ( auto& type : m_impl->types ) { type.second.reset(); }
+    m_impl->total.reset();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the snapshot of the statistics.
+ *  @return snapshot
+ */
+/*===========================================================================*/
+AllocationProfiler::Snapshot AllocationProfiler::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.sampling_interval = this->samplingInterval();
+
+    std::vector<std::pair<Statistics,std::vector<void*>>> sites;
+    {
+        kvs::MutexLocker locker( &m_impl->mutex );
+        snapshot.total = m_impl->total.statistics( "total" );
+        for ( const auto& type : m_impl->types )
+        {
+            snapshot.types.push_back( type.second.statistics( type.first ) );
+        }
+        for ( const auto& site : m_impl->sites )
+        {
+            if ( site.second.counter.peak_bytes == 0 ) { continue; }
+            const Statistics s = site.second.counter.statistics( site.first.first );
+            sites.push_back( std::make_pair( s, site.first.second ) );
+        }
+    }
+
+    // The symbols are resolved outside the lock.
+    for ( auto& site : sites )
+    {
+        site.first.frames = ::Symbolize( site.second );
+        snapshot.sites.push_back( site.first );
+    }
+
+    auto by_peak = [] ( const Statistics& a, const Statistics& b ) { return a.peak_bytes > b.peak_bytes; };
+    std::sort( snapshot.types.begin(), snapshot.types.end(), by_peak );
+    std::sort( snapshot.sites.begin(), snapshot.sites.end(), by_peak );
+    return snapshot;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the snapshot of the statistics.
+ *  @param  os [in] output stream
+ *  @param  indent [in] indent
+ *  @param  max_sites [in] maximum number of call sites (sorted by the peak bytes)
+ */
+/*===========================================================================*/
+void AllocationProfiler::print( std::ostream& os, const kvs::Indent& indent, const size_t max_sites ) const
+{
+    const Snapshot snapshot = this->snapshot();
+    auto print_statistics = [&] ( const Statistics& s, const kvs::Indent& ind )
+    {
+        os << ind << "Samples : " << s.nsamples << std::endl;
+        os << ind << "Live : " << s.live_bytes << " [bytes]" << std::endl;
+        os << ind << "Peak : " << s.peak_bytes << " [bytes]" << std::endl;
+        os << ind << "Total : " << s.total_bytes << " [bytes]" << std::endl;
+    };
+
+    os << indent << "Sampling interval : " << snapshot.sampling_interval << " [bytes]" << std::endl;
+    print_statistics( snapshot.total, indent );
+
+    os << indent << "Types" << std::endl;
+    for ( const auto& s : snapshot.types )
+    {
+        os << indent.nextIndent() << s.type << std::endl;
+        print_statistics( s, indent.nextIndent().nextIndent() );
+    }
+
+    os << indent << "Call sites" << std::endl;
+    const size_t nsites = std::min( max_sites, snapshot.sites.size() );
+    for ( size_t i = 0; i < nsites; i++ )
+    {
+        const Statistics& s = snapshot.sites[i];
+        os << indent.nextIndent() << "#" << i << " " << s.type << std::endl;
+        print_statistics( s, indent.nextIndent().nextIndent() );
+        os << indent.nextIndent().nextIndent() << "Stack" << std::endl;
+        for ( const auto& frame : s.frames )
+        {
+            os << indent.nextIndent().nextIndent().nextIndent() << frame << std::endl;
+        }
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the snapshot of the statistics to the file.
+ *  @param  filename [in] output filename
+ *  @param  max_sites [in] maximum number of call sites (sorted by the peak bytes)
+ *  @return true if the file has been written
+ */
+/*===========================================================================*/
+bool AllocationProfiler::write( const std::string& filename, const size_t max_sites ) const
+{
+    std::ofstream ofs( filename.c_str() );
+    if ( !ofs.is_open() )
+    {
+        kvsMessageError() << "Cannot open " << filename << "." << std::endl;
+        return false;
+    }
+
+    this->print( ofs, kvs::Indent(0), max_sites );
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Counts down the bytes on the thread and samples the allocation.
+ *  @param  type [in] type name used when no scope is set (static storage)
+ *  @param  bytes [in] allocated bytes
+ *  @return sampled allocation (NULL if not sampled)
+ */
+/*===========================================================================*/
+AllocationProfiler::Sample* AllocationProfiler::sample( const char* type, const size_t bytes )
+{
+    ::ThreadState& state = ::State;
+    const size_t mean = m_impl->interval.load( std::memory_order_relaxed );
+    if ( state.random == 0 )
+    {
+        const std::uint64_t address = reinterpret_cast<std::uintptr_t>( &state );
+        state.random = ( address ^ ( std::uint64_t( std::time( nullptr ) ) << 32 ) ) | 1;
+        state.countdown = ::NextInterval( state, mean );
+    }
+
+    state.countdown -= static_cast<std::ptrdiff_t>( bytes );
+    if ( state.countdown > 0 ) { return nullptr; }
+    state.countdown = mean > 0 ? ::NextInterval( state, mean ) : 0;
+
+    // An allocation of n bytes is sampled with the probability 1 - exp(-n/mean).
+    const double probability = mean > 0 ? 1.0 - std::exp( -double( bytes ) / double( mean ) ) : 1.0;
+    const size_t weight = probability > 0.0 ? static_cast<size_t>( double( bytes ) / probability ) : mean;
+
+    Impl::SiteKey key;
+    key.first = Scope::Current() ? Scope::Current() : type;
+    ::CaptureStack( key.second, 1 );
+
+    kvs::MutexLocker locker( &m_impl->mutex );
+    auto site = m_impl->sites.find( key );
+    if ( site == m_impl->sites.end() )
+    {
+        site = m_impl->sites.insert( std::make_pair( key, Impl::Site() ) ).first;
+        site->second.key = &site->first;
+        site->second.type_counter = &m_impl->types[ key.first ];
+    }
+
+    site->second.counter.add( weight );
+    site->second.type_counter->add( weight );
+    m_impl->total.add( weight );
+    return new Sample{ &site->second, weight };
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the sampled allocation.
+ *  @param  sample [in] sampled allocation
+ */
+/*===========================================================================*/
+void AllocationProfiler::release( Sample* sample )
+{
+    {
+        kvs::MutexLocker locker( &m_impl->mutex );
+        sample->site->counter.remove( sample->weight );
+        sample->site->type_counter->remove( sample->weight );
+        m_impl->total.remove( sample->weight );
+    }
+    delete sample;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Scope class.
+ *  @param  type [in] type name (static storage)
+ */
+/*===========================================================================*/
+AllocationProfiler::Scope::Scope( const char* type ):
+    m_previous( ::CurrentScope )
+{
+    ::CurrentScope = type;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Scope class.
+ */
+/*===========================================================================*/
+AllocationProfiler::Scope::~Scope()
+{
+    ::CurrentScope = m_previous;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the type name of the innermost scope on the thread.
+ *  @return type name (NULL if no scope is set)
+ */
+/*===========================================================================*/
+const char* AllocationProfiler::Scope::Current()
+{
+    return ::CurrentScope;
+}
+
+} // end of namespace kvs
@@ -0,0 +1,159 @@
+/*****************************************************************************/
+/**
+ *  @file   AllocationProfiler.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/Indent>
+#include <kvs/Deleter>
+#include <kvs/Noncopyable>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <iostream>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Sampling allocation profiler.
+ *
+ *  The allocations of kvs::ValueArray are sampled once every N bytes on
+ *  average (Poisson sampling with the mean interval N), where each thread
+ *  counts down its own byte counter without locking. Only the sampled
+ *  allocations capture the call stack and update the statistics, and each
+ *  sampled allocation is weighted by the inverse of its sampling probability
+ *  so that the live, peak and total bytes are unbiased estimates.
+ *
+ *  The statistics are collected per call site (type and call stack) and per
+ *  type. The type is the label of the innermost Scope on the allocating
+ *  thread (e.g. the importer class name), or kvs::ValueArray otherwise.
+ *
+ *  The profiler is disabled by default, and the disabled profiler costs
+ *  one function call per allocation. (This header is included by
+ *  kvs::ValueArray, so it avoids the headers with the deleted functions,
+ *  which conflict with the delete macro of kvs/DebugNew.)
+ */
+/*===========================================================================*/
+class AllocationProfiler : private kvs::Noncopyable
+{
+public:
+    class Sample;
+    class Scope;
+    template <typename T> class Deleter;
+
+    struct Statistics
+    {
+        std::string type; ///< type name
+        std::vector<std::string> frames; ///< call stack (empty for the type statistics)
+        size_t nsamples = 0; ///< number of sampled allocations
+        size_t live_bytes = 0; ///< estimated live bytes
+        size_t peak_bytes = 0; ///< estimated peak live bytes
+        size_t total_bytes = 0; ///< estimated total allocated bytes
+    };
+
+    struct Snapshot
+    {
+        size_t sampling_interval = 0; ///< mean sampling interval in bytes
+        Statistics total{}; ///< statistics of all the allocations
+        std::vector<Statistics> types{}; ///< statistics per type (sorted by peak bytes)
+        std::vector<Statistics> sites{}; ///< statistics per call site (sorted by peak bytes)
+    };
+
+private:
+    class Impl;
+    Impl* m_impl; ///< statistics of the sampled allocations
+
+public:
+    static AllocationProfiler& Instance();
+
+    static bool IsEnabled();
+    static Sample* Allocated( const char* type, const size_t bytes );
+    static void Released( Sample* sample );
+
+    void setSamplingInterval( const size_t bytes );
+    void setEnabled( const bool enabled = true );
+    void enable() { this->setEnabled( true ); }
+    void disable() { this->setEnabled( false ); }
+    bool isEnabled() const { return IsEnabled(); }
+    size_t samplingInterval() const;
+
+    void clear();
+    Snapshot snapshot() const;
+    void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0), const size_t max_sites = 20 ) const;
+    bool write( const std::string& filename, const size_t max_sites = 20 ) const;
+
+private:
+    AllocationProfiler();
+    Sample* sample( const char* type, const size_t bytes );
+    void release( Sample* sample );
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Scope class that labels the allocations on the thread with the type.
+ */
+/*===========================================================================*/
+class AllocationProfiler::Scope : private kvs::Noncopyable
+{
+private:
+    const char* m_previous; ///< label of the enclosing scope
+
+public:
+    Scope( const char* type );
+    ~Scope();
+
+    static const char* Current();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Deleter class that releases the sampled allocation.
+ */
+/*===========================================================================*/
+template <typename T>
+class AllocationProfiler::Deleter
+{
+private:
+    Sample* m_sample; ///< sampled allocation
+
+public:
+    Deleter( Sample* sample ): m_sample( sample ) {}
+
+    template <typename U>
+    void operator ()( U* p ) const
+    {
+        kvs::Deleter<T>()( p );
+        AllocationProfiler::Released( m_sample );
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the sample if the allocation is sampled.
+ *  @param  type [in] type name used when no scope is set (static storage)
+ *  @param  bytes [in] allocated bytes
+ *  @return sampled allocation (NULL if not sampled)
+ */
+/*===========================================================================*/
+inline AllocationProfiler::Sample* AllocationProfiler::Allocated( const char* type, const size_t bytes )
+{
+    if ( !IsEnabled() ) { return nullptr; }
+    return Instance().sample( type, bytes );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the sampled allocation.
+ *  @param  sample [in] sampled allocation returned by Allocated()
+ */
+/*===========================================================================*/
+inline void AllocationProfiler::Released( Sample* sample )
+{
+    if ( sample ) { Instance().release( sample ); }
+}
+
+} // end of namespace kvs
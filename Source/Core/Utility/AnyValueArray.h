@@ -10,6 +10,7 @@
 #include <kvs/Type>
 #include <kvs/SharedPointer>
 #include <kvs/ValueArray>
+#include <kvs/AllocationProfiler>
 #include "StaticAssert.h"
 
 
@@ -345,6 +346,7 @@ public:
     template<typename T>
     void allocate( const size_t size )
     {
+        kvs::AllocationProfiler::Scope scope( "kvs::AnyValueArray" );
         *this = AnyValueArray( kvs::ValueArray<T>( size ) );
     }
     // }
@@ -0,0 +1,139 @@
+/*****************************************************************************/
+/**
+ *  @file   ArrayAllocator.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "ArrayAllocator.h"
+#include <kvs/Platform>
+#include <atomic>
+#include <cstdlib>
+#if defined( KVS_PLATFORM_WINDOWS )
+#include <malloc.h>
+#endif
+
+
+namespace
+{
+
+std::atomic<kvs::ArrayAllocator*> DefaultAllocator( nullptr );
+thread_local kvs::ArrayAllocator* CurrentAllocator = nullptr;
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+const size_t ArrayAllocator::DefaultAlignment;
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the allocator used for the arrays on the calling thread.
+ *  @return allocator of the innermost scope, or default allocator (NULL: new[])
+ */
+/*===========================================================================*/
+ArrayAllocator* ArrayAllocator::Current()
+{
+    if ( ::CurrentAllocator ) { return ::CurrentAllocator; }
+    return ::DefaultAllocator.load( std::memory_order_acquire );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the default allocator.
+ *  @return default allocator (NULL if not set)
+ */
+/*===========================================================================*/
+ArrayAllocator* ArrayAllocator::Default()
+{
+    return ::DefaultAllocator.load( std::memory_order_acquire );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the default allocator used by all the threads.
+ *  @param  allocator [in] allocator (NULL: new[])
+ */
+/*===========================================================================*/
+void ArrayAllocator::SetDefault( ArrayAllocator* allocator )
+{
+    ::DefaultAllocator.store( allocator, std::memory_order_release );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the statistics of the allocator.
+ *  @param  os [in] output stream
+ *  @param  indent [in] indent
+ */
+/*===========================================================================*/
+void ArrayAllocator::print( std::ostream& os, const kvs::Indent& indent ) const
+{
+    const Statistics stats = this->statistics();
+    os << indent << "Allocator : " << this->name() << std::endl;
+    os << indent << "Number of allocations : " << stats.nallocations << std::endl;
+    os << indent << "Hit rate : " << stats.hitRate() * 100.0 << " [%]" << std::endl;
+    os << indent << "Live bytes : " << stats.live_bytes << " [bytes]" << std::endl;
+    os << indent << "Peak bytes : " << stats.peak_bytes << " [bytes]" << std::endl;
+    os << indent << "Retained bytes : " << stats.retained_bytes << " [bytes]" << std::endl;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocates the aligned memory.
+ *  @param  bytes [in] number of bytes
+ *  @param  alignment [in] alignment (power of two, multiple of sizeof(void*))
+ *  @return pointer to the memory (NULL if failed)
+ */
+/*===========================================================================*/
+void* ArrayAllocator::AlignedAllocate( const size_t bytes, const size_t alignment )
+{
+    const size_t size = bytes > 0 ? bytes : 1;
+#if defined( KVS_PLATFORM_WINDOWS )
+    return _aligned_malloc( size, alignment );
+#else
+    void* pointer = nullptr;
+    if ( posix_memalign( &pointer, alignment, size ) != 0 ) { return nullptr; }
+    return pointer;
+#endif
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Frees the memory allocated by AlignedAllocate().
+ *  @param  pointer [in] pointer to the memory
+ */
+/*===========================================================================*/
+void ArrayAllocator::AlignedFree( void* pointer )
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    _aligned_free( pointer );
+#else
+    std::free( pointer );
+#endif
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Scope class.
+ *  @param  allocator [in] allocator used in the scope (NULL: default allocator)
+ */
+/*===========================================================================*/
+ArrayAllocator::Scope::Scope( ArrayAllocator* allocator ):
+    m_previous( ::CurrentAllocator )
+{
+    ::CurrentAllocator = allocator;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Scope class.
+ */
+/*===========================================================================*/
+ArrayAllocator::Scope::~Scope()
+{
+    ::CurrentAllocator = m_previous;
+}
+
+} // end of namespace kvs
@@ -0,0 +1,160 @@
+/*****************************************************************************/
+/**
+ *  @file   ArrayAllocator.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/Indent>
+#include <kvs/Noncopyable>
+#include <kvs/AllocationProfiler>
+#include <cstddef>
+#include <new>
+#include <iostream>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Base class of the memory allocators for kvs::ValueArray.
+ *
+ *  The allocations of kvs::ValueArray (and kvs::AnyValueArray) on a thread
+ *  use the allocator of the innermost Scope on the thread, or the default
+ *  allocator set by SetDefault() otherwise. If neither is set, the arrays
+ *  are allocated by new[] as before. The arrays keep a pointer to their
+ *  allocator, so the allocator must outlive the arrays allocated by it.
+ *
+ *  (This header is included by kvs::ValueArray, so it avoids the headers
+ *  with the deleted functions, which conflict with the delete macro of
+ *  kvs/DebugNew.)
+ */
+/*===========================================================================*/
+class ArrayAllocator : private kvs::Noncopyable
+{
+public:
+    class Scope;
+    template <typename T> class Deleter;
+
+    struct Statistics
+    {
+        size_t nallocations = 0; ///< number of allocations
+        size_t nhits = 0; ///< number of allocations served by the retained memory
+        size_t live_bytes = 0; ///< bytes of the live allocations
+        size_t peak_bytes = 0; ///< peak bytes of the live allocations
+        size_t retained_bytes = 0; ///< bytes retained by the allocator for reuse
+        double hitRate() const { return nallocations > 0 ? double( nhits ) / double( nallocations ) : 0.0; }
+    };
+
+    static const size_t DefaultAlignment = 64; ///< alignment of the arrays (cache line)
+
+public:
+    static ArrayAllocator* Current();
+    static ArrayAllocator* Default();
+    static void SetDefault( ArrayAllocator* allocator );
+
+    ArrayAllocator() {}
+    virtual ~ArrayAllocator() {}
+
+    virtual const char* name() const = 0;
+    virtual void* allocate( const size_t bytes, const size_t alignment = DefaultAlignment ) = 0;
+    virtual void deallocate( void* pointer, const size_t bytes ) = 0;
+    virtual Statistics statistics() const = 0;
+    virtual void trim() {}
+
+    void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
+
+    template <typename T> T* create( const size_t size );
+    template <typename T> void destroy( T* values, const size_t size );
+
+protected:
+    static void* AlignedAllocate( const size_t bytes, const size_t alignment );
+    static void AlignedFree( void* pointer );
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Scope class that sets the allocator of the arrays on the thread.
+ */
+/*===========================================================================*/
+class ArrayAllocator::Scope : private kvs::Noncopyable
+{
+private:
+    ArrayAllocator* m_previous; ///< allocator of the enclosing scope
+
+public:
+    Scope( ArrayAllocator* allocator );
+    ~Scope();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Deleter class that returns the array to the allocator.
+ */
+/*===========================================================================*/
+template <typename T>
+class ArrayAllocator::Deleter
+{
+private:
+    ArrayAllocator* m_allocator; ///< allocator of the array
+    size_t m_size; ///< number of elements
+    kvs::AllocationProfiler::Sample* m_sample; ///< sampled allocation (NULL if not sampled)
+
+public:
+    Deleter( ArrayAllocator* allocator, const size_t size, kvs::AllocationProfiler::Sample* sample ):
+        m_allocator( allocator ),
+        m_size( size ),
+        m_sample( sample ) {}
+
+    void operator ()( T* p ) const
+    {
+        m_allocator->destroy<T>( p, m_size );
+        kvs::AllocationProfiler::Released( m_sample );
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocates and default-initializes the array (same as new T[size]).
+ *  @param  size [in] number of elements
+ *  @return pointer to the array
+ */
+/*===========================================================================*/
+template <typename T>
+inline T* ArrayAllocator::create( const size_t size )
+{
+    const size_t alignment = alignof( T ) > DefaultAlignment ? alignof( T ) : DefaultAlignment;
+    void* pointer = this->allocate( sizeof( T ) * size, alignment );
+    if ( !pointer ) { throw std::bad_alloc(); }
+
+    T* values = static_cast<T*>( pointer );
+    size_t i = 0;
+    try
+    {
+        for ( ; i < size; i++ ) { ::new( static_cast<void*>( values + i ) ) T; }
+    }
+    catch ( ... )
+    {
+        while ( i-- > 0 ) { values[i].~T(); }
+        this->deallocate( pointer, sizeof( T ) * size );
+        throw;
+    }
+    return values;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the array and returns the memory to the allocator.
+ *  @param  values [in] pointer to the array returned by create()
+ *  @param  size [in] number of elements
+ */
+/*===========================================================================*/
+template <typename T>
+inline void ArrayAllocator::destroy( T* values, const size_t size )
+{
+    for ( size_t i = 0; i < size; i++ ) { values[i].~T(); }
+    this->deallocate( values, sizeof( T ) * size );
+}
+
+} // end of namespace kvs
@@ -7,6 +7,7 @@
 #pragma once
 #include <kvs/Type>
 #include <string>
+#include <cstring>
 #include <utility>
 
 
@@ -102,12 +103,14 @@ inline void Endian::Swap8Bytes( void* value )
 /*===========================================================================*/
 inline void Endian::Swap2Bytes( void* values, size_t n )
 {
+    // The values are swapped word by word so that the loop can be
+    // vectorized by the compiler.
     unsigned char* v = static_cast<unsigned char*>( values );
-    unsigned char* vend = v + n * 2;
-    while ( v != vend )
+    for ( size_t i = 0; i < n; i++, v += 2 )
     {
-        Swap2Bytes( v );
-        v += 2;
+        kvs::UInt16 w; std::memcpy( &w, v, 2 );
+        w = static_cast<kvs::UInt16>( ( w >> 8 ) | ( w << 8 ) );
+        std::memcpy( v, &w, 2 );
     }
 }
 
@@ -121,11 +124,14 @@ inline void Endian::Swap2Bytes( void* values, size_t n )
 inline void Endian::Swap4Bytes( void* values, size_t n )
 {
     unsigned char* v = static_cast<unsigned char*>( values );
-    unsigned char* vend = v + n * 4;
-    while ( v != vend )
+    for ( size_t i = 0; i < n; i++, v += 4 )
     {
-        Swap4Bytes( v );
-        v += 4;
+        kvs::UInt32 w; std::memcpy( &w, v, 4 );
+        w = ( w >> 24 ) |
+            ( ( w >> 8 ) & 0x0000FF00U ) |
+            ( ( w << 8 ) & 0x00FF0000U ) |
+            ( w << 24 );
+        std::memcpy( v, &w, 4 );
     }
 }
 
@@ -139,11 +145,13 @@ inline void Endian::Swap4Bytes( void* values, size_t n )
 inline void Endian::Swap8Bytes( void* values, size_t n )
 {
     unsigned char* v = static_cast<unsigned char*>( values );
-    unsigned char* vend = v + n * 8;
-    while ( v != vend )
+    for ( size_t i = 0; i < n; i++, v += 8 )
     {
-        Swap8Bytes( v );
-        v += 8;
+        kvs::UInt64 w; std::memcpy( &w, v, 8 );
+        w = ( ( w & 0x00000000FFFFFFFFULL ) << 32 ) | ( ( w & 0xFFFFFFFF00000000ULL ) >> 32 );
+        w = ( ( w & 0x0000FFFF0000FFFFULL ) << 16 ) | ( ( w & 0xFFFF0000FFFF0000ULL ) >> 16 );
+        w = ( ( w & 0x00FF00FF00FF00FFULL ) << 8 )  | ( ( w & 0xFF00FF00FF00FF00ULL ) >> 8 );
+        std::memcpy( v, &w, 8 );
     }
 }
 
@@ -0,0 +1,288 @@
+/*****************************************************************************/
+/**
+ *  @file   FrameArena.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "FrameArena.h"
+#include <kvs/Mutex>
+#include <kvs/MutexLocker>
+#include <kvs/Assert>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+
+const size_t BlockAlignment = 4096;
+
+/*===========================================================================*/
+/**
+ *  @brief  Memory block of the arena.
+ */
+/*===========================================================================*/
+struct Block
+{
+    char* data; ///< memory of the block
+    size_t size; ///< bytes of the block
+    size_t offset; ///< bytes used in the current frame
+    size_t nlive; ///< number of the live arrays in the block
+    bool detached; ///< true if the block is released when the last array is released
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Header stored just before each array.
+ */
+/*===========================================================================*/
+struct Header
+{
+    Block* block; ///< block of the array
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocates the array in the block.
+ *  @param  block [in/out] block
+ *  @param  bytes [in] number of bytes
+ *  @param  alignment [in] alignment
+ *  @return pointer to the array (NULL if the block has no space)
+ */
+/*===========================================================================*/
+void* Bump( Block* block, const size_t bytes, const size_t alignment )
+{
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>( block->data );
+    const std::uintptr_t first = base + block->offset + sizeof( Header );
+    const std::uintptr_t aligned = ( first + alignment - 1 ) / alignment * alignment;
+    if ( aligned + bytes > base + block->size ) { return nullptr; }
+
+    reinterpret_cast<Header*>( aligned - sizeof( Header ) )->block = block;
+    block->offset = static_cast<size_t>( aligned + bytes - base );
+    block->nlive++;
+    return reinterpret_cast<void*>( aligned );
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+const size_t FrameArena::DefaultBlockSize;
+
+/*===========================================================================*/
+/**
+ *  @brief  Blocks and statistics of the arena.
+ */
+/*===========================================================================*/
+class FrameArena::Impl
+{
+public:
+    kvs::Mutex mutex{}; ///< mutex for the members
+    size_t block_size = 0; ///< bytes of the shared blocks
+    std::vector<::Block*> blocks{}; ///< blocks of the current frame
+    size_t current = 0; ///< index of the block for the next array
+    size_t ndetached = 0; ///< number of the detached blocks
+    ArrayAllocator::Statistics stats{}; ///< statistics
+
+    ::Block* newBlock( const size_t size )
+    {
+        void* data = ArrayAllocator::AlignedAllocate( size, ::BlockAlignment );
+        if ( !data ) { return nullptr; }
+        stats.retained_bytes += size;
+        return new ::Block{ static_cast<char*>( data ), size, 0, 0, false };
+    }
+
+    void deleteBlock( ::Block* block )
+    {
+        ArrayAllocator::AlignedFree( block->data );
+        delete block;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new FrameArena class.
+ *  @param  block_size [in] bytes of the blocks
+ */
+/*===========================================================================*/
+FrameArena::FrameArena( const size_t block_size ):
+    m_impl( new Impl() )
+{
+    m_impl->block_size = std::max( block_size, ::BlockAlignment );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the FrameArena class.
+ */
+/*===========================================================================*/
+FrameArena::~FrameArena()
+{
+    KVS_ASSERT( m_impl->stats.live_bytes == 0 );
+    for ( auto* block : m_impl->blocks ) { m_impl->deleteBlock( block ); }
+    delete m_impl;
+}
+
+size_t FrameArena::blockSize() const
+{
+    return m_impl->block_size;
+}
+
+size_t FrameArena::numberOfBlocks() const
+{
+    kvs::MutexLocker locker( &m_impl->mutex );
+    return m_impl->blocks.size() + m_impl->ndetached;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocates the memory in the current frame.
+ *  @param  bytes [in] number of bytes
+ *  @param  alignment [in] alignment (power of two)
+ *  @return pointer to the memory (NULL if failed)
+ */
+/*===========================================================================*/
+void* FrameArena::allocate( const size_t bytes, const size_t alignment )
+{
+    const size_t align = std::max( alignment, sizeof( ::Header ) );
+    const size_t required = bytes + align + sizeof( ::Header );
+
+    kvs::MutexLocker locker( &m_impl->mutex );
+    ArrayAllocator::Statistics& stats = m_impl->stats;
+
+    void* pointer = nullptr;
+    if ( required > m_impl->block_size / 2 )
+    {
+        // The large array gets its own block, which is full from the start.
+        ::Block* block = m_impl->newBlock( required );
+        if ( !block ) { return nullptr; }
+        pointer = ::Bump( block, bytes, align );
+        block->offset = block->size;
+        m_impl->blocks.push_back( block );
+    }
+    else
+    {
+        for ( ; m_impl->current < m_impl->blocks.size(); m_impl->current++ )
+        {
+            pointer = ::Bump( m_impl->blocks[ m_impl->current ], bytes, align );
+            if ( pointer ) { stats.nhits++; break; }
+        }
+
+        if ( !pointer )
+        {
+            ::Block* block = m_impl->newBlock( m_impl->block_size );
+            if ( !block ) { return nullptr; }
+            pointer = ::Bump( block, bytes, align );
+            m_impl->blocks.push_back( block );
+            m_impl->current = m_impl->blocks.size() - 1;
+        }
+    }
+
+    stats.nallocations++;
+    stats.live_bytes += bytes;
+    stats.peak_bytes = std::max( stats.peak_bytes, stats.live_bytes );
+    return pointer;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the memory.
+ *
+ *  The memory is reclaimed by reset(), except that the detached block is
+ *  released when its last array is released.
+ *
+ *  @param  pointer [in] pointer to the memory returned by allocate()
+ *  @param  bytes [in] number of bytes passed to allocate()
+ */
+/*===========================================================================*/
+void FrameArena::deallocate( void* pointer, const size_t bytes )
+{
+    if ( !pointer ) { return; }
+
+    ::Block* block = reinterpret_cast<::Header*>( static_cast<char*>( pointer ) - sizeof( ::Header ) )->block;
+
+    kvs::MutexLocker locker( &m_impl->mutex );
+    m_impl->stats.live_bytes -= bytes;
+    KVS_ASSERT( block->nlive > 0 );
+    if ( --block->nlive == 0 && block->detached )
+    {
+        m_impl->ndetached--;
+        m_impl->deleteBlock( block );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the statistics of the allocator.
+ *
+ *  The hits are the arrays allocated in the existing blocks, and the
+ *  retained bytes are the bytes of the blocks of the current frame.
+ *
+ *  @return statistics
+ */
+/*===========================================================================*/
+ArrayAllocator::Statistics FrameArena::statistics() const
+{
+    kvs::MutexLocker locker( &m_impl->mutex );
+    return m_impl->stats;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the blocks that have no live arrays.
+ */
+/*===========================================================================*/
+void FrameArena::trim()
+{
+    kvs::MutexLocker locker( &m_impl->mutex );
+    std::vector<::Block*> blocks;
+    for ( auto* block : m_impl->blocks )
+    {
+        if ( block->nlive > 0 ) { blocks.push_back( block ); continue; }
+        m_impl->stats.retained_bytes -= block->size;
+        m_impl->deleteBlock( block );
+    }
+    m_impl->blocks.swap( blocks );
+    m_impl->current = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Starts a new frame and reuses the blocks.
+ *
+ *  The blocks without the live arrays are rewound (the dedicated blocks of
+ *  the large arrays are released), and the blocks with the live arrays are
+ *  detached from the arena and released later with their last arrays.
+ */
+/*===========================================================================*/
+void FrameArena::reset()
+{
+    kvs::MutexLocker locker( &m_impl->mutex );
+    std::vector<::Block*> blocks;
+    for ( auto* block : m_impl->blocks )
+    {
+        if ( block->nlive > 0 )
+        {
+            block->detached = true;
+            m_impl->ndetached++;
+            m_impl->stats.retained_bytes -= block->size;
+        }
+        else if ( block->size != m_impl->block_size )
+        {
+            m_impl->stats.retained_bytes -= block->size;
+            m_impl->deleteBlock( block );
+        }
+        else
+        {
+            block->offset = 0;
+            blocks.push_back( block );
+        }
+    }
+    m_impl->blocks.swap( blocks );
+    m_impl->current = 0;
+}
+
+} // end of namespace kvs
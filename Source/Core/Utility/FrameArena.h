@@ -0,0 +1,51 @@
+/*****************************************************************************/
+/**
+ *  @file   FrameArena.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/ArrayAllocator>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Arena allocator for the temporary arrays of a frame.
+ *
+ *  The arrays are allocated by bumping the offset in the large blocks, and
+ *  the memory is reclaimed at once by reset() (for example, at the end of
+ *  each frame or time step) instead of being freed array by array. The
+ *  blocks with the live arrays at reset() are not reused, but are released
+ *  when their last array is released, so that reset() never invalidates
+ *  the arrays still in use. The requests larger than a half of the block
+ *  get their own blocks.
+ */
+/*===========================================================================*/
+class FrameArena : public kvs::ArrayAllocator
+{
+public:
+    static const size_t DefaultBlockSize = 64 * 1024 * 1024;
+
+private:
+    class Impl;
+    Impl* m_impl; ///< blocks and statistics
+
+public:
+    FrameArena( const size_t block_size = DefaultBlockSize );
+    virtual ~FrameArena();
+
+    size_t blockSize() const;
+    size_t numberOfBlocks() const;
+
+    const char* name() const { return "kvs::FrameArena"; }
+    void* allocate( const size_t bytes, const size_t alignment = DefaultAlignment );
+    void deallocate( void* pointer, const size_t bytes );
+    Statistics statistics() const;
+    void trim();
+    void reset();
+};
+
+} // end of namespace kvs
@@ -0,0 +1,130 @@
+/*****************************************************************************/
+/**
+ *  @file   HugePageAllocator.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "HugePageAllocator.h"
+#include <kvs/Platform>
+#include <kvs/Mutex>
+#include <kvs/MutexLocker>
+#include <algorithm>
+#if defined( KVS_PLATFORM_LINUX )
+#include <sys/mman.h>
+#endif
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the bytes rounded up to the huge page size.
+ *  @param  bytes [in] number of bytes
+ *  @return rounded bytes
+ */
+/*===========================================================================*/
+inline size_t HugePageBytes( const size_t bytes )
+{
+    const size_t page = kvs::HugePageAllocator::HugePageSize;
+    return ( bytes + page - 1 ) / page * page;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+const size_t HugePageAllocator::HugePageSize;
+
+/*===========================================================================*/
+/**
+ *  @brief  Statistics of the allocator.
+ */
+/*===========================================================================*/
+class HugePageAllocator::Impl
+{
+public:
+    kvs::Mutex mutex{}; ///< mutex for the statistics
+    ArrayAllocator::Statistics stats{}; ///< statistics
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new HugePageAllocator class.
+ */
+/*===========================================================================*/
+HugePageAllocator::HugePageAllocator():
+    m_impl( new Impl() )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the HugePageAllocator class.
+ */
+/*===========================================================================*/
+HugePageAllocator::~HugePageAllocator()
+{
+    delete m_impl;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocates the memory.
+ *  @param  bytes [in] number of bytes
+ *  @param  alignment [in] alignment
+ *  @return pointer to the memory (NULL if failed)
+ */
+/*===========================================================================*/
+void* HugePageAllocator::allocate( const size_t bytes, const size_t alignment )
+{
+    const bool huge = bytes >= HugePageSize;
+    const size_t size = huge ? ::HugePageBytes( bytes ) : bytes;
+    void* pointer = ArrayAllocator::AlignedAllocate( size, std::max( alignment, huge ? HugePageSize : DefaultAlignment ) );
+    if ( !pointer ) { return nullptr; }
+
+#if defined( KVS_PLATFORM_LINUX ) && defined( MADV_HUGEPAGE )
+    // The advice is a hint; the pages are still usable if it is refused.
+    if ( huge ) { madvise( pointer, size, MADV_HUGEPAGE ); }
+#endif
+
+    kvs::MutexLocker locker( &m_impl->mutex );
+    ArrayAllocator::Statistics& stats = m_impl->stats;
+    stats.nallocations++;
+    stats.live_bytes += size;
+    stats.peak_bytes = std::max( stats.peak_bytes, stats.live_bytes );
+    return pointer;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the memory.
+ *  @param  pointer [in] pointer to the memory returned by allocate()
+ *  @param  bytes [in] number of bytes passed to allocate()
+ */
+/*===========================================================================*/
+void HugePageAllocator::deallocate( void* pointer, const size_t bytes )
+{
+    if ( !pointer ) { return; }
+    {
+        kvs::MutexLocker locker( &m_impl->mutex );
+        m_impl->stats.live_bytes -= bytes >= HugePageSize ? ::HugePageBytes( bytes ) : bytes;
+    }
+    ArrayAllocator::AlignedFree( pointer );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the statistics of the allocator.
+ *  @return statistics
+ */
+/*===========================================================================*/
+ArrayAllocator::Statistics HugePageAllocator::statistics() const
+{
+    kvs::MutexLocker locker( &m_impl->mutex );
+    return m_impl->stats;
+}
+
+} // end of namespace kvs
@@ -0,0 +1,47 @@
+/*****************************************************************************/
+/**
+ *  @file   HugePageAllocator.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/ArrayAllocator>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocator that backs the large arrays with the huge pages.
+ *
+ *  The requests not less than the huge page size (2 MiB) are aligned to and
+ *  rounded up to the huge page size, and advised to be backed by transparent
+ *  huge pages on Linux, which reduces the TLB misses of the scans over the
+ *  large volumes. The other requests are aligned to the cache line. On the
+ *  other platforms, the large requests are only aligned.
+ *
+ *  Nothing is retained, so the statistics have no hits (use PoolAllocator
+ *  with this allocator as the upstream to keep the buffers).
+ */
+/*===========================================================================*/
+class HugePageAllocator : public kvs::ArrayAllocator
+{
+public:
+    static const size_t HugePageSize = 2 * 1024 * 1024;
+
+private:
+    class Impl;
+    Impl* m_impl; ///< statistics
+
+public:
+    HugePageAllocator();
+    virtual ~HugePageAllocator();
+
+    const char* name() const { return "kvs::HugePageAllocator"; }
+    void* allocate( const size_t bytes, const size_t alignment = DefaultAlignment );
+    void deallocate( void* pointer, const size_t bytes );
+    Statistics statistics() const;
+};
+
+} // end of namespace kvs
@@ -0,0 +1,301 @@
+/*****************************************************************************/
+/**
+ *  @file   PoolAllocator.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "PoolAllocator.h"
+#include <kvs/Mutex>
+#include <kvs/MutexLocker>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+
+const size_t ClassesPerOctave = 4;
+const size_t NumberOfClasses = ClassesPerOctave * 64;
+const size_t PoolAlignment = 4096; // page size, so that the buffers can be shared by any alignment
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the index of the size class of the given bytes.
+ *  @param  bytes [in] number of bytes (>= ClassesPerOctave)
+ *  @return index of the smallest class not less than the bytes
+ */
+/*===========================================================================*/
+size_t ClassIndex( const size_t bytes )
+{
+    size_t octave = 0;
+    while ( octave < 63 && ( size_t(2) << octave ) <= bytes ) { octave++; }
+
+    const size_t base = size_t(1) << octave;
+    const size_t step = base / ClassesPerOctave;
+    const size_t quarter = ( bytes - base + step - 1 ) / step;
+    return octave * ClassesPerOctave + quarter; // quarter == 4 is the base of the next octave
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the bytes of the size class.
+ *  @param  index [in] index of the size class
+ *  @return number of bytes
+ */
+/*===========================================================================*/
+size_t ClassBytes( const size_t index )
+{
+    const size_t base = size_t(1) << ( index / ClassesPerOctave );
+    return base + ( index % ClassesPerOctave ) * ( base / ClassesPerOctave );
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+const size_t PoolAllocator::DefaultMinPooledBytes;
+const size_t PoolAllocator::DefaultMaxRetainedBytes;
+
+/*===========================================================================*/
+/**
+ *  @brief  Free lists and statistics of the pool.
+ */
+/*===========================================================================*/
+class PoolAllocator::Impl
+{
+public:
+    kvs::Mutex mutex{}; ///< mutex for the members
+    size_t max_retained_bytes = 0; ///< maximum bytes retained in the free lists
+    size_t min_pooled_bytes = 0; ///< minimum bytes of the pooled requests
+    kvs::ArrayAllocator* upstream = nullptr; ///< allocator of the buffers (NULL: aligned malloc)
+    std::vector<std::vector<void*>> free_lists{}; ///< released buffers of each size class
+    ArrayAllocator::Statistics stats{}; ///< statistics
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new PoolAllocator class.
+ *  @param  max_retained_bytes [in] maximum bytes retained for reuse
+ *  @param  min_pooled_bytes [in] minimum bytes of the requests served by the pool
+ *  @param  upstream [in] allocator of the buffers (NULL: aligned malloc)
+ */
+/*===========================================================================*/
+PoolAllocator::PoolAllocator(
+    const size_t max_retained_bytes,
+    const size_t min_pooled_bytes,
+    kvs::ArrayAllocator* upstream ):
+    m_impl( new Impl() )
+{
+    m_impl->max_retained_bytes = max_retained_bytes;
+    m_impl->min_pooled_bytes = std::max( min_pooled_bytes, PoolAlignment );
+    m_impl->upstream = upstream;
+    m_impl->free_lists.resize( ::NumberOfClasses );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the PoolAllocator class.
+ */
+/*===========================================================================*/
+PoolAllocator::~PoolAllocator()
+{
+    this->trim();
+    delete m_impl;
+}
+
+size_t PoolAllocator::maxRetainedBytes() const
+{
+    kvs::MutexLocker locker( &m_impl->mutex );
+    return m_impl->max_retained_bytes;
+}
+
+size_t PoolAllocator::minPooledBytes() const
+{
+    return m_impl->min_pooled_bytes;
+}
+
+kvs::ArrayAllocator* PoolAllocator::upstream() const
+{
+    return m_impl->upstream;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the maximum retained bytes and releases the excess buffers.
+ *  @param  bytes [in] maximum bytes retained for reuse
+ */
+/*===========================================================================*/
+void PoolAllocator::setMaxRetainedBytes( const size_t bytes )
+{
+    std::vector<std::pair<void*,size_t>> excess;
+    {
+        kvs::MutexLocker locker( &m_impl->mutex );
+        m_impl->max_retained_bytes = bytes;
+
+        // The largest buffers are released first.
+        for ( size_t index = ::NumberOfClasses; index-- > 0 && m_impl->stats.retained_bytes > bytes; )
+        {
+            auto& list = m_impl->free_lists[ index ];
+            while ( !list.empty() && m_impl->stats.retained_bytes > bytes )
+            {
+                excess.push_back( std::make_pair( list.back(), ::ClassBytes( index ) ) );
+                m_impl->stats.retained_bytes -= ::ClassBytes( index );
+                list.pop_back();
+            }
+        }
+    }
+
+    for ( const auto& buffer : excess ) { this->deallocate_upstream( buffer.first, buffer.second ); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocates the memory.
+ *  @param  bytes [in] number of bytes
+ *  @param  alignment [in] alignment
+ *  @return pointer to the memory (NULL if failed)
+ */
+/*===========================================================================*/
+void* PoolAllocator::allocate( const size_t bytes, const size_t alignment )
+{
+    if ( bytes < m_impl->min_pooled_bytes )
+    {
+        void* pointer = this->allocate_upstream( bytes, alignment );
+        if ( pointer )
+        {
+            kvs::MutexLocker locker( &m_impl->mutex );
+            ArrayAllocator::Statistics& stats = m_impl->stats;
+            stats.nallocations++;
+            stats.live_bytes += bytes;
+            stats.peak_bytes = std::max( stats.peak_bytes, stats.live_bytes );
+        }
+        return pointer;
+    }
+
+    const size_t index = ::ClassIndex( bytes );
+    const size_t class_bytes = ::ClassBytes( index );
+    {
+        kvs::MutexLocker locker( &m_impl->mutex );
+        ArrayAllocator::Statistics& stats = m_impl->stats;
+        auto& list = m_impl->free_lists[ index ];
+        if ( !list.empty() && reinterpret_cast<std::uintptr_t>( list.back() ) % alignment == 0 )
+        {
+            void* pointer = list.back();
+            list.pop_back();
+            stats.nallocations++;
+            stats.nhits++;
+            stats.retained_bytes -= class_bytes;
+            stats.live_bytes += class_bytes;
+            stats.peak_bytes = std::max( stats.peak_bytes, stats.live_bytes );
+            return pointer;
+        }
+    }
+
+    void* pointer = this->allocate_upstream( class_bytes, std::max( alignment, PoolAlignment ) );
+    if ( !pointer )
+    {
+        // Returns the retained buffers to the system and tries again.
+        this->trim();
+        pointer = this->allocate_upstream( class_bytes, std::max( alignment, PoolAlignment ) );
+        if ( !pointer ) { return nullptr; }
+    }
+
+    kvs::MutexLocker locker( &m_impl->mutex );
+    ArrayAllocator::Statistics& stats = m_impl->stats;
+    stats.nallocations++;
+    stats.live_bytes += class_bytes;
+    stats.peak_bytes = std::max( stats.peak_bytes, stats.live_bytes );
+    return pointer;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases the memory to the pool.
+ *  @param  pointer [in] pointer to the memory returned by allocate()
+ *  @param  bytes [in] number of bytes passed to allocate()
+ */
+/*===========================================================================*/
+void PoolAllocator::deallocate( void* pointer, const size_t bytes )
+{
+    if ( !pointer ) { return; }
+
+    if ( bytes < m_impl->min_pooled_bytes )
+    {
+        {
+            kvs::MutexLocker locker( &m_impl->mutex );
+            m_impl->stats.live_bytes -= bytes;
+        }
+        this->deallocate_upstream( pointer, bytes );
+        return;
+    }
+
+    const size_t index = ::ClassIndex( bytes );
+    const size_t class_bytes = ::ClassBytes( index );
+    {
+        kvs::MutexLocker locker( &m_impl->mutex );
+        ArrayAllocator::Statistics& stats = m_impl->stats;
+        stats.live_bytes -= class_bytes;
+        if ( stats.retained_bytes + class_bytes <= m_impl->max_retained_bytes )
+        {
+            m_impl->free_lists[ index ].push_back( pointer );
+            stats.retained_bytes += class_bytes;
+            return;
+        }
+    }
+
+    this->deallocate_upstream( pointer, class_bytes );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the statistics of the allocator.
+ *  @return statistics
+ */
+/*===========================================================================*/
+ArrayAllocator::Statistics PoolAllocator::statistics() const
+{
+    kvs::MutexLocker locker( &m_impl->mutex );
+    return m_impl->stats;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases all the retained buffers.
+ */
+/*===========================================================================*/
+void PoolAllocator::trim()
+{
+    std::vector<std::pair<void*,size_t>> retained;
+    {
+        kvs::MutexLocker locker( &m_impl->mutex );
+        for ( size_t index = 0; index < ::NumberOfClasses; index++ )
+        {
+            for ( void* pointer : m_impl->free_lists[ index ] )
+            {
+                retained.push_back( std::make_pair( pointer, ::ClassBytes( index ) ) );
+            }
+            m_impl->free_lists[ index ].clear();
+        }
+        m_impl->stats.retained_bytes = 0;
+    }
+
+    for ( const auto& buffer : retained ) { this->deallocate_upstream( buffer.first, buffer.second ); }
+}
+
+void* PoolAllocator::allocate_upstream( const size_t bytes, const size_t alignment )
+{
+    if ( m_impl->upstream ) { return m_impl->upstream->allocate( bytes, alignment ); }
+    return ArrayAllocator::AlignedAllocate( bytes, alignment );
+}
+
+void PoolAllocator::deallocate_upstream( void* pointer, const size_t bytes )
+{
+    if ( m_impl->upstream ) { m_impl->upstream->deallocate( pointer, bytes ); }
+    else { ArrayAllocator::AlignedFree( pointer ); }
+}
+
+} // end of namespace kvs
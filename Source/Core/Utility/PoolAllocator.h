@@ -0,0 +1,59 @@
+/*****************************************************************************/
+/**
+ *  @file   PoolAllocator.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/ArrayAllocator>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Size-class pool allocator for the large arrays.
+ *
+ *  The requests not less than the minimum pooled size are rounded up to the
+ *  size classes (four classes per power of two, so that the rounding wastes
+ *  at most 25%), and the released buffers are kept on the free list of the
+ *  class for the next request of the same class, instead of being returned
+ *  to the system (and page-faulted again). The retained bytes are capped,
+ *  and the smaller requests are passed to the upstream allocator directly.
+ */
+/*===========================================================================*/
+class PoolAllocator : public kvs::ArrayAllocator
+{
+public:
+    static const size_t DefaultMinPooledBytes = 64 * 1024;
+    static const size_t DefaultMaxRetainedBytes = size_t(1) << 30;
+
+private:
+    class Impl;
+    Impl* m_impl; ///< free lists and statistics
+
+public:
+    PoolAllocator(
+        const size_t max_retained_bytes = DefaultMaxRetainedBytes,
+        const size_t min_pooled_bytes = DefaultMinPooledBytes,
+        kvs::ArrayAllocator* upstream = nullptr );
+    virtual ~PoolAllocator();
+
+    size_t maxRetainedBytes() const;
+    size_t minPooledBytes() const;
+    kvs::ArrayAllocator* upstream() const;
+    void setMaxRetainedBytes( const size_t bytes );
+
+    const char* name() const { return "kvs::PoolAllocator"; }
+    void* allocate( const size_t bytes, const size_t alignment = DefaultAlignment );
+    void deallocate( void* pointer, const size_t bytes );
+    Statistics statistics() const;
+    void trim();
+
+private:
+    void* allocate_upstream( const size_t bytes, const size_t alignment );
+    void deallocate_upstream( void* pointer, const size_t bytes );
+};
+
+} // end of namespace kvs
@@ -0,0 +1,386 @@
+/*****************************************************************************/
+/**
+ *  @file   Profiler.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Profiler.h"
+#include <kvs/MutexLocker>
+#include <kvs/Message>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the quoted and escaped JSON string.
+ *  @param  s [in] string
+ *  @return JSON string
+ */
+/*===========================================================================*/
+std::string Quote( const char* s )
+{
+    std::string result = "\"";
+    for ( ; s && *s; ++s )
+    {
+        if ( *s == '"' || *s == '\\' ) { result += '\\'; }
+        result += *s;
+    }
+    return result + "\"";
+}
+
+}
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Event buffer of a thread.
+ *
+ *  The buffer is a list of fixed-size chunks, which are never moved. Only
+ *  the owner thread appends the events, and publishes them by the release
+ *  store of the chunk size, so that the other threads can read the events
+ *  recorded so far without locking.
+ */
+/*===========================================================================*/
+class Profiler::ThreadBuffer
+{
+private:
+    static const size_t ChunkSize = 4096;
+
+    struct Chunk
+    {
+        Event events[ ChunkSize ]; ///< events
+        std::atomic<size_t> size{ 0 }; ///< number of published events
+        std::atomic<Chunk*> next{ nullptr }; ///< next chunk
+    };
+
+    Chunk* m_head; ///< first chunk
+    Chunk* m_tail; ///< last chunk (accessed by the owner thread only)
+    std::atomic<size_t> m_ndiscarded{ 0 }; ///< number of events discarded by clear()
+
+public:
+    ThreadBuffer(): m_head( new Chunk() ), m_tail( m_head ) {}
+
+    ~ThreadBuffer()
+    {
+        Chunk* chunk = m_head;
+        while ( chunk )
+        {
+            Chunk* next = chunk->next.load( std::memory_order_relaxed );
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+    void push( const Event& event )
+    {
+        size_t size = m_tail->size.load( std::memory_order_relaxed );
+        if ( size == ChunkSize )
+        {
+            Chunk* chunk = new Chunk();
+            m_tail->next.store( chunk, std::memory_order_release );
+            m_tail = chunk;
+            size = 0;
+        }
+        m_tail->events[ size ] = event;
+        m_tail->size.store( size + 1, std::memory_order_release );
+    }
+
+    size_t size() const
+    {
+        size_t n = 0;
+        for ( const Chunk* c = m_head; c; c = c->next.load( std::memory_order_acquire ) )
+        {
+            n += c->size.load( std::memory_order_acquire );
+        }
+        return n - std::min( n, m_ndiscarded.load( std::memory_order_relaxed ) );
+    }
+
+    std::vector<Event> events() const
+    {
+        std::vector<Event> result;
+        size_t skip = m_ndiscarded.load( std::memory_order_relaxed );
+        for ( const Chunk* c = m_head; c; c = c->next.load( std::memory_order_acquire ) )
+        {
+            const size_t size = c->size.load( std::memory_order_acquire );
+            const size_t first = std::min( skip, size );
+            result.insert( result.end(), c->events + first, c->events + size );
+            skip -= first;
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        // The chunks are kept, since the owner thread may be appending to them.
+        size_t n = 0;
+        for ( const Chunk* c = m_head; c; c = c->next.load( std::memory_order_acquire ) )
+        {
+            n += c->size.load( std::memory_order_acquire );
+        }
+        m_ndiscarded.store( n, std::memory_order_relaxed );
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the profiler instance.
+ *  @return profiler
+ */
+/*===========================================================================*/
+Profiler& Profiler::Instance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Profiler class. The zones are recorded by default.
+ */
+/*===========================================================================*/
+Profiler::Profiler():
+    m_epoch( kvs::GetStamp() ),
+    m_enabled( true )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Profiler class.
+ */
+/*===========================================================================*/
+Profiler::~Profiler()
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Records the zone on the event buffer of the calling thread.
+ *  @param  category [in] category name (static storage)
+ *  @param  name [in] zone name (static storage)
+ *  @param  begin [in] begin time in usec
+ *  @param  end [in] end time in usec
+ */
+/*===========================================================================*/
+void Profiler::record( const char* category, const char* name, const double begin, const double end )
+{
+    const Event event = { category, name, begin, end };
+    this->thread_buffer()->push( event );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Discards the recorded events.
+ */
+/*===========================================================================*/
+void Profiler::clear()
+{
+    kvs::MutexLocker locker( &m_mutex );
+    for ( auto& buffer : m_buffers ) { buffer->clear(); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the events recorded on the thread.
+ *  @param  thread_index [in] index of the thread in the order of the first zone
+ *  @return events in the order of the end time
+ */
+/*===========================================================================*/
+std::vector<Profiler::Event> Profiler::events( const size_t thread_index ) const
+{
+    kvs::MutexLocker locker( &m_mutex );
+    if ( thread_index >= m_buffers.size() ) { return std::vector<Event>(); }
+    return m_buffers[ thread_index ]->events();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of threads that have recorded the zones.
+ *  @return number of threads
+ */
+/*===========================================================================*/
+size_t Profiler::numberOfThreads() const
+{
+    kvs::MutexLocker locker( &m_mutex );
+    return m_buffers.size();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of recorded events of all the threads.
+ *  @return number of events
+ */
+/*===========================================================================*/
+size_t Profiler::numberOfEvents() const
+{
+    kvs::MutexLocker locker( &m_mutex );
+    size_t n = 0;
+    for ( const auto& buffer : m_buffers ) { n += buffer->size(); }
+    return n;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the stamp timers of the zones.
+ *  @return stamp timer list with one stamp timer (in msec) per zone name
+ */
+/*===========================================================================*/
+kvs::StampTimerList Profiler::stampTimerList() const
+{
+    std::vector<kvs::StampTimer> timers;
+    std::map<std::string,size_t> indices;
+    const size_t nthreads = this->numberOfThreads();
+    for ( size_t i = 0; i < nthreads; i++ )
+    {
+        for ( const auto& e : this->events( i ) )
+        {
+            auto index = indices.find( e.name );
+            if ( index == indices.end() )
+            {
+                index = indices.insert( std::make_pair( std::string( e.name ), timers.size() ) ).first;
+                timers.push_back( kvs::StampTimer( e.name ) );
+                timers.back().setUnitToMSec();
+            }
+            timers[ index->second ].stamp( kvs::StampTimer::Time( ( e.end - e.begin ) * 0.001 ) );
+        }
+    }
+
+    kvs::StampTimerList list;
+    for ( const auto& timer : timers ) { list.push( timer ); }
+    return list;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the summary of the zones sorted by the total time.
+ *  @param  os [in] output stream
+ *  @param  indent [in] indent
+ */
+/*===========================================================================*/
+void Profiler::print( std::ostream& os, const kvs::Indent& indent ) const
+{
+    struct Summary
+    {
+        std::string category;
+        std::string name;
+        size_t count = 0;
+        double total = 0.0;
+        double max = 0.0;
+    };
+
+    std::map<std::string,Summary> summaries;
+    const size_t nthreads = this->numberOfThreads();
+    for ( size_t i = 0; i < nthreads; i++ )
+    {
+        for ( const auto& e : this->events( i ) )
+        {
+            Summary& s = summaries[ std::string( e.category ) + "/" + e.name ];
+            const double time = ( e.end - e.begin ) * 0.001;
+            s.category = e.category;
+            s.name = e.name;
+            s.count++;
+            s.total += time;
+            s.max = std::max( s.max, time );
+        }
+    }
+
+    std::vector<Summary> sorted;
+    for ( const auto& s : summaries ) { sorted.push_back( s.second ); }
+    std::sort( sorted.begin(), sorted.end(),
+               [] ( const Summary& a, const Summary& b ) { return a.total > b.total; } );
+
+    os << indent << "Number of threads : " << nthreads << std::endl;
+    for ( const auto& s : sorted )
+    {
+        os << indent << s.name << " (" << s.category << ")" << std::endl;
+        os << indent.nextIndent() << "Count : " << s.count << std::endl;
+        os << indent.nextIndent() << "Total : " << s.total << " [msec]" << std::endl;
+        os << indent.nextIndent() << "Average : " << s.total / s.count << " [msec]" << std::endl;
+        os << indent.nextIndent() << "Max : " << s.max << " [msec]" << std::endl;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the zones in the Chrome trace event format (JSON).
+ *  @param  os [in] output stream
+ */
+/*===========================================================================*/
+void Profiler::write( std::ostream& os ) const
+{
+    os << std::fixed << std::setprecision( 3 );
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    const size_t nthreads = this->numberOfThreads();
+    for ( size_t i = 0; i < nthreads; i++ )
+    {
+        os << ( first ? "" : "," ) << std::endl;
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i
+           << ",\"args\":{\"name\":\"thread " << i << "\"}}";
+        first = false;
+
+        // The complete events ("X") are nested by the viewer from the times.
+        for ( const auto& e : this->events( i ) )
+        {
+            os << "," << std::endl;
+            os << "{\"name\":" << ::Quote( e.name )
+               << ",\"cat\":" << ::Quote( e.category )
+               << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << i
+               << ",\"ts\":" << e.begin
+               << ",\"dur\":" << e.end - e.begin << "}";
+        }
+    }
+
+    os << std::endl << "]}" << std::endl;
+    os << std::defaultfloat;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the zones in the Chrome trace event format to the file.
+ *  @param  filename [in] output filename (e.g. trace.json)
+ *  @return true if the file has been written
+ */
+/*===========================================================================*/
+bool Profiler::write( const std::string& filename ) const
+{
+    std::ofstream ofs( filename.c_str() );
+    if ( !ofs.is_open() )
+    {
+        kvsMessageError() << "Cannot open " << filename << "." << std::endl;
+        return false;
+    }
+
+    this->write( ofs );
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the event buffer of the calling thread.
+ *  @return event buffer (registered on the first call on the thread)
+ */
+/*===========================================================================*/
+Profiler::ThreadBuffer* Profiler::thread_buffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if ( !buffer )
+    {
+        kvs::MutexLocker locker( &m_mutex );
+        m_buffers.emplace_back( new ThreadBuffer() );
+        buffer = m_buffers.back().get();
+    }
+    return buffer;
+}
+
+} // end of namespace kvs
@@ -0,0 +1,141 @@
+/*****************************************************************************/
+/**
+ *  @file   Profiler.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/Timer>
+#include <kvs/StampTimerList>
+#include <kvs/Indent>
+#include <kvs/Mutex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <iostream>
+
+
+/*===========================================================================*/
+/**
+ *  @def    KVS_PROFILER_ZONE( category, name )
+ *  @brief  Records the enclosing scope as a zone of the profiler.
+ *
+ *  The category and the name must point to strings with static storage
+ *  duration (string literals or kvs module names). The zones are compiled
+ *  in only when KVS_ENABLE_PROFILER is defined (KVS_ENABLE_PROFILER = 1 in
+ *  kvs.conf); otherwise the macro expands to nothing.
+ */
+/*===========================================================================*/
+#define KVS_PROFILER_CONCAT_( a, b ) a##b
+#define KVS_PROFILER_CONCAT( a, b ) KVS_PROFILER_CONCAT_( a, b )
+#if defined( __COUNTER__ )
+#define KVS_PROFILER_UNIQUE_NAME KVS_PROFILER_CONCAT( kvs_profiler_zone_, __COUNTER__ )
+#else
+#define KVS_PROFILER_UNIQUE_NAME KVS_PROFILER_CONCAT( kvs_profiler_zone_, __LINE__ )
+#endif
+
+#if defined( KVS_ENABLE_PROFILER )
+#define KVS_PROFILER_ZONE( category, name ) \
+    kvs::Profiler::Zone KVS_PROFILER_UNIQUE_NAME( category, name )
+#else
+#define KVS_PROFILER_ZONE( category, name )
+#endif
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Scoped-zone profiler.
+ *
+ *  Each thread appends the zones to its own event buffer without locking
+ *  (only the first zone of a thread registers the buffer under the mutex).
+ *  The nested zones on a thread form the call hierarchy, which is shown by
+ *  the Chrome trace viewer (chrome://tracing or Perfetto) from the file
+ *  written by write(). The zones can also be exported as a stamp timer list
+ *  with one stamp timer per zone name.
+ */
+/*===========================================================================*/
+class Profiler
+{
+public:
+    struct Event
+    {
+        const char* category; ///< category name
+        const char* name; ///< zone name
+        double begin; ///< begin time in usec from the epoch of the profiler
+        double end; ///< end time in usec from the epoch of the profiler
+    };
+
+    class Zone;
+
+private:
+    class ThreadBuffer;
+
+    kvs::TimeStamp m_epoch; ///< epoch of the time stamps
+    std::atomic<bool> m_enabled; ///< flag for recording the zones
+    mutable kvs::Mutex m_mutex; ///< mutex for the thread buffer list
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers{}; ///< event buffers of the threads
+
+public:
+    static Profiler& Instance();
+
+    ~Profiler();
+    Profiler( const Profiler& ) = delete;
+    Profiler& operator =( const Profiler& ) = delete;
+
+    void setEnabled( const bool enabled = true ) { m_enabled.store( enabled, std::memory_order_relaxed ); }
+    void enable() { this->setEnabled( true ); }
+    void disable() { this->setEnabled( false ); }
+    bool isEnabled() const { return m_enabled.load( std::memory_order_relaxed ); }
+
+    double now() const { return kvs::TimeStampDiffInUSec( kvs::GetStamp(), m_epoch ); }
+    void record( const char* category, const char* name, const double begin, const double end );
+    void clear();
+
+    std::vector<Event> events( const size_t thread_index ) const;
+    size_t numberOfThreads() const;
+    size_t numberOfEvents() const;
+
+    kvs::StampTimerList stampTimerList() const;
+    void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
+    void write( std::ostream& os ) const;
+    bool write( const std::string& filename ) const;
+
+private:
+    Profiler();
+    ThreadBuffer* thread_buffer();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Zone class that records the lifetime of the object.
+ */
+/*===========================================================================*/
+class Profiler::Zone
+{
+private:
+    const char* m_category; ///< category name
+    const char* m_name; ///< zone name
+    double m_begin; ///< begin time (negative: not recorded)
+
+public:
+    Zone( const char* category, const char* name ):
+        m_category( category ),
+        m_name( name ),
+        m_begin( Profiler::Instance().isEnabled() ? Profiler::Instance().now() : -1.0 ) {}
+
+    ~Zone()
+    {
+        if ( m_begin < 0.0 ) { return; }
+        Profiler& profiler = Profiler::Instance();
+        profiler.record( m_category, m_name, m_begin, profiler.now() );
+    }
+
+    Zone( const Zone& ) = delete;
+    Zone& operator =( const Zone& ) = delete;
+};
+
+} // end of namespace kvs
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <fstream>
 #include <numeric>
+#include <algorithm>
 #include <array>
 
 
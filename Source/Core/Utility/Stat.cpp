@@ -0,0 +1,125 @@
+/*****************************************************************************/
+/**
+ *  @file   Stat.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Stat.h"
+#include <kvs/TaskScheduler>
+#include <kvs/FastFourierTransform>
+
+
+namespace
+{
+
+kvs::TaskScheduler* ChunkScheduler = nullptr; ///< task scheduler for the chunks (nullptr: serial)
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+namespace Stat
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the task scheduler to reduce the chunks of the large arrays.
+ *
+ *  Sum, Mean, Var, VarP, StdDev, StdDevP, Cov and CovP are computed serially
+ *  unless a scheduler is set. The results do not depend on the scheduler.
+ *
+ *  @param  scheduler [in] pointer to the task scheduler (nullptr: serial)
+ */
+/*===========================================================================*/
+void SetScheduler( kvs::TaskScheduler* scheduler )
+{
+    ::ChunkScheduler = scheduler;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the task scheduler to reduce the chunks of the large arrays.
+ *  @return pointer to the task scheduler (nullptr: serial)
+ */
+/*===========================================================================*/
+kvs::TaskScheduler* Scheduler()
+{
+    return ::ChunkScheduler;
+}
+
+namespace detail
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Calls the function for each chunk on the task scheduler if it is set.
+ *  @param  nchunks [in] number of chunks
+ *  @param  function [in] function called as function( chunk_index )
+ */
+/*===========================================================================*/
+void ForEachChunk( const size_t nchunks, const std::function<void(size_t)>& function )
+{
+    if ( !::ChunkScheduler )
+    {
+        for ( size_t i = 0; i < nchunks; i++ ) { function( i ); }
+        return;
+    }
+
+    ::ChunkScheduler->parallelFor( 0, nchunks, [&] ( const size_t begin, const size_t end )
+    {
+        for ( size_t i = begin; i < end; i++ ) { function( i ); }
+    }, 1 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns array of correlation for all the lags from the centered values.
+ *  @param  x [in] values 1 centered by the mean a
+ *  @param  y [in] values 2 centered by the mean b
+ *  @param  a [in] mean of the values 1
+ *  @param  b [in] mean of the values 2
+ *  @return array of correlation
+ */
+/*===========================================================================*/
+std::vector<double> CenteredCorrs(
+    const std::vector<double>& x,
+    const std::vector<double>& y,
+    const double a,
+    const double b )
+{
+    // s12[k] = sum_{i=k}^{n-1} x[i] * y[i-k]
+    const std::vector<double> s12 = kvs::FastFourierTransform::Correlate( x, y );
+
+    // For the lag k, the overlap is x[k..n-1] and y[0..n-k-1] (m = n - k
+    // elements). The sums of the original values are the centered sums plus
+    // the terms of the means, e.g. sum1 = s1 + m * a, and the terms that do
+    // not cancel out in Corr() are multiplied by r = 1 - m / n.
+    const size_t n = x.size();
+    std::vector<double> corrs( n );
+    double s1 = 0.0, s11 = 0.0;
+    double s2 = 0.0, s22 = 0.0;
+    for ( size_t k = n; k-- > 0; )
+    {
+        s1 += x[k];
+        s11 += x[k] * x[k];
+        s2 += y[n-1-k];
+        s22 += y[n-1-k] * y[n-1-k];
+
+        const double m = static_cast<double>( n - k );
+        const double r = 1.0 - m / n;
+        const double var1 = s11 - s1 * s1 / n + r * ( 2.0 * a * s1 + m * a * a );
+        const double var2 = s22 - s2 * s2 / n + r * ( 2.0 * b * s2 + m * b * b );
+        const double cov = s12[k] - s1 * s2 / n + r * ( a * s2 + b * s1 + m * a * b );
+        corrs[k] = cov / std::sqrt( var1 * var2 );
+    }
+
+    return corrs;
+}
+
+} // end of namespace detail
+
+} // end of namespace Stat
+
+} // end of namespace kvs
@@ -7,22 +7,464 @@
 #pragma once
 #include <cmath>
 #include <numeric>
+#include <vector>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <type_traits>
 #include <kvs/Assert>
 #include <kvs/ValueArray>
 #include <kvs/ValueTable>
 #include <kvs/Math>
 #include <kvs/Value>
+#include <kvs/Type>
 
 
 namespace kvs
 {
 
+class AnyValueArray;
+class TaskScheduler;
+
 namespace Stat
 {
 
+void SetScheduler( kvs::TaskScheduler* scheduler );
+kvs::TaskScheduler* Scheduler();
+
+/*===========================================================================*/
+/**
+ *  @brief  Strided view of the elements of an array.
+ *
+ *  The view refers to the elements of a kvs::ValueArray or a column of
+ *  kvs::AnyValueTable without copying, e.g. a component of the interleaved
+ *  vectors can be viewed as StridedView<float>( column, component, veclen ).
+ *  The viewed array must outlive the view.
+ */
+/*===========================================================================*/
+template <typename T>
+class StridedView
+{
+private:
+    const T* m_data = nullptr; ///< pointer to the first element
+    size_t m_size = 0; ///< number of elements
+    size_t m_stride = 1; ///< distance between the elements
+
+public:
+    StridedView() = default;
+
+    StridedView( const T* data, const size_t size, const size_t stride = 1 ):
+        m_data( data ),
+        m_size( size ),
+        m_stride( stride )
+    {
+        KVS_ASSERT( stride > 0 );
+    }
+
+    StridedView( const kvs::ValueArray<T>& values ):
+        m_data( values.data() ),
+        m_size( values.size() ),
+        m_stride( 1 ) {}
+
+    // The column type is a template parameter so that kvs::AnyValueArray is
+    // required only where the constructor is used.
+    template <typename Column, typename = typename std::enable_if<std::is_same<Column,kvs::AnyValueArray>::value>::type>
+    StridedView( const Column& column, const size_t offset = 0, const size_t stride = 1 ):
+        m_data( static_cast<const T*>( column.data() ) + offset ),
+        m_size( offset < column.size() ? ( column.size() - offset + stride - 1 ) / stride : 0 ),
+        m_stride( stride )
+    {
+        KVS_ASSERT( column.typeID() == kvs::Type::GetID<T>() );
+        KVS_ASSERT( stride > 0 );
+    }
+
+    const T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    size_t stride() const { return m_stride; }
+    bool empty() const { return m_size == 0; }
+    const T& operator []( const size_t index ) const { return m_data[ index * m_stride ]; }
+};
+
+namespace detail
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Floating point type for the moments (at least double).
+ */
+/*===========================================================================*/
+template <typename T>
+using Real = typename std::conditional<std::is_same<T,long double>::value, long double, double>::type;
+
+// The arrays are reduced by the chunks of the constant size, so that the
+// results do not depend on the number of threads. Each chunk is accumulated
+// by the independent lanes to shorten the dependency chains of the sums.
+const size_t ChunkSize = 16384; ///< number of elements reduced by a task
+const size_t Lanes = 8; ///< number of the independent accumulators
+const size_t DirectCorrelationSize = 32; ///< array size below which the correlations are computed directly
+
+using UnitStride = std::integral_constant<size_t,1>;
+
+/*===========================================================================*/
+/**
+ *  @brief  Neumaier's compensated summation.
+ */
+/*===========================================================================*/
+template <typename R>
+struct CompensatedSum
+{
+    R sum = R(0); ///< running sum
+    R compensation = R(0); ///< accumulated roundoff error of the sum
+
+    void add( const R x )
+    {
+        const R t = sum + x;
+        compensation += std::abs( sum ) >= std::abs( x ) ? ( sum - t ) + x : ( x - t ) + sum;
+        sum = t;
+    }
+
+    void add( const CompensatedSum& other )
+    {
+        this->add( other.sum );
+        compensation += other.compensation;
+    }
+
+    R value() const { return sum + compensation; }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Number of samples, mean and sum of squared deviations.
+ */
+/*===========================================================================*/
+template <typename R>
+struct Moments
+{
+    size_t count = 0; ///< number of samples
+    R mean = R(0); ///< mean
+    R m2 = R(0); ///< sum of squared deviations from the mean
+
+    // Chan's pairwise update.
+    void add( const Moments& other )
+    {
+        if ( other.count == 0 ) { return; }
+        if ( count == 0 ) { *this = other; return; }
+        const size_t n = count + other.count;
+        const R delta = other.mean - mean;
+        const R weight = R( count ) * R( other.count ) / R( n );
+        mean += delta * R( other.count ) / R( n );
+        m2 += other.m2 + delta * delta * weight;
+        count = n;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Number of samples, means and sum of products of deviations.
+ */
+/*===========================================================================*/
+template <typename R>
+struct CoMoments
+{
+    size_t count = 0; ///< number of samples
+    R mean1 = R(0); ///< mean of the values 1
+    R mean2 = R(0); ///< mean of the values 2
+    R c2 = R(0); ///< sum of products of deviations from the means
+
+    void add( const CoMoments& other )
+    {
+        if ( other.count == 0 ) { return; }
+        if ( count == 0 ) { *this = other; return; }
+        const size_t n = count + other.count;
+        const R delta1 = other.mean1 - mean1;
+        const R delta2 = other.mean2 - mean2;
+        const R weight = R( count ) * R( other.count ) / R( n );
+        mean1 += delta1 * R( other.count ) / R( n );
+        mean2 += delta2 * R( other.count ) / R( n );
+        c2 += other.c2 + delta1 * delta2 * weight;
+        count = n;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns compensated sum of the elements p[0], p[stride], ...
+ *  @param  p [in] pointer to the first element
+ *  @param  stride [in] stride (UnitStride for the contiguous elements)
+ *  @param  n [in] number of elements
+ *  @return compensated sum
+ */
+/*===========================================================================*/
+template <typename R, typename T, typename Stride>
+inline CompensatedSum<R> SumKernel( const T* p, const Stride stride, const size_t n )
+{
+    R s[ Lanes ] = {};
+    R c[ Lanes ] = {};
+    size_t i = 0;
+    for ( ; i + Lanes <= n; i += Lanes )
+    {
+        for ( size_t l = 0; l < Lanes; l++ )
+        {
+            const R x = static_cast<R>( p[ ( i + l ) * stride ] );
+            const R t = s[l] + x;
+            c[l] += std::abs( s[l] ) >= std::abs( x ) ? ( s[l] - t ) + x : ( x - t ) + s[l];
+            s[l] = t;
+        }
+    }
+
+    CompensatedSum<R> sum;
+    for ( size_t l = 0; l < Lanes; l++ ) { sum.add( s[l] ); sum.compensation += c[l]; }
+    for ( ; i < n; i++ ) { sum.add( static_cast<R>( p[ i * stride ] ) ); }
+    return sum;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns moments of the elements p[0], p[stride], ...
+ *
+ *  The mean is computed by the compensated sum, and the squared deviations
+ *  are corrected by the sum of the deviations (compensated two-pass).
+ *
+ *  @param  p [in] pointer to the first element
+ *  @param  stride [in] stride (UnitStride for the contiguous elements)
+ *  @param  n [in] number of elements
+ *  @return moments
+ */
+/*===========================================================================*/
+template <typename R, typename T, typename Stride>
+inline Moments<R> MomentsKernel( const T* p, const Stride stride, const size_t n )
+{
+    Moments<R> moments;
+    if ( n == 0 ) { return moments; }
+
+    const R mean = SumKernel<R>( p, stride, n ).value() / R( n );
+    R d[ Lanes ] = {};
+    R d2[ Lanes ] = {};
+    size_t i = 0;
+    for ( ; i + Lanes <= n; i += Lanes )
+    {
+        for ( size_t l = 0; l < Lanes; l++ )
+        {
+            const R delta = static_cast<R>( p[ ( i + l ) * stride ] ) - mean;
+            d[l] += delta;
+            d2[l] += delta * delta;
+        }
+    }
+
+    R sum = R(0), sum2 = R(0);
+    for ( size_t l = 0; l < Lanes; l++ ) { sum += d[l]; sum2 += d2[l]; }
+    for ( ; i < n; i++ )
+    {
+        const R delta = static_cast<R>( p[ i * stride ] ) - mean;
+        sum += delta;
+        sum2 += delta * delta;
+    }
+
+    moments.count = n;
+    moments.mean = mean + sum / R( n );
+    moments.m2 = sum2 - sum * sum / R( n );
+    return moments;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns co-moments of the elements p1[0], p1[stride1], ... and p2[0], p2[stride2], ...
+ *  @param  p1 [in] pointer to the first element 1
+ *  @param  stride1 [in] stride 1
+ *  @param  p2 [in] pointer to the first element 2
+ *  @param  stride2 [in] stride 2
+ *  @param  n [in] number of elements
+ *  @return co-moments
+ */
+/*===========================================================================*/
+template <typename R, typename T, typename Stride>
+inline CoMoments<R> CoMomentsKernel( const T* p1, const Stride stride1, const T* p2, const Stride stride2, const size_t n )
+{
+    CoMoments<R> moments;
+    if ( n == 0 ) { return moments; }
+
+    const R mean1 = SumKernel<R>( p1, stride1, n ).value() / R( n );
+    const R mean2 = SumKernel<R>( p2, stride2, n ).value() / R( n );
+    R d1[ Lanes ] = {};
+    R d2[ Lanes ] = {};
+    R d12[ Lanes ] = {};
+    size_t i = 0;
+    for ( ; i + Lanes <= n; i += Lanes )
+    {
+        for ( size_t l = 0; l < Lanes; l++ )
+        {
+            const R delta1 = static_cast<R>( p1[ ( i + l ) * stride1 ] ) - mean1;
+            const R delta2 = static_cast<R>( p2[ ( i + l ) * stride2 ] ) - mean2;
+            d1[l] += delta1;
+            d2[l] += delta2;
+            d12[l] += delta1 * delta2;
+        }
+    }
+
+    R sum1 = R(0), sum2 = R(0), sum12 = R(0);
+    for ( size_t l = 0; l < Lanes; l++ ) { sum1 += d1[l]; sum2 += d2[l]; sum12 += d12[l]; }
+    for ( ; i < n; i++ )
+    {
+        const R delta1 = static_cast<R>( p1[ i * stride1 ] ) - mean1;
+        const R delta2 = static_cast<R>( p2[ i * stride2 ] ) - mean2;
+        sum1 += delta1;
+        sum2 += delta2;
+        sum12 += delta1 * delta2;
+    }
+
+    moments.count = n;
+    moments.mean1 = mean1 + sum1 / R( n );
+    moments.mean2 = mean2 + sum2 / R( n );
+    moments.c2 = sum12 - sum1 * sum2 / R( n );
+    return moments;
+}
+
+void ForEachChunk( const size_t nchunks, const std::function<void(size_t)>& function );
+
+/*===========================================================================*/
+/**
+ *  @brief  Reduces the chunks of [0,n) in the order of the chunks.
+ *
+ *  The chunks are processed in parallel only if a task scheduler is given
+ *  by SetScheduler().
+ *
+ *  @param  n [in] number of elements
+ *  @param  function [in] function called as function( begin, end ) for a chunk
+ *  @param  reduction [in] function called as reduction( result, partial_result )
+ *  @return reduced result
+ */
+/*===========================================================================*/
+template <typename P, typename Function, typename Reduction>
+inline P Reduce( const size_t n, Function function, Reduction reduction )
+{
+    if ( n <= ChunkSize ) { return function( size_t(0), n ); }
+
+    const size_t nchunks = ( n + ChunkSize - 1 ) / ChunkSize;
+    std::deque<P> partials( nchunks ); // not std::vector because of vector<bool>
+    ForEachChunk( nchunks, [&] ( const size_t i )
+    {
+        const size_t begin = i * ChunkSize;
+        partials[i] = function( begin, std::min( begin + ChunkSize, n ) );
+    } );
+
+    P result = partials[0];
+    for ( size_t i = 1; i < nchunks; i++ ) { result = reduction( result, partials[i] ); }
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns sum of the floating point values (compensated).
+ *  @param  values [in] values
+ *  @return sum
+ */
+/*===========================================================================*/
+template <typename T>
+inline T Sum( const StridedView<T>& values, std::true_type )
+{
+    using Partial = CompensatedSum<T>;
+    const Partial sum = Reduce<Partial>( values.size(),
+        [&] ( const size_t begin, const size_t end )
+        {
+            const T* p = values.data() + begin * values.stride();
+            return values.stride() == 1 ?
+                SumKernel<T>( p, UnitStride(), end - begin ) :
+                SumKernel<T>( p, values.stride(), end - begin );
+        },
+        [] ( Partial result, const Partial& partial ) { result.add( partial ); return result; } );
+    return sum.value();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns sum of the integer values (exact unless overflow).
+ *  @param  values [in] values
+ *  @return sum
+ */
+/*===========================================================================*/
+template <typename T>
+inline T Sum( const StridedView<T>& values, std::false_type )
+{
+    return Reduce<T>( values.size(),
+        [&] ( const size_t begin, const size_t end )
+        {
+            T sum = T(0);
+            for ( size_t i = begin; i < end; i++ ) { sum += values[i]; }
+            return sum;
+        },
+        [] ( const T result, const T partial ) { return T( result + partial ); } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns moments of the values.
+ *  @param  values [in] values
+ *  @return moments
+ */
+/*===========================================================================*/
+template <typename T>
+inline Moments<Real<T>> MomentsOf( const StridedView<T>& values )
+{
+    using Partial = Moments<Real<T>>;
+    return Reduce<Partial>( values.size(),
+        [&] ( const size_t begin, const size_t end )
+        {
+            const T* p = values.data() + begin * values.stride();
+            return values.stride() == 1 ?
+                MomentsKernel<Real<T>>( p, UnitStride(), end - begin ) :
+                MomentsKernel<Real<T>>( p, values.stride(), end - begin );
+        },
+        [] ( Partial result, const Partial& partial ) { result.add( partial ); return result; } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns co-moments of the values.
+ *  @param  values1 [in] values 1
+ *  @param  values2 [in] values 2
+ *  @return co-moments
+ */
+/*===========================================================================*/
+template <typename T>
+inline CoMoments<Real<T>> CoMomentsOf( const StridedView<T>& values1, const StridedView<T>& values2 )
+{
+    using Partial = CoMoments<Real<T>>;
+    return Reduce<Partial>( values1.size(),
+        [&] ( const size_t begin, const size_t end )
+        {
+            const size_t stride1 = values1.stride();
+            const size_t stride2 = values2.stride();
+            const T* p1 = values1.data() + begin * stride1;
+            const T* p2 = values2.data() + begin * stride2;
+            return stride1 == 1 && stride2 == 1 ?
+                CoMomentsKernel<Real<T>>( p1, UnitStride(), p2, UnitStride(), end - begin ) :
+                CoMomentsKernel<Real<T>>( p1, stride1, p2, stride2, end - begin );
+        },
+        [] ( Partial result, const Partial& partial ) { result.add( partial ); return result; } );
+}
+
+} // end of namespace detail
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns summation of elements of the given view.
+ *  @param  values [in] strided view
+ *  @return summation
+ */
+/*===========================================================================*/
+template <typename T>
+T Sum( const StridedView<T>& values )
+{
+    return detail::Sum( values, std::is_floating_point<T>() );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns summation of elements of the given array.
+ *
+ *  The array is summed up in parallel by the compensated (Neumaier) summation
+ *  for the floating point types.
+ *
  *  @param  values [in] array
  *  @return summation
  */
@@ -30,7 +472,21 @@ namespace Stat
 template <typename T>
 T Sum( const kvs::ValueArray<T>& values )
 {
-    return std::accumulate( values.begin(), values.end(), T(0) );
+    return Sum( StridedView<T>( values ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns mean value of elements of the given view.
+ *  @param  values [in] strided view
+ *  @return mean value
+ */
+/*===========================================================================*/
+template <typename T>
+T Mean( const StridedView<T>& values )
+{
+    KVS_ASSERT( values.size() != 0 );
+    return Sum( values ) / T( values.size() );
 }
 
 /*===========================================================================*/
@@ -43,8 +499,7 @@ T Sum( const kvs::ValueArray<T>& values )
 template <typename T>
 T Mean( const kvs::ValueArray<T>& values )
 {
-    KVS_ASSERT( values.size() != 0 );
-    return std::accumulate( values.begin(), values.end(), T(0) ) / values.size();
+    return Mean( StridedView<T>( values ) );
 }
 
 /*===========================================================================*/
@@ -92,9 +547,31 @@ public:
     }
 };
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns variance of the given view.
+ *  @param  values [in] strided view
+ *  @param  mean [in/out] mean value
+ *  @return variance
+ */
+/*===========================================================================*/
+template <typename T>
+T Var( const StridedView<T>& values, T* mean = nullptr )
+{
+    KVS_ASSERT( values.size() > 1 );
+
+    const auto moments = detail::MomentsOf( values );
+    if ( mean ) *mean = T( moments.mean );
+    return T( moments.m2 / ( moments.count - 1 ) );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns variance of the given array.
+ *
+ *  The chunks of the array are reduced in parallel by the compensated
+ *  two-pass algorithm and merged by Chan's pairwise update.
+ *
  *  @param  values [in] value array
  *  @param  mean [in/out] mean value
  *  @return variance
@@ -103,18 +580,24 @@ public:
 template <typename T>
 T Var( const kvs::ValueArray<T>& values, T* mean = nullptr )
 {
-    KVS_ASSERT( values.size() > 1 );
-
-    T sum = T(0), sum2 = T(0);
-    for ( const auto& value : values )
-    {
-        sum += value;
-        sum2 += value * value;
-    }
+    return Var( StridedView<T>( values ), mean );
+}
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns population variance of the given view.
+ *  @param  values [in] strided view
+ *  @param  mean [in/out] mean value
+ *  @return population variance
+ */
+/*===========================================================================*/
+template <typename T>
+T VarP( const StridedView<T>& values, T* mean = nullptr )
+{
+    KVS_ASSERT( values.size() != 0 );
     const auto n = values.size();
-    if ( mean ) *mean = sum / n;
-    return ( sum2 - ( sum * sum ) / n ) / ( n - 1 );
+    if ( n == 1 ) { if ( mean ) *mean = values[0]; return T(0); }
+    return Var( values, mean ) * ( n - 1 ) / n;
 }
 
 /*===========================================================================*/
@@ -333,9 +816,39 @@ T OnlineVarP( const kvs::ValueArray<T>& values, T* mean = nullptr )
     return OnlineVar( values, mean ) * ( n - 1 ) / n;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns covariance of the given views.
+ *  @param  values1 [in] strided view1
+ *  @param  values2 [in] strided view2
+ *  @param  mean1 [in/out] mean value1
+ *  @param  mean2 [in/out] mean value2
+ *  @return covariance
+ */
+/*===========================================================================*/
+template <typename T>
+T Cov(
+    const StridedView<T>& values1,
+    const StridedView<T>& values2,
+    T* mean1 = nullptr,
+    T* mean2 = nullptr )
+{
+    KVS_ASSERT( values1.size() > 1 );
+    KVS_ASSERT( values1.size() == values2.size() );
+
+    const auto moments = detail::CoMomentsOf( values1, values2 );
+    if ( mean1 ) { *mean1 = T( moments.mean1 ); }
+    if ( mean2 ) { *mean2 = T( moments.mean2 ); }
+    return T( moments.c2 / ( moments.count - 1 ) );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns covariance of the given arrays.
+ *
+ *  The chunks of the arrays are reduced in parallel by the compensated
+ *  two-pass algorithm and merged by Chan's pairwise update.
+ *
  *  @param  values1 [in] array1
  *  @param  values2 [in] array2
  *  @param  mean1 [in/out] mean value1
@@ -350,23 +863,30 @@ T Cov(
     T* mean1 = nullptr,
     T* mean2 = nullptr )
 {
-    KVS_ASSERT( values1.size() - 1 != 0 );
-    KVS_ASSERT( values1.size() == values2.size() );
+    return Cov( StridedView<T>( values1 ), StridedView<T>( values2 ), mean1, mean2 );
+}
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns population covariance of the given views.
+ *  @param  values1 [in] strided view1
+ *  @param  values2 [in] strided view2
+ *  @param  mean1 [in/out] mean value1
+ *  @param  mean2 [in/out] mean value2
+ *  @return population covariance
+ */
+/*===========================================================================*/
+template <typename T>
+T CovP(
+    const StridedView<T>& values1,
+    const StridedView<T>& values2,
+    T* mean1 = nullptr,
+    T* mean2 = nullptr )
+{
+    KVS_ASSERT( values1.size() != 0 );
+    KVS_ASSERT( values1.size() == values2.size() );
     const size_t n = values1.size();
-    T sum1 = T(0);
-    T sum2 = T(0);
-    T sum12 = T(0);
-    for ( size_t i = 0; i < n; i++ )
-    {
-        sum1 += values1[i];
-        sum2 += values2[i];
-        sum12 += values1[i] * values2[i];
-    }
-
-    if ( mean1 ) { *mean1 = sum1 / n; }
-    if ( mean2 ) { *mean2 = sum2 / n; }
-    return ( sum12 - ( sum1 * sum2 ) / n ) / ( n - 1 );
+    return ( n == 1 ) ? T(0) : Cov( values1, values2, mean1, mean2 ) * ( n - 1 ) / n;
 }
 
 /*===========================================================================*/
@@ -616,6 +1136,20 @@ T StdDev( const kvs::ValueArray<T>& values, T* mean = nullptr )
     return T( std::sqrt( Var( values, mean ) ) );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns standard deviation of the given view.
+ *  @param  values [in] strided view
+ *  @param  mean [in/out] mean value
+ *  @return standard deviation
+ */
+/*===========================================================================*/
+template <typename T>
+T StdDev( const StridedView<T>& values, T* mean = nullptr )
+{
+    return T( std::sqrt( Var( values, mean ) ) );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns standard deviation of the given array using population variance.
@@ -630,6 +1164,20 @@ T StdDevP( const kvs::ValueArray<T>& values, T* mean = nullptr )
     return T( std::sqrt( VarP( values, mean ) ) );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns standard deviation of the given view using population variance.
+ *  @param  values [in] strided view
+ *  @param  mean [in/out] mean value
+ *  @return standard deviation
+ */
+/*===========================================================================*/
+template <typename T>
+T StdDevP( const StridedView<T>& values, T* mean = nullptr )
+{
+    return T( std::sqrt( VarP( values, mean ) ) );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns standard deviation of the given array using the specified variance calculation function.
@@ -647,15 +1195,15 @@ T StdDev( const kvs::ValueArray<T>& values, F VarF, T* mean = nullptr )
 
 /*===========================================================================*/
 /**
- *  @brief  Returns correlation between the given arrays with a lag.
- *  @param  values1 [in] array 1
- *  @param  values2 [in] array 2
+ *  @brief  Returns correlation between the given views with a lag.
+ *  @param  values1 [in] strided view 1
+ *  @param  values2 [in] strided view 2
  *  @param  lag [in] lag
  *  @return correlation
  */
 /*===========================================================================*/
 template <typename T>
-T Corr( const kvs::ValueArray<T>& values1, const kvs::ValueArray<T>& values2, const size_t lag = 0 )
+T Corr( const StridedView<T>& values1, const StridedView<T>& values2, const size_t lag = 0 )
 {
     KVS_ASSERT( values1.size() != 0 );
     KVS_ASSERT( values1.size() > lag );
@@ -681,6 +1229,86 @@ T Corr( const kvs::ValueArray<T>& values1, const kvs::ValueArray<T>& values2, co
     return cov / std::sqrt( var1 * var2 );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns correlation between the given arrays with a lag.
+ *  @param  values1 [in] array 1
+ *  @param  values2 [in] array 2
+ *  @param  lag [in] lag
+ *  @return correlation
+ */
+/*===========================================================================*/
+template <typename T>
+T Corr( const kvs::ValueArray<T>& values1, const kvs::ValueArray<T>& values2, const size_t lag = 0 )
+{
+    return Corr( StridedView<T>( values1 ), StridedView<T>( values2 ), lag );
+}
+
+namespace detail
+{
+
+std::vector<double> CenteredCorrs( const std::vector<double>& x, const std::vector<double>& y, const double a, const double b );
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns array of correlation between the given views for all the lags.
+ *
+ *  The result is the same as Corr( values1, values2, lag ) for each lag, but
+ *  the lagged sums of the products are computed for all the lags at once by
+ *  the FFT in O(n log n) instead of O(n^2). The values are centered before
+ *  the FFT so that the roundoff error of the FFT is relative to the deviations
+ *  rather than the magnitudes, and the centering is compensated exactly in
+ *  the lagged sums.
+ *
+ *  @param  values1 [in] strided view 1
+ *  @param  values2 [in] strided view 2
+ *  @return array of correlation
+ */
+/*===========================================================================*/
+template <typename T>
+inline kvs::ValueArray<T> Corrs( const StridedView<T>& values1, const StridedView<T>& values2 )
+{
+    KVS_ASSERT( values1.size() == values2.size() );
+
+    const size_t n = values1.size();
+    kvs::ValueArray<T> corrs( n );
+    if ( n < DirectCorrelationSize )
+    {
+        for ( size_t k = 0; k < n; k++ ) { corrs[k] = Corr( values1, values2, k ); }
+        return corrs;
+    }
+
+    const double a = MomentsOf( values1 ).mean;
+    const double b = MomentsOf( values2 ).mean;
+    std::vector<double> x( n ), y( n );
+    for ( size_t i = 0; i < n; i++ )
+    {
+        x[i] = static_cast<double>( values1[i] ) - a;
+        y[i] = static_cast<double>( values2[i] ) - b;
+    }
+
+    const std::vector<double> c = CenteredCorrs( x, y, a, b );
+    for ( size_t k = 0; k < n; k++ ) { corrs[k] = static_cast<T>( c[k] ); }
+
+    return corrs;
+}
+
+} // end of namespace detail
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns auto-correlation for the given view with a lag.
+ *  @param  values [in] strided view
+ *  @param  lag [in] lag
+ *  @return auto-correlation
+ */
+/*===========================================================================*/
+template <typename T>
+T AutoCorr( const StridedView<T>& values, const size_t lag )
+{
+    return Corr( values, values, lag );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns auto-correlation for the given array with a lag.
@@ -695,9 +1323,25 @@ T AutoCorr( const kvs::ValueArray<T>& values, const size_t lag )
     return Corr( values, values, lag );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns array of auto-correlation for the given view.
+ *  @param  values [in] strided view
+ *  @return array of auto-correlation
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::ValueArray<T> AutoCorr( const StridedView<T>& values )
+{
+    return detail::Corrs( values, values );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns array of auto-correlation for the given array.
+ *
+ *  The auto-correlation for all the lags is computed by the FFT in O(n log n).
+ *
  *  @param  values [in] array
  *  @return array of auto-correlation
  */
@@ -705,10 +1349,22 @@ T AutoCorr( const kvs::ValueArray<T>& values, const size_t lag )
 template <typename T>
 kvs::ValueArray<T> AutoCorr( const kvs::ValueArray<T>& values )
 {
-    const size_t n = values.size();
-    kvs::ValueArray<T> corrs( n );
-    for ( size_t i = 0; i < n; i++ ) { corrs[i] = AutoCorr( values, i ); }
-    return corrs;
+    return AutoCorr( StridedView<T>( values ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns cross-correlation between the given views with a lag.
+ *  @param  values1 [in] strided view 1
+ *  @param  values2 [in] strided view 2
+ *  @param  lag [in] lag
+ *  @return cross-correlation
+ */
+/*===========================================================================*/
+template <typename T>
+T CrossCorr( const StridedView<T>& values1, const StridedView<T>& values2, const size_t lag )
+{
+    return Corr( values1, values2, lag );
 }
 
 /*===========================================================================*/
@@ -726,9 +1382,26 @@ T CrossCorr( const kvs::ValueArray<T>& values1, const kvs::ValueArray<T>& values
     return Corr( values1, values2, lag );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns array of cross-correlation between the given views.
+ *  @param  values1 [in] strided view 1
+ *  @param  values2 [in] strided view 2
+ *  @return array of cross-correlation
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::ValueArray<T> CrossCorr( const StridedView<T>& values1, const StridedView<T>& values2 )
+{
+    return detail::Corrs( values1, values2 );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns array of cross-correlation between the given arrays.
+ *
+ *  The cross-correlation for all the lags is computed by the FFT in O(n log n).
+ *
  *  @param  values1 [in] array 1
  *  @param  values2 [in] array 2
  *  @return array of cross-correlation
@@ -737,10 +1410,7 @@ T CrossCorr( const kvs::ValueArray<T>& values1, const kvs::ValueArray<T>& values
 template <typename T>
 kvs::ValueArray<T> CrossCorr( const kvs::ValueArray<T>& values1, const kvs::ValueArray<T>& values2 )
 {
-    const size_t n = values1.size();
-    kvs::ValueArray<T> corrs( n );
-    for ( size_t i = 0; i < n; i++ ) { corrs[i] = CrossCorr( values1, values2, i ); }
-    return corrs;
+    return CrossCorr( StridedView<T>( values1 ), StridedView<T>( values2 ) );
 }
 
 /*===========================================================================*/
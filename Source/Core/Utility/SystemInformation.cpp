@@ -11,8 +11,10 @@
 #include <kvs/Platform>
 #if   defined ( KVS_PLATFORM_WINDOWS )
 #include <windows.h>
+#include <psapi.h>
 #elif defined ( KVS_PLATFORM_LINUX ) || defined ( KVS_PLATFORM_CYGWIN )
 #include <unistd.h>
+#include <sys/resource.h>
 #elif defined ( KVS_PLATFORM_MACOSX )
 #include <mach/mach.h>
 #include <mach/machine.h>
@@ -20,8 +22,10 @@
 #include <mach/host_info.h>
 #include <sys/sysctl.h>
 #include <sys/utsname.h>
+#include <sys/resource.h>
 #endif
 #include <kvs/Message>
+#include <kvs/IgnoreUnusedVariable>
 
 
 namespace
@@ -212,4 +216,136 @@ size_t SystemInformation::FreeMemorySize()
 #endif
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns peak resident memory size of the current process in bytes.
+ *  @return peak memory usage
+ */
+/*===========================================================================*/
+size_t SystemInformation::PeakMemoryUsage()
+{
+// Windows
+#if defined ( KVS_PLATFORM_WINDOWS )
+    PROCESS_MEMORY_COUNTERS counters;
+    if ( !GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+    {
+        kvsMessageWarning( "Failure to get process memory info." );
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+
+// Linux
+#elif defined ( KVS_PLATFORM_LINUX ) || defined ( KVS_PLATFORM_CYGWIN )
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) == -1 )
+    {
+        const char* message = strerror( errno );
+        kvsMessageWarning( message );
+        return 0;
+    }
+    return static_cast<size_t>( usage.ru_maxrss ) * 1024; // in kilobytes
+
+// Mac OS X
+#elif defined ( KVS_PLATFORM_MACOSX )
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) == -1 )
+    {
+        const char* message = strerror( errno );
+        kvsMessageWarning( message );
+        return 0;
+    }
+    return static_cast<size_t>( usage.ru_maxrss ); // in bytes
+#endif
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns number of NUMA nodes.
+ *  @return number of NUMA nodes (1 if not available)
+ */
+/*===========================================================================*/
+size_t SystemInformation::NumberOfNUMANodes()
+{
+// Windows
+#if defined ( KVS_PLATFORM_WINDOWS )
+    ULONG highest = 0;
+    if ( !GetNumaHighestNodeNumber( &highest ) ) { return 1; }
+    return static_cast<size_t>( highest ) + 1;
+
+// Linux
+#elif defined ( KVS_PLATFORM_LINUX )
+    size_t nnodes = 0;
+    for ( ;; nnodes++ )
+    {
+        char path[64];
+        snprintf( path, sizeof( path ), "/sys/devices/system/node/node%zu/cpulist", nnodes );
+        FILE* file = fopen( path, "r" );
+        if ( !file ) { break; }
+        fclose( file );
+    }
+    return nnodes > 0 ? nnodes : 1;
+
+// Mac OS X and the others
+#else
+    return 1;
+#endif
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the processor indices of the NUMA node.
+ *  @param  node [in] NUMA node index
+ *  @return processor indices (all the processors if not available)
+ */
+/*===========================================================================*/
+std::vector<size_t> SystemInformation::NUMANodeProcessors( const size_t node )
+{
+    std::vector<size_t> processors;
+
+// Windows
+#if defined ( KVS_PLATFORM_WINDOWS )
+    ULONGLONG mask = 0;
+    if ( GetNumaNodeProcessorMask( static_cast<UCHAR>( node ), &mask ) )
+    {
+        for ( size_t i = 0; i < sizeof( mask ) * 8; i++ )
+        {
+            if ( mask & ( ULONGLONG(1) << i ) ) { processors.push_back( i ); }
+        }
+    }
+
+// Linux
+#elif defined ( KVS_PLATFORM_LINUX )
+    // The list is given as ranges, e.g. "0-3,8-11".
+    char path[64];
+    snprintf( path, sizeof( path ), "/sys/devices/system/node/node%zu/cpulist", node );
+    FILE* file = fopen( path, "r" );
+    if ( file )
+    {
+        unsigned int first = 0;
+        while ( fscanf( file, "%u", &first ) == 1 )
+        {
+            unsigned int last = first;
+            int c = fgetc( file );
+            if ( c == '-' )
+            {
+                if ( fscanf( file, "%u", &last ) != 1 ) { break; }
+                c = fgetc( file );
+            }
+            for ( unsigned int i = first; i <= last; i++ ) { processors.push_back( i ); }
+            if ( c != ',' ) { break; }
+        }
+        fclose( file );
+    }
+#else
+    kvs::IgnoreUnusedVariable( node );
+#endif
+
+    if ( processors.empty() )
+    {
+        const size_t nprocessors = SystemInformation::NumberOfProcessors();
+        for ( size_t i = 0; i < nprocessors; i++ ) { processors.push_back( i ); }
+    }
+    return processors;
+}
+
 } // end of namespace kvs
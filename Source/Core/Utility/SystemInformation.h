@@ -6,6 +6,7 @@
 /*****************************************************************************/
 #pragma once
 #include <cstdio>
+#include <vector>
 
 
 namespace kvs
@@ -22,6 +23,9 @@ public:
     static size_t NumberOfProcessors();
     static size_t TotalMemorySize();
     static size_t FreeMemorySize();
+    static size_t PeakMemoryUsage();
+    static size_t NumberOfNUMANodes();
+    static std::vector<size_t> NUMANodeProcessors( const size_t node );
 
 private:
     SystemInformation();
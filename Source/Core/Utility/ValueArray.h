@@ -14,6 +14,8 @@
 #include <iostream>
 #include <sstream>
 #include <initializer_list>
+#include <kvs/AllocationProfiler>
+#include <kvs/ArrayAllocator>
 #include <kvs/DebugNew>
 #include <kvs/Assert>
 #include <kvs/Value>
@@ -48,6 +50,7 @@ public:
 private:
     kvs::SharedPointer<value_type> m_values; ///< values
     size_t m_size; ///< number of values.
+    size_t m_capacity; ///< number of allocated values (>= m_size)
 
 public:
     static ValueArray Random( const size_t size, const unsigned int seed = 0 )
@@ -72,6 +75,16 @@ public:
         return v;
     }
 
+    static ValueArray Uninitialized( const size_t size )
+    {
+        // The values of trivially constructible types are left uninitialized
+        // (same as ValueArray( size ), but explicit at the call sites that
+        // overwrite all the values anyway).
+        this_type v;
+        v.allocate( size );
+        return v;
+    }
+
     static ValueArray Linear( const size_t size, const T start = T(0), const T step = T(1) )
     {
         if ( size == 0 ) { return ValueArray(); }
@@ -86,6 +99,7 @@ public:
     ValueArray()
     {
         m_size = 0;
+        m_capacity = 0;
     }
 
     explicit ValueArray( const size_t size )
@@ -105,6 +119,25 @@ public:
         std::copy( values.begin(), values.end(), this->begin() );
     }
 
+    explicit ValueArray( std::vector<T>&& values )
+    {
+        // Takes over the buffer of the vector without copying the values.
+        m_size = values.size();
+        m_capacity = values.size();
+        if ( values.empty() ) { return; }
+        std::vector<T>* holder = new std::vector<T>( std::move( values ) );
+        m_values.reset( holder->data(), vector_deleter( holder ) );
+    }
+
+    template <typename Deleter>
+    ValueArray( value_type* values, const size_t size, Deleter deleter ):
+        m_values( values, deleter )
+    {
+        // Takes over the external buffer, which is released by the deleter.
+        m_size = size;
+        m_capacity = size;
+    }
+
     template <typename InIter>
     ValueArray( InIter first, InIter last )
     {
@@ -122,6 +155,7 @@ public:
         m_values( sp )
     {
         m_size = size;
+        m_capacity = size;
     }
 
 public:
@@ -299,6 +333,11 @@ public:
         return m_size;
     }
 
+    size_type capacity() const
+    {
+        return m_capacity;
+    }
+
     size_type byteSize() const
     {
         return this->size() * sizeof( value_type );
@@ -328,6 +367,7 @@ public:
     {
         std::swap( m_values, other.m_values );
         std::swap( m_size, other.m_size );
+        std::swap( m_capacity, other.m_capacity );
     }
 
     ValueArray clone() const
@@ -381,10 +421,53 @@ public:
     void allocate( const size_t size )
     {
 //        m_values.reset( new value_type[ size ], kvs::temporal::ArrayDeleter<value_type>() );
-        m_values.reset( new value_type[ size ], kvs::Deleter<value_type[]>() );
+        kvs::ArrayAllocator* allocator = kvs::ArrayAllocator::Current();
+        if ( allocator )
+        {
+            value_type* values = allocator->create<value_type>( size );
+            auto* sample = kvs::AllocationProfiler::Allocated( "kvs::ValueArray", sizeof( value_type ) * size );
+            m_values.reset( values, kvs::ArrayAllocator::Deleter<value_type>( allocator, size, sample ) );
+            m_size = size;
+            m_capacity = size;
+            return;
+        }
+
+        value_type* values = new value_type[ size ];
+        auto* sample = kvs::AllocationProfiler::Allocated( "kvs::ValueArray", sizeof( value_type ) * size );
+        if ( sample ) { m_values.reset( values, kvs::AllocationProfiler::Deleter<value_type[]>( sample ) ); }
+        else { m_values.reset( values, kvs::Deleter<value_type[]>() ); }
+        m_size = size;
+        m_capacity = size;
+    }
+
+    void reserve( const size_t capacity )
+    {
+        if ( capacity > m_capacity ) { this->reallocate( capacity ); }
+    }
+
+    void resize( const size_t size )
+    {
+        // The added values are not initialized, as in allocate(). The buffer
+        // shared with the other arrays is not overwritten.
+        if ( size > m_capacity || ( size > m_size && !m_values.unique() ) ) { this->reallocate( size ); }
         m_size = size;
     }
 
+    void push_back( const T& value )
+    {
+        if ( m_size == m_capacity || !m_values.unique() )
+        {
+            this->reallocate( std::max( m_capacity * 2, m_size + 1 ) );
+        }
+        m_values.get()[ m_size++ ] = value;
+    }
+
+    void shrink_to_fit()
+    {
+        if ( m_size == 0 ) { this->release(); }
+        else if ( m_capacity > m_size ) { this->reallocate( m_size ); }
+    }
+
     void fill( const T& value )
     {
         std::fill( this->begin(), this->end(), value );
@@ -394,6 +477,7 @@ public:
     {
         m_values.reset();
         m_size = 0;
+        m_capacity = 0;
     }
 
     bool unique() const
@@ -472,7 +556,40 @@ public:
         return indices;
     }
 
+    template <typename Index>
+    ValueArray gather( const std::vector<Index>& indices, const size_t stride = 1 ) const
+    {
+        // The i-th item (of stride values) is the indices[i]-th item of this array,
+        // e.g. v.gather( order ) applies the permutation obtained by argsort().
+        ValueArray ret = ValueArray::Uninitialized( indices.size() * stride );
+        const_iterator src = this->begin();
+        iterator dst = ret.begin();
+        for ( size_t i = 0; i < indices.size(); i++, dst += stride )
+        {
+            KVS_ASSERT( ( indices[i] + 1 ) * stride <= this->size() );
+            std::copy( src + indices[i] * stride, src + ( indices[i] + 1 ) * stride, dst );
+        }
+        return ret;
+    }
+
 private:
+    void reallocate( const size_t capacity )
+    {
+        const size_t size = std::min( m_size, capacity );
+        this_type temp;
+        temp.allocate( capacity );
+        if ( m_values.unique() ) { std::move( this->begin(), this->begin() + size, temp.begin() ); }
+        else { std::copy( this->begin(), this->begin() + size, temp.begin() ); }
+        temp.m_size = size;
+        temp.swap( *this );
+    }
+
+    struct vector_deleter
+    {
+        std::vector<T>* m_vector; vector_deleter( std::vector<T>* vector ): m_vector( vector ) {}
+        void operator () ( T* ) const { delete m_vector; }
+    };
+
     struct argsort_less
     {
         const_iterator m_begin; argsort_less( const_iterator begin ): m_begin( begin ) {}
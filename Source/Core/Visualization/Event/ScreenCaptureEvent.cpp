@@ -55,6 +55,7 @@ void ScreenCaptureEvent::update( kvs::KeyEvent* event )
     {
         auto image = scene()->camera()->snapshot();
         if ( m_capture_func ) { m_capture_func( image ); }
+        else if ( m_writer ) { m_writer->write( image, this->output_filename() ); }
         else { image.write( this->output_filename() ); }
     }
 }
@@ -9,6 +9,7 @@
 #include <string>
 #include <functional>
 #include <kvs/ColorImage>
+#include <kvs/AsyncImageWriter>
 
 
 namespace kvs
@@ -29,6 +30,7 @@ private:
     std::string m_filename = ""; ///< filename of captured image
     std::string m_basename = "screenshot"; ///< basename of captured image
     CaptureFunc m_capture_func = nullptr;
+    kvs::AsyncImageWriter* m_writer = nullptr; ///< background image writer (not allocated)
 
 public:
     ScreenCaptureEvent( const int key = kvs::Key::s );
@@ -37,6 +39,7 @@ public:
     void setKey( const int key ) { m_key = key; }
     void setFilename( const std::string& filename ) { m_filename = filename; }
     void setBasename( const std::string& basename ) { m_basename = basename; }
+    void setWriter( kvs::AsyncImageWriter* writer ) { m_writer = writer; }
     void update( CaptureFunc func ) { m_capture_func = func; }
     void update( kvs::KeyEvent* event );
 
@@ -42,6 +42,19 @@ PointExporter<kvs::KVSMLPointObject>::exec( const kvs::ObjectBase* object )
     this->setColors( point->colors() );
     this->setNormals( point->normals() );
     this->setSizes( point->sizes() );
+    this->setQuantizedCoords( point->quantizedCoords() );
+    this->setPackedNormals( point->packedNormals() );
+    this->setColorIndices( point->colorIndices(), point->colorPalette() );
+
+    // The quantized coordinates are stored relative to the object bounds.
+    if ( point->hasQuantizedCoords() )
+    {
+        this->setMinMaxObjectCoords( point->minQuantizationCoord(), point->maxQuantizationCoord() );
+        if ( point->hasMinMaxExternalCoords() )
+        {
+            this->setMinMaxExternalCoords( point->minExternalCoord(), point->maxExternalCoord() );
+        }
+    }
 
     return this;
 }
@@ -10,6 +10,8 @@
 #include <kvs/Type>
 #include <kvs/Vector3>
 #include <kvs/Matrix33>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/OpenMP>
 
 
 namespace kvs
@@ -43,6 +45,11 @@ public:
         m_bucket[ index ].push_back( std::make_pair( value, distance ) );
     }
 
+    static kvs::ValueArray<kvs::Real32> Interpolate(
+        const kvs::UnstructuredVolumeObject* volume,
+        const std::vector<Value>& cell_values,
+        const std::vector<kvs::Vec3>& cell_centers );
+
     kvs::ValueArray<kvs::Real32> serialize() const
     {
         // Specialized for
@@ -51,6 +58,10 @@ public:
         //    tensor value as kvs::Mat3
         return kvs::ValueArray<kvs::Real32>( m_bucket.size() );
     }
+
+private:
+    static size_t Veclen();
+    static void Store( const Value& value, kvs::Real32* dst );
 };
 
 template <>
@@ -168,4 +179,96 @@ inline kvs::ValueArray<kvs::Real32> InverseDistanceWeighting<kvs::Mat3>::seriali
     return values;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Interpolates the cell values to the nodes by inverse distance weighting.
+ *  @param  volume [in] pointer to the unstructured volume object
+ *  @param  cell_values [in] values of the cells
+ *  @param  cell_centers [in] centers of the cells
+ *  @return interpolated node values
+ *
+ *  The values of the cells sharing each node are gathered by using the
+ *  node-to-cell adjacency of the volume in the ascending order of the cell
+ *  indices, so that the nodes are processed in parallel and the result is
+ *  the same as the one of inserting the cells in order and serializing.
+ */
+/*===========================================================================*/
+template <typename Value>
+inline kvs::ValueArray<kvs::Real32> InverseDistanceWeighting<Value>::Interpolate(
+    const kvs::UnstructuredVolumeObject* volume,
+    const std::vector<Value>& cell_values,
+    const std::vector<kvs::Vec3>& cell_centers )
+{
+    volume->updateNodeToCellAdjacency();
+    const kvs::UInt32* offsets = volume->nodeToCellOffsets().data();
+    const kvs::UInt32* indices = volume->nodeToCellIndices().data();
+    const kvs::Real32* coords = volume->coords().data();
+
+    const size_t veclen = Veclen();
+    const size_t nnodes = volume->numberOfNodes();
+    kvs::ValueArray<kvs::Real32> values( nnodes * veclen );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nnodes ); i++ )
+    {
+        const kvs::Vec3 coord( coords + 3 * i );
+        const kvs::UInt32 first = offsets[i];
+        const kvs::UInt32 last = offsets[ i + 1 ];
+
+        float w = 0.0f;
+        for ( kvs::UInt32 j = first; j < last; j++ )
+        {
+            const float d = ( coord - cell_centers[ indices[j] ] ).length();
+            w += 1.0f / d;
+        }
+
+        Value value{};
+        for ( kvs::UInt32 j = first; j < last; j++ )
+        {
+            const kvs::Real32 d = ( coord - cell_centers[ indices[j] ] ).length();
+            value += ( ( 1.0f / d ) / w ) * cell_values[ indices[j] ];
+        }
+
+        Store( value, values.data() + i * veclen );
+    }
+
+    return values;
+}
+
+template <>
+inline size_t InverseDistanceWeighting<kvs::Real32>::Veclen() { return 1; }
+
+template <>
+inline size_t InverseDistanceWeighting<kvs::Vec3>::Veclen() { return 3; }
+
+template <>
+inline size_t InverseDistanceWeighting<kvs::Mat3>::Veclen() { return 9; }
+
+template <>
+inline void InverseDistanceWeighting<kvs::Real32>::Store( const kvs::Real32& value, kvs::Real32* dst )
+{
+    dst[0] = value;
+}
+
+template <>
+inline void InverseDistanceWeighting<kvs::Vec3>::Store( const kvs::Vec3& value, kvs::Real32* dst )
+{
+    dst[0] = value[0];
+    dst[1] = value[1];
+    dst[2] = value[2];
+}
+
+template <>
+inline void InverseDistanceWeighting<kvs::Mat3>::Store( const kvs::Mat3& value, kvs::Real32* dst )
+{
+    dst[0] = value[0][0];
+    dst[1] = value[0][1];
+    dst[2] = value[0][2];
+    dst[3] = value[1][0];
+    dst[4] = value[1][1];
+    dst[5] = value[1][2];
+    dst[6] = value[2][0];
+    dst[7] = value[2][1];
+    dst[8] = value[2][2];
+}
+
 } // end of namespace kvs
@@ -8,6 +8,7 @@
 #include <kvs/KMeans>
 #include <kvs/FastKMeans>
 #include <kvs/AdaptiveKMeans>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -91,6 +92,8 @@ KMeansClustering::~KMeansClustering()
 /*===========================================================================*/
 KMeansClustering::SuperClass* KMeansClustering::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -8,6 +8,7 @@
 #include <kvs/DebugNew>
 #include <kvs/MersenneTwister>
 #include <kvs/Vector3>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -82,6 +83,8 @@ void LineIntegralConvolution::setLength( const double length )
 /*===========================================================================*/
 LineIntegralConvolution::SuperClass* LineIntegralConvolution::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
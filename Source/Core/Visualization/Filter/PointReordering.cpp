@@ -0,0 +1,216 @@
+/****************************************************************************/
+/**
+ *  @file   PointReordering.cpp
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#include "PointReordering.h"
+#include <kvs/Message>
+#include <kvs/Vector3>
+#include <kvs/OpenMP>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <kvs/Profiler>
+
+
+namespace
+{
+
+/// Number of bits per axis of the curve index.
+const size_t NumberOfBits = 21;
+
+/*===========================================================================*/
+/**
+ *  @brief  Spreads the lower 21 bits of x so that two zero bits follow each bit.
+ */
+/*===========================================================================*/
+inline kvs::UInt64 Spread( kvs::UInt64 x )
+{
+    x &= 0x1fffff;
+    x = ( x | x << 32 ) & 0x1f00000000ffffULL;
+    x = ( x | x << 16 ) & 0x1f0000ff0000ffULL;
+    x = ( x | x << 8 ) & 0x100f00f00f00f00fULL;
+    x = ( x | x << 4 ) & 0x10c30c30c30c30c3ULL;
+    x = ( x | x << 2 ) & 0x1249249249249249ULL;
+    return x;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the Morton index of the quantized coordinates.
+ */
+/*===========================================================================*/
+inline kvs::UInt64 MortonIndex( const kvs::UInt32 x, const kvs::UInt32 y, const kvs::UInt32 z )
+{
+    return Spread( x ) << 2 | Spread( y ) << 1 | Spread( z );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the Hilbert index of the quantized coordinates.
+ *
+ *  The coordinates are converted to the transposed Hilbert index by Skilling's
+ *  algorithm (AIP Conf. Proc. 707, 2004), whose bits are then interleaved.
+ */
+/*===========================================================================*/
+inline kvs::UInt64 HilbertIndex( const kvs::UInt32 x, const kvs::UInt32 y, const kvs::UInt32 z )
+{
+    kvs::UInt32 X[3] = { x, y, z };
+    const kvs::UInt32 M = 1u << ( NumberOfBits - 1 );
+
+    // Inverse undo.
+    for ( kvs::UInt32 Q = M; Q > 1; Q >>= 1 )
+    {
+        const kvs::UInt32 P = Q - 1;
+        for ( size_t i = 0; i < 3; i++ )
+        {
+            if ( X[i] & Q ) { X[0] ^= P; }
+            else
+            {
+                const kvs::UInt32 t = ( X[0] ^ X[i] ) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode.
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    kvs::UInt32 t = 0;
+    for ( kvs::UInt32 Q = M; Q > 1; Q >>= 1 )
+    {
+        if ( X[2] & Q ) { t ^= Q - 1; }
+    }
+    X[0] ^= t;
+    X[1] ^= t;
+    X[2] ^= t;
+
+    return MortonIndex( X[0], X[1], X[2] );
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new PointReordering class.
+ *  @param  object [in] pointer to the point object
+ *  @param  curve_type [in] space-filling curve type
+ */
+/*===========================================================================*/
+PointReordering::PointReordering( const kvs::PointObject* object, const CurveType curve_type ):
+    m_curve_type( curve_type )
+{
+    this->exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes this class.
+ *  @param  object [in] pointer to the object
+ *  @return pointer to the reordered object
+ */
+/*===========================================================================*/
+PointReordering::SuperClass* PointReordering::exec( const kvs::ObjectBase* object )
+{
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
+    if ( !object )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError( "Input object is NULL." );
+        return NULL;
+    }
+
+    const kvs::PointObject* point = kvs::PointObject::DownCast( object );
+    if ( !point )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError( "Input object is not supported." );
+        return NULL;
+    }
+
+    this->reorder( point );
+    BaseClass::setSuccess( true );
+
+    return this;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sorts the points along the space-filling curve.
+ *  @param  point [in] pointer to the point object
+ */
+/*===========================================================================*/
+void PointReordering::reorder( const kvs::PointObject* point )
+{
+    SuperClass::shallowCopy( *point );
+
+    const size_t nvertices = point->numberOfVertices();
+    if ( nvertices < 2 ) { return; }
+
+    // The compressed attributes are reordered as they are, but the keys are
+    // calculated from the decoded coordinates.
+    const kvs::ValueArray<kvs::Real32> decompressed_coords = point->decompressedCoords();
+    const kvs::Real32* coords = decompressed_coords.data();
+    kvs::Vec3 min_coord( coords );
+    kvs::Vec3 max_coord( coords );
+    for ( size_t i = 1; i < nvertices; i++ )
+    {
+        for ( size_t j = 0; j < 3; j++ )
+        {
+            min_coord[j] = std::min( min_coord[j], coords[ 3 * i + j ] );
+            max_coord[j] = std::max( max_coord[j], coords[ 3 * i + j ] );
+        }
+    }
+
+    const double max_index = double( ( 1u << NumberOfBits ) - 1 );
+    double scale[3];
+    for ( size_t j = 0; j < 3; j++ )
+    {
+        const double width = double( max_coord[j] ) - double( min_coord[j] );
+        scale[j] = width > 0.0 ? max_index / width : 0.0;
+    }
+
+    // Sort by (curve index, point index) so that the order is deterministic.
+    const bool hilbert = m_curve_type == HilbertCurve;
+    std::vector<std::pair<kvs::UInt64,kvs::UInt32> > keys( nvertices );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nvertices ); i++ )
+    {
+        kvs::UInt32 q[3];
+        for ( size_t j = 0; j < 3; j++ )
+        {
+            const double x = ( double( coords[ 3 * i + j ] ) - min_coord[j] ) * scale[j];
+            q[j] = static_cast<kvs::UInt32>( std::min( std::max( x + 0.5, 0.0 ), max_index ) );
+        }
+        const kvs::UInt64 key = hilbert ? ::HilbertIndex( q[0], q[1], q[2] ) : ::MortonIndex( q[0], q[1], q[2] );
+        keys[i] = std::make_pair( key, kvs::UInt32( i ) );
+    }
+    std::sort( keys.begin(), keys.end() );
+
+    std::vector<kvs::UInt32> order( nvertices );
+    for ( size_t i = 0; i < nvertices; i++ ) { order[i] = keys[i].second; }
+
+    if ( point->hasQuantizedCoords() )
+    {
+        const kvs::ValueArray<kvs::UInt16> coords = point->quantizedCoords().gather( order, 3 );
+        SuperClass::setQuantizedCoords( coords, point->minQuantizationCoord(), point->maxQuantizationCoord() );
+    }
+    else { SuperClass::setCoords( point->coords().gather( order, 3 ) ); }
+
+    if ( point->hasColorIndices() ) { SuperClass::setColorIndices( point->colorIndices().gather( order, 1 ), point->colorPalette() ); }
+    else if ( point->numberOfColors() == nvertices ) { SuperClass::setColors( point->colors().gather( order, 3 ) ); }
+
+    if ( point->hasPackedNormals() ) { SuperClass::setPackedNormals( point->packedNormals().gather( order, 1 ) ); }
+    else if ( point->numberOfNormals() == nvertices ) { SuperClass::setNormals( point->normals().gather( order, 3 ) ); }
+
+    if ( point->numberOfSizes() == nvertices ) { SuperClass::setSizes( point->sizes().gather( order, 1 ) ); }
+}
+
+} // end of namespace kvs
@@ -0,0 +1,58 @@
+/****************************************************************************/
+/**
+ *  @file   PointReordering.h
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#pragma once
+#include <kvs/PointObject>
+#include <kvs/Module>
+#include <kvs/FilterBase>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Sorts points along a space-filling curve for memory locality.
+ *
+ *  The coordinates are quantized to 21 bits per axis within the bounding box
+ *  and the points (with their colors, normals and sizes) are sorted by the
+ *  Morton or Hilbert index, so that points close in space are also close in
+ *  memory.
+ */
+/*===========================================================================*/
+class PointReordering : public kvs::FilterBase, public kvs::PointObject
+{
+    kvsModule( kvs::PointReordering, Filter );
+    kvsModuleBaseClass( kvs::FilterBase );
+    kvsModuleSuperClass( kvs::PointObject );
+
+public:
+    enum CurveType
+    {
+        MortonCurve,
+        HilbertCurve
+    };
+
+private:
+    CurveType m_curve_type = HilbertCurve; ///< space-filling curve type
+
+public:
+    PointReordering() = default;
+    PointReordering( const kvs::PointObject* object, const CurveType curve_type = HilbertCurve );
+    virtual ~PointReordering() = default;
+
+    CurveType curveType() const { return m_curve_type; }
+    void setCurveType( const CurveType curve_type ) { m_curve_type = curve_type; }
+    void setCurveTypeToMorton() { this->setCurveType( MortonCurve ); }
+    void setCurveTypeToHilbert() { this->setCurveType( HilbertCurve ); }
+
+    SuperClass* exec( const kvs::ObjectBase* object );
+
+private:
+    void reorder( const kvs::PointObject* point );
+};
+
+} // end of namespace kvs
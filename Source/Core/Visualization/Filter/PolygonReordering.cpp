@@ -0,0 +1,250 @@
+/****************************************************************************/
+/**
+ *  @file   PolygonReordering.cpp
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#include "PolygonReordering.h"
+#include <kvs/Message>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <kvs/Profiler>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the average number of vertex cache misses per polygon.
+ *  @param  polygon [in] pointer to the polygon object
+ *  @param  cache_size [in] size of the simulated FIFO vertex cache
+ *  @return average cache miss ratio (ACMR)
+ */
+/*===========================================================================*/
+double PolygonReordering::AverageCacheMissRatio( const kvs::PolygonObject* polygon, const size_t cache_size )
+{
+    const size_t npolygons = polygon->numberOfConnections();
+    if ( npolygons == 0 ) { return 0.0; }
+
+    const size_t nvertices = polygon->numberOfVertices();
+    const kvs::ValueArray<kvs::UInt32>& connections = polygon->connections();
+
+    std::vector<kvs::UInt8> cached( nvertices, 0 );
+    std::deque<kvs::UInt32> fifo;
+    size_t nmisses = 0;
+    for ( size_t i = 0; i < connections.size(); i++ )
+    {
+        const kvs::UInt32 v = connections[i];
+        if ( cached[v] ) { continue; }
+
+        nmisses++;
+        cached[v] = 1;
+        fifo.push_back( v );
+        if ( fifo.size() > cache_size )
+        {
+            cached[ fifo.front() ] = 0;
+            fifo.pop_front();
+        }
+    }
+
+    return static_cast<double>( nmisses ) / npolygons;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new PolygonReordering class.
+ *  @param  object [in] pointer to the polygon object
+ *  @param  cache_size [in] size of the vertex cache
+ */
+/*===========================================================================*/
+PolygonReordering::PolygonReordering( const kvs::PolygonObject* object, const size_t cache_size ):
+    m_cache_size( cache_size )
+{
+    this->exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes this class.
+ *  @param  object [in] pointer to the object
+ *  @return pointer to the reordered object
+ */
+/*===========================================================================*/
+PolygonReordering::SuperClass* PolygonReordering::exec( const kvs::ObjectBase* object )
+{
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
+    if ( !object )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError( "Input object is NULL." );
+        return NULL;
+    }
+
+    const kvs::PolygonObject* polygon = kvs::PolygonObject::DownCast( object );
+    if ( !polygon )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError( "Input object is not supported." );
+        return NULL;
+    }
+
+    if ( polygon->polygonType() != kvs::PolygonObject::Triangle &&
+         polygon->polygonType() != kvs::PolygonObject::Quadrangle )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError( "Input polygon type is not supported." );
+        return NULL;
+    }
+
+    this->reorder( polygon );
+    BaseClass::setSuccess( true );
+
+    return this;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reorders the polygons and the vertices.
+ *  @param  polygon [in] pointer to the polygon object
+ */
+/*===========================================================================*/
+void PolygonReordering::reorder( const kvs::PolygonObject* polygon )
+{
+    SuperClass::shallowCopy( *polygon );
+
+    // Polygons without connections have no shared vertices to reuse.
+    const size_t npolygons = polygon->numberOfConnections();
+    if ( npolygons == 0 ) { return; }
+
+    const size_t nvertices = polygon->numberOfVertices();
+    const size_t nvertices_per_polygon = polygon->polygonType();
+    const kvs::UInt32* connections = polygon->connections().data();
+    const size_t nindices = npolygons * nvertices_per_polygon;
+
+    // Vertex-to-polygon adjacency.
+    std::vector<kvs::UInt32> offsets( nvertices + 1, 0 );
+    for ( size_t i = 0; i < nindices; i++ ) { offsets[ connections[i] + 1 ]++; }
+    for ( size_t i = 0; i < nvertices; i++ ) { offsets[ i + 1 ] += offsets[i]; }
+    std::vector<kvs::UInt32> indices( nindices );
+    {
+        std::vector<kvs::UInt32> cursor( offsets.begin(), offsets.end() - 1 );
+        for ( size_t i = 0; i < nindices; i++ )
+        {
+            indices[ cursor[ connections[i] ]++ ] = kvs::UInt32( i / nvertices_per_polygon );
+        }
+    }
+
+    // Tipsify: fan around the current vertex, then move to the candidate that
+    // stays longest in the cache, or to a dead-end vertex when none is left.
+    const long cache_size = static_cast<long>( m_cache_size );
+    std::vector<kvs::UInt32> live( nvertices );
+    for ( size_t i = 0; i < nvertices; i++ ) { live[i] = offsets[ i + 1 ] - offsets[i]; }
+    std::vector<long> timestamps( nvertices, 0 );
+    std::vector<kvs::UInt8> emitted( npolygons, 0 );
+    std::vector<kvs::UInt32> dead_ends;
+    std::vector<kvs::UInt32> candidates;
+    std::vector<kvs::UInt32> polygon_order;
+    polygon_order.reserve( npolygons );
+
+    long time = cache_size + 1;
+    size_t cursor = 0;
+    long fanning = connections[0];
+    while ( fanning >= 0 )
+    {
+        candidates.clear();
+        for ( kvs::UInt32 k = offsets[ fanning ]; k < offsets[ fanning + 1 ]; k++ )
+        {
+            const kvs::UInt32 p = indices[k];
+            if ( emitted[p] ) { continue; }
+
+            emitted[p] = 1;
+            polygon_order.push_back( p );
+            for ( size_t j = 0; j < nvertices_per_polygon; j++ )
+            {
+                const kvs::UInt32 v = connections[ p * nvertices_per_polygon + j ];
+                dead_ends.push_back( v );
+                candidates.push_back( v );
+                live[v]--;
+                if ( time - timestamps[v] > cache_size ) { timestamps[v] = time++; }
+            }
+        }
+
+        fanning = -1;
+        long best_priority = -1;
+        for ( size_t i = 0; i < candidates.size(); i++ )
+        {
+            const kvs::UInt32 v = candidates[i];
+            if ( live[v] == 0 ) { continue; }
+
+            long priority = 0;
+            if ( time - timestamps[v] + 2 * long( live[v] ) <= cache_size ) { priority = time - timestamps[v]; }
+            if ( priority > best_priority ) { best_priority = priority; fanning = v; }
+        }
+
+        while ( fanning < 0 && !dead_ends.empty() )
+        {
+            const kvs::UInt32 v = dead_ends.back();
+            dead_ends.pop_back();
+            if ( live[v] > 0 ) { fanning = v; }
+        }
+
+        while ( fanning < 0 && cursor < nvertices )
+        {
+            if ( live[ cursor ] > 0 ) { fanning = long( cursor ); }
+            cursor++;
+        }
+    }
+
+    // Renumber the vertices in order of first reference.
+    const kvs::UInt32 unused = kvs::UInt32( -1 );
+    std::vector<kvs::UInt32> new_ids( nvertices, unused );
+    std::vector<kvs::UInt32> vertex_order;
+    vertex_order.reserve( nvertices );
+    kvs::ValueArray<kvs::UInt32> new_connections( nindices );
+    for ( size_t i = 0; i < npolygons; i++ )
+    {
+        const kvs::UInt32 p = polygon_order[i];
+        for ( size_t j = 0; j < nvertices_per_polygon; j++ )
+        {
+            const kvs::UInt32 v = connections[ p * nvertices_per_polygon + j ];
+            if ( new_ids[v] == unused )
+            {
+                new_ids[v] = kvs::UInt32( vertex_order.size() );
+                vertex_order.push_back( v );
+            }
+            new_connections[ i * nvertices_per_polygon + j ] = new_ids[v];
+        }
+    }
+    for ( size_t i = 0; i < nvertices; i++ )
+    {
+        if ( new_ids[i] == unused ) { vertex_order.push_back( kvs::UInt32( i ) ); }
+    }
+
+    const bool vertex_color = polygon->colorType() == kvs::PolygonObject::VertexColor;
+    const bool polygon_color = polygon->colorType() == kvs::PolygonObject::PolygonColor;
+    const bool vertex_normal = polygon->normalType() == kvs::PolygonObject::VertexNormal;
+    const bool polygon_normal = polygon->normalType() == kvs::PolygonObject::PolygonNormal;
+    const size_t ncolors = polygon->numberOfColors();
+    const size_t nopacities = polygon->numberOfOpacities();
+    const size_t nnormals = polygon->numberOfNormals();
+
+    SuperClass::setCoords( polygon->coords().gather( vertex_order, 3 ) );
+    SuperClass::setConnections( new_connections );
+    if ( ncolors > 1 )
+    {
+        if ( vertex_color && ncolors == nvertices ) { SuperClass::setColors( polygon->colors().gather( vertex_order, 3 ) ); }
+        else if ( polygon_color && ncolors == npolygons ) { SuperClass::setColors( polygon->colors().gather( polygon_order, 3 ) ); }
+    }
+    if ( nopacities > 1 )
+    {
+        if ( vertex_color && nopacities == nvertices ) { SuperClass::setOpacities( polygon->opacities().gather( vertex_order, 1 ) ); }
+        else if ( polygon_color && nopacities == npolygons ) { SuperClass::setOpacities( polygon->opacities().gather( polygon_order, 1 ) ); }
+    }
+    if ( vertex_normal && nnormals == nvertices ) { SuperClass::setNormals( polygon->normals().gather( vertex_order, 3 ) ); }
+    else if ( polygon_normal && nnormals == npolygons ) { SuperClass::setNormals( polygon->normals().gather( polygon_order, 3 ) ); }
+}
+
+} // end of namespace kvs
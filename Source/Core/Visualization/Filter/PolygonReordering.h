@@ -0,0 +1,52 @@
+/****************************************************************************/
+/**
+ *  @file   PolygonReordering.h
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#pragma once
+#include <kvs/PolygonObject>
+#include <kvs/Module>
+#include <kvs/FilterBase>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reorders polygons and vertices for post-transform vertex cache reuse.
+ *
+ *  The polygons are reordered with the Tipsify algorithm (Sander et al. 2007)
+ *  for a vertex cache of the given size, and the vertices are then renumbered
+ *  in order of first reference so that vertex fetches are sequential. The
+ *  geometry itself is unchanged.
+ */
+/*===========================================================================*/
+class PolygonReordering : public kvs::FilterBase, public kvs::PolygonObject
+{
+    kvsModule( kvs::PolygonReordering, Filter );
+    kvsModuleBaseClass( kvs::FilterBase );
+    kvsModuleSuperClass( kvs::PolygonObject );
+
+public:
+    static double AverageCacheMissRatio( const kvs::PolygonObject* polygon, const size_t cache_size = 16 );
+
+private:
+    size_t m_cache_size = 16; ///< size of the vertex cache
+
+public:
+    PolygonReordering() = default;
+    PolygonReordering( const kvs::PolygonObject* object, const size_t cache_size = 16 );
+    virtual ~PolygonReordering() = default;
+
+    size_t cacheSize() const { return m_cache_size; }
+    void setCacheSize( const size_t cache_size ) { m_cache_size = cache_size; }
+
+    SuperClass* exec( const kvs::ObjectBase* object );
+
+private:
+    void reorder( const kvs::PolygonObject* polygon );
+};
+
+} // end of namespace kvs
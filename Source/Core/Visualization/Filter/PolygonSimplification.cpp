@@ -0,0 +1,698 @@
+/****************************************************************************/
+/**
+ *  @file   PolygonSimplification.cpp
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#include "PolygonSimplification.h"
+#include <kvs/Message>
+#include <kvs/Vector3>
+#include <kvs/RGBColor>
+#include <kvs/Math>
+#include <kvs/OpenMP>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <cmath>
+#include <kvs/Profiler>
+
+
+namespace
+{
+
+/// Min. cosine between the normals of a triangle before and after a collapse.
+const double MinNormalCosine = 0.5;
+
+/*===========================================================================*/
+/**
+ *  @brief  Symmetric 4x4 error quadric.
+ */
+/*===========================================================================*/
+class Quadric
+{
+private:
+    double m_a[10]; ///< upper triangle (a00,a01,a02,a03,a11,a12,a13,a22,a23,a33)
+
+public:
+    Quadric() { std::fill( m_a, m_a + 10, 0.0 ); }
+
+    Quadric( const kvs::Vec3d& n, const double d )
+    {
+        m_a[0] = n.x() * n.x(); m_a[1] = n.x() * n.y(); m_a[2] = n.x() * n.z(); m_a[3] = n.x() * d;
+        m_a[4] = n.y() * n.y(); m_a[5] = n.y() * n.z(); m_a[6] = n.y() * d;
+        m_a[7] = n.z() * n.z(); m_a[8] = n.z() * d;
+        m_a[9] = d * d;
+    }
+
+    Quadric& operator +=( const Quadric& q )
+    {
+        for ( size_t i = 0; i < 10; i++ ) { m_a[i] += q.m_a[i]; }
+        return *this;
+    }
+
+    double error( const kvs::Vec3d& p ) const
+    {
+        const double x = p.x();
+        const double y = p.y();
+        const double z = p.z();
+        return
+            m_a[0] * x * x + 2.0 * m_a[1] * x * y + 2.0 * m_a[2] * x * z + 2.0 * m_a[3] * x +
+            m_a[4] * y * y + 2.0 * m_a[5] * y * z + 2.0 * m_a[6] * y +
+            m_a[7] * z * z + 2.0 * m_a[8] * z +
+            m_a[9];
+    }
+
+    bool minimize( kvs::Vec3d* p ) const
+    {
+        const double c00 = m_a[4] * m_a[7] - m_a[5] * m_a[5];
+        const double c01 = m_a[2] * m_a[5] - m_a[1] * m_a[7];
+        const double c02 = m_a[1] * m_a[5] - m_a[2] * m_a[4];
+        const double c11 = m_a[0] * m_a[7] - m_a[2] * m_a[2];
+        const double c12 = m_a[1] * m_a[2] - m_a[0] * m_a[5];
+        const double c22 = m_a[0] * m_a[4] - m_a[1] * m_a[1];
+        const double det = m_a[0] * c00 + m_a[1] * c01 + m_a[2] * c02;
+        const double trace = m_a[0] + m_a[4] + m_a[7];
+        if ( trace <= 0.0 || std::abs( det ) <= 1.0e-10 * trace * trace * trace ) { return false; }
+
+        const double b0 = m_a[3];
+        const double b1 = m_a[6];
+        const double b2 = m_a[8];
+        *p = kvs::Vec3d(
+            -( c00 * b0 + c01 * b1 + c02 * b2 ) / det,
+            -( c01 * b0 + c11 * b1 + c12 * b2 ) / det,
+            -( c02 * b0 + c12 * b1 + c22 * b2 ) / det );
+        return true;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Edge collapse candidate.
+ */
+/*===========================================================================*/
+struct Candidate
+{
+    double cost; ///< quadric error at the new position
+    kvs::UInt32 keep; ///< vertex moved to the new position
+    kvs::UInt32 remove; ///< vertex removed by the collapse
+    kvs::Vec3d position; ///< new position
+
+    bool operator <( const Candidate& other ) const
+    {
+        if ( cost != other.cost ) { return cost < other.cost; }
+        if ( keep != other.keep ) { return keep < other.keep; }
+        return remove < other.remove;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Welds the vertices of a triangle soup that share the same position.
+ *  @param  coords [in] vertex coordinates (three vertices per triangle)
+ *  @param  vertex_ids [out] input vertex ID of each welded vertex
+ *  @param  triangles [out] welded vertex IDs of each triangle
+ */
+/*===========================================================================*/
+void Weld(
+    const kvs::ValueArray<kvs::Real32>& coords,
+    std::vector<kvs::UInt32>* vertex_ids,
+    std::vector<kvs::UInt32>* triangles )
+{
+    const size_t nvertices = coords.size() / 3;
+    const kvs::Real32* p = coords.data();
+
+    std::vector<kvs::UInt32> order( nvertices );
+    for ( size_t i = 0; i < nvertices; i++ ) { order[i] = kvs::UInt32( i ); }
+    std::sort( order.begin(), order.end(), [p]( const kvs::UInt32 a, const kvs::UInt32 b )
+    {
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            if ( p[ 3 * a + k ] != p[ 3 * b + k ] ) { return p[ 3 * a + k ] < p[ 3 * b + k ]; }
+        }
+        return a < b;
+    } );
+
+    // Representative (smallest input ID) of each group of coincident vertices.
+    std::vector<kvs::UInt32> representatives( nvertices );
+    for ( size_t i = 0, first = 0; i < nvertices; i++ )
+    {
+        const kvs::UInt32 a = order[first];
+        const kvs::UInt32 b = order[i];
+        if ( p[ 3 * a ] != p[ 3 * b ] || p[ 3 * a + 1 ] != p[ 3 * b + 1 ] || p[ 3 * a + 2 ] != p[ 3 * b + 2 ] )
+        {
+            first = i;
+        }
+        representatives[b] = order[first];
+    }
+
+    // Number the welded vertices in order of first appearance.
+    std::vector<kvs::UInt32> new_ids( nvertices );
+    vertex_ids->clear();
+    for ( size_t i = 0; i < nvertices; i++ )
+    {
+        if ( representatives[i] == i )
+        {
+            new_ids[i] = kvs::UInt32( vertex_ids->size() );
+            vertex_ids->push_back( kvs::UInt32( i ) );
+        }
+    }
+
+    triangles->resize( nvertices );
+    for ( size_t i = 0; i < nvertices; i++ )
+    {
+        (*triangles)[i] = new_ids[ representatives[i] ];
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Triangle mesh being simplified.
+ */
+/*===========================================================================*/
+class Mesh
+{
+public:
+    std::vector<kvs::Vec3d> positions; ///< vertex positions
+    std::vector<Quadric> quadrics; ///< accumulated vertex quadrics
+    std::vector<kvs::UInt8> fixed; ///< 1 for boundary and non-manifold vertices
+    std::vector<kvs::Vec3> colors; ///< vertex colors (optional)
+    std::vector<kvs::Real32> opacities; ///< vertex opacities (optional)
+    std::vector<kvs::Vec3> normals; ///< vertex normals (optional)
+    std::vector<kvs::UInt32> triangles; ///< vertex IDs (three per triangle)
+    std::vector<kvs::UInt32> face_ids; ///< input polygon ID of each triangle
+    std::vector<kvs::UInt8> alive; ///< 0 for triangles removed in the current pass
+    std::vector<kvs::UInt32> offsets; ///< vertex-to-triangle offsets
+    std::vector<kvs::UInt32> indices; ///< vertex-to-triangle indices
+    std::vector<kvs::UInt8> locked; ///< 1 for vertices touched in the current pass
+
+    size_t numberOfVertices() const { return positions.size(); }
+    size_t numberOfTriangles() const { return triangles.size() / 3; }
+
+    kvs::Vec3d faceNormal( const size_t t ) const
+    {
+        const kvs::Vec3d& p0 = positions[ triangles[ 3 * t + 0 ] ];
+        const kvs::Vec3d& p1 = positions[ triangles[ 3 * t + 1 ] ];
+        const kvs::Vec3d& p2 = positions[ triangles[ 3 * t + 2 ] ];
+        return ( p1 - p0 ).cross( p2 - p0 );
+    }
+
+    void updateAdjacency()
+    {
+        const size_t nvertices = this->numberOfVertices();
+        const size_t ntriangles = this->numberOfTriangles();
+        offsets.assign( nvertices + 1, 0 );
+        for ( size_t i = 0; i < 3 * ntriangles; i++ ) { offsets[ triangles[i] + 1 ]++; }
+        for ( size_t i = 0; i < nvertices; i++ ) { offsets[ i + 1 ] += offsets[i]; }
+
+        indices.resize( 3 * ntriangles );
+        std::vector<kvs::UInt32> cursor( offsets.begin(), offsets.end() - 1 );
+        for ( size_t i = 0; i < 3 * ntriangles; i++ )
+        {
+            indices[ cursor[ triangles[i] ]++ ] = kvs::UInt32( i / 3 );
+        }
+    }
+
+    void updateQuadrics()
+    {
+        const size_t nvertices = this->numberOfVertices();
+        quadrics.resize( nvertices );
+        KVS_OMP_PARALLEL_FOR( schedule(static) )
+        for ( long i = 0; i < long( nvertices ); i++ )
+        {
+            Quadric q;
+            for ( kvs::UInt32 k = offsets[i]; k < offsets[ i + 1 ]; k++ )
+            {
+                const size_t t = indices[k];
+                const kvs::Vec3d n = this->faceNormal( t );
+                const double length = n.length();
+                if ( length > 0.0 )
+                {
+                    const kvs::Vec3d u = n / length;
+                    q += Quadric( u, -u.dot( positions[ triangles[ 3 * t ] ] ) );
+                }
+            }
+            quadrics[i] = q;
+        }
+    }
+
+    void updateFixedVertices()
+    {
+        const size_t nvertices = this->numberOfVertices();
+        fixed.assign( nvertices, 0 );
+        KVS_OMP_PARALLEL()
+        {
+            std::vector<kvs::UInt32> neighbors;
+            KVS_OMP_FOR( schedule(static) )
+            for ( long i = 0; i < long( nvertices ); i++ )
+            {
+                // Every edge around an interior vertex is shared by exactly two triangles.
+                neighbors.clear();
+                bool degenerated = false;
+                for ( kvs::UInt32 k = offsets[i]; k < offsets[ i + 1 ]; k++ )
+                {
+                    const kvs::UInt32* id = &triangles[ 3 * indices[k] ];
+                    if ( id[0] == id[1] || id[1] == id[2] || id[2] == id[0] ) { degenerated = true; }
+                    for ( size_t j = 0; j < 3; j++ )
+                    {
+                        if ( id[j] != kvs::UInt32( i ) ) { neighbors.push_back( id[j] ); }
+                    }
+                }
+                std::sort( neighbors.begin(), neighbors.end() );
+
+                bool manifold = !degenerated;
+                for ( size_t j = 0; j < neighbors.size() && manifold; )
+                {
+                    size_t n = j + 1;
+                    while ( n < neighbors.size() && neighbors[n] == neighbors[j] ) { n++; }
+                    manifold = ( n - j == 2 );
+                    j = n;
+                }
+                fixed[i] = manifold ? 0 : 1;
+            }
+        }
+    }
+
+    Candidate evaluate( kvs::UInt32 a, kvs::UInt32 b ) const
+    {
+        Candidate candidate;
+        candidate.cost = std::numeric_limits<double>::infinity();
+        if ( a == b || ( fixed[a] && fixed[b] ) ) { return candidate; }
+        if ( fixed[b] ) { std::swap( a, b ); }
+
+        Quadric q = quadrics[a];
+        q += quadrics[b];
+
+        const kvs::Vec3d& pa = positions[a];
+        const kvs::Vec3d& pb = positions[b];
+        kvs::Vec3d p = pa;
+        if ( !fixed[a] )
+        {
+            // Fall back to the best of the end points and the midpoint when the
+            // optimal position is undetermined or drifts away from the edge.
+            const kvs::Vec3d pm = ( pa + pb ) * 0.5;
+            if ( !q.minimize( &p ) || ( p - pm ).squaredLength() > ( pb - pa ).squaredLength() )
+            {
+                const double ea = q.error( pa );
+                const double eb = q.error( pb );
+                const double em = q.error( pm );
+                p = ( em <= ea && em <= eb ) ? pm : ( ea <= eb ) ? pa : pb;
+            }
+        }
+
+        candidate.cost = std::max( q.error( p ), 0.0 );
+        candidate.keep = a;
+        candidate.remove = b;
+        candidate.position = p;
+        return candidate;
+    }
+
+    bool collapsible( const Candidate& c ) const
+    {
+        const kvs::UInt32 a = c.keep;
+        const kvs::UInt32 b = c.remove;
+
+        // Link condition: an interior edge must be shared by exactly two triangles
+        // and its end points must have exactly two common neighbors.
+        std::vector<kvs::UInt32> na;
+        std::vector<kvs::UInt32> nb;
+        size_t nshared = 0;
+        for ( kvs::UInt32 k = offsets[a]; k < offsets[ a + 1 ]; k++ )
+        {
+            const kvs::UInt32 t = indices[k];
+            if ( !alive[t] ) { continue; }
+            for ( size_t j = 0; j < 3; j++ )
+            {
+                const kvs::UInt32 v = triangles[ 3 * t + j ];
+                if ( v != a ) { na.push_back( v ); }
+            }
+        }
+        for ( kvs::UInt32 k = offsets[b]; k < offsets[ b + 1 ]; k++ )
+        {
+            const kvs::UInt32 t = indices[k];
+            if ( !alive[t] ) { continue; }
+            bool shared = false;
+            for ( size_t j = 0; j < 3; j++ )
+            {
+                const kvs::UInt32 v = triangles[ 3 * t + j ];
+                if ( v == a ) { shared = true; }
+                if ( v != b ) { nb.push_back( v ); }
+            }
+            if ( shared ) { nshared++; }
+        }
+        if ( nshared != 2 ) { return false; }
+
+        std::sort( na.begin(), na.end() );
+        na.erase( std::unique( na.begin(), na.end() ), na.end() );
+        std::sort( nb.begin(), nb.end() );
+        nb.erase( std::unique( nb.begin(), nb.end() ), nb.end() );
+        std::vector<kvs::UInt32> common;
+        std::set_intersection( na.begin(), na.end(), nb.begin(), nb.end(), std::back_inserter( common ) );
+        if ( common.size() != 2 ) { return false; }
+
+        // Reject collapses that flip or fold the remaining triangles.
+        const kvs::UInt32 ends[2] = { a, b };
+        for ( size_t e = 0; e < 2; e++ )
+        {
+            const kvs::UInt32 v = ends[e];
+            for ( kvs::UInt32 k = offsets[v]; k < offsets[ v + 1 ]; k++ )
+            {
+                const kvs::UInt32 t = indices[k];
+                if ( !alive[t] ) { continue; }
+
+                kvs::Vec3d p[3];
+                bool shared = false;
+                for ( size_t j = 0; j < 3; j++ )
+                {
+                    const kvs::UInt32 id = triangles[ 3 * t + j ];
+                    if ( id == ends[ 1 - e ] ) { shared = true; }
+                    p[j] = ( id == v ) ? c.position : positions[id];
+                }
+                if ( shared ) { continue; }
+
+                const kvs::Vec3d n0 = this->faceNormal( t );
+                const kvs::Vec3d n1 = ( p[1] - p[0] ).cross( p[2] - p[0] );
+                const double l0 = n0.length();
+                const double l1 = n1.length();
+                if ( !( l1 > 0.0 ) ) { return false; }
+                if ( l0 > 0.0 && n0.dot( n1 ) < MinNormalCosine * l0 * l1 ) { return false; }
+            }
+        }
+
+        return true;
+    }
+
+    size_t collapse( const Candidate& c )
+    {
+        const kvs::UInt32 a = c.keep;
+        const kvs::UInt32 b = c.remove;
+
+        // Interpolate the vertex attributes at the projection onto the edge.
+        const kvs::Vec3d e = positions[b] - positions[a];
+        const double l = e.squaredLength();
+        const double s = l > 0.0 ? kvs::Math::Clamp( ( c.position - positions[a] ).dot( e ) / l, 0.0, 1.0 ) : 0.0;
+        const float t = static_cast<float>( s );
+        if ( !colors.empty() ) { colors[a] = colors[a] * ( 1.0f - t ) + colors[b] * t; }
+        if ( !opacities.empty() ) { opacities[a] = opacities[a] * ( 1.0f - t ) + opacities[b] * t; }
+        if ( !normals.empty() ) { normals[a] = normals[a] * ( 1.0f - t ) + normals[b] * t; }
+
+        size_t nremoved = 0;
+        for ( kvs::UInt32 k = offsets[b]; k < offsets[ b + 1 ]; k++ )
+        {
+            const kvs::UInt32 t = indices[k];
+            if ( !alive[t] ) { continue; }
+
+            kvs::UInt32* id = &triangles[ 3 * t ];
+            if ( id[0] == a || id[1] == a || id[2] == a ) { alive[t] = 0; nremoved++; }
+            else
+            {
+                for ( size_t j = 0; j < 3; j++ ) { if ( id[j] == b ) { id[j] = a; } }
+            }
+        }
+
+        // The adjacency of the one-ring is stale until the next pass.
+        const kvs::UInt32 ends[2] = { a, b };
+        for ( size_t i = 0; i < 2; i++ )
+        {
+            const kvs::UInt32 v = ends[i];
+            for ( kvs::UInt32 k = offsets[v]; k < offsets[ v + 1 ]; k++ )
+            {
+                const kvs::UInt32* id = &triangles[ 3 * indices[k] ];
+                locked[ id[0] ] = locked[ id[1] ] = locked[ id[2] ] = 1;
+            }
+        }
+
+        positions[a] = c.position;
+        quadrics[a] += quadrics[b];
+        return nremoved;
+    }
+
+    void removeDeadTriangles()
+    {
+        const size_t ntriangles = this->numberOfTriangles();
+        size_t n = 0;
+        for ( size_t i = 0; i < ntriangles; i++ )
+        {
+            if ( !alive[i] ) { continue; }
+            for ( size_t j = 0; j < 3; j++ ) { triangles[ 3 * n + j ] = triangles[ 3 * i + j ]; }
+            face_ids[n] = face_ids[i];
+            n++;
+        }
+        triangles.resize( 3 * n );
+        face_ids.resize( n );
+    }
+};
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new PolygonSimplification class.
+ *  @param  object [in] pointer to a triangle polygon object
+ *  @param  target_npolygons [in] target number of triangles
+ */
+/*===========================================================================*/
+PolygonSimplification::PolygonSimplification(
+    const kvs::PolygonObject* object,
+    const size_t target_npolygons ):
+    m_target_npolygons( target_npolygons )
+{
+    this->exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes this class.
+ *  @param  object [in] pointer to the object
+ *  @return pointer to the simplified object
+ */
+/*===========================================================================*/
+PolygonSimplification::SuperClass* PolygonSimplification::exec( const kvs::ObjectBase* object )
+{
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
+    if ( !object )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError( "Input object is NULL." );
+        return NULL;
+    }
+
+    const kvs::PolygonObject* polygon = kvs::PolygonObject::DownCast( object );
+    if ( !polygon )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError( "Input object is not supported." );
+        return NULL;
+    }
+
+    if ( polygon->polygonType() != kvs::PolygonObject::Triangle )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError( "Input polygon type is not supported." );
+        return NULL;
+    }
+
+    this->simplify( polygon );
+
+    SuperClass::updateMinMaxCoords();
+    BaseClass::setSuccess( true );
+
+    return this;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Simplifies the triangle mesh.
+ *  @param  polygon [in] pointer to the triangle polygon object
+ */
+/*===========================================================================*/
+void PolygonSimplification::simplify( const kvs::PolygonObject* polygon )
+{
+    const size_t nvertices = polygon->numberOfVertices();
+    const bool indexed = polygon->numberOfConnections() > 0;
+    const size_t npolygons = indexed ? polygon->numberOfConnections() : nvertices / 3;
+
+    ::Mesh mesh;
+    std::vector<kvs::UInt32> vertex_ids;
+    if ( indexed )
+    {
+        vertex_ids.resize( nvertices );
+        for ( size_t i = 0; i < nvertices; i++ ) { vertex_ids[i] = kvs::UInt32( i ); }
+        mesh.triangles.assign( polygon->connections().begin(), polygon->connections().end() );
+    }
+    else
+    {
+        ::Weld( polygon->coords(), &vertex_ids, &mesh.triangles );
+    }
+
+    mesh.face_ids.resize( npolygons );
+    for ( size_t i = 0; i < npolygons; i++ ) { mesh.face_ids[i] = kvs::UInt32( i ); }
+
+    // Vertex attributes are carried along the collapses; polygon attributes
+    // follow the surviving triangles.
+    const bool vertex_color = polygon->colorType() == kvs::PolygonObject::VertexColor;
+    const bool polygon_color = polygon->colorType() == kvs::PolygonObject::PolygonColor;
+    const bool has_vertex_colors = vertex_color && nvertices > 1 && polygon->numberOfColors() == nvertices;
+    const bool has_vertex_opacities = vertex_color && nvertices > 1 && polygon->numberOfOpacities() == nvertices;
+    const bool has_vertex_normals = polygon->normalType() == kvs::PolygonObject::VertexNormal && polygon->numberOfNormals() == nvertices;
+    const bool has_polygon_colors = polygon_color && npolygons > 1 && polygon->numberOfColors() == npolygons;
+    const bool has_polygon_opacities = polygon_color && npolygons > 1 && polygon->numberOfOpacities() == npolygons;
+    const bool has_polygon_normals = polygon->normalType() == kvs::PolygonObject::PolygonNormal && polygon->numberOfNormals() > 0;
+
+    const size_t nwelded = vertex_ids.size();
+    mesh.positions.resize( nwelded );
+    if ( has_vertex_colors ) { mesh.colors.resize( nwelded ); }
+    if ( has_vertex_opacities ) { mesh.opacities.resize( nwelded ); }
+    if ( has_vertex_normals ) { mesh.normals.resize( nwelded ); }
+    for ( size_t i = 0; i < nwelded; i++ )
+    {
+        const size_t id = vertex_ids[i];
+        mesh.positions[i] = kvs::Vec3d( polygon->coord( id ) );
+        if ( has_vertex_colors ) { mesh.colors[i] = kvs::Vec3( polygon->color( id ).toVec3i() ); }
+        if ( has_vertex_opacities ) { mesh.opacities[i] = polygon->opacity( id ); }
+        if ( has_vertex_normals ) { mesh.normals[i] = polygon->normal( id ); }
+    }
+
+    mesh.updateAdjacency();
+    mesh.updateQuadrics();
+    mesh.updateFixedVertices();
+
+    size_t ntriangles = mesh.numberOfTriangles();
+    std::vector<::Candidate> candidates;
+    while ( ntriangles > m_target_npolygons )
+    {
+        // Evaluate the cheapest edge of each triangle in parallel.
+        const size_t nt = mesh.numberOfTriangles();
+        candidates.resize( nt );
+        KVS_OMP_PARALLEL_FOR( schedule(static) )
+        for ( long i = 0; i < long( nt ); i++ )
+        {
+            const kvs::UInt32* id = &mesh.triangles[ 3 * i ];
+            ::Candidate best = mesh.evaluate( id[0], id[1] );
+            for ( size_t j = 1; j < 3; j++ )
+            {
+                const ::Candidate c = mesh.evaluate( id[j], id[ ( j + 1 ) % 3 ] );
+                if ( c.cost < best.cost ) { best = c; }
+            }
+            candidates[i] = best;
+        }
+
+        const double max_error = m_max_error;
+        candidates.erase( std::remove_if( candidates.begin(), candidates.end(),
+            [max_error]( const ::Candidate& c ) { return !( c.cost <= max_error ); } ), candidates.end() );
+        std::sort( candidates.begin(), candidates.end() );
+
+        // Collapse an independent set of edges in order of increasing error.
+        mesh.alive.assign( nt, 1 );
+        mesh.locked.assign( mesh.numberOfVertices(), 0 );
+        size_t ncollapses = 0;
+        for ( size_t i = 0; i < candidates.size() && ntriangles > m_target_npolygons; i++ )
+        {
+            const ::Candidate& c = candidates[i];
+            if ( mesh.locked[ c.keep ] || mesh.locked[ c.remove ] ) { continue; }
+            if ( !mesh.collapsible( c ) ) { continue; }
+            ntriangles -= mesh.collapse( c );
+            ncollapses++;
+        }
+
+        mesh.removeDeadTriangles();
+        if ( ncollapses == 0 ) { break; }
+        mesh.updateAdjacency();
+    }
+
+    // Compact the referenced vertices.
+    const size_t nt = mesh.numberOfTriangles();
+    std::vector<kvs::UInt8> referenced( mesh.numberOfVertices(), 0 );
+    for ( size_t i = 0; i < 3 * nt; i++ ) { referenced[ mesh.triangles[i] ] = 1; }
+    std::vector<kvs::UInt32> new_ids( mesh.numberOfVertices(), 0 );
+    size_t nv = 0;
+    for ( size_t i = 0; i < new_ids.size(); i++ )
+    {
+        if ( referenced[i] ) { new_ids[i] = kvs::UInt32( nv++ ); }
+    }
+
+    kvs::ValueArray<kvs::Real32> coords( 3 * nv );
+    kvs::ValueArray<kvs::UInt8> colors( has_vertex_colors ? 3 * nv : has_polygon_colors ? 3 * nt : 0 );
+    kvs::ValueArray<kvs::UInt8> opacities( has_vertex_opacities ? nv : has_polygon_opacities ? nt : 0 );
+    kvs::ValueArray<kvs::Real32> normals( has_vertex_normals ? 3 * nv : has_polygon_normals ? 3 * nt : 0 );
+    for ( size_t i = 0; i < mesh.numberOfVertices(); i++ )
+    {
+        if ( !referenced[i] ) { continue; }
+        const size_t n = new_ids[i];
+        const kvs::Vec3d& p = mesh.positions[i];
+        coords[ 3 * n + 0 ] = static_cast<kvs::Real32>( p.x() );
+        coords[ 3 * n + 1 ] = static_cast<kvs::Real32>( p.y() );
+        coords[ 3 * n + 2 ] = static_cast<kvs::Real32>( p.z() );
+        if ( has_vertex_colors )
+        {
+            for ( size_t j = 0; j < 3; j++ )
+            {
+                colors[ 3 * n + j ] = static_cast<kvs::UInt8>( kvs::Math::Clamp( mesh.colors[i][j] + 0.5f, 0.0f, 255.0f ) );
+            }
+        }
+        if ( has_vertex_opacities )
+        {
+            opacities[n] = static_cast<kvs::UInt8>( kvs::Math::Clamp( mesh.opacities[i] + 0.5f, 0.0f, 255.0f ) );
+        }
+        if ( has_vertex_normals )
+        {
+            // The interpolated normals can cancel out; such a vertex keeps its input normal.
+            const kvs::Vec3& m = mesh.normals[i];
+            const float length = m.length();
+            const kvs::Vec3 v = length > 0.0f ? m / length : polygon->normal( vertex_ids[i] );
+            normals[ 3 * n + 0 ] = v.x();
+            normals[ 3 * n + 1 ] = v.y();
+            normals[ 3 * n + 2 ] = v.z();
+        }
+    }
+
+    kvs::ValueArray<kvs::UInt32> connections( 3 * nt );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nt ); i++ )
+    {
+        for ( size_t j = 0; j < 3; j++ )
+        {
+            connections[ 3 * i + j ] = new_ids[ mesh.triangles[ 3 * i + j ] ];
+        }
+
+        const size_t id = mesh.face_ids[i];
+        if ( has_polygon_colors )
+        {
+            const kvs::RGBColor c = polygon->color( id );
+            colors[ 3 * i + 0 ] = c.r();
+            colors[ 3 * i + 1 ] = c.g();
+            colors[ 3 * i + 2 ] = c.b();
+        }
+        if ( has_polygon_opacities ) { opacities[i] = polygon->opacity( id ); }
+        if ( has_polygon_normals )
+        {
+            // A zero-area face keeps the normal of its input polygon.
+            const kvs::Vec3d m = mesh.faceNormal( i );
+            const double length = m.length();
+            const kvs::Vec3d v = length > 0.0 ? m / length :
+                kvs::Vec3d( polygon->normal( kvs::Math::Min( id, polygon->numberOfNormals() - 1 ) ) );
+            normals[ 3 * i + 0 ] = static_cast<kvs::Real32>( v.x() );
+            normals[ 3 * i + 1 ] = static_cast<kvs::Real32>( v.y() );
+            normals[ 3 * i + 2 ] = static_cast<kvs::Real32>( v.z() );
+        }
+    }
+
+    SuperClass::setCoords( coords );
+    SuperClass::setConnections( connections );
+    SuperClass::setNormals( normals );
+    SuperClass::setPolygonTypeToTriangle();
+    SuperClass::setColorType( polygon->colorType() );
+    SuperClass::setNormalType( polygon->normalType() );
+    if ( colors.size() > 0 ) { SuperClass::setColors( colors ); }
+    else if ( polygon->numberOfColors() > 0 ) { SuperClass::setColor( polygon->color() ); }
+    if ( opacities.size() > 0 ) { SuperClass::setOpacities( opacities ); }
+    else if ( polygon->numberOfOpacities() > 0 ) { SuperClass::setOpacity( polygon->opacity() ); }
+    else { SuperClass::setOpacity( 255 ); }
+}
+
+} // end of namespace kvs
@@ -0,0 +1,56 @@
+/****************************************************************************/
+/**
+ *  @file   PolygonSimplification.h
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#pragma once
+#include <limits>
+#include <kvs/PolygonObject>
+#include <kvs/Module>
+#include <kvs/FilterBase>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Quadric error metric based simplification of triangle meshes.
+ *
+ *  Edges are collapsed in order of increasing quadric error until the number
+ *  of triangles falls to the target or the smallest error exceeds the bound.
+ *  Each pass evaluates the collapse costs in parallel and then collapses an
+ *  independent set of edges, so that the mesh is reduced by a large fraction
+ *  per pass. Boundary and non-manifold edges are kept fixed. Vertex colors,
+ *  opacities and normals are interpolated along the collapsed edges.
+ */
+/*===========================================================================*/
+class PolygonSimplification : public kvs::FilterBase, public kvs::PolygonObject
+{
+    kvsModule( kvs::PolygonSimplification, Filter );
+    kvsModuleBaseClass( kvs::FilterBase );
+    kvsModuleSuperClass( kvs::PolygonObject );
+
+private:
+    size_t m_target_npolygons = 0; ///< target number of triangles (0: no target)
+    double m_max_error = std::numeric_limits<double>::max(); ///< max. quadric error
+
+public:
+    PolygonSimplification() = default;
+    PolygonSimplification( const kvs::PolygonObject* object, const size_t target_npolygons );
+    virtual ~PolygonSimplification() = default;
+
+    size_t targetNumberOfPolygons() const { return m_target_npolygons; }
+    double maxError() const { return m_max_error; }
+
+    void setTargetNumberOfPolygons( const size_t target_npolygons ) { m_target_npolygons = target_npolygons; }
+    void setMaxError( const double max_error ) { m_max_error = max_error; }
+
+    SuperClass* exec( const kvs::ObjectBase* object );
+
+private:
+    void simplify( const kvs::PolygonObject* polygon );
+};
+
+} // end of namespace kvs
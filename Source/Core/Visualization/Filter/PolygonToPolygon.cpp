@@ -6,6 +6,7 @@
 /*****************************************************************************/
 #include "PolygonToPolygon.h"
 #include <map>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -51,6 +52,8 @@ PolygonToPolygon::~PolygonToPolygon()
 /*===========================================================================*/
 PolygonToPolygon::SuperClass* PolygonToPolygon::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
       BaseClass::setSuccess( false );
@@ -177,12 +180,12 @@ void PolygonToPolygon::calculate_triangle_connections( const kvs::PolygonObject*
         }
     }
 
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
+    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( std::move( connections ) ) );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setColorType( kvs::PolygonObject::VertexColor );
-    if ( has_colors ) SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
+    if ( has_colors ) SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( std::move( colors ) ) );
     else SuperClass::setColor( object->color() );
 }
 
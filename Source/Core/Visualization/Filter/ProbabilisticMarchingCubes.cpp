@@ -13,6 +13,7 @@
 #include <kvs/Vector3>
 #include <kvs/InverseDistanceWeighting>
 #include <random>
+#include <kvs/Profiler>
 
 
 namespace
@@ -373,6 +374,8 @@ using ThisClass = kvs::ProbabilisticMarchingCubes;
 
 ThisClass::SuperClass* ThisClass::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -13,6 +13,7 @@
 #include "ProjectedFieldSimilarity.h"
 #include <kvs/MultiDimensionalScaling>
 #include <kvs/FieldSimilarity>
+#include <kvs/Profiler>
 
 
 namespace
@@ -69,6 +70,8 @@ using ThisClass = ProjectedFieldSimilarity;
 
 ThisClass::SuperClass* ThisClass::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
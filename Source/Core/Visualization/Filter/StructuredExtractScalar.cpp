@@ -5,6 +5,7 @@
  */
 /*****************************************************************************/
 #include "StructuredExtractScalar.h"
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -34,6 +35,8 @@ StructuredExtractScalar::StructuredExtractScalar(
 /*===========================================================================*/
 StructuredExtractScalar::SuperClass* StructuredExtractScalar::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -6,6 +6,7 @@
 /*****************************************************************************/
 #include "StructuredVectorToScalar.h"
 #include <kvs/Math>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -49,6 +50,8 @@ StructuredVectorToScalar::~StructuredVectorToScalar()
 /*===========================================================================*/
 StructuredVectorToScalar::SuperClass* StructuredVectorToScalar::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
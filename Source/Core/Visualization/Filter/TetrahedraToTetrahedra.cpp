@@ -6,8 +6,10 @@
 /*****************************************************************************/
 #include "TetrahedraToTetrahedra.h"
 #include <algorithm>
-#include <map>
+#include <vector>
 #include <kvs/AnyValueArray>
+#include <kvs/OpenMP>
+#include <kvs/Profiler>
 
 
 namespace
@@ -15,71 +17,20 @@ namespace
 
 /*===========================================================================*/
 /**
- *  @brief  ID map class for removing the duplicated nodes.
+ *  @brief  Connections of the eight linear tetrahedra in a quadratic tetrahedron.
  */
 /*===========================================================================*/
-class IDMap
-{
-public:
-
-    typedef kvs::UInt32 Key;
-    typedef kvs::UInt32 Value;
-    typedef std::map<Key,Value> Bucket;
-
-private:
-
-    size_t m_index; ///< index of the connection ID
-    Bucket m_bucket; ///< bucket for the IDs
-
-public:
-
-    IDMap();
-
-    const Bucket& bucket() const;
-    void insert( const kvs::UInt32 id );
+const size_t SubTetrahedra[8][4] = {
+    { 0, 4, 5, 6 },
+    { 4, 1, 7, 9 },
+    { 5, 7, 2, 8 },
+    { 6, 9, 8, 3 },
+    { 5, 6, 4, 9 },
+    { 5, 9, 4, 7 },
+    { 5, 8, 9, 7 },
+    { 5, 6, 9, 8 }
 };
 
-/*===========================================================================*/
-/**
- *  @brief  Constructs a new IDMap class.
- */
-/*===========================================================================*/
-IDMap::IDMap():
-    m_index( 0 )
-{
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns the ID bucket.
- *  @return ID bucket
- */
-/*===========================================================================*/
-const IDMap::Bucket& IDMap::bucket() const
-{
-    return m_bucket;
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Inserts a ID.
- *  @param  id [in] ID
- */
-/*===========================================================================*/
-void IDMap::insert( const kvs::UInt32 id )
-{
-    const Key key = id;
-    const Value value = m_index;
-
-    Bucket::iterator i = m_bucket.find( key );
-    Bucket::const_iterator last = m_bucket.end();
-    if ( i == last )
-    {
-        m_bucket.insert( Bucket::value_type( key, value ) );
-        m_index++;
-    }
-}
-
 } // end of namespace
 
 
@@ -129,6 +80,8 @@ TetrahedraToTetrahedra::~TetrahedraToTetrahedra()
 /*===========================================================================*/
 TetrahedraToTetrahedra::SuperClass* TetrahedraToTetrahedra::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -221,63 +174,24 @@ void TetrahedraToTetrahedra::subdivide_8_tetrahedra( const kvs::UnstructuredVolu
     const size_t tet2_ncells = volume->numberOfCells();
     const kvs::UInt32* tet2_pconnections = volume->connections().data();
 
-    // Tetrahedral cells.
+    // Tetrahedral cells. Each quadratic cell is subdivided into the fixed
+    // number of cells, so that the output offset of the cell is given directly.
     const size_t ndivisions = 8;
     const size_t tet_ncells = tet2_ncells * ndivisions;
     kvs::ValueArray<kvs::UInt32> tet_connections( tet_ncells * 4 );
     kvs::UInt32* tet_pconnections = tet_connections.data();
-    for ( size_t i = 0; i < tet2_ncells; i++ )
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( tet2_ncells ); i++ )
     {
-        const kvs::UInt32 id0 = *(tet2_pconnections++);
-        const kvs::UInt32 id1 = *(tet2_pconnections++);
-        const kvs::UInt32 id2 = *(tet2_pconnections++);
-        const kvs::UInt32 id3 = *(tet2_pconnections++);
-        const kvs::UInt32 id4 = *(tet2_pconnections++);
-        const kvs::UInt32 id5 = *(tet2_pconnections++);
-        const kvs::UInt32 id6 = *(tet2_pconnections++);
-        const kvs::UInt32 id7 = *(tet2_pconnections++);
-        const kvs::UInt32 id8 = *(tet2_pconnections++);
-        const kvs::UInt32 id9 = *(tet2_pconnections++);
-
-        *(tet_pconnections++) = id0;
-        *(tet_pconnections++) = id4;
-        *(tet_pconnections++) = id5;
-        *(tet_pconnections++) = id6;
-
-        *(tet_pconnections++) = id4;
-        *(tet_pconnections++) = id1;
-        *(tet_pconnections++) = id7;
-        *(tet_pconnections++) = id9;
-
-        *(tet_pconnections++) = id5;
-        *(tet_pconnections++) = id7;
-        *(tet_pconnections++) = id2;
-        *(tet_pconnections++) = id8;
-
-        *(tet_pconnections++) = id6;
-        *(tet_pconnections++) = id9;
-        *(tet_pconnections++) = id8;
-        *(tet_pconnections++) = id3;
-
-        *(tet_pconnections++) = id5;
-        *(tet_pconnections++) = id6;
-        *(tet_pconnections++) = id4;
-        *(tet_pconnections++) = id9;
-
-        *(tet_pconnections++) = id5;
-        *(tet_pconnections++) = id9;
-        *(tet_pconnections++) = id4;
-        *(tet_pconnections++) = id7;
-
-        *(tet_pconnections++) = id5;
-        *(tet_pconnections++) = id8;
-        *(tet_pconnections++) = id9;
-        *(tet_pconnections++) = id7;
-
-        *(tet_pconnections++) = id5;
-        *(tet_pconnections++) = id6;
-        *(tet_pconnections++) = id9;
-        *(tet_pconnections++) = id8;
+        const kvs::UInt32* id = tet2_pconnections + 10 * i;
+        kvs::UInt32* connection = tet_pconnections + 4 * ndivisions * i;
+        for ( size_t j = 0; j < ndivisions; j++ )
+        {
+            *(connection++) = id[ ::SubTetrahedra[j][0] ];
+            *(connection++) = id[ ::SubTetrahedra[j][1] ];
+            *(connection++) = id[ ::SubTetrahedra[j][2] ];
+            *(connection++) = id[ ::SubTetrahedra[j][3] ];
+        }
     }
 
     if ( volume->hasMinMaxExternalCoords() )
@@ -324,57 +238,58 @@ void TetrahedraToTetrahedra::remove_quadratic_nodes( const kvs::UnstructuredVolu
     const T* tet2_pvalues = static_cast<const T*>( volume->values().data() );
     const kvs::Real32* tet2_pcoords = volume->coords().data();
 
-    ::IDMap id_map;
+    // Assign the new IDs to the vertex nodes in order of their first appearance.
+    // The flat table indexed by the node ID is used instead of an ordered map.
+    const kvs::UInt32 Unused = kvs::UInt32(-1);
+    const size_t tet2_nnodes = volume->numberOfNodes();
+    std::vector<kvs::UInt32> new_ids( tet2_nnodes, Unused );
+    std::vector<kvs::UInt32> old_ids; old_ids.reserve( tet2_nnodes );
     for ( size_t i = 0; i < tet2_ncells; i++ )
     {
-        const kvs::UInt32 id0 = tet2_pconnections[ 10 * i + 0 ];
-        const kvs::UInt32 id1 = tet2_pconnections[ 10 * i + 1 ];
-        const kvs::UInt32 id2 = tet2_pconnections[ 10 * i + 2 ];
-        const kvs::UInt32 id3 = tet2_pconnections[ 10 * i + 3 ];
-
-        id_map.insert( id0 );
-        id_map.insert( id1 );
-        id_map.insert( id2 );
-        id_map.insert( id3 );
+        for ( size_t j = 0; j < 4; j++ )
+        {
+            const kvs::UInt32 id = tet2_pconnections[ 10 * i + j ];
+            if ( new_ids[ id ] == Unused )
+            {
+                new_ids[ id ] = static_cast<kvs::UInt32>( old_ids.size() );
+                old_ids.push_back( id );
+            }
+        }
     }
 
     const size_t tet_ncells = tet2_ncells;
     kvs::ValueArray<kvs::UInt32> tet_connections( tet_ncells * 4 );
     kvs::UInt32* tet_pconnections = tet_connections.data();
-    for ( size_t i = 0; i < tet2_ncells; i++ )
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( tet2_ncells ); i++ )
     {
-        const kvs::UInt32 id0 = tet2_pconnections[ 10 * i + 0 ];
-        const kvs::UInt32 id1 = tet2_pconnections[ 10 * i + 1 ];
-        const kvs::UInt32 id2 = tet2_pconnections[ 10 * i + 2 ];
-        const kvs::UInt32 id3 = tet2_pconnections[ 10 * i + 3 ];
-
-        *(tet_pconnections++) = id_map.bucket().find( id0 )->second;
-        *(tet_pconnections++) = id_map.bucket().find( id1 )->second;
-        *(tet_pconnections++) = id_map.bucket().find( id2 )->second;
-        *(tet_pconnections++) = id_map.bucket().find( id3 )->second;
+        tet_pconnections[ 4 * i + 0 ] = new_ids[ tet2_pconnections[ 10 * i + 0 ] ];
+        tet_pconnections[ 4 * i + 1 ] = new_ids[ tet2_pconnections[ 10 * i + 1 ] ];
+        tet_pconnections[ 4 * i + 2 ] = new_ids[ tet2_pconnections[ 10 * i + 2 ] ];
+        tet_pconnections[ 4 * i + 3 ] = new_ids[ tet2_pconnections[ 10 * i + 3 ] ];
     }
 
     const size_t tet_veclen = volume->veclen();
-    const size_t tet_nnodes = id_map.bucket().size();
+    const size_t tet_nnodes = old_ids.size();
     kvs::ValueArray<T> tet_values( tet_nnodes * tet_veclen );
     kvs::ValueArray<kvs::Real32> tet_coords( tet_nnodes * 3 );
     T* tet_pvalues = tet_values.data();
     kvs::Real32* tet_pcoords = tet_coords.data();
-    ::IDMap::Bucket::const_iterator id = id_map.bucket().begin();
-    while ( id != id_map.bucket().end() )
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( tet_nnodes ); i++ )
     {
+        const size_t id = old_ids[i];
+
         // Value array.
-        for ( size_t i = 0; i < tet_veclen; i++ )
+        for ( size_t j = 0; j < tet_veclen; j++ )
         {
-            tet_pvalues[ id->second * tet_veclen + i ] = tet2_pvalues[ id->first * tet_veclen + i ];
+            tet_pvalues[ i * tet_veclen + j ] = tet2_pvalues[ id * tet_veclen + j ];
         }
 
         // Coordinate data array.
-        tet_pcoords[ id->second * 3 + 0 ] = tet2_pcoords[ id->first * 3 + 0 ];
-        tet_pcoords[ id->second * 3 + 1 ] = tet2_pcoords[ id->first * 3 + 1 ];
-        tet_pcoords[ id->second * 3 + 2 ] = tet2_pcoords[ id->first * 3 + 2 ];
-
-        ++id;
+        tet_pcoords[ i * 3 + 0 ] = tet2_pcoords[ id * 3 + 0 ];
+        tet_pcoords[ i * 3 + 1 ] = tet2_pcoords[ id * 3 + 1 ];
+        tet_pcoords[ i * 3 + 2 ] = tet2_pcoords[ id * 3 + 2 ];
     }
 
     if ( volume->hasMinMaxExternalCoords() )
@@ -8,6 +8,8 @@
 #define KVS__TRILINEAR_INTERPOLATOR_H_INCLUDE
 
 #include <kvs/StructuredVolumeObject>
+#include <kvs/BrickedVolumeObject>
+#include <kvs/AnyValueArray>
 #include <kvs/Vector3>
 #include <kvs/Assert>
 #include <cstring>
@@ -30,6 +32,12 @@ private:
     kvs::Real32 m_weight[8]; ///< weight for the neighbouring grid index
 
     const kvs::StructuredVolumeObject* m_reference_volume; ///< reference irregular volume data
+    const kvs::BrickedVolumeObject* m_bricked_volume; ///< reference bricked volume data (or NULL)
+    kvs::AnyValueArray m_brick; ///< values of the current brick for the bricked volume
+    kvs::Vector3ui m_brick_index; ///< index of the current brick
+    const void* m_data; ///< pointer to the values referred by the neighbouring grid index
+    size_t m_line_size; ///< number of nodes per line in the referred values
+    size_t m_slice_size; ///< number of nodes per slice in the referred values
 
 public:
 
@@ -38,6 +46,8 @@ public:
     void attachPoint( const kvs::Vector3f& point );
     const kvs::UInt32* indices( void ) const;
     template <typename T>
+    const T* values( void ) const;
+    template <typename T>
     kvs::Real32 scalar( void ) const;
     template <typename T>
     kvs::Vec3 gradient( void ) const;
@@ -51,10 +61,21 @@ public:
 /*===========================================================================*/
 inline TrilinearInterpolator::TrilinearInterpolator( const kvs::StructuredVolumeObject* volume ):
     m_grid_index( 0, 0, 0 ),
-    m_reference_volume( volume )
+    m_reference_volume( volume ),
+    m_bricked_volume( kvs::BrickedVolumeObject::DownCast( volume ) ),
+    m_brick_index( 0, 0, 0 ),
+    m_data( volume->values().data() ),
+    m_line_size( volume->numberOfNodesPerLine() ),
+    m_slice_size( volume->numberOfNodesPerSlice() )
 {
     std::memset( m_index, 0x00, sizeof( kvs::UInt32 ) * 8 );
     std::memset( m_weight, 0x00, sizeof( kvs::Real32 ) * 8 );
+
+    if ( m_bricked_volume )
+    {
+        m_line_size = m_bricked_volume->numberOfBrickNodesPerLine();
+        m_slice_size = m_bricked_volume->numberOfBrickNodesPerSlice();
+    }
 }
 
 /*===========================================================================*/
@@ -80,13 +101,35 @@ inline void TrilinearInterpolator::attachPoint( const kvs::Vector3f& point )
     const size_t j = ( tj >= resolution.y() - 1 ) ? resolution.y() - 2 : tj;
     const size_t k = ( tk >= resolution.z() - 1 ) ? resolution.z() - 2 : tk;
 
-    const size_t line_size  = m_reference_volume->numberOfNodesPerLine();
-    const size_t slice_size = m_reference_volume->numberOfNodesPerSlice();
+    const size_t line_size  = m_line_size;
+    const size_t slice_size = m_slice_size;
 
     // Calculate index.
     m_grid_index.set( i, j, k );
 
-    m_index[0] = i + j * line_size + k * slice_size;
+    if ( m_bricked_volume )
+    {
+        // The index is calculated in the brick which includes the cell. The
+        // brick is switched only when the cell is in the different brick.
+        const size_t brick_size = m_bricked_volume->brickSize();
+        const kvs::Vector3ui brick_index( i / brick_size, j / brick_size, k / brick_size );
+        if ( m_brick.empty() || brick_index != m_brick_index )
+        {
+            m_brick = m_bricked_volume->brick( brick_index );
+            m_brick_index = brick_index;
+            m_data = m_brick.data();
+        }
+
+        const size_t ghost = kvs::BrickedVolumeObject::LowerGhostSize;
+        const size_t li = i - brick_index.x() * brick_size + ghost;
+        const size_t lj = j - brick_index.y() * brick_size + ghost;
+        const size_t lk = k - brick_index.z() * brick_size + ghost;
+        m_index[0] = li + lj * line_size + lk * slice_size;
+    }
+    else
+    {
+        m_index[0] = i + j * line_size + k * slice_size;
+    }
     m_index[1] = m_index[0] + 1;
     m_index[2] = m_index[1] + line_size;
     m_index[3] = m_index[0] + line_size;
@@ -127,6 +170,18 @@ inline const kvs::UInt32* TrilinearInterpolator::indices( void ) const
     return m_index;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the pointer to the values referred by the index array.
+ *  @return pointer to the values (the current brick for the bricked volume)
+ */
+/*===========================================================================*/
+template <typename T>
+inline const T* TrilinearInterpolator::values( void ) const
+{
+    return reinterpret_cast<const T*>( m_data );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns the interpolated scalar.
@@ -136,7 +191,7 @@ inline const kvs::UInt32* TrilinearInterpolator::indices( void ) const
 template <typename T>
 inline float TrilinearInterpolator::scalar( void ) const
 {
-    const T* const data = reinterpret_cast<const T*>( m_reference_volume->values().data() );
+    const T* const data = this->values<T>();
 
     return(
         static_cast<float>(
@@ -162,11 +217,11 @@ inline kvs::Vec3 TrilinearInterpolator::gradient( void ) const
     // Calculate the point's gradient.
     float dx[8], dy[8], dz[8];
 
-    const T* const data = reinterpret_cast<const T*>( m_reference_volume->values().data() );
+    const T* const data = this->values<T>();
 
     const kvs::Vector3ui resolution = m_reference_volume->resolution();
-    const size_t line_size  = m_reference_volume->numberOfNodesPerLine();
-    const size_t slice_size = m_reference_volume->numberOfNodesPerSlice();
+    const size_t line_size  = m_line_size;
+    const size_t slice_size = m_slice_size;
 
     const size_t i = m_grid_index.x();
     const size_t j = m_grid_index.y();
@@ -5,321 +5,15 @@
  */
 /*****************************************************************************/
 #include "Tubeline.h"
-#include <kvs/Quaternion>
 #include <kvs/Math>
+#include <kvs/OpenMP>
+#include <cmath>
+#include <kvs/Profiler>
 
 
 namespace
 {
 
-/*===========================================================================*/
-/**
- *  @brief  Returns a vertex array of the line object.
- *  @param  line [in] pointer to the line object
- *  @return vertex array
- */
-/*===========================================================================*/
-const kvs::ValueArray<kvs::Real32> GetVertexArray( const kvs::LineObject* line )
-{
-    if ( line->lineType() == kvs::LineObject::Strip )
-    {
-        return line->coords();
-    }
-    else if ( line->lineType() == kvs::LineObject::Uniline )
-    {
-        const kvs::Real32* v = line->coords().data();
-        const kvs::UInt32* c = line->connections().data();
-
-        const size_t dimension = 3;
-        const size_t nvertices = line->numberOfConnections();
-        kvs::ValueArray<kvs::Real32> vertices( nvertices * dimension );
-        for ( size_t i = 0, index = 0; i < nvertices; i++, index += dimension )
-        {
-            const kvs::UInt32 id = c[i];
-            vertices[ index + 0 ] = v[ id * dimension + 0 ];
-            vertices[ index + 1 ] = v[ id * dimension + 1 ];
-            vertices[ index + 2 ] = v[ id * dimension + 2 ];
-        }
-
-        return vertices;
-    }
-    else
-    {
-        const kvs::ValueArray<kvs::Real32> empty;
-        return empty;
-    }
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns a vertex array of the line object.
- *  @param  line [in] line object
- *  @param  id1 [in] ID of the start vertex
- *  @param  id2 [in] ID of the end vertex
- *  @return vertex array
- */
-/*===========================================================================*/
-const kvs::ValueArray<kvs::Real32> GetVertexArray(
-    const kvs::LineObject* line,
-    const size_t id1,
-    const size_t id2 )
-{
-    if ( line->lineType() == kvs::LineObject::Polyline )
-    {
-        const kvs::Real32* v = line->coords().data();
-
-        const size_t dimension = 3;
-        const size_t nvertices = id2 - id1 + 1;
-        kvs::ValueArray<kvs::Real32> vertices( nvertices * dimension );
-        for ( size_t i = 0, index = 0; i < nvertices; i++, index += dimension )
-        {
-            const size_t id = id1 + i;
-            vertices[ index + 0 ] = v[ id * dimension + 0 ];
-            vertices[ index + 1 ] = v[ id * dimension + 1 ];
-            vertices[ index + 2 ] = v[ id * dimension + 2 ];
-        }
-
-        return vertices;
-    }
-    else if ( line->lineType() == kvs::LineObject::Segment )
-    {
-        const kvs::Real32* v = line->coords().data();
-
-        const size_t dimension = 3;
-        const size_t nvertices = 2;
-        kvs::ValueArray<kvs::Real32> vertices( nvertices * dimension );
-
-        vertices[0] = v[ id1 * dimension + 0 ];
-        vertices[1] = v[ id1 * dimension + 1 ];
-        vertices[2] = v[ id1 * dimension + 2 ];
-
-        vertices[3] = v[ id2 * dimension + 0 ];
-        vertices[4] = v[ id2 * dimension + 1 ];
-        vertices[5] = v[ id2 * dimension + 2 ];
-
-        return vertices;
-    }
-    else
-    {
-        const kvs::ValueArray<kvs::Real32> empty;
-        return empty;
-    }
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns a color array of the line object.
- *  @param  line [in] pointer to the line object
- *  @return color array
- */
-/*===========================================================================*/
-const kvs::ValueArray<kvs::UInt8> GetColorArray( const kvs::LineObject* line )
-{
-    if ( line->numberOfColors() == 1 )
-    {
-        const kvs::UInt8* c = line->colors().data();
-
-        const size_t ncomponents = 3;
-        const size_t ncolors = line->numberOfVertices();
-        kvs::ValueArray<kvs::UInt8> colors( ncolors * ncomponents );
-        for ( size_t i = 0, index = 0; i < ncolors; i++, index += ncomponents )
-        {
-            colors[ index + 0 ] = c[0];
-            colors[ index + 1 ] = c[1];
-            colors[ index + 2 ] = c[2];
-        }
-
-        return colors;
-    }
-    else if ( line->numberOfColors() > 1 )
-    {
-        return line->colors();
-    }
-    else
-    {
-        const kvs::ValueArray<kvs::UInt8> empty;
-        return empty;
-    }
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns a color array of the line object.
- *  @param  line [in] pointer to the line object
- *  @param  id1 [in] ID of the start vertex
- *  @param  id2 [in] ID of the end vertex
- *  @param  con_id [in]
- *  @return color array
- */
-/*===========================================================================*/
-const kvs::ValueArray<kvs::UInt8> GetColorArray(
-    const kvs::LineObject* line,
-    const size_t id1,
-    const size_t id2,
-    const size_t con_id )
-{
-    // Ponter to the color array of the line object.
-    const kvs::UInt8* c = line->colors().data();
-
-    // Number of components and number of colors.
-    const size_t ncomponents = 3;
-    const size_t ncolors = id2 - id1 + 1;
-
-    if ( line->numberOfColors() == 1 )
-    {
-        kvs::ValueArray<kvs::UInt8> colors( ncomponents * ncolors );
-        for ( size_t i = 0, index = 0; i < ncolors; i++, index += ncomponents )
-        {
-            colors[ index + 0 ] = c[0];
-            colors[ index + 1 ] = c[1];
-            colors[ index + 2 ] = c[2];
-        }
-
-        return colors;
-    }
-    else if ( line->numberOfColors() > 1 )
-    {
-        if ( line->colorType() == kvs::LineObject::LineColor )
-        {
-            kvs::ValueArray<kvs::UInt8> colors( ncomponents * ncolors );
-
-            const kvs::UInt32* n = line->connections().data();
-
-            size_t counter = 0;
-            for ( size_t i = 0, index = 0; i < con_id; i++, index += 2 )
-            {
-                const size_t index_0 = n[ index + 0 ];
-                const size_t index_1 = n[ index + 1 ];
-                counter += index_1 - index_0;
-            }
-            for ( size_t i = 0, index = 0; i < ncolors - 1; i++ , index += ncomponents )
-            {
-                const size_t j = ( i + counter ) * ncomponents;
-                colors[ index + 0 ] = c[ j + 0 ];
-                colors[ index + 1 ] = c[ j + 1 ];
-                colors[ index + 2 ] = c[ j + 2 ];
-            }
-            const size_t i1 = ( ncolors - 1 ) * ncomponents;
-            const size_t i2 = ( ncolors - 2 + counter ) * ncomponents;
-            colors[ i1 + 0 ] = c[ i2 + 0 ];
-            colors[ i1 + 1 ] = c[ i2 + 1 ];
-            colors[ i1 + 2 ] = c[ i2 + 2 ];
-
-            return colors;
-        }
-        else // kvs::LineObject::VertexColor
-        {
-            kvs::ValueArray<kvs::UInt8> colors( ncomponents * ncolors );
-            for ( size_t i = 0, index = 0; i < ncolors; i++, index += ncomponents )
-            {
-                const size_t id = id1 + i;
-                colors[ index + 0 ] = c[ id * ncomponents + 0 ];
-                colors[ index + 1 ] = c[ id * ncomponents + 1 ];
-                colors[ index + 2 ] = c[ id * ncomponents + 2 ];
-            }
-
-            return colors;
-        }
-    }
-    else
-    {
-        const kvs::ValueArray<kvs::UInt8> empty;
-        return empty;
-    }
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns a size array of the line object.
- *  @param  line [in] pointer of the line object
- *  @return size array
- */
-/*===========================================================================*/
-const kvs::ValueArray<kvs::Real32> GetSizeArray( const kvs::LineObject* line )
-{
-    if ( line->numberOfSizes() == 1 )
-    {
-        const kvs::Real32* s = line->sizes().data();
-
-        const size_t nsizes = line->numberOfVertices() - 1;
-        kvs::ValueArray<kvs::Real32> sizes( nsizes );
-        for ( size_t i = 0; i < nsizes; i++ )
-        {
-            sizes[i] = s[0];
-        }
-
-        return sizes;
-    }
-    else if ( line->numberOfSizes() > 1 )
-    {
-        return line->sizes();
-    }
-    else
-    {
-        const kvs::ValueArray<kvs::Real32> empty;
-        return empty;
-    }
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Returns a size array of the line object.
- *  @param  line [in] pointer to the line object
- *  @param  id1 [in] ID of the start vertex
- *  @param  id2 [in] ID of the end vertex
- *  @param  con_id [in]
- *  @return size array
- */
-/*===========================================================================*/
-const kvs::ValueArray<kvs::Real32> GetSizeArray(
-    const kvs::LineObject* line,
-    const size_t id1,
-    const size_t id2,
-    const size_t con_id )
-{
-    // Ponter to the size array of the line object.
-    const kvs::Real32* s = line->sizes().data();
-
-    // Number of components of the size array.
-    const size_t nsizes = id2 - id1 + 1;
-
-    if ( line->numberOfSizes() == 1 )
-    {
-        kvs::ValueArray<kvs::Real32> sizes( nsizes );
-        for ( size_t i = 0; i < nsizes; i++ )
-        {
-            sizes[i] = s[0];
-        }
-
-        return sizes;
-    }
-    else if ( line->numberOfSizes() > 1 )
-    {
-        kvs::ValueArray<kvs::Real32> sizes( nsizes );
-
-        const kvs::UInt32* n = line->connections().data();
-
-        size_t counter = 0;
-        for ( size_t i = 0, index = 0; i < con_id; i++, index += 2 )
-        {
-            const size_t index_0 = n[ index + 0 ];
-            const size_t index_1 = n[ index + 1 ];
-            counter += index_1 - index_0;
-        }
-        for ( size_t i = 0; i < nsizes; i++ )
-        {
-            sizes[i] = s[ i + counter ];
-        }
-
-        return sizes;
-    }
-    else
-    {
-        const kvs::ValueArray<kvs::Real32> empty;
-        return empty;
-    }
-}
-
 /*===========================================================================*/
 /**
  *  @brief  Returns a color array of the line object.
@@ -347,27 +41,34 @@ kvs::PolygonObject::ColorType GetColorType( const kvs::LineObject* line )
 
 /*===========================================================================*/
 /**
- *  @brief  Returns a number of the vertices of the polygon object.
- *  @param  line [in] pointer to the line object
- *  @return number of the vertices
+ *  @brief  Returns the normalized vector, or the fallback for a zero vector.
+ *  @param  v [in] vector
+ *  @param  fallback [in] vector returned when v has zero length
+ *  @return normalized vector
  */
 /*===========================================================================*/
-size_t GetNumberOfVertices( const kvs::LineObject* line )
+inline kvs::Vec3 Normalized( const kvs::Vec3& v, const kvs::Vec3& fallback )
 {
-    size_t nvertices = 0;
-    switch ( line->lineType() )
-    {
-    case kvs::LineObject::Strip:
-        nvertices = line->numberOfVertices();
-        break;
-    case kvs::LineObject::Uniline:
-        nvertices = line->numberOfConnections();
-        break;
-    default:
-        break;
-    }
+    const float length = static_cast<float>( v.length() );
+    return length > 0.0f ? v / length : fallback;
+}
 
-    return nvertices;
+/*===========================================================================*/
+/**
+ *  @brief  Returns a unit vector perpendicular to the given unit vector.
+ *  @param  t [in] unit vector
+ *  @return perpendicular unit vector
+ */
+/*===========================================================================*/
+inline kvs::Vec3 Perpendicular( const kvs::Vec3& t )
+{
+    const float ax = std::abs( t.x() );
+    const float ay = std::abs( t.y() );
+    const float az = std::abs( t.z() );
+    const kvs::Vec3 axis =
+        ( ax <= ay && ax <= az ) ? kvs::Vec3( 1.0f, 0.0f, 0.0f ) :
+        ( ay <= az ) ? kvs::Vec3( 0.0f, 1.0f, 0.0f ) : kvs::Vec3( 0.0f, 0.0f, 1.0f );
+    return ::Normalized( t.cross( axis ), kvs::Vec3( 1.0f, 0.0f, 0.0f ) );
 }
 
 } // end of namespace
@@ -383,7 +84,8 @@ namespace kvs
 /*===========================================================================*/
 Tubeline::Tubeline( void ):
     kvs::FilterBase(),
-    m_ndivisions( 0 )
+    m_ndivisions( 0 ),
+    m_enable_triangulation( false )
 {
 }
 
@@ -397,7 +99,8 @@ Tubeline::Tubeline( void ):
 Tubeline::Tubeline(
     const kvs::LineObject* line,
     const size_t ndivisions ):
-    m_ndivisions( ndivisions )
+    m_ndivisions( ndivisions ),
+    m_enable_triangulation( false )
 {
     this->exec( line );
 }
@@ -431,6 +134,8 @@ void Tubeline::setNumberOfDivisions( const size_t ndivisions )
 /*===========================================================================*/
 Tubeline::SuperClass* Tubeline::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -446,6 +151,13 @@ Tubeline::SuperClass* Tubeline::exec( const kvs::ObjectBase* object )
         return NULL;
     }
 
+    if ( line->numberOfSizes() == 0 )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input object has no line size.");
+        return NULL;
+    }
+
     // Set the min/max coordinates.
     SuperClass::setMinMaxObjectCoords( line->minObjectCoord(), line->maxObjectCoord() );
     SuperClass::setMinMaxExternalCoords( line->minExternalCoord(), line->maxExternalCoord() );
@@ -474,6 +186,7 @@ Tubeline::SuperClass* Tubeline::exec( const kvs::ObjectBase* object )
         return NULL;
     }
 
+    BaseClass::setSuccess( true );
     return this;
 }
 
@@ -485,35 +198,15 @@ Tubeline::SuperClass* Tubeline::exec( const kvs::ObjectBase* object )
 /*===========================================================================*/
 void Tubeline::filtering_strip( const kvs::LineObject* line )
 {
-    const kvs::ValueArray<kvs::Real32> line_vertices = ::GetVertexArray( line );
-    const kvs::ValueArray<kvs::Real32> line_sizes = ::GetSizeArray( line );
-    const kvs::ValueArray<kvs::UInt8> line_colors = ::GetColorArray( line );
-    const size_t nvertices = ::GetNumberOfVertices( line );
-    const kvs::PolygonObject::ColorType color_type = ::GetColorType( line );
-
-    std::vector<kvs::Real32> vertices;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
-    std::vector<kvs::Real32> normals;
-    this->calculate_tubes(
-        &vertices,
-        &colors,
-        &connections,
-        &normals,
-        line_vertices,
-        line_sizes,
-        line_colors,
-        nvertices,
-        color_type );
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( vertices ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
-    SuperClass::setOpacity( 255 );
-    SuperClass::setPolygonType( kvs::PolygonObject::Quadrangle );
-    SuperClass::setColorType( color_type );
-    SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
+    // Single path through all of the vertices.
+    const size_t nvertices = line->numberOfVertices();
+    std::vector<kvs::UInt32> path_offsets( 2, 0 );
+    std::vector<kvs::UInt32> path_vertices( nvertices );
+    std::vector<kvs::UInt32> path_segments( 1, 0 );
+    for ( size_t i = 0; i < nvertices; i++ ) { path_vertices[i] = kvs::UInt32( i ); }
+    path_offsets[1] = kvs::UInt32( nvertices );
+
+    this->create_tubes( line, path_offsets, path_vertices, path_segments );
 }
 
 /*===========================================================================*/
@@ -524,35 +217,15 @@ void Tubeline::filtering_strip( const kvs::LineObject* line )
 /*===========================================================================*/
 void Tubeline::filtering_uniline( const kvs::LineObject* line )
 {
-    const kvs::ValueArray<kvs::Real32> line_vertices = ::GetVertexArray( line );
-    const kvs::ValueArray<kvs::Real32> line_sizes = ::GetSizeArray( line );
-    const kvs::ValueArray<kvs::UInt8> line_colors = ::GetColorArray( line );
-    const size_t nvertices = ::GetNumberOfVertices( line );
-    const kvs::PolygonObject::ColorType color_type = ::GetColorType( line );
-
-    std::vector<kvs::Real32> vertices;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
-    std::vector<kvs::Real32> normals;
-    this->calculate_tubes(
-        &vertices,
-        &colors,
-        &connections,
-        &normals,
-        line_vertices,
-        line_sizes,
-        line_colors,
-        nvertices,
-        color_type );
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( vertices ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
-    SuperClass::setOpacity( 255 );
-    SuperClass::setPolygonType( kvs::PolygonObject::Quadrangle );
-    SuperClass::setColorType( color_type );
-    SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
+    // Single path through the vertices in the connection order.
+    const size_t nconnections = line->numberOfConnections();
+    const kvs::UInt32* connections = line->connections().data();
+    std::vector<kvs::UInt32> path_offsets( 2, 0 );
+    std::vector<kvs::UInt32> path_vertices( connections, connections + nconnections );
+    std::vector<kvs::UInt32> path_segments( 1, 0 );
+    path_offsets[1] = kvs::UInt32( nconnections );
+
+    this->create_tubes( line, path_offsets, path_vertices, path_segments );
 }
 
 /*===========================================================================*/
@@ -563,71 +236,28 @@ void Tubeline::filtering_uniline( const kvs::LineObject* line )
 /*===========================================================================*/
 void Tubeline::filtering_polyline( const kvs::LineObject* line )
 {
-    std::vector<kvs::Real32> vertices;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
-    std::vector<kvs::Real32> normals;
-
-    const kvs::PolygonObject::ColorType color_type = ::GetColorType( line );
-
-    const kvs::UInt32* line_connections = line->connections().data();
-    const size_t line_nconnections = line->numberOfConnections();
-    for( size_t i = 0, index = 0; i < line_nconnections; i++, index += 2 )
-    {
-        const size_t id1 = line_connections[ index + 0 ];
-        const size_t id2 = line_connections[ index + 1 ];
-
-        const kvs::ValueArray<kvs::Real32> line_vertices = ::GetVertexArray( line, id1, id2 );
-        const kvs::ValueArray<kvs::Real32> line_sizes = ::GetSizeArray( line, id1, id2, i );
-        const kvs::ValueArray<kvs::UInt8> line_colors = ::GetColorArray( line, id1, id2, i );
-        const size_t nvertices = id2 - id1 + 1;
-
-        if ( line_sizes.size() < 2 ) continue;
-        if ( line_colors.size() < 2 ) continue;
-
-        std::vector<kvs::Real32> tmp_vertices;
-        std::vector<kvs::UInt8> tmp_colors;
-        std::vector<kvs::UInt32> tmp_connections;
-        std::vector<kvs::Real32> tmp_normals;
-        this->calculate_tubes(
-            &tmp_vertices,
-            &tmp_colors,
-            &tmp_connections,
-            &tmp_normals,
-            line_vertices,
-            line_sizes,
-            line_colors,
-            nvertices,
-            color_type );
-
-        const kvs::UInt32 nv = static_cast<kvs::UInt32>( vertices.size() / 3 );
-
-        vertices.insert( vertices.end(), tmp_vertices.begin(), tmp_vertices.end() );
-        normals.insert( normals.end(), tmp_normals.begin(), tmp_normals.end() );
-
-        const size_t tmp_ncolors = ( color_type == kvs::PolygonObject::VertexColor ) ?
-            tmp_colors.size() :
-            tmp_colors.size() - m_ndivisions * 3;
-        for( size_t j = 0; j < tmp_ncolors; j++ )
-        {
-            colors.push_back( tmp_colors[j] );
-        }
-
-        const size_t tmp_connections_size = tmp_connections.size();
-        for ( size_t j = 0; j < tmp_connections_size; j++ )
-        {
-            connections.push_back( tmp_connections[j] + nv );
-        }
-    }
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( vertices ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
-    SuperClass::setOpacity( 255 );
-    SuperClass::setPolygonType( kvs::PolygonObject::Quadrangle );
-    SuperClass::setColorType( color_type );
-    SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
+    // A path from the first to the last vertex of each polyline. The line
+    // sizes and colors are given for the segments numbered through all of
+    // the polylines.
+    const size_t nconnections = line->numberOfConnections();
+    const kvs::UInt32* connections = line->connections().data();
+    std::vector<kvs::UInt32> path_offsets( 1, 0 );
+    std::vector<kvs::UInt32> path_vertices;
+    std::vector<kvs::UInt32> path_segments;
+    kvs::UInt32 nsegments = 0;
+    for ( size_t i = 0; i < nconnections; i++ )
+    {
+        const kvs::UInt32 id1 = connections[ 2 * i + 0 ];
+        const kvs::UInt32 id2 = connections[ 2 * i + 1 ];
+        if ( id2 < id1 ) { continue; }
+
+        for ( kvs::UInt32 id = id1; id <= id2; id++ ) { path_vertices.push_back( id ); }
+        path_offsets.push_back( kvs::UInt32( path_vertices.size() ) );
+        path_segments.push_back( nsegments );
+        nsegments += id2 - id1;
+    }
+
+    this->create_tubes( line, path_offsets, path_vertices, path_segments );
 }
 
 /*===========================================================================*/
@@ -638,383 +268,197 @@ void Tubeline::filtering_polyline( const kvs::LineObject* line )
 /*===========================================================================*/
 void Tubeline::filtering_segment( const kvs::LineObject* line )
 {
-    std::vector<kvs::Real32> vertices;
-    std::vector<kvs::UInt8> colors;
-    std::vector<kvs::UInt32> connections;
-    std::vector<kvs::Real32> normals;
-
-    const kvs::PolygonObject::ColorType color_type = ::GetColorType( line );
-
-    const kvs::UInt32* line_connections = line->connections().data();
-    const size_t line_nconnections = line->numberOfConnections();
-    for( size_t i = 0, index = 0; i < line_nconnections; i++, index += 2 )
-    {
-        const size_t id1 = line_connections[ index + 0 ];
-        const size_t id2 = line_connections[ index + 1 ];
-
-        const size_t nvertices = 2;
-        const kvs::ValueArray<kvs::Real32> line_vertices = ::GetVertexArray( line, id1, id2 );
-//        const kvs::Real32 line_size = ( line->nsizes() == 1 ) ? line->size(0) : line->size(i);
-        kvs::ValueArray<kvs::Real32> line_sizes(1);
-        if ( line->numberOfSizes() == 1 ) line_sizes[0] = line->size(0);
-        else line_sizes[0] = line->size(i);
-
-        kvs::ValueArray<kvs::UInt8> line_colors(6);
-        if ( line->numberOfColors() == 1 )
-        {
-            line_colors[0] = line->color(0).r();
-            line_colors[1] = line->color(0).g();
-            line_colors[2] = line->color(0).b();
-            line_colors[3] = line->color(0).r();
-            line_colors[4] = line->color(0).g();
-            line_colors[5] = line->color(0).b();
-        }
-        else
-        {
-            if( color_type == kvs::PolygonObject::VertexColor )
-            {
-                line_colors[0] = line->color(id1).r();
-                line_colors[1] = line->color(id1).g();
-                line_colors[2] = line->color(id1).b();
-                line_colors[3] = line->color(id2).r();
-                line_colors[4] = line->color(id2).g();
-                line_colors[5] = line->color(id2).b();
-            }
-            else
-            {
-                line_colors[0] = line->color(i).r();
-                line_colors[1] = line->color(i).g();
-                line_colors[2] = line->color(i).b();
-                line_colors[3] = line->color(i).r();
-                line_colors[4] = line->color(i).g();
-                line_colors[5] = line->color(i).b();
-            }
-        }
-
-        std::vector<kvs::Real32> tmp_vertices;
-        std::vector<kvs::UInt8> tmp_colors;
-        std::vector<kvs::UInt32> tmp_connections;
-        std::vector<kvs::Real32> tmp_normals;
-        this->calculate_tubes(
-            &tmp_vertices,
-            &tmp_colors,
-            &tmp_connections,
-            &tmp_normals,
-            line_vertices,
-            line_sizes,
-            line_colors,
-            nvertices,
-            color_type );
-
-        vertices.insert( vertices.end(), tmp_vertices.begin(), tmp_vertices.end() );
-        normals.insert( normals.end(), tmp_normals.begin(), tmp_normals.end() );
-        colors.insert( colors.end(), tmp_colors.begin(), tmp_colors.end() );
-
-        const kvs::UInt32 nv = static_cast<kvs::UInt32>( vertices.size() / 3 );
-        const size_t tmp_connections_size = tmp_connections.size();
-        for ( size_t j = 0; j < tmp_connections_size; j++ )
-        {
-            connections.push_back( tmp_connections[j] + nv );
-        }
-    }
-
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( vertices ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
-    SuperClass::setOpacity( 255 );
-    SuperClass::setPolygonType( kvs::PolygonObject::Quadrangle );
-    SuperClass::setColorType( ::GetColorType( line ) );
-    SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Calculates tubeline polygon.
- *  @param  vertices [out] pointer to the vertex array of the polygon object
- *  @param  colors [out] pointer to the color array of the polygon object
- *  @param  connections [out] pointer to the connection array of the polygon object
- *  @param  normals [out] pointer to the normal array of the polygon object
- *  @param  line_vertices [in] vertex array of the line object
- *  @param  line_sizes [in] size array of the line object
- *  @param  line_colors [in] color array of the line object
- *  @param  nvertices [in] number of vertices
- *  @param  color_type [in] color type
- */
-/*===========================================================================*/
-void Tubeline::calculate_tubes(
-    std::vector<kvs::Real32>* vertices,
-    std::vector<kvs::UInt8>* colors,
-    std::vector<kvs::UInt32>* connections,
-    std::vector<kvs::Real32>* normals,
-    const kvs::ValueArray<kvs::Real32> line_vertices,
-    const kvs::ValueArray<kvs::Real32> line_sizes,
-    const kvs::ValueArray<kvs::UInt8> line_colors,
-    const size_t nvertices,
-    const kvs::PolygonObject::ColorType color_type )
-{
-    // First tube position.
-    kvs::Vector3f start_position( line_vertices[0], line_vertices[1], line_vertices[2] );
-    kvs::Vector3f end_position( line_vertices[3], line_vertices[4], line_vertices[5] );
-
-    // Initiali raduis parameters.
-    kvs::Real32 pre_radius  = 0.0f;
-    kvs::Real32 radius = line_sizes[0];
-    kvs::Real32 post_radius = line_sizes[1];
-
-    // Calculate vertices that are composed of the circles (cross-sections).
-    std::vector<kvs::Vector3f> start_circle;
-    std::vector<kvs::Vector3f> end_circle;
-    this->calculate_circles(
-        &start_circle,
-        &end_circle,
-        start_position,
-        end_position,
-        radius,
-        pre_radius,
-        post_radius );
-
-    // Calculate colors at the cross-sections.
-    kvs::RGBColor start_color( line_colors[0], line_colors[1], line_colors[2] );
-    kvs::RGBColor end_color( line_colors[3], line_colors[4], line_colors[5] );
-
-    size_t vertex_number = 0;
-
-    this->set_vertices( vertices, start_circle, end_circle );
-    this->set_colors( colors, start_color, end_color, color_type );
-    this->set_connections_and_normals( connections, normals, start_circle, end_circle, vertex_number );
-
-    const size_t nloops = nvertices - 1;
-    for ( size_t i = 1, index = 3; i < nloops; i++, index += 3 )
-    {
-        // Update the tube position.
-        const kvs::Real32 v0_x = line_vertices[ index + 0 ];
-        const kvs::Real32 v0_y = line_vertices[ index + 1 ];
-        const kvs::Real32 v0_z = line_vertices[ index + 2 ];
-        const kvs::Real32 v1_x = line_vertices[ index + 3 ];
-        const kvs::Real32 v1_y = line_vertices[ index + 4 ];
-        const kvs::Real32 v1_z = line_vertices[ index + 5 ];
-        start_position = kvs::Vector3f( v0_x, v0_y, v0_z );
-        end_position = kvs::Vector3f( v1_x, v1_y, v1_z );
-
-        // Update the reduis parameters.
-        pre_radius = line_sizes[i-1];
-        radius = line_sizes[i];
-        post_radius = ( i == nvertices - 2 ) ? 0.0f : line_sizes[i+1];
-
-        // Save parameters for the pre-tube.
-        const std::vector<kvs::Vector3f> pre_end_circle = end_circle;
-        const kvs::RGBColor pre_end_color = end_color;
-
-        // Update the vertices of the tube's circles.
-        start_circle.clear();
-        end_circle.clear();
-        this->calculate_circles(
-            &start_circle,
-            &end_circle,
-            start_position,
-            end_position,
-            radius,
-            pre_radius,
-            post_radius );
-
-        // tube + joint
-        vertex_number = m_ndivisions * 2 * i + m_ndivisions * 2 * ( i - 1 );
-
-        // Update the colors of the circles.
-        const kvs::UInt8 c0_r = line_colors[ index + 0 ];
-        const kvs::UInt8 c0_g = line_colors[ index + 1 ];
-        const kvs::UInt8 c0_b = line_colors[ index + 2 ];
-        const kvs::UInt8 c1_r = line_colors[ index + 3 ];
-        const kvs::UInt8 c1_g = line_colors[ index + 4 ];
-        const kvs::UInt8 c1_b = line_colors[ index + 5 ];
-        start_color = kvs::RGBColor( c0_r, c0_g, c0_b );
-        end_color = ( i == nvertices-1 ) ? start_color : kvs::RGBColor( c1_r, c1_g, c1_b );
-
-        // Set the data of the polygon object.
-        this->set_vertices( vertices, start_circle, end_circle );
-        this->set_colors( colors, start_color, end_color, color_type );
-        this->set_connections_and_normals( connections, normals, start_circle, end_circle, vertex_number );
-
-        // Calculate joint tube.
-        vertex_number += m_ndivisions * 2;
-        this->set_vertices( vertices, pre_end_circle, start_circle );
-        this->set_colors( colors, pre_end_color, start_color, color_type );
-        this->set_connections_and_normals( connections, normals, pre_end_circle, start_circle, vertex_number );
-    }
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Calculates vertices on the circles.
- *  @param  start_circle [out] pointer to the vertex array of the start circle
- *  @param  end_circle [out] pointer to the vertex array of the end circle
- *  @param  start_position [in] position of the start vertex
- *  @param  end_position [in] position of the end vertex
- *  @param  radius [in] radius
- *  @param  pre_radius [in] pre-radius
- *  @param  post_radius [in] post-radius
- */
-/*===========================================================================*/
-void Tubeline::calculate_circles(
-    std::vector<kvs::Vector3f>* start_circle,
-    std::vector<kvs::Vector3f>* end_circle,
-    const kvs::Vector3f& start_position,
-    const kvs::Vector3f& end_position,
-    const float radius,
-    const float pre_radius,
-    const float post_radius )
-{
-    const kvs::Vector3f vec1 = end_position - start_position;
-    const float length = static_cast<float>( vec1.length() );
-
-    //static kvs::Vector3f base( 0.0f, 0.0f, 1.0f ); ???
-    const kvs::Vector3f base( 0.0f, 0.0f, 1.0f );
-    const kvs::Vector3f axis = base.cross( vec1 );
-    const float radian = static_cast<float>( std::acos( base.dot( vec1 ) / ( base.length() * vec1.length() ) ) );
-    const kvs::Quaternion q( axis, radian );
-    const kvs::Matrix33f mat = q.toMatrix();
-
-    float diff_rad = static_cast<float>( 2.0f * kvs::Math::PI() / m_ndivisions );
-    float min_z = pre_radius - length * 0.5f;
-    float max_z = length * 0.5f - post_radius;
-    if ( length - post_radius - pre_radius < 0  )
-    {
-        min_z = 0.0f;
-        max_z = length;
-    }
-
-    const kvs::Vector3f pos = start_position + vec1 * 0.5f;
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        const float rad = diff_rad * i;
-        const float x = radius * std::cos( rad );
-        const float y = radius * std::sin( rad );
-
-        const kvs::Vector3f s_pos = mat * kvs::Vector3f( x, y, min_z ) + pos;
-        start_circle->push_back( s_pos );
-
-        const kvs::Vector3f e_pos = mat * kvs::Vector3f( x, y, max_z ) + pos;
-        end_circle->push_back( e_pos );
-    }
+    // A path of two vertices for each segment.
+    const size_t nconnections = line->numberOfConnections();
+    const kvs::UInt32* connections = line->connections().data();
+    std::vector<kvs::UInt32> path_offsets( nconnections + 1 );
+    std::vector<kvs::UInt32> path_vertices( connections, connections + 2 * nconnections );
+    std::vector<kvs::UInt32> path_segments( nconnections );
+    for ( size_t i = 0; i <= nconnections; i++ ) { path_offsets[i] = kvs::UInt32( 2 * i ); }
+    for ( size_t i = 0; i < nconnections; i++ ) { path_segments[i] = kvs::UInt32( i ); }
+
+    this->create_tubes( line, path_offsets, path_vertices, path_segments );
 }
 
 /*===========================================================================*/
 /**
- *  @brief  Sets a vertex array.
- *  @param  vertices [out] pointer to the vertex array
- *  @param  start_circle [in] vertex array of the start circle
- *  @param  end_circle [in] vertex array of the end circle
+ *  @brief  Creates the tubes along the paths in parallel.
+ *  @param  line [in] pointer to the line object
+ *  @param  path_offsets [in] offsets of the paths in the path vertex array
+ *  @param  path_vertices [in] vertex IDs of the line object along the paths
+ *  @param  path_segments [in] ID of the first segment of each path
  */
 /*===========================================================================*/
-void Tubeline::set_vertices(
-    std::vector<kvs::Real32>* vertices,
-    const std::vector<kvs::Vector3f>& start_circle,
-    const std::vector<kvs::Vector3f>& end_circle )
+void Tubeline::create_tubes(
+    const kvs::LineObject* line,
+    const std::vector<kvs::UInt32>& path_offsets,
+    const std::vector<kvs::UInt32>& path_vertices,
+    const std::vector<kvs::UInt32>& path_segments )
 {
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        vertices->push_back( start_circle[i].x() );
-        vertices->push_back( start_circle[i].y() );
-        vertices->push_back( start_circle[i].z() );
-    }
-
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        vertices->push_back( end_circle[i].x() );
-        vertices->push_back( end_circle[i].y() );
-        vertices->push_back( end_circle[i].z() );
-    }
-}
+    const size_t ndivisions = m_ndivisions;
+    const size_t npaths = path_segments.size();
+
+    // Output offsets of each path by a prefix sum, so that the paths are
+    // written to the exactly sized arrays independently.
+    std::vector<size_t> vertex_offsets( npaths + 1, 0 );
+    std::vector<size_t> quad_offsets( npaths + 1, 0 );
+    for ( size_t p = 0; p < npaths; p++ )
+    {
+        const size_t n = path_offsets[ p + 1 ] - path_offsets[p];
+        const size_t nrings = ( n < 2 || ndivisions == 0 ) ? 0 : n;
+        vertex_offsets[ p + 1 ] = vertex_offsets[p] + nrings * ndivisions;
+        quad_offsets[ p + 1 ] = quad_offsets[p] + ( nrings > 0 ? ( nrings - 1 ) * ndivisions : 0 );
+    }
+
+    const size_t nvertices = vertex_offsets[ npaths ];
+    const size_t nquads = quad_offsets[ npaths ];
+    const bool triangulation = m_enable_triangulation;
+    const size_t npolygons_per_quad = triangulation ? 2 : 1;
+    const size_t npolygons = nquads * npolygons_per_quad;
+
+    const size_t nsizes = line->numberOfSizes();
+    const size_t ncolors = line->numberOfColors();
+    const bool vertex_color = line->colorType() == kvs::LineObject::VertexColor;
+    const kvs::Real32* line_coords = line->coords().data();
+    const kvs::Real32* line_sizes = line->sizes().data();
+    const kvs::UInt8* line_colors = line->colors().data();
+
+    kvs::ValueArray<kvs::Real32> coords( nvertices * 3 );
+    kvs::ValueArray<kvs::Real32> normals( nvertices * 3 );
+    kvs::ValueArray<kvs::UInt32> connections( npolygons * ( triangulation ? 3 : 4 ) );
+    kvs::ValueArray<kvs::UInt8> colors;
+    if ( ncolors > 1 ) { colors.allocate( ( vertex_color ? nvertices : npolygons ) * 3 ); }
+
+    // Ring template.
+    std::vector<kvs::Real32> cos_table( ndivisions );
+    std::vector<kvs::Real32> sin_table( ndivisions );
+    for ( size_t k = 0; k < ndivisions; k++ )
+    {
+        const double angle = 2.0 * kvs::Math::PI() * k / ndivisions;
+        cos_table[k] = static_cast<kvs::Real32>( std::cos( angle ) );
+        sin_table[k] = static_cast<kvs::Real32>( std::sin( angle ) );
+    }
+
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( long p = 0; p < long( npaths ); p++ )
+    {
+        if ( vertex_offsets[ p + 1 ] == vertex_offsets[p] ) { continue; }
+
+        const kvs::UInt32* ids = path_vertices.data() + path_offsets[p];
+        const size_t n = path_offsets[ p + 1 ] - path_offsets[p];
+        const size_t first_segment = path_segments[p];
+        const size_t vertex_offset = vertex_offsets[p];
+        const size_t quad_offset = quad_offsets[p];
+
+        // Initial frame.
+        const kvs::Vec3 p0( line_coords + 3 * ids[0] );
+        const kvs::Vec3 p1( line_coords + 3 * ids[1] );
+        kvs::Vec3 prev_position = p0;
+        kvs::Vec3 prev_tangent = ::Normalized( p1 - p0, kvs::Vec3( 0.0f, 0.0f, 1.0f ) );
+        kvs::Vec3 r = ::Perpendicular( prev_tangent );
+
+        for ( size_t j = 0; j < n; j++ )
+        {
+            const kvs::Vec3 position( line_coords + 3 * ids[j] );
+            const kvs::Vec3 zero( 0.0f, 0.0f, 0.0f );
+            const kvs::Vec3 in = j > 0 ? ::Normalized( position - kvs::Vec3( line_coords + 3 * ids[ j - 1 ] ), zero ) : zero;
+            const kvs::Vec3 out = j < n - 1 ? ::Normalized( kvs::Vec3( line_coords + 3 * ids[ j + 1 ] ) - position, zero ) : zero;
+            const kvs::Vec3 tangent = ::Normalized( in + out, prev_tangent );
+
+            // Transport the frame by the double reflection method (Wang et al. 2008).
+            const kvs::Vec3 v1 = position - prev_position;
+            const float c1 = v1.dot( v1 );
+            if ( c1 > 0.0f )
+            {
+                const kvs::Vec3 rL = r - v1 * ( 2.0f / c1 * v1.dot( r ) );
+                const kvs::Vec3 tL = prev_tangent - v1 * ( 2.0f / c1 * v1.dot( prev_tangent ) );
+                const kvs::Vec3 v2 = tangent - tL;
+                const float c2 = v2.dot( v2 );
+                r = c2 > 0.0f ? rL - v2 * ( 2.0f / c2 * v2.dot( rL ) ) : rL;
+            }
+            r = ::Normalized( r - tangent * tangent.dot( r ), ::Perpendicular( tangent ) );
+            const kvs::Vec3 b = tangent.cross( r );
+
+            // Radius averaged over the adjacent segments.
+            const size_t s0 = first_segment + ( j > 0 ? j - 1 : 0 );
+            const size_t s1 = first_segment + ( j < n - 1 ? j : n - 2 );
+            const kvs::Real32 radius = nsizes == 1 ?
+                line_sizes[0] :
+                0.5f * ( line_sizes[ s0 ] + line_sizes[ s1 ] );
+
+            // Ring vertices.
+            const size_t ring = vertex_offset + j * ndivisions;
+            for ( size_t k = 0; k < ndivisions; k++ )
+            {
+                const kvs::Vec3 normal = r * cos_table[k] + b * sin_table[k];
+                const kvs::Vec3 coord = position + normal * radius;
+                const size_t index3 = 3 * ( ring + k );
+                coords[ index3 + 0 ] = coord.x();
+                coords[ index3 + 1 ] = coord.y();
+                coords[ index3 + 2 ] = coord.z();
+                normals[ index3 + 0 ] = normal.x();
+                normals[ index3 + 1 ] = normal.y();
+                normals[ index3 + 2 ] = normal.z();
+                if ( ncolors > 1 && vertex_color )
+                {
+                    const kvs::UInt8* c = line_colors + 3 * ids[j];
+                    colors[ index3 + 0 ] = c[0];
+                    colors[ index3 + 1 ] = c[1];
+                    colors[ index3 + 2 ] = c[2];
+                }
+            }
 
-/*===========================================================================*/
-/**
- *  @brief  Sets a color array
- *  @param  colors [out] pointer to the color array
- *  @param  start_color [in] color of the start vertex
- *  @param  end_color [in] color of the end vertex
- *  @param  color_type [in] polygon color type
- */
-/*===========================================================================*/
-void Tubeline::set_colors(
-    std::vector<kvs::UInt8>* colors,
-    const kvs::RGBColor& start_color,
-    const kvs::RGBColor& end_color,
-    const kvs::PolygonObject::ColorType color_type )
-{
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        colors->push_back( start_color.r() );
-        colors->push_back( start_color.g() );
-        colors->push_back( start_color.b() );
-    }
+            // Polygons between this ring and the next one.
+            if ( j < n - 1 )
+            {
+                const bool polygon_color = ncolors > 1 && !vertex_color;
+                const kvs::UInt8* c = polygon_color ? line_colors + 3 * ( first_segment + j ) : NULL;
+                for ( size_t k = 0; k < ndivisions; k++ )
+                {
+                    const kvs::UInt32 a0 = kvs::UInt32( ring + k );
+                    const kvs::UInt32 a1 = kvs::UInt32( ring + ( k + 1 ) % ndivisions );
+                    const kvs::UInt32 b0 = kvs::UInt32( a0 + ndivisions );
+                    const kvs::UInt32 b1 = kvs::UInt32( a1 + ndivisions );
+                    const size_t quad = quad_offset + j * ndivisions + k;
+                    if ( triangulation )
+                    {
+                        kvs::UInt32* t = connections.data() + 6 * quad;
+                        t[0] = a0; t[1] = a1; t[2] = b0;
+                        t[3] = b0; t[4] = a1; t[5] = b1;
+                    }
+                    else
+                    {
+                        kvs::UInt32* q = connections.data() + 4 * quad;
+                        q[0] = a0; q[1] = a1; q[2] = b1; q[3] = b0;
+                    }
+
+                    if ( polygon_color )
+                    {
+                        for ( size_t m = 0; m < npolygons_per_quad; m++ )
+                        {
+                            const size_t index3 = 3 * ( npolygons_per_quad * quad + m );
+                            colors[ index3 + 0 ] = c[0];
+                            colors[ index3 + 1 ] = c[1];
+                            colors[ index3 + 2 ] = c[2];
+                        }
+                    }
+                }
+            }
 
-    if( color_type == kvs::PolygonObject::VertexColor )
-    {
-        for ( size_t i = 0; i < m_ndivisions; i++ )
-        {
-            colors->push_back( end_color.r() );
-            colors->push_back( end_color.g() );
-            colors->push_back( end_color.b() );
+            prev_position = position;
+            prev_tangent = tangent;
         }
     }
-}
-
-/*===========================================================================*/
-/**
- *  @brief  Sets a connection array and a normal array.
- *  @param  connections [out] pointer to the connection array
- *  @param  normals [out] pointer to the normal array
- *  @param  start_circle [in] vertex array of the start circle
- *  @param  end_circle [in] vertex array of the end circle
- *  @param  vertex_number [in] vertex number
- */
-/*===========================================================================*/
-void Tubeline::set_connections_and_normals(
-    std::vector<kvs::UInt32>* connections,
-    std::vector<kvs::Real32>* normals,
-    const std::vector<kvs::Vector3f>& start_circle,
-    const std::vector<kvs::Vector3f>& end_circle,
-    const size_t vertex_number )
-{
-    // create vertex index list
-    std::vector<kvs::UInt32> v_ids;
-    std::vector<kvs::UInt32> n_ids;
 
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        const kvs::UInt32 index = static_cast<kvs::UInt32>( i );
-        v_ids.push_back( vertex_number + index );
-        n_ids.push_back( index );
-    }
-    v_ids.push_back( vertex_number );
-    n_ids.push_back( 0 );
-
-   /*  Simple example. Triangle pole.
-    *
-    *                     norm
-    *                       ^
-    *                       |
-    *            base ------|--------- base + m_division
-    *             /   \     |            /  \
-    *            /     base+2           /    base+2 + m_division 
-    *         base+1 -------------- base+1 + m_division 
-    *
-    */
-    for ( size_t i = 0; i < m_ndivisions; i++ )
-    {
-        connections->push_back( v_ids[i] + m_ndivisions );
-        connections->push_back( v_ids[i+1] + m_ndivisions );
-        connections->push_back( v_ids[i+1] );
-        connections->push_back( v_ids[i]   );
-
-        const kvs::Vector3f v1 = start_circle[n_ids[i+1]] - start_circle[n_ids[i]];
-        const kvs::Vector3f v2 = end_circle[n_ids[i+1]] - start_circle[n_ids[i]];
-        const kvs::Vector3f norm = -v1.cross( v2 );
-        normals->push_back( norm.x() );
-        normals->push_back( norm.y() );
-        normals->push_back( norm.z() );
-    }
+    SuperClass::setCoords( coords );
+    SuperClass::setNormals( normals );
+    SuperClass::setConnections( connections );
+    if ( ncolors > 1 ) { SuperClass::setColors( colors ); }
+    else if ( ncolors == 1 ) { SuperClass::setColor( line->color() ); }
+    SuperClass::setOpacity( 255 );
+    SuperClass::setPolygonType( triangulation ? kvs::PolygonObject::Triangle : kvs::PolygonObject::Quadrangle );
+    SuperClass::setColorType( ::GetColorType( line ) );
+    SuperClass::setNormalType( kvs::PolygonObject::VertexNormal );
 }
 
 } // end of namespace kvs
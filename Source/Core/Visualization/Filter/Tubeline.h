@@ -11,6 +11,7 @@
 #include <kvs/PolygonObject>
 #include <kvs/Module>
 #include <kvs/FilterBase>
+#include <vector>
 
 
 namespace kvs
@@ -19,6 +20,11 @@ namespace kvs
 /*===========================================================================*/
 /**
  *  @brief  Create tubeline from line object.
+ *
+ *  Each line is swept by a circle of the line size along parallel-transport
+ *  frames, so that consecutive cross-sections share their vertices. The
+ *  tubes are output as quadrangles, or as indexed triangles in strip order
+ *  when the triangulation is enabled.
  */
 /*===========================================================================*/
 class Tubeline : public kvs::FilterBase, public kvs::PolygonObject
@@ -30,6 +36,7 @@ class Tubeline : public kvs::FilterBase, public kvs::PolygonObject
 protected:
 
     size_t m_ndivisions; ///< number of divisions of circle
+    bool m_enable_triangulation; ///< if true, tubes are output as indexed triangles
 
 public:
 
@@ -38,6 +45,10 @@ public:
     virtual ~Tubeline( void );
 
     void setNumberOfDivisions( const size_t ndivisions );
+    void setEnabledTriangulation( const bool enable ) { m_enable_triangulation = enable; }
+    void enableTriangulation() { this->setEnabledTriangulation( true ); }
+    void disableTriangulation() { this->setEnabledTriangulation( false ); }
+    bool isEnabledTriangulation() const { return m_enable_triangulation; }
 
     SuperClass* exec( const kvs::ObjectBase* object );
 
@@ -48,45 +59,11 @@ protected:
     void filtering_polyline( const kvs::LineObject* line );
     void filtering_segment( const kvs::LineObject* line );
 
-protected:
-
-    void calculate_tubes(
-        std::vector<kvs::Real32>* vertices,
-        std::vector<kvs::UInt8>* colors,
-        std::vector<kvs::UInt32>* connections,
-        std::vector<kvs::Real32>* normals,
-        const kvs::ValueArray<kvs::Real32> line_vertices,
-        const kvs::ValueArray<kvs::Real32> line_sizes,
-        const kvs::ValueArray<kvs::UInt8> line_colors,
-        const size_t nvertices,
-        const kvs::PolygonObject::ColorType color_type );
-
-    void calculate_circles(
-        std::vector<kvs::Vector3f>* start_circle,
-        std::vector<kvs::Vector3f>* end_circle,
-        const kvs::Vector3f& start_postion,
-        const kvs::Vector3f& end_position,
-        const float radius,
-        const float pre_radius,
-        const float post_radius );
-
-    void set_vertices(
-        std::vector<kvs::Real32>* vertices,
-        const std::vector<kvs::Vector3f>& start_circle,
-        const std::vector<kvs::Vector3f>& end_circle );
-
-    void set_colors(
-        std::vector<kvs::UInt8>* colors,
-        const kvs::RGBColor& start_color,
-        const kvs::RGBColor& end_color,
-        const kvs::PolygonObject::ColorType color_type );
-
-    void set_connections_and_normals(
-        std::vector<kvs::UInt32>* connections,
-        std::vector<kvs::Real32>* normals,
-        const std::vector<kvs::Vector3f>& start_circle,
-        const std::vector<kvs::Vector3f>& end_circle,
-        const size_t vertex_number );
+    void create_tubes(
+        const kvs::LineObject* line,
+        const std::vector<kvs::UInt32>& path_offsets,
+        const std::vector<kvs::UInt32>& path_vertices,
+        const std::vector<kvs::UInt32>& path_segments );
 
 #if 1 // KVS_ENABLE_DEPRECATED
 public:
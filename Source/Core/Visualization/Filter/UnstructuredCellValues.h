@@ -0,0 +1,92 @@
+/*****************************************************************************/
+/**
+ *  @file   UnstructuredCellValues.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <vector>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/CellBase>
+#include <kvs/TetrahedralCell>
+#include <kvs/QuadraticTetrahedralCell>
+#include <kvs/HexahedralCell>
+#include <kvs/QuadraticHexahedralCell>
+#include <kvs/PyramidalCell>
+#include <kvs/PrismaticCell>
+#include <kvs/Vector3>
+#include <kvs/OpenMP>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns a new cell interpolator for the cell type of the volume.
+ *  @param  volume [in] pointer to an unstructured volume object
+ *  @return pointer to the cell interpolator (NULL if the cell type is not supported)
+ */
+/*===========================================================================*/
+kvs::CellBase* CreateCell( const kvs::UnstructuredVolumeObject* volume )
+{
+    switch ( volume->cellType() )
+    {
+    case kvs::UnstructuredVolumeObject::Tetrahedra: return new kvs::TetrahedralCell( volume );
+    case kvs::UnstructuredVolumeObject::QuadraticTetrahedra: return new kvs::QuadraticTetrahedralCell( volume );
+    case kvs::UnstructuredVolumeObject::Hexahedra: return new kvs::HexahedralCell( volume );
+    case kvs::UnstructuredVolumeObject::QuadraticHexahedra: return new kvs::QuadraticHexahedralCell( volume );
+    case kvs::UnstructuredVolumeObject::Pyramid: return new kvs::PyramidalCell( volume );
+    case kvs::UnstructuredVolumeObject::Prism: return new kvs::PrismaticCell( volume );
+    default: break;
+    }
+
+    kvsMessageError("Unsupported cell type.");
+    return NULL;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Calculates the values at the centers of the cells in parallel.
+ *  @param  volume [in] pointer to an unstructured volume object
+ *  @param  func [in] function returning the value from the cell bound to the center
+ *  @param  values [out] values of the cells
+ *  @param  centers [out] centers of the cells in the global coordinate
+ *  @return true if the values are calculated
+ */
+/*===========================================================================*/
+template <typename Value, typename Function>
+bool CellValues(
+    const kvs::UnstructuredVolumeObject* volume,
+    Function func,
+    std::vector<Value>& values,
+    std::vector<kvs::Vec3>& centers )
+{
+    const size_t ncells = volume->numberOfCells();
+    values.resize( ncells );
+    centers.resize( ncells );
+
+    // Check the cell type before the parallel region.
+    kvs::CellBase* cell = ::CreateCell( volume );
+    if ( !cell ) { return false; }
+    delete cell;
+
+    KVS_OMP_PARALLEL()
+    {
+        kvs::CellBase* cell = ::CreateCell( volume );
+        const kvs::Vec3 center = cell->localCenter();
+        KVS_OMP_FOR( schedule(static) )
+        for ( long i = 0; i < long( ncells ); i++ )
+        {
+            cell->bindCell( kvs::UInt32( i ) );
+            cell->setLocalPoint( center );
+            values[i] = func( *cell );
+            centers[i] = cell->center();
+        }
+        delete cell;
+    }
+
+    return true;
+}
+
+} // end of namespace
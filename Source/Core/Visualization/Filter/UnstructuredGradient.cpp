@@ -6,8 +6,11 @@
 /*****************************************************************************/
 #include "UnstructuredGradient.h"
 #include "InverseDistanceWeighting.h"
+#include "UnstructuredCellValues.h"
 #include <kvs/UnstructuredVolumeObject>
-#include <kvs/PrismaticCell>
+#include <kvs/OpenMP>
+#include <vector>
+#include <kvs/Profiler>
 
 
 namespace
@@ -72,6 +75,8 @@ UnstructuredGradient::UnstructuredGradient( const kvs::UnstructuredVolumeObject*
 /*===========================================================================*/
 UnstructuredGradient::SuperClass* UnstructuredGradient::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     const kvs::UnstructuredVolumeObject* volume = ::Cast( object );
     if ( !volume ) { return NULL; }
 
@@ -95,31 +100,22 @@ UnstructuredGradient::SuperClass* UnstructuredGradient::exec( const kvs::ObjectB
 /*===========================================================================*/
 void UnstructuredGradient::scalar_gradient( const kvs::UnstructuredVolumeObject* volume )
 {
-    const size_t ncells = volume->numberOfCells();
-    const size_t nnodes = volume->numberOfNodes();
-    const kvs::UInt32* connections = volume->connections().data();
-
-    kvs::InverseDistanceWeighting<kvs::Vec3> idw( nnodes );
-    kvs::PrismaticCell cell( volume );
-    const kvs::Vec3 center = cell.localCenter();
-    for ( size_t i = 0; i < ncells; i++ )
+    // Gradient vectors at the cell centers.
+    std::vector<kvs::Vec3> gradients;
+    std::vector<kvs::Vec3> centers;
+    auto gradient = [] ( const kvs::CellBase& cell ) { return cell.gradientVector(); };
+    if ( !::CellValues( volume, gradient, gradients, centers ) )
     {
-        cell.bindCell( i );
-        cell.setLocalPoint( center );
-        const kvs::Vec3 V = cell.gradientVector();
-
-        const kvs::Vec3 c = cell.center();
-        for ( size_t j = 0; j < cell.numberOfCellNodes(); j++ )
-        {
-            const kvs::UInt32 id = *( connections++ );
-            const kvs::Real32 d = ( cell.coord(j) - c ).length();
-            idw.insert( id, V, d );
-        }
+        BaseClass::setSuccess( false );
+        return;
     }
 
+    // Gradient vectors at the nodes.
+    const auto values = kvs::InverseDistanceWeighting<kvs::Vec3>::Interpolate( volume, gradients, centers );
+
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 3 );
-    SuperClass::setValues( kvs::AnyValueArray( idw.serialize() ) );
+    SuperClass::setValues( kvs::AnyValueArray( values ) );
     SuperClass::updateMinMaxValues();
 }
 
@@ -131,31 +127,23 @@ void UnstructuredGradient::scalar_gradient( const kvs::UnstructuredVolumeObject*
 /*===========================================================================*/
 void UnstructuredGradient::vector_gradient( const kvs::UnstructuredVolumeObject* volume )
 {
-    const size_t ncells = volume->numberOfCells();
-    const size_t nnodes = volume->numberOfNodes();
-    const kvs::UInt32* connections = volume->connections().data();
-
-    kvs::InverseDistanceWeighting<kvs::Mat3> idw( nnodes );
-    kvs::PrismaticCell cell( volume );
-    const kvs::Vec3 center = cell.localCenter();
-    for ( size_t i = 0; i < ncells; i++ )
+    // Gradient tensors at the cell centers. The inverse of the Jacobi matrix
+    // of the cell is calculated once and applied to the three components.
+    std::vector<kvs::Mat3> gradients;
+    std::vector<kvs::Vec3> centers;
+    auto gradient = [] ( const kvs::CellBase& cell ) { return cell.gradientTensor(); };
+    if ( !::CellValues( volume, gradient, gradients, centers ) )
     {
-        cell.bindCell( i );
-        cell.setLocalPoint( center );
-        const kvs::Mat3 T = cell.gradientTensor();
-
-        const kvs::Vec3 c = cell.center();
-        for ( size_t j = 0; j < cell.numberOfCellNodes(); j++ )
-        {
-            const kvs::UInt32 id = *( connections++ );
-            const kvs::Real32 d = ( cell.coord(j) - c ).length();
-            idw.insert( id, T, d );
-        }
+        BaseClass::setSuccess( false );
+        return;
     }
 
+    // Gradient tensors at the nodes.
+    const auto values = kvs::InverseDistanceWeighting<kvs::Mat3>::Interpolate( volume, gradients, centers );
+
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 9 );
-    SuperClass::setValues( kvs::AnyValueArray( idw.serialize() ) );
+    SuperClass::setValues( kvs::AnyValueArray( values ) );
     SuperClass::updateMinMaxValues();
 }
 
@@ -6,10 +6,13 @@
 /*****************************************************************************/
 #include "UnstructuredQCriterion.h"
 #include "InverseDistanceWeighting.h"
-#include <kvs/PrismaticCell>
+#include "UnstructuredCellValues.h"
+#include <kvs/OpenMP>
+#include <vector>
 #include <map>
 #include <kvs/Type>
 #include <kvs/UnstructuredVolumeObject>
+#include <kvs/Profiler>
 
 
 namespace
@@ -164,6 +167,8 @@ UnstructuredQCriterion::UnstructuredQCriterion( const kvs::UnstructuredVolumeObj
 /*===========================================================================*/
 UnstructuredQCriterion::SuperClass* UnstructuredQCriterion::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     const kvs::UnstructuredVolumeObject* volume = ::Cast( object );
     if ( !volume ) { return NULL; }
 
@@ -187,32 +192,22 @@ UnstructuredQCriterion::SuperClass* UnstructuredQCriterion::exec( const kvs::Obj
 /*===========================================================================*/
 void UnstructuredQCriterion::qvalues_from_vectors( const kvs::UnstructuredVolumeObject* volume )
 {
-    const kvs::UInt32* connections = volume->connections().data();
-    const size_t ncells = volume->numberOfCells();
-    const size_t nnodes = volume->numberOfNodes();
-
-    kvs::InverseDistanceWeighting<kvs::Real32> idw( nnodes );
-    kvs::PrismaticCell cell( volume );
-    const kvs::Vec3 center = cell.localCenter();
-    for ( size_t i = 0; i < ncells; i++ )
+    // Q-values at the cell centers.
+    std::vector<kvs::Real32> qvalues;
+    std::vector<kvs::Vec3> centers;
+    auto qvalue = [] ( const kvs::CellBase& cell ) { return ::Q( cell.gradientTensor() ); };
+    if ( !::CellValues( volume, qvalue, qvalues, centers ) )
     {
-        cell.bindCell( i );
-        cell.setLocalPoint( center );
-        const kvs::Mat3 T = cell.gradientTensor();
-        const kvs::Real32 Q = ::Q( T );
-
-        const kvs::Vec3 c = cell.center();
-        for ( size_t j = 0; j < cell.numberOfCellNodes(); j++ )
-        {
-            const kvs::UInt32 id = *( connections++ );
-            const kvs::Real32 d = ( cell.coord(j) - c ).length();
-            idw.insert( id, Q, d );
-        }
+        BaseClass::setSuccess( false );
+        return;
     }
 
+    // Q-values at the nodes.
+    const auto values = kvs::InverseDistanceWeighting<kvs::Real32>::Interpolate( volume, qvalues, centers );
+
     SuperClass::shallowCopy( *volume );
     SuperClass::setVeclen( 1 );
-    SuperClass::setValues( kvs::AnyValueArray( idw.serialize() ) );
+    SuperClass::setValues( kvs::AnyValueArray( values ) );
     SuperClass::updateMinMaxValues();
 }
 
@@ -227,7 +222,8 @@ void UnstructuredQCriterion::qvalues_from_tensors( const kvs::UnstructuredVolume
     const size_t nnodes = volume->numberOfNodes();
 
     kvs::ValueArray<kvs::Real32> values( nnodes );
-    for ( size_t i = 0; i < nnodes; i++ )
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nnodes ); i++ )
     {
         const kvs::Mat3 T = ::Tensor( volume, i );
         values[i] = ::Q( T );
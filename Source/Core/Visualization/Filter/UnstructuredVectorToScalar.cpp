@@ -6,6 +6,7 @@
 /*****************************************************************************/
 #include "UnstructuredVectorToScalar.h"
 #include <kvs/Math>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -49,6 +50,8 @@ UnstructuredVectorToScalar::~UnstructuredVectorToScalar()
 /*===========================================================================*/
 UnstructuredVectorToScalar::SuperClass* UnstructuredVectorToScalar::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "filter", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -14,6 +14,7 @@
 #include <kvs/TetrahedralCell>
 #include <kvs/MersenneTwister>
 #include "CellByCellSampling.h"
+#include <kvs/Profiler>
 
 
 namespace
@@ -486,6 +487,8 @@ CellByCellLayeredSampling::CellByCellLayeredSampling(
 /*===========================================================================*/
 CellByCellLayeredSampling::SuperClass* CellByCellLayeredSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
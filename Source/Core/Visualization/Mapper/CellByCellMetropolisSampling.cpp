@@ -13,6 +13,7 @@
 #include <kvs/Value>
 #include <kvs/CellBase>
 #include "CellByCellSampling.h"
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -81,6 +82,8 @@ CellByCellMetropolisSampling::CellByCellMetropolisSampling(
 /*===========================================================================*/
 CellByCellMetropolisSampling::SuperClass* CellByCellMetropolisSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -183,7 +186,15 @@ void CellByCellMetropolisSampling::generate_particles( const kvs::StructuredVolu
     density_map.attachObject( volume );
     density_map.create( BaseClass::transferFunction().opacityMap() );
 
-    const kvs::Vec3ui ncells( volume->resolution() - kvs::Vector3ui::Constant(1) );
+    // Resolution level. The particles are sampled in the cells of the level
+    // and placed in the index coordinates of the finest level.
+    const size_t level = kvs::Math::Min( m_level, volume->numberOfLevels() - 1 );
+    kvs::StructuredVolumeObject level_volume;
+    if ( level > 0 ) { volume->shallowCopyLevel( level, &level_volume ); }
+    const kvs::StructuredVolumeObject* grid_volume = level > 0 ? &level_volume : volume;
+    const kvs::Vec3 grid_scale = CellByCellSampling::LevelGridScale( volume, grid_volume );
+
+    const kvs::Vec3ui ncells( grid_volume->resolution() - kvs::Vector3ui::Constant(1) );
     const kvs::ColorMap color_map( BaseClass::transferFunction().colorMap() );
 
     // Calculate number of particles.
@@ -191,8 +202,8 @@ void CellByCellMetropolisSampling::generate_particles( const kvs::StructuredVolu
     kvs::ValueArray<kvs::UInt32> nparticles( ncells.x() * ncells.y() * ncells.z() );
     KVS_OMP_PARALLEL()
     {
-        kvs::TrilinearInterpolator interpolator( volume );
-        CellByCellSampling::GridSampler<T> sampler( &interpolator, &density_map );
+        kvs::TrilinearInterpolator interpolator( grid_volume );
+        CellByCellSampling::GridSampler<T> sampler( &interpolator, &density_map, grid_scale );
 
         KVS_OMP_FOR( reduction(+:N) )
         for ( kvs::UInt32 z = 0; z < ncells.z(); ++z )
@@ -218,8 +229,8 @@ void CellByCellMetropolisSampling::generate_particles( const kvs::StructuredVolu
     particles.allocate( N * repetitions );
     KVS_OMP_PARALLEL()
     {
-        kvs::TrilinearInterpolator interpolator( volume );
-        CellByCellSampling::GridSampler<T> sampler( &interpolator, &density_map );
+        kvs::TrilinearInterpolator interpolator( grid_volume );
+        CellByCellSampling::GridSampler<T> sampler( &interpolator, &density_map, grid_scale );
 
         KVS_OMP_FOR( schedule(dynamic) )
         for ( kvs::UInt32 r = 0; r < repetitions; ++r )
@@ -34,6 +34,7 @@ private:
     size_t m_repetition_level = 1; ///< repetition level
     float m_sampling_step = 0.5f; ///< sampling step in the object coordinate
     float m_object_depth = 0.0f; ///< object depth
+    size_t m_level = 0; ///< resolution level of the structured volume (0: finest level)
 
 public:
     CellByCellRejectionSampling() = default;
@@ -56,11 +57,13 @@ public:
     size_t repetitionLevel() const { return m_repetition_level; }
     float samplingStep() const { return m_sampling_step; }
     float objectDepth() const { return m_object_depth; }
+    size_t level() const { return m_level; }
 
     void attachCamera( const kvs::Camera* camera ) { m_camera = camera; }
     void setRepetitionLevel( const size_t repetition_level ) { m_repetition_level = repetition_level; }
     void setSamplingStep( const float step ) { m_sampling_step = step; }
     void setObjectDepth( const float depth ) { m_object_depth = depth; }
+    void setLevel( const size_t level ) { m_level = level; }
 
 private:
     void mapping( const kvs::StructuredVolumeObject* volume );
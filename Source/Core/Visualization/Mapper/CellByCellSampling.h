@@ -6,6 +6,7 @@
 /*****************************************************************************/
 #pragma once
 #include <kvs/Type>
+#include <kvs/Math>
 #include <kvs/ValueArray>
 #include <kvs/Camera>
 #include <kvs/ObjectBase>
@@ -63,6 +64,27 @@ inline kvs::Real32 RandomNumber()
     return w * ( 1.0f / 4294967296.0f );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the grid size of the level in the index coordinates of the finest level.
+ *  @param  volume [in] pointer to the volume object
+ *  @param  level_volume [in] pointer to the level volume extracted from the volume
+ *  @return grid size
+ */
+/*===========================================================================*/
+inline const kvs::Vec3 LevelGridScale(
+    const kvs::StructuredVolumeObject* volume,
+    const kvs::StructuredVolumeObject* level_volume )
+{
+    kvs::Vec3 scale( 1.0f, 1.0f, 1.0f );
+    for ( int i = 0; i < 3; i++ )
+    {
+        const kvs::UInt32 n = level_volume->resolution()[i];
+        if ( n > 1 ) { scale[i] = kvs::Real32( volume->resolution()[i] - 1 ) / ( n - 1 ); }
+    }
+    return scale;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns a position of a randomly sampled point in the grid.
@@ -197,24 +219,41 @@ private:
     kvs::ColorMap m_color_map; ///< color map
     kvs::ValueArray<kvs::Real32> m_coords; ///< coorinate value array
     kvs::ValueArray<kvs::Real32> m_normals; ///< normal vector array
-    kvs::ValueArray<kvs::UInt8> m_colors; ///< color value array
+    kvs::ValueArray<kvs::Real32> m_scalars; ///< scalar value array
 
 public:
     ColoredParticles( const kvs::ColorMap& color_map ): m_color_map( color_map ) {}
     const kvs::ValueArray<kvs::Real32>& coords() const { return m_coords; }
     const kvs::ValueArray<kvs::Real32>& normals() const { return m_normals; }
-    const kvs::ValueArray<kvs::UInt8>& colors() const { return m_colors; }
+
+    kvs::ValueArray<kvs::UInt8> colors() const
+    {
+        // The scalar values are converted to the colors block by block with
+        // ColorMap::map() after the sampling.
+        const size_t nparticles = m_scalars.size();
+        const size_t block_size = 4096;
+        const long nblocks = long( ( nparticles + block_size - 1 ) / block_size );
+        kvs::ValueArray<kvs::UInt8> colors( nparticles * 3 );
+        KVS_OMP_PARALLEL_FOR( schedule(static) )
+        for ( long i = 0; i < nblocks; i++ )
+        {
+            const size_t begin = size_t(i) * block_size;
+            const size_t n = kvs::Math::Min( block_size, nparticles - begin );
+            m_color_map.map( m_scalars.data() + begin, n, colors.data() + begin * 3 );
+        }
+        return colors;
+    }
 
     void allocate( const size_t nparticles )
     {
         m_coords.allocate( nparticles * 3 );
         m_normals.allocate( nparticles * 3 );
-        m_colors.allocate( nparticles * 3 );
+        m_scalars.allocate( nparticles );
+        m_scalars.fill( 0.0f );
     }
 
     void push( const size_t index, const Particle& particle )
     {
-        const kvs::RGBColor color = m_color_map.at( particle.scalar );
         const size_t index3 = index * 3;
         m_coords[ index3 + 0 ] = particle.coord.x();
         m_coords[ index3 + 1 ] = particle.coord.y();
@@ -222,9 +261,7 @@ public:
         m_normals[ index3 + 0 ] = particle.normal.x();
         m_normals[ index3 + 1 ] = particle.normal.y();
         m_normals[ index3 + 2 ] = particle.normal.z();
-        m_colors[ index3 + 0 ] = color.r();
-        m_colors[ index3 + 1 ] = color.g();
-        m_colors[ index3 + 2 ] = color.b();
+        m_scalars[ index ] = particle.scalar;
     }
 };
 
@@ -282,7 +319,7 @@ inline kvs::Real32 ParticleDensityMap::maxValueInGrid(
     const kvs::TrilinearInterpolator& grid,
     const kvs::StructuredVolumeObject* volume ) const
 {
-    const DataType* const values = volume->values().asValueArray<DataType>().data();
+    const DataType* const values = grid.values<DataType>();
     const kvs::UInt32* const indices = grid.indices();
     kvs::Real32 smin = static_cast<kvs::Real32>( values[ indices[0] ] );
     kvs::Real32 smax = static_cast<kvs::Real32>( values[ indices[0] ] );
@@ -344,14 +381,17 @@ private:
     Particle m_current; ///< current sampled point
     Particle m_trial; ///< trial point
     kvs::Vec3ui m_base_index; ///< base index of grid
+    kvs::Vec3 m_grid_scale; ///< grid size in the index coordinates of the finest level
 
 public:
     GridSampler(){}
     GridSampler(
         kvs::TrilinearInterpolator* grid,
-        ParticleDensityMap* density_map ):
+        ParticleDensityMap* density_map,
+        const kvs::Vec3& grid_scale = kvs::Vec3( 1.0f, 1.0f, 1.0f ) ):
         m_grid( grid ),
-        m_density_map( density_map ) {}
+        m_density_map( density_map ),
+        m_grid_scale( grid_scale ) {}
 
     const kvs::TrilinearInterpolator* grid() const { return m_grid; }
 
@@ -369,14 +409,15 @@ public:
 
         const kvs::Real32 scalar = m_grid->template scalar<T>();
         const kvs::Real32 density = m_density_map->at( scalar );
-        const kvs::Real32 volume = 1.0f;
+        const kvs::Real32 volume = m_grid_scale.x() * m_grid_scale.y() * m_grid_scale.z();
         return NumberOfParticles( density, volume );
     }
 
     kvs::Real32 sample()
     {
-        m_current.coord = RandomSamplingInCube( m_base_index );
-        m_grid->attachPoint( m_current.coord );
+        const kvs::Vec3 coord = RandomSamplingInCube( m_base_index );
+        m_grid->attachPoint( coord );
+        m_current.coord = coord * m_grid_scale;
         m_current.normal = m_grid->template gradient<T>();
         m_current.scalar = m_grid->template scalar<T>();
         return m_density_map->at( m_current.scalar );
@@ -406,8 +447,9 @@ public:
 
     kvs::Real32 trySample()
     {
-        m_trial.coord = RandomSamplingInCube( m_base_index );
-        m_grid->attachPoint( m_trial.coord );
+        const kvs::Vec3 coord = RandomSamplingInCube( m_base_index );
+        m_grid->attachPoint( coord );
+        m_trial.coord = coord * m_grid_scale;
         m_trial.normal = m_grid->template gradient<T>();
         m_trial.scalar = m_grid->template scalar<T>();
         return m_density_map->at( m_trial.scalar );
@@ -14,6 +14,7 @@
 #include <kvs/CellBase>
 #include <kvs/CellByCellSampling>
 #include "CellByCellSampling.h"
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -82,6 +83,8 @@ CellByCellUniformSampling::CellByCellUniformSampling(
 /*===========================================================================*/
 CellByCellUniformSampling::SuperClass* CellByCellUniformSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -185,7 +188,15 @@ void CellByCellUniformSampling::generate_particles( const kvs::StructuredVolumeO
     density_map.attachObject( volume );
     density_map.create( BaseClass::transferFunction().opacityMap() );
 
-    const kvs::Vec3ui ncells( volume->resolution() - kvs::Vector3ui::Constant(1) );
+    // Resolution level. The particles are sampled in the cells of the level
+    // and placed in the index coordinates of the finest level.
+    const size_t level = kvs::Math::Min( m_level, volume->numberOfLevels() - 1 );
+    kvs::StructuredVolumeObject level_volume;
+    if ( level > 0 ) { volume->shallowCopyLevel( level, &level_volume ); }
+    const kvs::StructuredVolumeObject* grid_volume = level > 0 ? &level_volume : volume;
+    const kvs::Vec3 grid_scale = CellByCellSampling::LevelGridScale( volume, grid_volume );
+
+    const kvs::Vec3ui ncells( grid_volume->resolution() - kvs::Vector3ui::Constant(1) );
     const kvs::ColorMap color_map( BaseClass::transferFunction().colorMap() );
 
     // Calculate number of particles.
@@ -193,8 +204,8 @@ void CellByCellUniformSampling::generate_particles( const kvs::StructuredVolumeO
     kvs::ValueArray<kvs::UInt32> nparticles( ncells.x() * ncells.y() * ncells.z() );
     KVS_OMP_PARALLEL()
     {
-        kvs::TrilinearInterpolator interpolator( volume );
-        CellByCellSampling::GridSampler<T> sampler( &interpolator, &density_map );
+        kvs::TrilinearInterpolator interpolator( grid_volume );
+        CellByCellSampling::GridSampler<T> sampler( &interpolator, &density_map, grid_scale );
 
         KVS_OMP_FOR( reduction(+:N) )
         for ( kvs::UInt32 z = 0; z < ncells.z(); ++z )
@@ -225,8 +236,8 @@ void CellByCellUniformSampling::generate_particles( const kvs::StructuredVolumeO
 */
     KVS_OMP_PARALLEL()
     {
-        kvs::TrilinearInterpolator interpolator( volume );
-        CellByCellSampling::GridSampler<T> sampler( &interpolator, &density_map );
+        kvs::TrilinearInterpolator interpolator( grid_volume );
+        CellByCellSampling::GridSampler<T> sampler( &interpolator, &density_map, grid_scale );
         KVS_OMP_FOR( schedule(static) )
         for ( kvs::UInt32 r = 0; r < repetitions; ++r )
         {
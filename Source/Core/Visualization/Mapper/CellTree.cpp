@@ -14,7 +14,7 @@
  */
 /*****************************************************************************/
 #include "CellTree.h"
-#include <kvs/Thread>
+#include <kvs/TaskScheduler>
 #include <kvs/BitArray>
 
 
@@ -125,7 +125,7 @@ void FindMinMax( const PerCell* begin, const PerCell* end, float* min, float* ma
  *  @brief  Splitter class.
  */
 /*===========================================================================*/
-class Splitter : public kvs::Thread
+class Splitter
 {
 private:
 
@@ -381,7 +381,7 @@ private:
     std::vector<kvs::CellTree::Node> m_nodes;
     std::vector<kvs::CellTree::Node> m_nodes1;
     std::vector<kvs::CellTree::Node> m_nodes2;
-    Splitter m_thread[2];
+    Splitter m_splitter[2];
     PerCell* m_pc;
     PerCell* m_pc1;
     PerCell* m_pc2;
@@ -608,14 +608,14 @@ public:
             m_pc1 = m_pc;
             m_pc2 = mid;
 
-            m_thread[0].init( m_leafsize, &m_nodes1, m_pc1, 0, lmin, lmax );
-            m_thread[1].init( m_leafsize, &m_nodes2, m_pc2, 0, rmin, rmax );
+            m_splitter[0].init( m_leafsize, &m_nodes1, m_pc1, 0, lmin, lmax );
+            m_splitter[1].init( m_leafsize, &m_nodes2, m_pc2, 0, rmin, rmax );
 
-            m_thread[0].start();
-            m_thread[1].start();
-
-            m_thread[0].wait();
-            m_thread[1].wait();
+            // both branches are split on the shared task scheduler
+            kvs::TaskScheduler::TaskGroup group;
+            group.run( [this] { m_splitter[0].run(); } );
+            group.run( [this] { m_splitter[1].run(); } );
+            group.wait();
 
             // merge data into celltree
             // size = size_of_tree1 + size_of_tree2 + root
@@ -5,6 +5,7 @@
  */
 /****************************************************************************/
 #include "ColorMap.h"
+#include "TableLookUp.h"
 #include <kvs/Assert>
 #include <kvs/RGBColor>
 #include <kvs/HCLColor>
@@ -22,6 +23,38 @@ namespace
 const size_t NumberOfChannels = 3;
 kvs::ColorMap::ColorMapFunction DefaultColorMap = kvs::ColorMap::BrewerRdBu;
 
+/*===========================================================================*/
+/**
+ *  @brief  Looks up the color of the value by assuming piecewise linear map.
+ *  @param  table [in] color table
+ *  @param  resolution [in] resolution of the color table
+ *  @param  min_value [in] min. value
+ *  @param  max_value [in] max. value
+ *  @param  value [in] value
+ *  @param  rgb [out] interpolated RGB color
+ */
+/*===========================================================================*/
+inline void LookUp(
+    const kvs::UInt8* table,
+    const size_t resolution,
+    const float min_value,
+    const float max_value,
+    const float value,
+    kvs::UInt8* rgb )
+{
+    size_t s0 = 0;
+    size_t s1 = 0;
+    const float t = ::Locate( resolution, min_value, max_value, value, &s0, &s1 );
+
+    const kvs::UInt8* c0 = table + NumberOfChannels * s0;
+    const kvs::UInt8* c1 = table + NumberOfChannels * s1;
+    for ( size_t i = 0; i < NumberOfChannels; i++ )
+    {
+        const float c = kvs::Math::Mix( c0[i] / 255.0f, c1[i] / 255.0f, t );
+        rgb[i] = static_cast<kvs::UInt8>( kvs::Math::Round( kvs::Math::Clamp( c, 0.0f, 1.0f ) * 255.0f ) );
+    }
+}
+
 }
 
 
@@ -1042,17 +1075,46 @@ const kvs::RGBColor ColorMap::operator []( const size_t index ) const
 /*===========================================================================*/
 const kvs::RGBColor ColorMap::at( const float value ) const
 {
-    const float v0 = kvs::Math::Clamp( value, m_min_value, m_max_value );
-    const float r = static_cast<float>( m_resolution - 1 );
-    const float v = ( v0 - m_min_value ) / ( m_max_value - m_min_value ) * r;
-    const size_t s0 = static_cast<size_t>( v );
-    const size_t s1 = kvs::Math::Min( s0 + 1, m_resolution - 1 );
-
-    const kvs::RGBColor c0( m_table.data() + ::NumberOfChannels * s0 );
-    const kvs::RGBColor c1( m_table.data() + ::NumberOfChannels * s1 );
-    return kvs::RGBColor::Mix( c0, c1, v - s0 );
+    kvs::UInt8 rgb[ ::NumberOfChannels ];
+    ::LookUp( m_table.data(), m_resolution, m_min_value, m_max_value, value, rgb );
+    return kvs::RGBColor( rgb );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Maps the values to the RGB colors.
+ *  @param  values [in] pointer to the values
+ *  @param  nvalues [in] number of values
+ *  @param  colors [out] pointer to the RGB colors (3 x nvalues)
+ *
+ *  The resulting colors are the same as at() for each value. The 8-bit and
+ *  16-bit integer values are converted via the table of the colors for all
+ *  representable values without the per-value floating-point calculation.
+ */
+/*===========================================================================*/
+template <typename T>
+void ColorMap::map( const T* values, const size_t nvalues, kvs::UInt8* colors ) const
+{
+    KVS_ASSERT( m_table.size() == ::NumberOfChannels * m_resolution );
+
+    auto lookup = [this] ( const float value, kvs::UInt8* rgb )
+    {
+        ::LookUp( m_table.data(), m_resolution, m_min_value, m_max_value, value, rgb );
+    };
+    ::MapValues< ::NumberOfChannels>( values, nvalues, lookup, colors );
+}
+
+template void ColorMap::map<kvs::Int8>( const kvs::Int8* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::Int16>( const kvs::Int16* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::Int32>( const kvs::Int32* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::Int64>( const kvs::Int64* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::UInt8>( const kvs::UInt8* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::UInt16>( const kvs::UInt16* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::UInt32>( const kvs::UInt32* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::UInt64>( const kvs::UInt64* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::Real32>( const kvs::Real32* values, const size_t nvalues, kvs::UInt8* colors ) const;
+template void ColorMap::map<kvs::Real64>( const kvs::Real64* values, const size_t nvalues, kvs::UInt8* colors ) const;
+
 /*==========================================================================*/
 /**
  *  @brief  Substitution operator =.
@@ -13,6 +13,7 @@
 #include <kvs/Timer>
 #include <map>
 #include <cstring>
+#include <kvs/Profiler>
 
 
 namespace
@@ -938,6 +939,8 @@ ExternalFaces::~ExternalFaces()
 /*===========================================================================*/
 ExternalFaces::SuperClass* ExternalFaces::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -12,6 +12,7 @@
 #include <kvs/IgnoreUnusedVariable>
 #include <kvs/Timer>
 #include <map>
+#include <kvs/Profiler>
 
 
 namespace
@@ -175,6 +176,8 @@ ExtractEdges::~ExtractEdges()
 /*===========================================================================*/
 ExtractEdges::SuperClass* ExtractEdges::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -7,6 +7,7 @@
 #include "ExtractVertices.h"
 #include <kvs/VolumeObjectBase>
 #include <kvs/StructuredVolumeObject>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -71,6 +72,8 @@ ExtractVertices::~ExtractVertices()
 /*===========================================================================*/
 ExtractVertices::SuperClass* ExtractVertices::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -7,6 +7,8 @@
 #include "FrequencyTable.h"
 #include <kvs/Type>
 #include <kvs/Value>
+#include <vector>
+#include <cmath>
 
 
 namespace kvs
@@ -48,11 +50,7 @@ void FrequencyTable::create( const kvs::VolumeObjectBase* volume )
     // Calculate the min/max range value and the number of bins.
     this->calculate_range( volume );
 
-    // Allocate and initialize the bin array.
-    m_bin.allocate( static_cast<size_t>( m_nbins ) );
-    m_bin.fill( 0 );
-
-    // Count the bin.
+    // Count the bin (the bin array is shared with the histogram cached on the volume).
     this->count_bin( volume );
 }
 
@@ -241,6 +239,7 @@ void FrequencyTable::calculate_range( const kvs::VolumeObjectBase* volume )
     {
         if ( kvs::Math::IsZero( m_min_range ) && kvs::Math::IsZero( m_max_range ) )
         {
+            if ( !volume->hasMinMaxValues() ) { volume->updateMinMaxValues(); }
             m_min_range = volume->minValue();
             m_max_range = volume->maxValue();
         }
@@ -285,15 +284,20 @@ void FrequencyTable::calculate_range( const kvs::ImageObject* image )
 /*==========================================================================*/
 void FrequencyTable::count_bin( const kvs::VolumeObjectBase* volume )
 {
-    const std::type_info& type = volume->values().typeInfo()->type();
-    if (      type == typeid( kvs::Int8 )   ) this->binning<kvs::Int8>( volume );
-    else if ( type == typeid( kvs::UInt8 )  ) this->binning<kvs::UInt8>( volume );
-    else if ( type == typeid( kvs::Int16 )  ) this->binning<kvs::Int16>( volume );
-    else if ( type == typeid( kvs::UInt16 ) ) this->binning<kvs::UInt16>( volume );
-    else if ( type == typeid( kvs::Int32 )  ) this->binning<kvs::Int32>( volume );
-    else if ( type == typeid( kvs::UInt32 ) ) this->binning<kvs::UInt32>( volume );
-    else if ( type == typeid( kvs::Real32 ) ) this->binning<kvs::Real32>( volume );
-    else if ( type == typeid( kvs::Real64 ) ) this->binning<kvs::Real64>( volume );
+    // The histogram is counted by the parallel scan of the volume, and the
+    // volume returns the cached one for the same parameters.
+    const std::vector<kvs::Real64> ignore_values( m_ignore_values.begin(), m_ignore_values.end() );
+    const auto histogram = volume->histogram( static_cast<size_t>( m_nbins ), m_min_range, m_max_range, ignore_values );
+    m_bin = histogram->bins.clone();
+    m_max_count = histogram->max_count;
+
+    m_mean = static_cast<kvs::Real64>( histogram->total_count ) / m_nbins;
+
+    kvs::Real64 sum = 0;
+    for ( size_t i = 0; i < m_nbins; i++ ) sum += kvs::Math::Square( m_bin[i] - m_mean );
+    m_variance = sum / m_nbins;
+
+    m_standard_deviation = std::sqrt( m_variance );
 }
 
 /*==========================================================================*/
@@ -69,7 +69,6 @@ private:
     void calculate_range( const kvs::ImageObject* image );
     void count_bin( const kvs::VolumeObjectBase* volume );
     void count_bin( const kvs::ImageObject* image, const size_t channel );
-    template <typename T> void binning( const kvs::VolumeObjectBase* volume );
     template <typename T> void binning( const kvs::ImageObject* image, const size_t channel );
     bool is_ignore_value( const kvs::Real64 value );
 
@@ -78,81 +77,6 @@ public:
     KVS_DEPRECATED( void setNBins( const kvs::UInt64 nbins ) ) { this->setNumberOfBins( nbins ); }
 };
 
-/*==========================================================================*/
-/**
- *  Create a bin array.
- *  @param volume [in] pointer to the volume object
- */
-/*==========================================================================*/
-template <typename T>
-inline void FrequencyTable::binning( const kvs::VolumeObjectBase* volume )
-{
-    const size_t veclen = volume->veclen();
-    const T* values = reinterpret_cast<const T*>( volume->values().data() );
-    const T* const end = values + volume->numberOfNodes() * veclen;
-    const kvs::Real64 width = ( m_max_range - m_min_range ) / kvs::Real64( m_nbins - 1 );
-
-    size_t total_count = 0;
-
-    m_max_count = 0;
-    if ( veclen == 1 )
-    {
-        while ( values < end )
-        {
-            kvs::Real64 value = kvs::Real64( *values );
-            ++values;
-
-            if ( !this->is_ignore_value( value ) )
-            {
-//                kvs::UInt64 index = static_cast<kvs::UInt64>( ( value - m_min_range ) / width );
-//                index = kvs::Math::Clamp( index, kvs::UInt64(0), m_nbins - 1 );
-                kvs::Real64 temp = static_cast<kvs::UInt64>( ( value - m_min_range ) / width );
-                kvs::UInt64 index = kvs::Math::Floor( temp );
-
-                m_bin[index] = m_bin[index] + 1;
-                m_max_count = kvs::Math::Max( m_max_count, m_bin[index] );
-
-                total_count++;
-            }
-        }
-    }
-    else
-    {
-        while ( values < end )
-        {
-            kvs::Real64 magnitude = 0.0;
-            for ( size_t i = 0; i < veclen; ++i )
-            {
-                kvs::Real64 value = kvs::Real64( *values );
-                magnitude += static_cast<kvs::Real64>( kvs::Math::Square( value ) );
-                ++values;
-            }
-            magnitude = std::sqrt( magnitude );
-
-            if ( !this->is_ignore_value( magnitude ) )
-            {
-//                kvs::UInt64 index = static_cast<kvs::UInt64>( ( magnitude - m_min_range ) / width );
-//                index = kvs::Math::Clamp( index, kvs::UInt64(0), m_nbins - 1 );
-                kvs::Real64 temp = static_cast<kvs::UInt64>( ( magnitude - m_min_range ) / width );
-                kvs::UInt64 index = kvs::Math::Floor( temp );
-
-                m_bin[index] = m_bin[index] + 1;
-                m_max_count = kvs::Math::Max( m_max_count, m_bin[index] );
-
-                total_count++;
-            }
-        }
-    }
-
-    m_mean = static_cast<kvs::Real64>( total_count ) / m_nbins;
-
-    kvs::Real64 sum = 0;
-    for ( size_t i = 0; i < m_nbins; i++ ) sum += kvs::Math::Square( m_bin[i] - m_mean );
-    m_variance = sum / m_nbins;
-
-    m_standard_deviation = std::sqrt( m_variance );
-}
-
 /*==========================================================================*/
 /**
  *  Create a bin array.
@@ -5,9 +5,11 @@
  */
 /****************************************************************************/
 #include "HitAndMissSampling.h"
-#include <kvs/MersenneTwister>
+#include <kvs/Xorshift128>
+#include <kvs/OpenMP>
 #include <kvs/IgnoreUnusedVariable>
 #include <vector>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -20,7 +22,8 @@ namespace kvs
 /*===========================================================================*/
 HitAndMissSampling::HitAndMissSampling():
     kvs::MapperBase(),
-    kvs::PointObject()
+    kvs::PointObject(),
+    m_seed( 0 )
 {
 }
 
@@ -32,7 +35,8 @@ HitAndMissSampling::HitAndMissSampling():
 /*==========================================================================*/
 HitAndMissSampling::HitAndMissSampling( const kvs::VolumeObjectBase* volume ):
     kvs::MapperBase(),
-    kvs::PointObject()
+    kvs::PointObject(),
+    m_seed( 0 )
 {
     this->exec( volume );
 }
@@ -48,7 +52,8 @@ HitAndMissSampling::HitAndMissSampling(
     const kvs::VolumeObjectBase* volume,
     const kvs::TransferFunction& transfer_function ):
     kvs::MapperBase( transfer_function ),
-    kvs::PointObject()
+    kvs::PointObject(),
+    m_seed( 0 )
 {
     this->exec( volume );
 }
@@ -71,6 +76,8 @@ HitAndMissSampling::~HitAndMissSampling()
 /*===========================================================================*/
 HitAndMissSampling::SuperClass* HitAndMissSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -159,44 +166,82 @@ void HitAndMissSampling::mapping( const kvs::UnstructuredVolumeObject* volume )
 /**
  *  @brief  Generate particles for the structured volume object.
  *  @param  volume [in] pointer to the structured volume object
+ *
+ *  Each slice of the volume has its own random number stream derived from the
+ *  seed by jumping the generator, so that the generated particles do not
+ *  depend on the number of threads. The particles are counted in the first
+ *  pass and written into the allocated arrays in the second pass, in which
+ *  the same random numbers are drawn again.
  */
 /*==========================================================================*/
 template <typename T>
 void HitAndMissSampling::generate_particles( const kvs::StructuredVolumeObject* volume  )
 {
-    // Set the geometry arrays.
-    const size_t max_nparticles = volume->numberOfNodes();
-    std::vector<kvs::Real32> coords;  coords.reserve( max_nparticles * 3 );
-    std::vector<kvs::UInt8>  colors;  colors.reserve( max_nparticles * 3 );
-    std::vector<kvs::Real32> normals; normals.reserve( max_nparticles * 3 );
-
     // Aliases.
     const kvs::Vector3ui resolution = volume->resolution();
     const size_t line_size  = volume->numberOfNodesPerLine();
     const size_t slice_size = volume->numberOfNodesPerSlice();
     const T* values = reinterpret_cast<const T*>( volume->values().data() );
+    const kvs::ColorMap& color_map = BaseClass::colorMap();
+    const kvs::OpacityMap& opacity_map = BaseClass::opacityMap();
+
+    // Random number generators for each slice.
+    const size_t nslices = resolution.z();
+    std::vector<kvs::Xorshift128> generators( nslices, kvs::Xorshift128( m_seed ) );
+    for ( size_t k = 1; k < nslices; k++ )
+    {
+        generators[k] = generators[k-1];
+        generators[k].jump();
+    }
+
+    // Count the particles in each slice.
+    std::vector<size_t> offsets( nslices + 1, 0 );
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( long k = 0; k < long( nslices ); k++ )
+    {
+        kvs::Xorshift128 R = generators[k];
+        const T* value = values + k * slice_size;
+        size_t counter = 0;
+        for ( size_t index = 0; index < slice_size; index++ )
+        {
+            const size_t voxel_value = value[ index ];
+            if ( R() < opacity_map[ voxel_value ] ) { counter++; }
+        }
+        offsets[ k + 1 ] = counter;
+    }
+
+    for ( size_t k = 0; k < nslices; k++ ) { offsets[ k + 1 ] += offsets[k]; }
 
-    kvs::MersenneTwister R; // Random number generator
-    size_t index = 0;     // index of voxel
-    for ( size_t k = 0; k < resolution.z(); k++ )
+    // Set the geometry arrays.
+    const size_t nparticles = offsets[ nslices ];
+    kvs::ValueArray<kvs::Real32> coords( nparticles * 3 );
+    kvs::ValueArray<kvs::UInt8> colors( nparticles * 3 );
+    kvs::ValueArray<kvs::Real32> normals( nparticles * 3 );
+
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( long k = 0; k < long( nslices ); k++ )
     {
+        kvs::Xorshift128 R = generators[k];
+        size_t index = k * slice_size; // index of voxel
+        size_t index3 = offsets[k] * 3; // index of particle
         for ( size_t j = 0; j < resolution.y(); j++ )
         {
             for ( size_t i = 0; i < resolution.x(); i++, index++ )
             {
                 // Rejection.
                 const size_t voxel_value = values[ index ];
-                if( R() < BaseClass::opacityMap()[ voxel_value ] )
+                if( R() < opacity_map[ voxel_value ] )
                 {
                     // Set coordinate value.
-                    coords.push_back( static_cast<kvs::Real32>(i) );
-                    coords.push_back( static_cast<kvs::Real32>(j) );
-                    coords.push_back( static_cast<kvs::Real32>(k) );
+                    coords[ index3 + 0 ] = static_cast<kvs::Real32>(i);
+                    coords[ index3 + 1 ] = static_cast<kvs::Real32>(j);
+                    coords[ index3 + 2 ] = static_cast<kvs::Real32>(k);
 
                     // Set color value.
-                    colors.push_back( BaseClass::colorMap()[ voxel_value ].r() );
-                    colors.push_back( BaseClass::colorMap()[ voxel_value ].g() );
-                    colors.push_back( BaseClass::colorMap()[ voxel_value ].b() );
+                    const kvs::RGBColor color = color_map[ voxel_value ];
+                    colors[ index3 + 0 ] = color.r();
+                    colors[ index3 + 1 ] = color.g();
+                    colors[ index3 + 2 ] = color.b();
 
                     // Calculate a normal vector at the node(i,j,k).
                     kvs::Vector3ui front( index, index, index ); // front index
@@ -211,21 +256,23 @@ void HitAndMissSampling::generate_particles( const kvs::StructuredVolumeObject*
                     else{ front.y() += line_size; back.y() -= line_size; }
 
                     if(      k == 0                  ) front.z() += slice_size;
-                    else if( k == resolution.z() - 1 ) back.z()  -= slice_size;
+                    else if( size_t(k) == resolution.z() - 1 ) back.z()  -= slice_size;
                     else{ front.z() += slice_size; back.z() -= slice_size; }
 
                     // Set normal vector.
-                    normals.push_back( static_cast<kvs::Real32>( values[ front.x() ] - values[ back.x() ] ) );
-                    normals.push_back( static_cast<kvs::Real32>( values[ front.y() ] - values[ back.y() ] ) );
-                    normals.push_back( static_cast<kvs::Real32>( values[ front.z() ] - values[ back.z() ] ) );
+                    normals[ index3 + 0 ] = static_cast<kvs::Real32>( values[ front.x() ] - values[ back.x() ] );
+                    normals[ index3 + 1 ] = static_cast<kvs::Real32>( values[ front.y() ] - values[ back.y() ] );
+                    normals[ index3 + 2 ] = static_cast<kvs::Real32>( values[ front.z() ] - values[ back.z() ] );
+
+                    index3 += 3;
                 }
             } // end of i-loop
         } // end of j-loop
     } // end of k-loop
 
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+    SuperClass::setCoords( coords );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( normals );
     SuperClass::setSize( 1.0f );
 }
 
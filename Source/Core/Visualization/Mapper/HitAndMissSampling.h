@@ -20,7 +20,7 @@ namespace kvs
 
 /*==========================================================================*/
 /**
- *  Hit and Miss sampling class.
+ *  Hit and Miss sampling class. The random seed can be given by setSeed() (0 by default).
  */
 /*==========================================================================*/
 class HitAndMissSampling : public kvs::MapperBase, public kvs::PointObject
@@ -29,6 +29,10 @@ class HitAndMissSampling : public kvs::MapperBase, public kvs::PointObject
     kvsModuleBaseClass( kvs::MapperBase );
     kvsModuleSuperClass( kvs::PointObject );
 
+private:
+
+    kvs::UInt32 m_seed; ///< seed of the random number generator
+
 public:
 
     HitAndMissSampling();
@@ -36,6 +40,9 @@ public:
     HitAndMissSampling( const kvs::VolumeObjectBase* object, const kvs::TransferFunction& transfer_function );
     virtual ~HitAndMissSampling();
 
+    kvs::UInt32 seed() const { return m_seed; }
+    void setSeed( const kvs::UInt32 seed ) { m_seed = seed; }
+
     SuperClass* exec( const kvs::ObjectBase* object );
 
 private:
@@ -11,6 +11,7 @@
 #include <kvs/MarchingHexahedra>
 #include <kvs/MarchingPyramid>
 #include <kvs/MarchingPrism>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -114,6 +115,8 @@ Isosurface::Isosurface(
 /*===========================================================================*/
 Isosurface::SuperClass* Isosurface::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
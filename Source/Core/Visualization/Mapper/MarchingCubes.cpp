@@ -7,6 +7,7 @@
 #include "MarchingCubes.h"
 #include "MarchingCubesTable.h"
 #include <cstring>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -45,6 +46,8 @@ MarchingCubes::MarchingCubes(
 /*===========================================================================*/
 MarchingCubes::SuperClass* MarchingCubes::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     BaseClass::setSuccess( false );
 
     if ( !object )
@@ -235,9 +238,9 @@ void MarchingCubes::extract_surfaces_with_duplication( const Volume* volume )
 
     if ( coords.size() > 0 )
     {
-        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
+        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
         SuperClass::setColor( BaseClass::transferFunction().colorMap().at( m_isolevel ) );
-        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
         SuperClass::setOpacity( 255 );
     }
 }
@@ -281,10 +284,10 @@ void MarchingCubes::extract_surfaces_without_duplication( const Volume* volume )
 
     if ( coords.size() > 0 )
     {
-        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-        SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
+        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+        SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( std::move( connections ) ) );
         SuperClass::setColor( BaseClass::transferFunction().colorMap().at( m_isolevel ) );
-        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
         SuperClass::setOpacity( 255 );
     }
 }
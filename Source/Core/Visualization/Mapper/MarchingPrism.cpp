@@ -6,6 +6,7 @@
 /****************************************************************************/
 #include "MarchingPrism.h"
 #include "MarchingPrismTable.h"
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -44,6 +45,8 @@ MarchingPrism::MarchingPrism(
 /*===========================================================================*/
 kvs::ObjectBase* MarchingPrism::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -217,9 +220,9 @@ void MarchingPrism::extract_surfaces_with_duplication(
 
     if ( coords.size() > 0 )
     {
-        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
+        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
         SuperClass::setColor( BaseClass::transferFunction().colorMap().at( m_isolevel ) );
-        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
         SuperClass::setOpacity( 255 );
     }
 }
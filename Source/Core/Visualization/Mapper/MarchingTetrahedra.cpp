@@ -7,6 +7,7 @@
 #include "MarchingTetrahedra.h"
 #include "MarchingTetrahedraTable.h"
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -45,6 +46,8 @@ MarchingTetrahedra::MarchingTetrahedra(
 /*===========================================================================*/
 MarchingTetrahedra::SuperClass* MarchingTetrahedra::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -229,9 +232,9 @@ void MarchingTetrahedra::extract_surfaces_with_duplication(
 
     if ( coords.size() > 0 )
     {
-        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
+        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
         SuperClass::setColor( BaseClass::transferFunction().colorMap().at( m_isolevel ) );
-        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
         SuperClass::setOpacity( 255 );
     }
 }
@@ -279,10 +282,10 @@ void MarchingTetrahedra::extract_surfaces_without_duplication(
 
     if ( coords.size() > 0 )
     {
-        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-        SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
+        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+        SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( std::move( connections ) ) );
         SuperClass::setColor( BaseClass::transferFunction().colorMap().at( m_isolevel ) );
-        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
         SuperClass::setOpacity( 255 );
     }
 
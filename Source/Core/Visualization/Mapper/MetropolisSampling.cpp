@@ -5,12 +5,29 @@
  */
 /****************************************************************************/
 #include "MetropolisSampling.h"
-#include <kvs/MersenneTwister>
+#include <kvs/Xorshift128>
+#include <kvs/OpenMP>
 #include <kvs/TrilinearInterpolator>
 #include <kvs/IgnoreUnusedVariable>
+#include <kvs/Math>
 #include <vector>
+#include <kvs/Profiler>
 
 
+namespace
+{
+
+/// Number of particles generated by each Markov chain.
+const size_t ChainLength = 16384;
+
+/// Number of trials discarded at the beginning of each Markov chain.
+const size_t BurnInLength = 1024;
+
+/// Max. number of trials to find the initial particle of each Markov chain.
+const size_t MaxInitialTrials = 65536;
+
+}
+
 namespace kvs
 {
 
@@ -21,7 +38,9 @@ namespace kvs
 /*==========================================================================*/
 MetropolisSampling::MetropolisSampling():
     kvs::MapperBase(),
-    kvs::PointObject()
+    kvs::PointObject(),
+    m_nparticles( 0 ),
+    m_seed( 0 )
 {
 }
 
@@ -37,7 +56,8 @@ MetropolisSampling::MetropolisSampling(
     const size_t                 nparticles ):
     kvs::MapperBase(),
     kvs::PointObject(),
-    m_nparticles( nparticles )
+    m_nparticles( nparticles ),
+    m_seed( 0 )
 {
     this->exec( volume );
 }
@@ -56,7 +76,8 @@ MetropolisSampling::MetropolisSampling(
     const kvs::TransferFunction& transfer_function ):
     kvs::MapperBase( transfer_function ),
     kvs::PointObject(),
-    m_nparticles( nparticles )
+    m_nparticles( nparticles ),
+    m_seed( 0 )
 {
     this->exec( volume );
 }
@@ -100,6 +121,8 @@ void MetropolisSampling::setNParticles( const size_t nparticles )
 /*===========================================================================*/
 MetropolisSampling::SuperClass* MetropolisSampling::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -170,91 +193,103 @@ void MetropolisSampling::mapping( const kvs::UnstructuredVolumeObject* volume )
 /**
  *  @brief  Generate particles for the structured volume object.
  *  @param  volume [in] pointer to the structured volume object
+ *
+ *  The particles are generated by independent Markov chains, each of which
+ *  generates a fixed number of particles with its own random number stream
+ *  derived from the seed by jumping the generator. The chains are processed
+ *  in parallel and write into their own ranges of the particle arrays, so
+ *  that the generated particles do not depend on the number of threads.
+ *  Each chain starts from a particle with nonzero opacity and discards the
+ *  first trials (burn-in) before recording the particles.
  */
 /*==========================================================================*/
 template <typename T>
 void MetropolisSampling::generate_particles( const kvs::StructuredVolumeObject* volume  )
 {
-    // Set the trilinear interpolator.
-    kvs::TrilinearInterpolator interpolator( volume );
-
     // Alias.
     const kvs::Vector3ui r = volume->resolution() - kvs::Vector3ui::Constant(1);
+    const kvs::ColorMap& color_map = BaseClass::colorMap();
+    const kvs::OpacityMap& opacity_map = BaseClass::opacityMap();
 
     // Allocate memory for generated particles.
     kvs::ValueArray<kvs::Real32> coords( m_nparticles * 3 );
     kvs::ValueArray<kvs::UInt8> colors( m_nparticles * 3 );
     kvs::ValueArray<kvs::Real32> normals( m_nparticles * 3 );
-/*
-    SuperClass::m_coords.allocate( m_nparticles * 3 );
-    SuperClass::m_colors.allocate( m_nparticles * 3 );
-    SuperClass::m_normals.allocate( m_nparticles * 3 );
-*/
-
-    // Random number generator.
-    kvs::MersenneTwister R;
-
-    // Set a initial particle and a trial particle.
-    kvs::Vector3f particle( static_cast<float>(R() * r.x()),
-                            static_cast<float>(R() * r.y()),
-                            static_cast<float>(R() * r.z()) );
-    kvs::Vector3f trial_particle( 0.0f, 0.0f, 0.0f );
-
-    // Attach the initial particle to the interpolator and get a rho value.
-    interpolator.attachPoint( particle );
-    size_t scalar = static_cast<size_t>( interpolator.template scalar<T>() );
-    float  rho    = BaseClass::opacityMap()[ scalar ];
-    float  trial_rho( 0.0f );
 
-    // Point sampling process.
-    size_t counter = 0;
-    while( counter < m_nparticles )
+    // Random number generators for each chain.
+    const size_t nchains = ( m_nparticles + ::ChainLength - 1 ) / ::ChainLength;
+    std::vector<kvs::Xorshift128> generators( nchains, kvs::Xorshift128( m_seed ) );
+    for ( size_t c = 1; c < nchains; c++ )
     {
-        trial_particle.set( static_cast<float>(R() * r.x()),
-                            static_cast<float>(R() * r.y()),
-                            static_cast<float>(R() * r.z()) );
-        interpolator.attachPoint( trial_particle );
+        generators[c] = generators[c-1];
+        generators[c].jump();
+    }
 
-        scalar    = static_cast<size_t>( interpolator.template scalar<T>() );
-        trial_rho = BaseClass::opacityMap()[ scalar ];
+    size_t nfailed = 0;
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) reduction(+:nfailed) )
+    for ( long c = 0; c < long( nchains ); c++ )
+    {
+        // Set the trilinear interpolator.
+        kvs::TrilinearInterpolator interpolator( volume );
+
+        // Random number generator.
+        kvs::Xorshift128 R = generators[c];
+
+        // Set a initial particle, which must have a nonzero rho value so that
+        // the acceptance ratio is defined, and a trial particle.
+        kvs::Vector3f particle( 0.0f, 0.0f, 0.0f );
+        kvs::Vector3f trial_particle( 0.0f, 0.0f, 0.0f );
+        size_t scalar = 0;
+        float  rho    = 0.0f;
+        float  trial_rho( 0.0f );
+        for ( size_t i = 0; i < ::MaxInitialTrials && rho <= 0.0f; i++ )
+        {
+            particle.set( R() * r.x(), R() * r.y(), R() * r.z() );
+            interpolator.attachPoint( particle );
+            scalar = static_cast<size_t>( interpolator.template scalar<T>() );
+            rho    = opacity_map[ scalar ];
+        }
 
-        const float ratio = trial_rho / rho;
-        if( ratio >= 1.0f )
+        if ( rho <= 0.0f )
         {
-            // Adopt the particle.
-            const kvs::Vector3f gradient = interpolator.template gradient<T>();
-//            this->adopt_particle( counter, trial_particle, scalar, gradient );
-            const size_t index3 = counter * 3;
-            coords[ index3 + 0 ]  = trial_particle.x();
-            coords[ index3 + 1 ]  = trial_particle.y();
-            coords[ index3 + 2 ]  = trial_particle.z();
-            colors[ index3 + 0 ]  = BaseClass::colorMap()[ scalar ].r();
-            colors[ index3 + 1 ]  = BaseClass::colorMap()[ scalar ].g();
-            colors[ index3 + 2 ]  = BaseClass::colorMap()[ scalar ].b();
-            normals[ index3 + 0 ] = gradient.x();
-            normals[ index3 + 1 ] = gradient.y();
-            normals[ index3 + 2 ] = gradient.z();
-
-            // Update the particle.
-            particle = trial_particle;
-            rho      = trial_rho;
-
-            counter++;
+            nfailed++;
+            continue;
         }
-        else
+
+        // Point sampling process. The particles are recorded after the burn-in.
+        const size_t begin = c * ::ChainLength;
+        const size_t end = kvs::Math::Min( begin + ::ChainLength, m_nparticles );
+        size_t counter = begin;
+        size_t ntrials = 0;
+        while( counter < end )
         {
-            if( ratio >= R() )
+            trial_particle.set( R() * r.x(), R() * r.y(), R() * r.z() );
+            interpolator.attachPoint( trial_particle );
+
+            scalar    = static_cast<size_t>( interpolator.template scalar<T>() );
+            trial_rho = opacity_map[ scalar ];
+
+            // The particle with zero rho value is never adopted.
+            const float ratio = trial_rho / rho;
+            const bool adopted = trial_rho > 0.0f && ( ratio >= 1.0f || ratio >= R() );
+            if ( ntrials++ < ::BurnInLength )
+            {
+                if ( adopted ) { particle = trial_particle; rho = trial_rho; }
+                continue;
+            }
+
+            if( adopted )
             {
                 // Adopt the particle.
                 const kvs::Vector3f gradient = interpolator.template gradient<T>();
-//                this->adopt_particle( counter, trial_particle, scalar, gradient );
+                const kvs::RGBColor color = color_map[ scalar ];
                 const size_t index3 = counter * 3;
                 coords[ index3 + 0 ]  = trial_particle.x();
                 coords[ index3 + 1 ]  = trial_particle.y();
                 coords[ index3 + 2 ]  = trial_particle.z();
-                colors[ index3 + 0 ]  = BaseClass::colorMap()[ scalar ].r();
-                colors[ index3 + 1 ]  = BaseClass::colorMap()[ scalar ].g();
-                colors[ index3 + 2 ]  = BaseClass::colorMap()[ scalar ].b();
+                colors[ index3 + 0 ]  = color.r();
+                colors[ index3 + 1 ]  = color.g();
+                colors[ index3 + 2 ]  = color.b();
                 normals[ index3 + 0 ] = gradient.x();
                 normals[ index3 + 1 ] = gradient.y();
                 normals[ index3 + 2 ] = gradient.z();
@@ -271,14 +306,14 @@ void MetropolisSampling::generate_particles( const kvs::StructuredVolumeObject*
                 interpolator.attachPoint( particle );
                 scalar = interpolator.template scalar<T>();
                 const kvs::Vector3f gradient = interpolator.template gradient<T>();
-//                this->adopt_particle( counter, particle, scalar, gradient );
+                const kvs::RGBColor color = color_map[ scalar ];
                 const size_t index3 = counter * 3;
                 coords[ index3 + 0 ]  = particle.x();
                 coords[ index3 + 1 ]  = particle.y();
                 coords[ index3 + 2 ]  = particle.z();
-                colors[ index3 + 0 ]  = BaseClass::colorMap()[ scalar ].r();
-                colors[ index3 + 1 ]  = BaseClass::colorMap()[ scalar ].g();
-                colors[ index3 + 2 ]  = BaseClass::colorMap()[ scalar ].b();
+                colors[ index3 + 0 ]  = color.r();
+                colors[ index3 + 1 ]  = color.g();
+                colors[ index3 + 2 ]  = color.b();
                 normals[ index3 + 0 ] = gradient.x();
                 normals[ index3 + 1 ] = gradient.y();
                 normals[ index3 + 2 ] = gradient.z();
@@ -291,6 +326,13 @@ void MetropolisSampling::generate_particles( const kvs::StructuredVolumeObject*
         }
     }
 
+    if ( nfailed > 0 )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Cannot find a particle with nonzero opacity.");
+        return;
+    }
+
     SuperClass::setCoords( coords );
     SuperClass::setColors( colors );
     SuperClass::setNormals( normals );
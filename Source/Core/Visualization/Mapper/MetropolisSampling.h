@@ -20,7 +20,7 @@ namespace kvs
 
 /*==========================================================================*/
 /**
- *  Metropolis sampling class.
+ *  Metropolis sampling class. The random seed can be given by setSeed() (0 by default).
  */
 /*==========================================================================*/
 class MetropolisSampling : public MapperBase, public PointObject
@@ -32,6 +32,7 @@ class MetropolisSampling : public MapperBase, public PointObject
 protected:
 
     size_t m_nparticles; ///< number of generated particles
+    kvs::UInt32 m_seed; ///< seed of the random number generator
 
 public:
 
@@ -45,6 +46,8 @@ public:
 
     size_t nparticles() const;
     void setNParticles( const size_t nparticles );
+    kvs::UInt32 seed() const { return m_seed; }
+    void setSeed( const kvs::UInt32 seed ) { m_seed = seed; }
 
     SuperClass* exec( const kvs::ObjectBase* object );
 
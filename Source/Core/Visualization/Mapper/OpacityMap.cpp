@@ -5,6 +5,7 @@
  */
 /****************************************************************************/
 #include "OpacityMap.h"
+#include "TableLookUp.h"
 #include <kvs/Assert>
 #include <kvs/Math>
 
@@ -15,6 +16,30 @@ namespace
 // Default opacity map
 kvs::OpacityMap::OpacityMapFunction DefaultOpacityMap = kvs::OpacityMap::Linear;
 
+/*===========================================================================*/
+/**
+ *  @brief  Looks up the opacity of the value by assuming piecewise linear map.
+ *  @param  table [in] opacity table
+ *  @param  resolution [in] resolution of the opacity table
+ *  @param  min_value [in] min. value
+ *  @param  max_value [in] max. value
+ *  @param  value [in] value
+ *  @return interpolated opacity
+ */
+/*===========================================================================*/
+inline kvs::Real32 LookUp(
+    const kvs::Real32* table,
+    const size_t resolution,
+    const float min_value,
+    const float max_value,
+    const float value )
+{
+    size_t s0 = 0;
+    size_t s1 = 0;
+    const float t = ::Locate( resolution, min_value, max_value, value, &s0, &s1 );
+    return kvs::Math::Mix( table[ s0 ], table[ s1 ], t );
+}
+
 } // end of namespace
 
 
@@ -275,17 +300,44 @@ kvs::Real32 OpacityMap::operator []( const size_t index ) const
 /*===========================================================================*/
 kvs::Real32 OpacityMap::at( const float value ) const
 {
-    const float v0 = kvs::Math::Clamp( value, m_min_value, m_max_value );
-    const float r = static_cast<float>( m_resolution - 1 );
-    const float v = ( v0 - m_min_value ) / ( m_max_value - m_min_value ) * r;
-    const size_t s0 = static_cast<size_t>( v );
-    const size_t s1 = kvs::Math::Min( s0 + 1, m_resolution - 1 );
-
-    const kvs::Real32 a0 = m_table[ s0 ];
-    const kvs::Real32 a1 = m_table[ s1 ];
-    return kvs::Math::Mix( a0, a1, v - s0 );
+    return ::LookUp( m_table.data(), m_resolution, m_min_value, m_max_value, value );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Maps the values to the opacities.
+ *  @param  values [in] pointer to the values
+ *  @param  nvalues [in] number of values
+ *  @param  opacities [out] pointer to the opacities (nvalues)
+ *
+ *  The resulting opacities are the same as at() for each value. The 8-bit and
+ *  16-bit integer values are converted via the table of the opacities for all
+ *  representable values without the per-value floating-point calculation.
+ */
+/*===========================================================================*/
+template <typename T>
+void OpacityMap::map( const T* values, const size_t nvalues, kvs::Real32* opacities ) const
+{
+    KVS_ASSERT( m_table.size() == m_resolution );
+
+    auto lookup = [this] ( const float value, kvs::Real32* opacity )
+    {
+        *opacity = ::LookUp( m_table.data(), m_resolution, m_min_value, m_max_value, value );
+    };
+    ::MapValues<1>( values, nvalues, lookup, opacities );
 }
 
+template void OpacityMap::map<kvs::Int8>( const kvs::Int8* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::Int16>( const kvs::Int16* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::Int32>( const kvs::Int32* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::Int64>( const kvs::Int64* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::UInt8>( const kvs::UInt8* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::UInt16>( const kvs::UInt16* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::UInt32>( const kvs::UInt32* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::UInt64>( const kvs::UInt64* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::Real32>( const kvs::Real32* values, const size_t nvalues, kvs::Real32* opacities ) const;
+template void OpacityMap::map<kvs::Real64>( const kvs::Real64* values, const size_t nvalues, kvs::Real32* opacities ) const;
+
 /*==========================================================================*/
 /**
  *  Substitution operator =.
@@ -6,6 +6,10 @@
 /****************************************************************************/
 #include "OrthoSlice.h"
 #include <kvs/Matrix33>
+#include <kvs/Math>
+#include <kvs/Message>
+#include <kvs/OpenMP>
+#include <kvs/Profiler>
 
 
 namespace
@@ -27,7 +31,11 @@ namespace kvs
  */
 /*==========================================================================*/
 OrthoSlice::OrthoSlice():
-    m_aligned_axis( OrthoSlice::XAxis )
+    m_aligned_axis( OrthoSlice::XAxis ),
+    m_position( 0.0f ),
+    m_level( 0 ),
+    m_cached_axis( -1 ),
+    m_cached_resolution( 0, 0, 0 )
 {
 }
 
@@ -45,12 +53,15 @@ OrthoSlice::OrthoSlice(
     const float                  position,
     const AlignedAxis            axis,
     const kvs::TransferFunction& transfer_function ):
-    kvs::SlicePlane(
-        volume,
-        ::Normal[axis] * position,
-        ::Normal[axis],
-        transfer_function )
+    m_aligned_axis( axis ),
+    m_position( position ),
+    m_level( 0 ),
+    m_cached_axis( -1 ),
+    m_cached_resolution( 0, 0, 0 )
 {
+    BaseClass::setTransferFunction( transfer_function );
+    SuperClass::setPlane( ::Normal[axis] * position, ::Normal[axis] );
+    this->exec( volume );
 }
 
 /*===========================================================================*/
@@ -62,7 +73,308 @@ OrthoSlice::OrthoSlice(
 /*===========================================================================*/
 void OrthoSlice::setPlane( const float position, const kvs::OrthoSlice::AlignedAxis axis )
 {
+    m_aligned_axis = axis;
+    m_position = position;
     SuperClass::setPlane( ::Normal[axis] * position, ::Normal[axis] );
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Executes the mapper process.
+ *  @param  object [in] pointer to the volume object
+ *  @return pointer to the sliced plane (polygon object)
+ */
+/*===========================================================================*/
+kvs::PolygonObject* OrthoSlice::exec( const kvs::ObjectBase* object )
+{
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
+    const auto* bricked_volume = kvs::BrickedVolumeObject::DownCast( object );
+    if ( bricked_volume )
+    {
+        this->mapping( bricked_volume );
+        return this;
+    }
+
+    const auto* structured_volume = kvs::StructuredVolumeObject::DownCast( object );
+    if ( structured_volume && m_level > 0 && structured_volume->numberOfLevels() > 1 )
+    {
+        const size_t level = kvs::Math::Min( m_level, structured_volume->numberOfLevels() - 1 );
+        this->mapping_level( structured_volume, level );
+        return this;
+    }
+
+    if ( structured_volume &&
+         structured_volume->gridType() == kvs::StructuredVolumeObject::Uniform &&
+         structured_volume->veclen() == 1 )
+    {
+        this->mapping_uniform( structured_volume, m_position );
+        return this;
+    }
+
+    return SuperClass::exec( object );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Extracts the plane from the bricked volume object.
+ *  @param  volume [in] pointer to the bricked volume object
+ *
+ *  Only the slab of the cells which intersect the plane is read from the brick
+ *  file, and the plane is extracted from the slab as a structured volume.
+ */
+/*===========================================================================*/
+void OrthoSlice::mapping( const kvs::BrickedVolumeObject* volume )
+{
+    const int axis = m_aligned_axis;
+    const kvs::Vec3ui resolution = volume->resolution();
+    if ( resolution[axis] < 2 )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input volume has no cells along the aligned axis.");
+        return;
+    }
+
+    // Node index range of the slab.
+    const float max_position = static_cast<float>( resolution[axis] - 1 );
+    const float position = kvs::Math::Clamp( m_position, 0.0f, max_position );
+    const kvs::UInt32 index = kvs::Math::Min( static_cast<kvs::UInt32>( position ), resolution[axis] - 2 );
+    kvs::Vec3ui min_index( 0, 0, 0 );
+    kvs::Vec3ui max_index( resolution - kvs::Vec3ui( 1, 1, 1 ) );
+    min_index[axis] = index;
+    max_index[axis] = index + 1;
+
+    const kvs::AnyValueArray values = volume->readRegion( min_index, max_index );
+    if ( values.empty() )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Cannot read the slab from the bricked volume.");
+        return;
+    }
+
+    // The object coordinates of the slab are shifted by the slab offset, so
+    // that the plane is placed at the same position as in the whole volume.
+    const kvs::Vec3 min_coord = volume->minObjectCoord();
+    const kvs::Vec3 max_coord = volume->maxObjectCoord();
+    const kvs::Vec3 ncells( resolution - kvs::Vec3ui( 1, 1, 1 ) );
+    const kvs::Vec3 scale( ( max_coord - min_coord ) / ncells );
+    const kvs::Vec3ui slab_resolution( max_index - min_index + kvs::Vec3ui( 1, 1, 1 ) );
+    const kvs::Vec3 slab_ncells( slab_resolution - kvs::Vec3ui( 1, 1, 1 ) );
+    const kvs::Vec3 slab_min_coord( min_coord + kvs::Vec3( min_index ) );
+
+    kvs::StructuredVolumeObject slab;
+    slab.setGridTypeToUniform();
+    slab.setResolution( slab_resolution );
+    slab.setVeclen( volume->veclen() );
+    slab.setValues( values );
+    slab.setMinMaxValues( volume->minValue(), volume->maxValue() );
+    slab.setMinMaxObjectCoords( slab_min_coord, slab_min_coord + slab_ncells * scale );
+    slab.setMinMaxExternalCoords( slab_min_coord, slab_min_coord + slab_ncells * scale );
+
+    this->mapping_uniform( &slab, position - index );
+
+    // Restore the reference to the input volume.
+    BaseClass::attachVolume( volume );
+    BaseClass::setMinMaxCoords( volume, this );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Extracts the plane from the coarse level of the structured volume.
+ *  @param  volume [in] pointer to the structured volume object
+ *  @param  level [in] resolution level
+ */
+/*===========================================================================*/
+void OrthoSlice::mapping_level( const kvs::StructuredVolumeObject* volume, const size_t level )
+{
+    kvs::StructuredVolumeObject level_volume;
+    volume->shallowCopyLevel( level, &level_volume );
+
+    // The coarse level covers the same region as the finest level, so the
+    // position is scaled to the index coordinates of the level.
+    const int axis = m_aligned_axis;
+    const float n0 = static_cast<float>( volume->resolution()[axis] ) - 1.0f;
+    const float n = static_cast<float>( level_volume.resolution()[axis] ) - 1.0f;
+    const float position = n0 > 0.0f ? m_position * n / n0 : m_position;
+
+    this->mapping_uniform( &level_volume, position );
+
+    // Restore the reference to the input volume.
+    BaseClass::attachVolume( volume );
+    BaseClass::setMinMaxCoords( volume, this );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Extracts the plane from the uniform grid volume.
+ *  @param  volume [in] pointer to the structured volume object
+ *  @param  position [in] position on the aligned axis in the index coordinates
+ */
+/*===========================================================================*/
+void OrthoSlice::mapping_uniform( const kvs::StructuredVolumeObject* volume, const float position )
+{
+    if ( volume->veclen() != 1 )
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Input volume is not a sclar field data.");
+        return;
+    }
+
+    // Attach the pointer to the volume object.
+    BaseClass::attachVolume( volume );
+    BaseClass::setRange( volume );
+    BaseClass::setMinMaxCoords( volume, this );
+
+    const auto& type = volume->values().typeInfo()->type();
+    if (      type == typeid( kvs::Int8   ) ) this->extract_uniform_plane<kvs::Int8>( volume, position );
+    else if ( type == typeid( kvs::Int16  ) ) this->extract_uniform_plane<kvs::Int16>( volume, position );
+    else if ( type == typeid( kvs::Int32  ) ) this->extract_uniform_plane<kvs::Int32>( volume, position );
+    else if ( type == typeid( kvs::Int64  ) ) this->extract_uniform_plane<kvs::Int64>( volume, position );
+    else if ( type == typeid( kvs::UInt8  ) ) this->extract_uniform_plane<kvs::UInt8>( volume, position );
+    else if ( type == typeid( kvs::UInt16 ) ) this->extract_uniform_plane<kvs::UInt16>( volume, position );
+    else if ( type == typeid( kvs::UInt32 ) ) this->extract_uniform_plane<kvs::UInt32>( volume, position );
+    else if ( type == typeid( kvs::UInt64 ) ) this->extract_uniform_plane<kvs::UInt64>( volume, position );
+    else if ( type == typeid( kvs::Real32 ) ) this->extract_uniform_plane<kvs::Real32>( volume, position );
+    else if ( type == typeid( kvs::Real64 ) ) this->extract_uniform_plane<kvs::Real64>( volume, position );
+    else
+    {
+        BaseClass::setSuccess( false );
+        kvsMessageError("Unsupported data type '%s'.", volume->values().typeInfo()->typeName() );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Extracts the plane as a grid of triangle pairs from the uniform grid volume.
+ *  @param  volume [in] pointer to the structured volume object
+ *  @param  position [in] position on the aligned axis in the index coordinates
+ *
+ *  The node values on the plane are linearly interpolated between the two
+ *  node layers adjacent to the plane. The connections and the normals depend
+ *  only on the resolution and the axis, so that they are reused while the
+ *  plane is moved along the axis. The coordinate and color arrays are also
+ *  overwritten in place if they are not shared with other objects.
+ */
+/*===========================================================================*/
+template <typename T>
+void OrthoSlice::extract_uniform_plane( const kvs::StructuredVolumeObject* volume, const float position )
+{
+    const int a = m_aligned_axis;
+    const int u = ( a + 1 ) % 3;
+    const int v = ( a + 2 ) % 3;
+    const kvs::Vec3ui resolution = volume->resolution();
+    if ( resolution[a] < 2 || resolution[u] < 2 || resolution[v] < 2 ||
+         position < 0.0f || position > static_cast<float>( resolution[a] - 1 ) )
+    {
+        // The plane does not intersect the volume.
+        SuperClass::setCoords( kvs::ValueArray<kvs::Real32>() );
+        SuperClass::setColors( kvs::ValueArray<kvs::UInt8>() );
+        SuperClass::setNormals( kvs::ValueArray<kvs::Real32>() );
+        SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>() );
+        SuperClass::setOpacity( 255 );
+        SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
+        SuperClass::setColorType( kvs::PolygonObject::VertexColor );
+        SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
+        return;
+    }
+
+    const size_t nu = resolution[u];
+    const size_t nv = resolution[v];
+    const size_t nvertices = nu * nv;
+    const size_t npolygons = ( nu - 1 ) * ( nv - 1 ) * 2;
+
+    // Connections and normals of the triangle pairs. The triangles face the
+    // negative direction of the aligned axis as well as SlicePlane.
+    if ( m_cached_axis != a || m_cached_resolution != resolution )
+    {
+        kvs::ValueArray<kvs::UInt32> connections( npolygons * 3 );
+        kvs::ValueArray<kvs::Real32> normals( npolygons * 3 );
+        KVS_OMP_PARALLEL_FOR( schedule(static) )
+        for ( long j = 0; j < long( nv - 1 ); ++j )
+        {
+            size_t index = j * ( nu - 1 ) * 6;
+            for ( size_t i = 0; i < nu - 1; ++i )
+            {
+                const kvs::UInt32 v00 = static_cast<kvs::UInt32>( j * nu + i );
+                const kvs::UInt32 v10 = v00 + 1;
+                const kvs::UInt32 v01 = v00 + static_cast<kvs::UInt32>( nu );
+                const kvs::UInt32 v11 = v01 + 1;
+                connections[ index++ ] = v00;
+                connections[ index++ ] = v01;
+                connections[ index++ ] = v10;
+                connections[ index++ ] = v10;
+                connections[ index++ ] = v01;
+                connections[ index++ ] = v11;
+            }
+        }
+
+        normals.fill( 0.0f );
+        for ( size_t i = 0; i < npolygons; ++i ) { normals[ 3 * i + a ] = -1.0f; }
+
+        m_cached_axis = a;
+        m_cached_resolution = resolution;
+        m_cached_connections = connections;
+        m_cached_normals = normals;
+    }
+
+    // Reuse the coordinate and color arrays if they are owned by this object only.
+    kvs::ValueArray<kvs::Real32> coords;
+    if ( SuperClass::coords().size() == nvertices * 3 && SuperClass::coords().unique() ) { coords = SuperClass::coords(); }
+    else { coords.allocate( nvertices * 3 ); }
+
+    kvs::ValueArray<kvs::UInt8> colors;
+    if ( SuperClass::colors().size() == nvertices * 3 && SuperClass::colors().unique() ) { colors = SuperClass::colors(); }
+    else { colors.allocate( nvertices * 3 ); }
+
+    // Node values on the plane.
+    const size_t k = kvs::Math::Min( static_cast<size_t>( position ), size_t( resolution[a] - 2 ) );
+    const float t = position - static_cast<float>( k );
+    const size_t stride[3] = { 1, resolution.x(), size_t( resolution.x() ) * resolution.y() };
+    const T* values = static_cast<const T*>( volume->values().data() );
+    const kvs::ColorMap& color_map = BaseClass::transferFunction().colorMap();
+
+    const auto min_coord = volume->minObjectCoord();
+    const auto max_coord = volume->maxObjectCoord();
+    const auto scale_factor = ( max_coord - min_coord ) / kvs::Vec3( resolution - kvs::Vec3ui::Constant(1) );
+
+    KVS_OMP_PARALLEL()
+    {
+        std::vector<kvs::Real32> line( nu );
+
+        KVS_OMP_FOR( schedule(static) )
+        for ( long j = 0; j < long( nv ); ++j )
+        {
+            const T* value0 = values + k * stride[a] + j * stride[v];
+            const T* value1 = value0 + stride[a];
+            kvs::Real32* coord = coords.data() + j * nu * 3;
+            for ( size_t i = 0; i < nu; ++i )
+            {
+                const kvs::Real32 s0 = static_cast<kvs::Real32>( value0[ i * stride[u] ] );
+                const kvs::Real32 s1 = static_cast<kvs::Real32>( value1[ i * stride[u] ] );
+                line[i] = s0 + ( s1 - s0 ) * t;
+
+                kvs::Vec3 p;
+                p[a] = position;
+                p[u] = static_cast<float>( i );
+                p[v] = static_cast<float>( j );
+                p = ( p + min_coord ) * scale_factor;
+                *( coord++ ) = p.x();
+                *( coord++ ) = p.y();
+                *( coord++ ) = p.z();
+            }
+
+            color_map.map( line.data(), nu, colors.data() + j * nu * 3 );
+        }
+    }
+
+    SuperClass::setCoords( coords );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( m_cached_normals );
+    SuperClass::setConnections( m_cached_connections );
+    SuperClass::setOpacity( 255 );
+    SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
+    SuperClass::setColorType( kvs::PolygonObject::VertexColor );
+    SuperClass::setNormalType( kvs::PolygonObject::PolygonNormal );
+}
+
 } // end of namespace kvs
@@ -7,6 +7,8 @@
 #pragma once
 #include <kvs/SlicePlane>
 #include <kvs/VolumeObjectBase>
+#include <kvs/BrickedVolumeObject>
+#include <kvs/ValueArray>
 #include <kvs/Module>
 
 
@@ -33,6 +35,12 @@ public:
 
 protected:
     AlignedAxis m_aligned_axis; ///< aligned axis
+    float m_position; ///< position on the aligned axis
+    size_t m_level; ///< resolution level of the structured volume (0: finest level)
+    int m_cached_axis; ///< aligned axis of the cached connections
+    kvs::Vec3ui m_cached_resolution; ///< volume resolution of the cached connections
+    kvs::ValueArray<kvs::UInt32> m_cached_connections; ///< cached connections of the quad grid
+    kvs::ValueArray<kvs::Real32> m_cached_normals; ///< cached normals of the quad grid
 
 public:
     OrthoSlice();
@@ -43,6 +51,17 @@ public:
         const kvs::TransferFunction& transfer_function );
 
     void setPlane( const float position, const kvs::OrthoSlice::AlignedAxis axis );
+    void setLevel( const size_t level ) { m_level = level; }
+    size_t level() const { return m_level; }
+
+    kvs::PolygonObject* exec( const kvs::ObjectBase* object );
+
+private:
+    void mapping( const kvs::BrickedVolumeObject* volume );
+    void mapping_level( const kvs::StructuredVolumeObject* volume, const size_t level );
+    void mapping_uniform( const kvs::StructuredVolumeObject* volume, const float position );
+    template <typename T>
+    void extract_uniform_plane( const kvs::StructuredVolumeObject* volume, const float position );
 };
 
 } // end of namespace kvs
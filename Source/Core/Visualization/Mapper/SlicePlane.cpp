@@ -10,6 +10,7 @@
 #include <kvs/MarchingHexahedraTable>
 #include <kvs/MarchingPyramidTable>
 #include <kvs/MarchingPrismTable>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -64,6 +65,8 @@ SlicePlane::SlicePlane(
 /*===========================================================================*/
 SlicePlane::SuperClass* SlicePlane::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
@@ -160,7 +163,7 @@ void SlicePlane::extract_plane(
     // Calculated the coordinate data array and the normal vector array.
     std::vector<kvs::Real32> coords;
     std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
+    std::vector<kvs::Real32> values;
 
     const kvs::Vec3u ncells( volume->resolution() - kvs::Vec3u::Constant(1) );
 //    const kvs::UInt32 line_size( volume->numberOfNodesPerLine() );
@@ -247,20 +250,9 @@ void SlicePlane::extract_plane(
                     const double value1 = this->interpolate_value<T>( volume, v2, v3 );
                     const double value2 = this->interpolate_value<T>( volume, v4, v5 );
 
-                    const auto color0 = color_map.at( value0 );
-                    colors.push_back( color0.r() );
-                    colors.push_back( color0.g() );
-                    colors.push_back( color0.b() );
-
-                    const auto color1 = color_map.at( value1 );
-                    colors.push_back( color1.r() );
-                    colors.push_back( color1.g() );
-                    colors.push_back( color1.b() );
-
-                    const auto color2 = color_map.at( value2 );
-                    colors.push_back( color2.r() );
-                    colors.push_back( color2.g() );
-                    colors.push_back( color2.b() );
+                    values.push_back( static_cast<kvs::Real32>( value0 ) );
+                    values.push_back( static_cast<kvs::Real32>( value1 ) );
+                    values.push_back( static_cast<kvs::Real32>( value2 ) );
 
                     // Calculate a normal vector for the triangle polygon.
                     const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
@@ -274,9 +266,11 @@ void SlicePlane::extract_plane(
 //        index += line_size;
     } // end of loop-z
 
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+    kvs::ValueArray<kvs::UInt8> colors( values.size() * 3 );
+    color_map.map( values.data(), values.size(), colors.data() );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setColorType( kvs::PolygonObject::VertexColor );
@@ -331,7 +325,7 @@ void SlicePlane::extract_tetrahedra_plane(
     // Calculated the coordinate data array and the normal vector array.
     std::vector<kvs::Real32> coords;
     std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
+    std::vector<kvs::Real32> values;
 
     // Refer the parameters of the unstructured volume object.
     const kvs::Real32* volume_coords = volume->coords().data();
@@ -402,20 +396,9 @@ void SlicePlane::extract_tetrahedra_plane(
             const double value1 = this->interpolate_value<T>( volume, c2, c3 );
             const double value2 = this->interpolate_value<T>( volume, c4, c5 );
 
-            const auto color0 = color_map.at( value0 );
-            colors.push_back( color0.r() );
-            colors.push_back( color0.g() );
-            colors.push_back( color0.b() );
-
-            const auto color1 = color_map.at( value1 );
-            colors.push_back( color1.r() );
-            colors.push_back( color1.g() );
-            colors.push_back( color1.b() );
-
-            const auto color2 = color_map.at( value2 );
-            colors.push_back( color2.r() );
-            colors.push_back( color2.g() );
-            colors.push_back( color2.b() );
+            values.push_back( static_cast<kvs::Real32>( value0 ) );
+            values.push_back( static_cast<kvs::Real32>( value1 ) );
+            values.push_back( static_cast<kvs::Real32>( value2 ) );
 
             // Calculate a normal vector for the triangle polygon.
             const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
@@ -425,9 +408,11 @@ void SlicePlane::extract_tetrahedra_plane(
         } // end of loop-triangle
     } // end of loop-cell
 
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+    kvs::ValueArray<kvs::UInt8> colors( values.size() * 3 );
+    color_map.map( values.data(), values.size(), colors.data() );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setColorType( kvs::PolygonObject::VertexColor );
@@ -447,7 +432,7 @@ void SlicePlane::extract_hexahedra_plane(
     // Calculated the coordinate data array and the normal vector array.
     std::vector<kvs::Real32> coords;
     std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
+    std::vector<kvs::Real32> values;
 
     // Refer the parameters of the unstructured volume object.
     const kvs::Real32* volume_coords = volume->coords().data();
@@ -522,20 +507,9 @@ void SlicePlane::extract_hexahedra_plane(
             const double value1 = this->interpolate_value<T>( volume, c2, c3 );
             const double value2 = this->interpolate_value<T>( volume, c4, c5 );
 
-            const auto color0 = color_map.at( value0 );
-            colors.push_back( color0.r() );
-            colors.push_back( color0.g() );
-            colors.push_back( color0.b() );
-
-            const auto color1 = color_map.at( value1 );
-            colors.push_back( color1.r() );
-            colors.push_back( color1.g() );
-            colors.push_back( color1.b() );
-
-            const auto color2 = color_map.at( value2 );
-            colors.push_back( color2.r() );
-            colors.push_back( color2.g() );
-            colors.push_back( color2.b() );
+            values.push_back( static_cast<kvs::Real32>( value0 ) );
+            values.push_back( static_cast<kvs::Real32>( value1 ) );
+            values.push_back( static_cast<kvs::Real32>( value2 ) );
 
             // Calculate a normal vector for the triangle polygon.
             const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
@@ -545,9 +519,11 @@ void SlicePlane::extract_hexahedra_plane(
         } // end of loop-triangle
     } // end of loop-cell
 
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+    kvs::ValueArray<kvs::UInt8> colors( values.size() * 3 );
+    color_map.map( values.data(), values.size(), colors.data() );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setColorType( kvs::PolygonObject::VertexColor );
@@ -567,7 +543,7 @@ void SlicePlane::extract_pyramid_plane(
     // Calculated the coordinate data array and the normal vector array.
     std::vector<kvs::Real32> coords;
     std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
+    std::vector<kvs::Real32> values;
 
     // Refer the parameters of the unstructured volume object.
     const kvs::Real32* volume_coords = volume->coords().data();
@@ -639,20 +615,9 @@ void SlicePlane::extract_pyramid_plane(
             const double value1 = this->interpolate_value<T>( volume, c2, c3 );
             const double value2 = this->interpolate_value<T>( volume, c4, c5 );
 
-            const auto color0 = color_map.at( value0 );
-            colors.push_back( color0.r() );
-            colors.push_back( color0.g() );
-            colors.push_back( color0.b() );
-
-            const auto color1 = color_map.at( value1 );
-            colors.push_back( color1.r() );
-            colors.push_back( color1.g() );
-            colors.push_back( color1.b() );
-
-            const auto color2 = color_map.at( value2 );
-            colors.push_back( color2.r() );
-            colors.push_back( color2.g() );
-            colors.push_back( color2.b() );
+            values.push_back( static_cast<kvs::Real32>( value0 ) );
+            values.push_back( static_cast<kvs::Real32>( value1 ) );
+            values.push_back( static_cast<kvs::Real32>( value2 ) );
 
             // Calculate a normal vector for the triangle polygon.
             const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
@@ -662,9 +627,11 @@ void SlicePlane::extract_pyramid_plane(
         } // end of loop-triangle
     } // end of loop-cell
 
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+    kvs::ValueArray<kvs::UInt8> colors( values.size() * 3 );
+    color_map.map( values.data(), values.size(), colors.data() );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setColorType( kvs::PolygonObject::VertexColor );
@@ -685,7 +652,7 @@ void SlicePlane::extract_prism_plane(
     // Calculated the coordinate data array and the normal vector array.
     std::vector<kvs::Real32> coords;
     std::vector<kvs::Real32> normals;
-    std::vector<kvs::UInt8> colors;
+    std::vector<kvs::Real32> values;
 
     // Refer the parameters of the unstructured volume object.
     const kvs::Real32* volume_coords = volume->coords().data();
@@ -758,20 +725,9 @@ void SlicePlane::extract_prism_plane(
             const double value1 = this->interpolate_value<T>( volume, c2, c3 );
             const double value2 = this->interpolate_value<T>( volume, c4, c5 );
 
-            const auto color0 = color_map.at( value0 );
-            colors.push_back( color0.r() );
-            colors.push_back( color0.g() );
-            colors.push_back( color0.b() );
-
-            const auto color1 = color_map.at( value1 );
-            colors.push_back( color1.r() );
-            colors.push_back( color1.g() );
-            colors.push_back( color1.b() );
-
-            const auto color2 = color_map.at( value2 );
-            colors.push_back( color2.r() );
-            colors.push_back( color2.g() );
-            colors.push_back( color2.b() );
+            values.push_back( static_cast<kvs::Real32>( value0 ) );
+            values.push_back( static_cast<kvs::Real32>( value1 ) );
+            values.push_back( static_cast<kvs::Real32>( value2 ) );
 
             // Calculate a normal vector for the triangle polygon.
             const kvs::Vec3 normal( -( vertex2 - vertex0 ).cross( vertex1 - vertex0 ) );
@@ -781,9 +737,11 @@ void SlicePlane::extract_prism_plane(
         } // end of loop-triangle
     } // end of loop-cell
 
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
-    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( normals ) );
+    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+    kvs::ValueArray<kvs::UInt8> colors( values.size() * 3 );
+    color_map.map( values.data(), values.size(), colors.data() );
+    SuperClass::setColors( colors );
+    SuperClass::setNormals( kvs::ValueArray<kvs::Real32>( std::move( normals ) ) );
     SuperClass::setOpacity( 255 );
     SuperClass::setPolygonType( kvs::PolygonObject::Triangle );
     SuperClass::setColorType( kvs::PolygonObject::VertexColor );
@@ -20,6 +20,7 @@
 #include <kvs/PyramidalCell>
 #include <kvs/PrismaticCell>
 #include <kvs/CellTreeLocator>
+#include <kvs/Profiler>
 
 
 namespace kvs
@@ -189,6 +190,8 @@ Streamline::Streamline(
 /*===========================================================================*/
 Streamline::BaseClass::SuperClass* Streamline::exec( const kvs::ObjectBase* object )
 {
+    KVS_PROFILER_ZONE( "mapper", this->moduleName() );
+
     if ( !object )
     {
         BaseClass::setSuccess( false );
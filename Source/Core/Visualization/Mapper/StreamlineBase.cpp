@@ -51,13 +51,13 @@ StreamlineBase::~StreamlineBase()
 void StreamlineBase::setSeedPoints( const kvs::PointObject* seed_points )
 {
     m_seed_points = new kvs::PointObject();
-    m_seed_points->setCoords( seed_points->coords() ); // shallow copy
+    m_seed_points->setCoords( seed_points->decompressedCoords() ); // shallow copy if not quantized
 }
 
 void StreamlineBase::mapping( Integrator* integrator )
 {
     std::vector<kvs::Real32> coords;
-    std::vector<kvs::UInt8> colors;
+    std::vector<kvs::Real32> lengths;
     std::vector<kvs::UInt32> connections;
 
     for ( size_t i = 0; i < m_seed_points->numberOfVertices(); i++ )
@@ -68,13 +68,10 @@ void StreamlineBase::mapping( Integrator* integrator )
         kvs::Vec3 value = integrator->value( point );
         if ( this->isTerminatedByVectorLength( value ) ) { continue; }
 
-        kvs::RGBColor color = this->interpolatedColor( value );
         coords.push_back( point.x() );
         coords.push_back( point.y() );
         coords.push_back( point.z() );
-        colors.push_back( color.r() );
-        colors.push_back( color.g() );
-        colors.push_back( color.b() );
+        lengths.push_back( value.length() );
 
         const size_t id0 = coords.size() / 3 - 1;
         for ( size_t j = 0; !this->isTerminatedByIntegrationTimes(j); j++ )
@@ -85,13 +82,10 @@ void StreamlineBase::mapping( Integrator* integrator )
             value = integrator->value( point );
             if ( this->isTerminatedByVectorLength( value ) ) { break; }
 
-            color = this->interpolatedColor( value );
             coords.push_back( point.x() );
             coords.push_back( point.y() );
             coords.push_back( point.z() );
-            colors.push_back( color.r() );
-            colors.push_back( color.g() );
-            colors.push_back( color.b() );
+            lengths.push_back( value.length() );
         }
         const size_t id1 = coords.size() / 3 - 1;
 
@@ -102,11 +96,16 @@ void StreamlineBase::mapping( Integrator* integrator )
         }
     }
 
+    // The colors of the vertices are mapped from the vector lengths at once,
+    // which gives the same colors as interpolatedColor().
+    kvs::ValueArray<kvs::UInt8> colors( lengths.size() * 3 );
+    BaseClass::transferFunction().colorMap().map( lengths.data(), lengths.size(), colors.data() );
+
     SuperClass::setLineType( kvs::LineObject::Polyline );
     SuperClass::setColorType( kvs::LineObject::VertexColor );
-    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( coords ) );
-    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( connections ) );
-    SuperClass::setColors( kvs::ValueArray<kvs::UInt8>( colors ) );
+    SuperClass::setCoords( kvs::ValueArray<kvs::Real32>( std::move( coords ) ) );
+    SuperClass::setConnections( kvs::ValueArray<kvs::UInt32>( std::move( connections ) ) );
+    SuperClass::setColors( colors );
     SuperClass::setSize( 1.0f );
 }
 
@@ -0,0 +1,120 @@
+/****************************************************************************/
+/**
+ *  @file   TableLookUp.h
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#pragma once
+#include <kvs/Math>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Locates the value in the table by assuming piecewise linear map.
+ *  @param  resolution [in] resolution of the table
+ *  @param  min_value [in] min. value
+ *  @param  max_value [in] max. value
+ *  @param  value [in] value
+ *  @param  s0 [out] index of the lower entry
+ *  @param  s1 [out] index of the upper entry
+ *  @return interpolation parameter between the lower and upper entries
+ */
+/*===========================================================================*/
+inline float Locate(
+    const size_t resolution,
+    const float min_value,
+    const float max_value,
+    const float value,
+    size_t* s0,
+    size_t* s1 )
+{
+    const float v0 = kvs::Math::Clamp( value, min_value, max_value );
+    const float r = static_cast<float>( resolution - 1 );
+    const float v = ( v0 - min_value ) / ( max_value - min_value ) * r;
+    *s0 = static_cast<size_t>( v );
+    *s1 = kvs::Math::Min( *s0 + 1, resolution - 1 );
+    return v - *s0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the values representable by the type.
+ *  @return number of the values (0 for the types wider than 16 bits)
+ */
+/*===========================================================================*/
+template <typename T>
+inline size_t NumberOfTableEntries()
+{
+    // The shift count is 0 for the wider types, which are instantiated too
+    // but never use the per-value table.
+    const size_t nbits = sizeof(T) <= 2 ? sizeof(T) * 8 : 0;
+    return nbits > 0 ? size_t(1) << nbits : 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns true if the values can be mapped via a per-value lookup table.
+ *  @param  nvalues [in] number of values
+ *  @return true, if the per-value lookup table is cheaper than the direct lookup
+ */
+/*===========================================================================*/
+template <typename T>
+inline bool UsePerValueTable( const size_t nvalues )
+{
+    // Up to 16-bit integers, the entries for all representable values are
+    // calculated once, and each value is converted with a single table access.
+    return std::is_integral<T>::value && sizeof(T) <= 2 &&
+        nvalues >= NumberOfTableEntries<T>();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Maps the values to the entries looked up by the given function.
+ *  @param  values [in] pointer to the values
+ *  @param  nvalues [in] number of values
+ *  @param  lookup [in] function to look up the entry of a value
+ *  @param  entries [out] pointer to the entries (NumberOfChannels x nvalues)
+ */
+/*===========================================================================*/
+template <size_t NumberOfChannels, typename T, typename Entry, typename LookUpFunction>
+inline void MapValues(
+    const T* values,
+    const size_t nvalues,
+    LookUpFunction lookup,
+    Entry* entries )
+{
+    if ( UsePerValueTable<T>( nvalues ) )
+    {
+        const size_t nentries = NumberOfTableEntries<T>();
+        const long lower = static_cast<long>( std::numeric_limits<T>::min() );
+        std::vector<Entry> table( NumberOfChannels * nentries );
+        for ( size_t i = 0; i < nentries; i++ )
+        {
+            const float value = static_cast<float>( lower + long(i) );
+            lookup( value, &table[ NumberOfChannels * i ] );
+        }
+
+        for ( size_t i = 0; i < nvalues; i++ )
+        {
+            const size_t index = static_cast<size_t>( static_cast<long>( values[i] ) - lower );
+            const Entry* entry = &table[ NumberOfChannels * index ];
+            std::copy( entry, entry + NumberOfChannels, entries + NumberOfChannels * i );
+        }
+        return;
+    }
+
+    for ( size_t i = 0; i < nvalues; i++ )
+    {
+        const float value = static_cast<float>( values[i] );
+        lookup( value, entries + NumberOfChannels * i );
+    }
+}
+
+} // end of namespace
@@ -329,6 +329,49 @@ kvs::ValueArray<kvs::Real32> TransferFunction::table() const
     return table;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the interpolated RGBA color of the value.
+ *  @param  value [in] value
+ *  @return RGB color and opacity
+ */
+/*===========================================================================*/
+kvs::RGBAColor TransferFunction::at( const float value ) const
+{
+    return kvs::RGBAColor( m_color_map.at( value ), m_opacity_map.at( value ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Maps the values to the RGB colors and the opacities.
+ *  @param  values [in] pointer to the values
+ *  @param  nvalues [in] number of values
+ *  @param  colors [out] pointer to the RGB colors (3 x nvalues)
+ *  @param  opacities [out] pointer to the opacities (nvalues)
+ */
+/*===========================================================================*/
+template <typename T>
+void TransferFunction::map(
+    const T* values,
+    const size_t nvalues,
+    kvs::UInt8* colors,
+    kvs::Real32* opacities ) const
+{
+    m_color_map.map( values, nvalues, colors );
+    m_opacity_map.map( values, nvalues, opacities );
+}
+
+template void TransferFunction::map<kvs::Int8>( const kvs::Int8*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::Int16>( const kvs::Int16*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::Int32>( const kvs::Int32*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::Int64>( const kvs::Int64*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::UInt8>( const kvs::UInt8*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::UInt16>( const kvs::UInt16*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::UInt32>( const kvs::UInt32*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::UInt64>( const kvs::UInt64*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::Real32>( const kvs::Real32*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+template void TransferFunction::map<kvs::Real64>( const kvs::Real64*, const size_t, kvs::UInt8*, kvs::Real32* ) const;
+
 /*==========================================================================*/
 /**
  *  @brief  Create the alpha map.
@@ -11,6 +11,7 @@
 #include <kvs/OpacityMap>
 #include <kvs/VolumeObjectBase>
 #include <kvs/ValueArray>
+#include <kvs/RGBAColor>
 
 
 namespace kvs
@@ -52,6 +53,9 @@ public:
     const kvs::OpacityMap& opacityMap() const;
     size_t resolution() const;
     kvs::ValueArray<kvs::Real32> table() const;
+    kvs::RGBAColor at( const float value ) const;
+    template <typename T>
+    void map( const T* values, const size_t nvalues, kvs::UInt8* colors, kvs::Real32* opacities ) const;
 
     void create( const size_t resolution );
     bool read( const std::string& filename );
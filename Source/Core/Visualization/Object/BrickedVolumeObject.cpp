@@ -0,0 +1,806 @@
+/****************************************************************************/
+/**
+ *  @file   BrickedVolumeObject.cpp
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#include "BrickedVolumeObject.h"
+#include <cstring>
+#include <cmath>
+#include <kvs/Platform>
+#include <kvs/MutexLocker>
+#include <kvs/Message>
+#include <kvs/Math>
+#include <kvs/Value>
+
+
+namespace
+{
+
+/*
+ *  Brick file format (native byte order)
+ *
+ *  Header:
+ *    Int8[8]   magic number "KVSBRICK"
+ *    UInt32    version
+ *    UInt32    value type ID (kvs::Type::TypeID)
+ *    UInt32    veclen
+ *    UInt32[3] resolution
+ *    UInt32    brick size (number of cells in each axis of a brick)
+ *    Real64[2] min. and max. values
+ *    Real32[6] min. and max. external coordinates
+ *  Bricks:
+ *    (brick size + 3)^3 * veclen values for each brick, which includes the
+ *    ghost nodes, in the order of the brick index (x-axis runs fastest).
+ */
+const char Magic[8] = { 'K', 'V', 'S', 'B', 'R', 'I', 'C', 'K' };
+const kvs::UInt32 Version = 1;
+const size_t HeaderSize = 8 + 4 * 7 + 8 * 2 + 4 * 6;
+
+/*===========================================================================*/
+/**
+ *  @brief  Moves the file position indicator to the specified position.
+ *  @param  fp [in] file pointer
+ *  @param  offset [in] offset in bytes from the beginning of the file
+ *  @return true, if the process is done successfully
+ */
+/*===========================================================================*/
+bool Seek( std::FILE* fp, const kvs::UInt64 offset )
+{
+#if defined( KVS_PLATFORM_WINDOWS )
+    return _fseeki64( fp, static_cast<__int64>( offset ), SEEK_SET ) == 0;
+#else
+    return fseeko( fp, static_cast<off_t>( offset ), SEEK_SET ) == 0;
+#endif
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the byte size of the value type.
+ *  @param  id [in] value type ID
+ *  @return byte size (0 for the unknown type)
+ */
+/*===========================================================================*/
+size_t SizeOf( const kvs::Type::TypeID id )
+{
+    switch ( id )
+    {
+    case kvs::Type::TypeInt8: return sizeof( kvs::Int8 );
+    case kvs::Type::TypeInt16: return sizeof( kvs::Int16 );
+    case kvs::Type::TypeInt32: return sizeof( kvs::Int32 );
+    case kvs::Type::TypeInt64: return sizeof( kvs::Int64 );
+    case kvs::Type::TypeUInt8: return sizeof( kvs::UInt8 );
+    case kvs::Type::TypeUInt16: return sizeof( kvs::UInt16 );
+    case kvs::Type::TypeUInt32: return sizeof( kvs::UInt32 );
+    case kvs::Type::TypeUInt64: return sizeof( kvs::UInt64 );
+    case kvs::Type::TypeReal32: return sizeof( kvs::Real32 );
+    case kvs::Type::TypeReal64: return sizeof( kvs::Real64 );
+    default: break;
+    }
+    return 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Allocates a value array for the value type.
+ *  @param  id [in] value type ID
+ *  @param  size [in] number of values
+ *  @return value array
+ */
+/*===========================================================================*/
+kvs::AnyValueArray Allocate( const kvs::Type::TypeID id, const size_t size )
+{
+    kvs::AnyValueArray values;
+    switch ( id )
+    {
+    case kvs::Type::TypeInt8: values.allocate<kvs::Int8>( size ); break;
+    case kvs::Type::TypeInt16: values.allocate<kvs::Int16>( size ); break;
+    case kvs::Type::TypeInt32: values.allocate<kvs::Int32>( size ); break;
+    case kvs::Type::TypeInt64: values.allocate<kvs::Int64>( size ); break;
+    case kvs::Type::TypeUInt8: values.allocate<kvs::UInt8>( size ); break;
+    case kvs::Type::TypeUInt16: values.allocate<kvs::UInt16>( size ); break;
+    case kvs::Type::TypeUInt32: values.allocate<kvs::UInt32>( size ); break;
+    case kvs::Type::TypeUInt64: values.allocate<kvs::UInt64>( size ); break;
+    case kvs::Type::TypeReal32: values.allocate<kvs::Real32>( size ); break;
+    case kvs::Type::TypeReal64: values.allocate<kvs::Real64>( size ); break;
+    default: break;
+    }
+    return values;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Updates the min/max values with the given values.
+ *  @param  data [in] pointer to the values
+ *  @param  nnodes [in] number of nodes
+ *  @param  veclen [in] vector length
+ *  @param  min_value [in/out] min. value (magnitude for the vector data)
+ *  @param  max_value [in/out] max. value (magnitude for the vector data)
+ */
+/*===========================================================================*/
+template <typename T>
+void UpdateMinMaxValues(
+    const void* data,
+    const size_t nnodes,
+    const size_t veclen,
+    kvs::Real64& min_value,
+    kvs::Real64& max_value )
+{
+    const T* value = static_cast<const T*>( data );
+    for ( size_t i = 0; i < nnodes; i++ )
+    {
+        kvs::Real64 v = 0.0;
+        if ( veclen == 1 ) { v = static_cast<kvs::Real64>( *value++ ); }
+        else
+        {
+            for ( size_t j = 0; j < veclen; j++, value++ )
+            {
+                v += static_cast<kvs::Real64>( *value ) * static_cast<kvs::Real64>( *value );
+            }
+            v = std::sqrt( v );
+        }
+        min_value = kvs::Math::Min( min_value, v );
+        max_value = kvs::Math::Max( max_value, v );
+    }
+}
+
+void UpdateMinMaxValues(
+    const kvs::Type::TypeID id,
+    const void* data,
+    const size_t nnodes,
+    const size_t veclen,
+    kvs::Real64& min_value,
+    kvs::Real64& max_value )
+{
+    switch ( id )
+    {
+    case kvs::Type::TypeInt8: UpdateMinMaxValues<kvs::Int8>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeInt16: UpdateMinMaxValues<kvs::Int16>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeInt32: UpdateMinMaxValues<kvs::Int32>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeInt64: UpdateMinMaxValues<kvs::Int64>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeUInt8: UpdateMinMaxValues<kvs::UInt8>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeUInt16: UpdateMinMaxValues<kvs::UInt16>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeUInt32: UpdateMinMaxValues<kvs::UInt32>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeUInt64: UpdateMinMaxValues<kvs::UInt64>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeReal32: UpdateMinMaxValues<kvs::Real32>( data, nnodes, veclen, min_value, max_value ); break;
+    case kvs::Type::TypeReal64: UpdateMinMaxValues<kvs::Real64>( data, nnodes, veclen, min_value, max_value ); break;
+    default: break;
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of bricks along an axis.
+ *  @param  resolution [in] number of nodes along the axis
+ *  @param  brick_size [in] number of cells in a brick along the axis
+ *  @return number of bricks
+ */
+/*===========================================================================*/
+inline size_t NumberOfBricks( const size_t resolution, const size_t brick_size )
+{
+    return ( resolution - 1 + brick_size - 1 ) / brick_size;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the index of the brick which owns the node along an axis.
+ *  @param  index [in] node index along the axis
+ *  @param  brick_size [in] number of cells in a brick along the axis
+ *  @param  nbricks [in] number of bricks along the axis
+ *  @return brick index
+ */
+/*===========================================================================*/
+inline size_t OwnerBrick( const size_t index, const size_t brick_size, const size_t nbricks )
+{
+    return kvs::Math::Min( index / brick_size, nbricks - 1 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the node index clamped in the volume.
+ *  @param  index [in] node index which can be out of the volume
+ *  @param  resolution [in] number of nodes along the axis
+ *  @return clamped node index
+ */
+/*===========================================================================*/
+inline size_t ClampedIndex( const long index, const size_t resolution )
+{
+    return static_cast<size_t>( kvs::Math::Clamp( index, 0L, static_cast<long>( resolution ) - 1 ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the brick file.
+ *  @param  fp [in] file pointer
+ *  @param  resolution [in] volume resolution
+ *  @param  veclen [in] vector length
+ *  @param  type_id [in] value type ID
+ *  @param  brick_size [in] brick size
+ *  @param  min_coord [in] min. external coordinate
+ *  @param  max_coord [in] max. external coordinate
+ *  @param  read_row [in] function that reads the node values along x-axis for (y, z)
+ *  @return true, if the process is done successfully
+ */
+/*===========================================================================*/
+template <typename RowReader>
+bool WriteBrickFile(
+    std::FILE* fp,
+    const kvs::Vec3ui& resolution,
+    const size_t veclen,
+    const kvs::Type::TypeID type_id,
+    const size_t brick_size,
+    const kvs::Vec3& min_coord,
+    const kvs::Vec3& max_coord,
+    RowReader read_row )
+{
+    const size_t lower = kvs::BrickedVolumeObject::LowerGhostSize;
+    const size_t n = brick_size + lower + kvs::BrickedVolumeObject::UpperGhostSize;
+    const size_t value_size = ::SizeOf( type_id ) * veclen;
+    const size_t nx = resolution.x();
+    const size_t nbx = ::NumberOfBricks( resolution.x(), brick_size );
+    const size_t nby = ::NumberOfBricks( resolution.y(), brick_size );
+    const size_t nbz = ::NumberOfBricks( resolution.z(), brick_size );
+
+    // Header (the min/max values are written after all the bricks are written).
+    const kvs::UInt32 header[7] = {
+        ::Version,
+        static_cast<kvs::UInt32>( type_id ),
+        static_cast<kvs::UInt32>( veclen ),
+        resolution.x(), resolution.y(), resolution.z(),
+        static_cast<kvs::UInt32>( brick_size ) };
+    kvs::Real64 min_max_values[2] = { kvs::Value<kvs::Real64>::Max(), kvs::Value<kvs::Real64>::Min() };
+    const kvs::Real32 min_max_coords[6] = {
+        min_coord.x(), min_coord.y(), min_coord.z(),
+        max_coord.x(), max_coord.y(), max_coord.z() };
+    if ( std::fwrite( ::Magic, 1, 8, fp ) != 8 ) { return false; }
+    if ( std::fwrite( header, sizeof( kvs::UInt32 ), 7, fp ) != 7 ) { return false; }
+    if ( std::fwrite( min_max_values, sizeof( kvs::Real64 ), 2, fp ) != 2 ) { return false; }
+    if ( std::fwrite( min_max_coords, sizeof( kvs::Real32 ), 6, fp ) != 6 ) { return false; }
+
+    // The node rows covered by a row of bricks along x-axis are read at once,
+    // so that each row of the input data is read only a few times.
+    std::vector<kvs::UInt8> rows( n * n * nx * value_size );
+    std::vector<kvs::UInt8> brick( n * n * n * value_size );
+    for ( size_t bz = 0; bz < nbz; bz++ )
+    {
+        for ( size_t by = 0; by < nby; by++ )
+        {
+            for ( size_t lz = 0; lz < n; lz++ )
+            {
+                const long z = static_cast<long>( bz * brick_size + lz ) - static_cast<long>( lower );
+                const size_t gz = ::ClampedIndex( z, resolution.z() );
+                for ( size_t ly = 0; ly < n; ly++ )
+                {
+                    const long y = static_cast<long>( by * brick_size + ly ) - static_cast<long>( lower );
+                    const size_t gy = ::ClampedIndex( y, resolution.y() );
+                    kvs::UInt8* row = rows.data() + ( lz * n + ly ) * nx * value_size;
+                    if ( !read_row( gy, gz, row ) ) { return false; }
+
+                    const bool owned =
+                        ::OwnerBrick( gy, brick_size, nby ) == by &&
+                        ::OwnerBrick( gz, brick_size, nbz ) == bz;
+                    if ( owned )
+                    {
+                        ::UpdateMinMaxValues( type_id, row, nx, veclen, min_max_values[0], min_max_values[1] );
+                    }
+                }
+            }
+
+            for ( size_t bx = 0; bx < nbx; bx++ )
+            {
+                kvs::UInt8* dst = brick.data();
+                for ( size_t lz = 0; lz < n; lz++ )
+                {
+                    for ( size_t ly = 0; ly < n; ly++ )
+                    {
+                        const kvs::UInt8* row = rows.data() + ( lz * n + ly ) * nx * value_size;
+                        for ( size_t lx = 0; lx < n; lx++, dst += value_size )
+                        {
+                            const long x = static_cast<long>( bx * brick_size + lx ) - static_cast<long>( lower );
+                            const size_t gx = ::ClampedIndex( x, resolution.x() );
+                            std::memcpy( dst, row + gx * value_size, value_size );
+                        }
+                    }
+                }
+
+                if ( std::fwrite( brick.data(), 1, brick.size(), fp ) != brick.size() ) { return false; }
+            }
+        }
+    }
+
+    if ( !::Seek( fp, 8 + sizeof( kvs::UInt32 ) * 7 ) ) { return false; }
+    if ( std::fwrite( min_max_values, sizeof( kvs::Real64 ), 2, fp ) != 2 ) { return false; }
+
+    return true;
+}
+
+} // end of namespace
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates a brick file from the structured volume object.
+ *  @param  filename [in] brick filename
+ *  @param  volume [in] pointer to the uniform grid volume object
+ *  @param  brick_size [in] number of cells in each axis of a brick
+ *  @return true, if the process is done successfully
+ */
+/*===========================================================================*/
+bool BrickedVolumeObject::CreateBrickFile(
+    const std::string& filename,
+    const kvs::StructuredVolumeObject* volume,
+    const size_t brick_size )
+{
+    if ( volume->gridType() != kvs::StructuredVolumeObject::Uniform )
+    {
+        kvsMessageError("Only the uniform grid volume can be bricked.");
+        return false;
+    }
+
+    const kvs::Vec3ui resolution = volume->resolution();
+    if ( brick_size == 0 || resolution.x() < 2 || resolution.y() < 2 || resolution.z() < 2 )
+    {
+        kvsMessageError("Invalid brick size or volume resolution.");
+        return false;
+    }
+
+    const size_t veclen = volume->veclen();
+    const kvs::Type::TypeID type_id = volume->values().typeID();
+    const size_t value_size = ::SizeOf( type_id ) * veclen;
+    const size_t line_size = volume->numberOfNodesPerLine();
+    const size_t slice_size = volume->numberOfNodesPerSlice();
+    const kvs::UInt8* values = static_cast<const kvs::UInt8*>( volume->values().data() );
+    auto read_row = [&] ( const size_t y, const size_t z, kvs::UInt8* row )
+    {
+        std::memcpy( row, values + ( y * line_size + z * slice_size ) * value_size, line_size * value_size );
+        return true;
+    };
+
+    std::FILE* fp = std::fopen( filename.c_str(), "wb" );
+    if ( !fp )
+    {
+        kvsMessageError("Cannot open %s.", filename.c_str() );
+        return false;
+    }
+
+    if ( !volume->hasMinMaxExternalCoords() )
+    {
+        // WARNING: remove constness, but safe in this case.
+        const_cast<kvs::StructuredVolumeObject*>( volume )->updateMinMaxCoords();
+    }
+    const kvs::Vec3 min_coord = volume->minExternalCoord();
+    const kvs::Vec3 max_coord = volume->maxExternalCoord();
+    const bool success = ::WriteBrickFile(
+        fp, resolution, veclen, type_id, brick_size, min_coord, max_coord, read_row );
+    std::fclose( fp );
+
+    if ( !success ) { kvsMessageError("Cannot write %s.", filename.c_str() ); }
+    return success;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Creates a brick file from the raw data file without loading the whole data.
+ *  @param  filename [in] brick filename
+ *  @param  raw_filename [in] raw data filename (node values in native byte order)
+ *  @param  resolution [in] volume resolution
+ *  @param  veclen [in] vector length
+ *  @param  type_id [in] value type ID
+ *  @param  brick_size [in] number of cells in each axis of a brick
+ *  @return true, if the process is done successfully
+ */
+/*===========================================================================*/
+bool BrickedVolumeObject::CreateBrickFile(
+    const std::string& filename,
+    const std::string& raw_filename,
+    const kvs::Vec3ui& resolution,
+    const size_t veclen,
+    const kvs::Type::TypeID type_id,
+    const size_t brick_size )
+{
+    const size_t value_size = ::SizeOf( type_id ) * veclen;
+    if ( value_size == 0 || brick_size == 0 ||
+         resolution.x() < 2 || resolution.y() < 2 || resolution.z() < 2 )
+    {
+        kvsMessageError("Invalid value type, brick size or volume resolution.");
+        return false;
+    }
+
+    std::FILE* ifp = std::fopen( raw_filename.c_str(), "rb" );
+    if ( !ifp )
+    {
+        kvsMessageError("Cannot open %s.", raw_filename.c_str() );
+        return false;
+    }
+
+    std::FILE* ofp = std::fopen( filename.c_str(), "wb" );
+    if ( !ofp )
+    {
+        kvsMessageError("Cannot open %s.", filename.c_str() );
+        std::fclose( ifp );
+        return false;
+    }
+
+    const kvs::UInt64 line_size = resolution.x();
+    const kvs::UInt64 slice_size = line_size * resolution.y();
+    auto read_row = [&] ( const size_t y, const size_t z, kvs::UInt8* row )
+    {
+        const kvs::UInt64 offset = ( y * line_size + z * slice_size ) * value_size;
+        if ( !::Seek( ifp, offset ) ) { return false; }
+        return std::fread( row, value_size, line_size, ifp ) == line_size;
+    };
+
+    const kvs::Vec3 min_coord( 0.0f, 0.0f, 0.0f );
+    const kvs::Vec3 max_coord( kvs::Vec3( resolution ) - kvs::Vec3( 1.0f, 1.0f, 1.0f ) );
+    const bool success = ::WriteBrickFile(
+        ofp, resolution, veclen, type_id, brick_size, min_coord, max_coord, read_row );
+    std::fclose( ofp );
+    std::fclose( ifp );
+
+    if ( !success ) { kvsMessageError("Cannot convert %s to %s.", raw_filename.c_str(), filename.c_str() ); }
+    return success;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Opens the brick file.
+ *  @param  filename [in] brick filename
+ *  @return true, if the process is done successfully
+ */
+/*===========================================================================*/
+bool BrickedVolumeObject::open( const std::string& filename )
+{
+    this->close();
+
+    std::FILE* fp = std::fopen( filename.c_str(), "rb" );
+    if ( !fp )
+    {
+        kvsMessageError("Cannot open %s.", filename.c_str() );
+        return false;
+    }
+
+    char magic[8];
+    kvs::UInt32 header[7];
+    kvs::Real64 min_max_values[2];
+    kvs::Real32 min_max_coords[6];
+    const bool success =
+        std::fread( magic, 1, 8, fp ) == 8 &&
+        std::fread( header, sizeof( kvs::UInt32 ), 7, fp ) == 7 &&
+        std::fread( min_max_values, sizeof( kvs::Real64 ), 2, fp ) == 2 &&
+        std::fread( min_max_coords, sizeof( kvs::Real32 ), 6, fp ) == 6;
+    if ( !success || std::memcmp( magic, ::Magic, 8 ) != 0 || header[0] != ::Version )
+    {
+        kvsMessageError("%s is not a brick file.", filename.c_str() );
+        std::fclose( fp );
+        return false;
+    }
+
+    const kvs::Type::TypeID type_id = static_cast<kvs::Type::TypeID>( header[1] );
+    if ( ::SizeOf( type_id ) == 0 || header[6] == 0 )
+    {
+        kvsMessageError("Broken header in %s.", filename.c_str() );
+        std::fclose( fp );
+        return false;
+    }
+
+    const size_t brick_size = header[6];
+    const kvs::Vec3ui resolution( header[3], header[4], header[5] );
+    m_filename = filename;
+    m_file = fp;
+    m_type_id = type_id;
+    m_brick_size = brick_size;
+    m_brick_resolution.set(
+        static_cast<kvs::UInt32>( ::NumberOfBricks( resolution.x(), brick_size ) ),
+        static_cast<kvs::UInt32>( ::NumberOfBricks( resolution.y(), brick_size ) ),
+        static_cast<kvs::UInt32>( ::NumberOfBricks( resolution.z(), brick_size ) ) );
+    m_entries.assign( this->numberOfBricks(), Entry() );
+
+    BaseClass::setGridTypeToUniform();
+    BaseClass::setResolution( resolution );
+    BaseClass::setVeclen( header[2] );
+    BaseClass::setValues( ::Allocate( type_id, 0 ) );
+    BaseClass::setMinMaxValues( min_max_values[0], min_max_values[1] );
+
+    const kvs::Vec3 min_coord( min_max_coords[0], min_max_coords[1], min_max_coords[2] );
+    const kvs::Vec3 max_coord( min_max_coords[3], min_max_coords[4], min_max_coords[5] );
+    BaseClass::setMinMaxObjectCoords( min_coord, max_coord );
+    BaseClass::setMinMaxExternalCoords( min_coord, max_coord );
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Closes the brick file and releases the cached bricks.
+ */
+/*===========================================================================*/
+void BrickedVolumeObject::close()
+{
+    this->clearCache();
+    if ( m_file )
+    {
+        std::fclose( m_file );
+        m_file = nullptr;
+    }
+
+    m_entries.clear();
+    m_type_id = kvs::Type::UnknownType;
+    m_brick_size = 0;
+    m_brick_resolution.set( 0, 0, 0 );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints information of the bricked volume object.
+ *  @param  os [in] output stream
+ *  @param  indent [in] indent
+ */
+/*===========================================================================*/
+void BrickedVolumeObject::print( std::ostream& os, const kvs::Indent& indent ) const
+{
+    BaseClass::print( os, indent );
+    os << indent << "Filename : " << m_filename << std::endl;
+    os << indent << "Brick size : " << m_brick_size << std::endl;
+    os << indent << "Brick resolution : " << m_brick_resolution << std::endl;
+    os << indent << "Cache size : " << m_cache_size << std::endl;
+    os << indent << "Number of cached bricks : " << this->numberOfCachedBricks() << std::endl;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the max. number of bricks in the cache.
+ *  @param  nbricks [in] max. number of bricks
+ */
+/*===========================================================================*/
+void BrickedVolumeObject::setCacheSize( const size_t nbricks )
+{
+    kvs::MutexLocker locker( &m_cache_mutex );
+    m_cache_size = nbricks;
+    while ( m_lru.size() > m_cache_size )
+    {
+        m_entries[ m_lru.back() ].values = kvs::AnyValueArray();
+        m_lru.pop_back();
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Releases all of the cached bricks.
+ */
+/*===========================================================================*/
+void BrickedVolumeObject::clearCache()
+{
+    kvs::MutexLocker locker( &m_cache_mutex );
+    for ( const size_t index : m_lru ) { m_entries[ index ].values = kvs::AnyValueArray(); }
+    m_lru.clear();
+    m_cache_hits = 0;
+    m_cache_misses = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Keeps the min/max values read from the brick file header.
+ *
+ *  The min/max values are given by the header of the brick file, which are
+ *  calculated when the file is created, so the node values are not scanned.
+ *  Since values() is always empty, the histogram and the component ranges of
+ *  this object are not available.
+ */
+/*===========================================================================*/
+void BrickedVolumeObject::updateMinMaxValues() const
+{
+}
+
+size_t BrickedVolumeObject::numberOfBricks() const
+{
+    return size_t( m_brick_resolution.x() ) * m_brick_resolution.y() * m_brick_resolution.z();
+}
+
+size_t BrickedVolumeObject::numberOfBrickNodesPerLine() const
+{
+    return m_brick_size + LowerGhostSize + UpperGhostSize;
+}
+
+size_t BrickedVolumeObject::numberOfBrickNodesPerSlice() const
+{
+    return this->numberOfBrickNodesPerLine() * this->numberOfBrickNodesPerLine();
+}
+
+size_t BrickedVolumeObject::numberOfBrickNodes() const
+{
+    return this->numberOfBrickNodesPerSlice() * this->numberOfBrickNodesPerLine();
+}
+
+size_t BrickedVolumeObject::numberOfCachedBricks() const
+{
+    kvs::MutexLocker locker( &m_cache_mutex );
+    return m_lru.size();
+}
+
+size_t BrickedVolumeObject::numberOfCacheHits() const
+{
+    kvs::MutexLocker locker( &m_cache_mutex );
+    return m_cache_hits;
+}
+
+size_t BrickedVolumeObject::numberOfCacheMisses() const
+{
+    kvs::MutexLocker locker( &m_cache_mutex );
+    return m_cache_misses;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the node values of the brick including the ghost nodes.
+ *  @param  brick_index [in] brick index in each axis
+ *  @return node values of the brick (empty if the loading is failed)
+ *
+ *  The brick is loaded from the file if it is not in the cache. The returned
+ *  array shares the values with the cache, and it keeps valid even if the
+ *  brick is evicted from the cache. This method can be called concurrently.
+ */
+/*===========================================================================*/
+kvs::AnyValueArray BrickedVolumeObject::brick( const kvs::Vec3ui& brick_index ) const
+{
+    KVS_ASSERT( brick_index.x() < m_brick_resolution.x() );
+    KVS_ASSERT( brick_index.y() < m_brick_resolution.y() );
+    KVS_ASSERT( brick_index.z() < m_brick_resolution.z() );
+
+    const size_t index = brick_index.x() + m_brick_resolution.x() *
+        ( brick_index.y() + size_t( m_brick_resolution.y() ) * brick_index.z() );
+    {
+        kvs::MutexLocker locker( &m_cache_mutex );
+        Entry& entry = m_entries[ index ];
+        if ( !entry.values.empty() )
+        {
+            m_lru.splice( m_lru.begin(), m_lru, entry.position );
+            m_cache_hits++;
+            return entry.values;
+        }
+        m_cache_misses++;
+    }
+
+    // The file is read without locking the cache, so that the other threads
+    // can access the cached bricks during the loading.
+    kvs::AnyValueArray values = this->load_brick( index );
+    if ( values.empty() ) { return values; }
+
+    kvs::MutexLocker locker( &m_cache_mutex );
+    Entry& entry = m_entries[ index ];
+    if ( !entry.values.empty() )
+    {
+        // The brick has been loaded by another thread.
+        m_lru.splice( m_lru.begin(), m_lru, entry.position );
+        return entry.values;
+    }
+
+    entry.values = values;
+    m_lru.push_front( index );
+    entry.position = m_lru.begin();
+    while ( m_lru.size() > m_cache_size )
+    {
+        m_entries[ m_lru.back() ].values = kvs::AnyValueArray();
+        m_lru.pop_back();
+    }
+
+    return values;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the node values in the specified region.
+ *  @param  min_index [in] min. node index of the region
+ *  @param  max_index [in] max. node index of the region (inclusive)
+ *  @return node values in the region (empty if the reading is failed)
+ */
+/*===========================================================================*/
+kvs::AnyValueArray BrickedVolumeObject::readRegion(
+    const kvs::Vec3ui& min_index,
+    const kvs::Vec3ui& max_index ) const
+{
+    const kvs::Vec3ui resolution = BaseClass::resolution();
+    for ( int i = 0; i < 3; i++ )
+    {
+        if ( min_index[i] > max_index[i] || max_index[i] >= resolution[i] )
+        {
+            kvsMessageError("Invalid region.");
+            return kvs::AnyValueArray();
+        }
+    }
+
+    const size_t veclen = BaseClass::veclen();
+    const size_t value_size = ::SizeOf( m_type_id ) * veclen;
+    const size_t rx = max_index.x() - min_index.x() + 1;
+    const size_t ry = max_index.y() - min_index.y() + 1;
+    const size_t rz = max_index.z() - min_index.z() + 1;
+    kvs::AnyValueArray region = ::Allocate( m_type_id, rx * ry * rz * veclen );
+    kvs::UInt8* dst = static_cast<kvs::UInt8*>( region.data() );
+
+    const size_t B = m_brick_size;
+    const size_t L = LowerGhostSize;
+    const size_t line_size = this->numberOfBrickNodesPerLine();
+    const size_t slice_size = this->numberOfBrickNodesPerSlice();
+    const kvs::Vec3ui nbricks = m_brick_resolution;
+    const kvs::Vec3ui min_brick(
+        ::OwnerBrick( min_index.x(), B, nbricks.x() ),
+        ::OwnerBrick( min_index.y(), B, nbricks.y() ),
+        ::OwnerBrick( min_index.z(), B, nbricks.z() ) );
+    const kvs::Vec3ui max_brick(
+        ::OwnerBrick( max_index.x(), B, nbricks.x() ),
+        ::OwnerBrick( max_index.y(), B, nbricks.y() ),
+        ::OwnerBrick( max_index.z(), B, nbricks.z() ) );
+
+    // Range of the nodes in the region owned by the brick along an axis.
+    auto owned_range = [&] ( const int axis, const size_t b, size_t& begin, size_t& end )
+    {
+        begin = kvs::Math::Max( size_t( min_index[axis] ), b * B );
+        end = ( b == nbricks[axis] - 1 ) ? max_index[axis] : kvs::Math::Min( size_t( max_index[axis] ), b * B + B - 1 );
+    };
+
+    for ( kvs::UInt32 bz = min_brick.z(); bz <= max_brick.z(); bz++ )
+    {
+        for ( kvs::UInt32 by = min_brick.y(); by <= max_brick.y(); by++ )
+        {
+            for ( kvs::UInt32 bx = min_brick.x(); bx <= max_brick.x(); bx++ )
+            {
+                const kvs::AnyValueArray values = this->brick( kvs::Vec3ui( bx, by, bz ) );
+                if ( values.empty() ) { return kvs::AnyValueArray(); }
+
+                size_t x0, x1, y0, y1, z0, z1;
+                owned_range( 0, bx, x0, x1 );
+                owned_range( 1, by, y0, y1 );
+                owned_range( 2, bz, z0, z1 );
+
+                const kvs::UInt8* src = static_cast<const kvs::UInt8*>( values.data() );
+                const size_t length = ( x1 - x0 + 1 ) * value_size;
+                for ( size_t z = z0; z <= z1; z++ )
+                {
+                    for ( size_t y = y0; y <= y1; y++ )
+                    {
+                        const size_t src_index =
+                            ( x0 - bx * B + L ) +
+                            ( y - by * B + L ) * line_size +
+                            ( z - bz * B + L ) * slice_size;
+                        const size_t dst_index =
+                            ( x0 - min_index.x() ) +
+                            ( y - min_index.y() ) * rx +
+                            ( z - min_index.z() ) * rx * ry;
+                        std::memcpy( dst + dst_index * value_size, src + src_index * value_size, length );
+                    }
+                }
+            }
+        }
+    }
+
+    return region;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Loads the brick from the file.
+ *  @param  index [in] brick index
+ *  @return node values of the brick (empty if the loading is failed)
+ */
+/*===========================================================================*/
+kvs::AnyValueArray BrickedVolumeObject::load_brick( const size_t index ) const
+{
+    const size_t nvalues = this->numberOfBrickNodes() * BaseClass::veclen();
+    kvs::AnyValueArray values = ::Allocate( m_type_id, nvalues );
+    const kvs::UInt64 brick_bytes = values.byteSize();
+    const kvs::UInt64 offset = ::HeaderSize + brick_bytes * index;
+
+    kvs::MutexLocker locker( &m_file_mutex );
+    if ( !::Seek( m_file, offset ) ||
+         std::fread( values.data(), 1, values.byteSize(), m_file ) != values.byteSize() )
+    {
+        kvsMessageError("Cannot read the brick #%lu from %s.", (unsigned long)index, m_filename.c_str() );
+        return kvs::AnyValueArray();
+    }
+
+    return values;
+}
+
+} // end of namespace kvs
@@ -0,0 +1,117 @@
+/****************************************************************************/
+/**
+ *  @file   BrickedVolumeObject.h
+ *  @author Naohisa Sakamoto
+ */
+/****************************************************************************/
+#pragma once
+#include <cstdio>
+#include <list>
+#include <string>
+#include <vector>
+#include <kvs/Module>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/AnyValueArray>
+#include <kvs/Mutex>
+#include <kvs/Type>
+#include <kvs/Vector3>
+#include <kvs/Indent>
+
+
+namespace kvs
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Out-of-core structured volume object stored as bricks in a file.
+ *
+ *  The node values of a uniform grid volume are divided into cubic bricks and
+ *  loaded from the brick file on demand. Loaded bricks are kept in a bounded
+ *  LRU cache, so the memory usage is limited by the cache size regardless of
+ *  the volume resolution. Each brick has the ghost nodes (one node on the
+ *  lower side and two nodes on the upper side in each axis), so that the
+ *  trilinear interpolation and the gradient calculation of the cells in the
+ *  brick can be done without accessing the neighbouring bricks. The value
+ *  array of this object, values(), is always empty.
+ */
+/*===========================================================================*/
+class BrickedVolumeObject : public kvs::StructuredVolumeObject
+{
+    kvsModule( kvs::BrickedVolumeObject, Object );
+    kvsModuleBaseClass( kvs::StructuredVolumeObject );
+
+public:
+    static const size_t LowerGhostSize = 1; ///< number of ghost nodes on the lower side
+    static const size_t UpperGhostSize = 2; ///< number of ghost nodes on the upper side
+
+private:
+    struct Entry
+    {
+        kvs::AnyValueArray values{}; ///< brick values (empty if not loaded)
+        std::list<size_t>::iterator position{}; ///< position in the LRU list
+    };
+
+    std::string m_filename = ""; ///< brick filename
+    std::FILE* m_file = nullptr; ///< file pointer
+    kvs::Type::TypeID m_type_id = kvs::Type::UnknownType; ///< value type ID
+    size_t m_brick_size = 0; ///< number of cells in each axis of a brick
+    kvs::Vec3ui m_brick_resolution{ 0, 0, 0 }; ///< number of bricks in each axis
+    size_t m_cache_size = 64; ///< max. number of bricks in the cache
+    mutable kvs::Mutex m_cache_mutex{}; ///< mutex for the cache
+    mutable kvs::Mutex m_file_mutex{}; ///< mutex for the file access
+    mutable std::vector<Entry> m_entries{}; ///< brick entries
+    mutable std::list<size_t> m_lru{}; ///< brick indices in least recently used order
+    mutable size_t m_cache_hits = 0; ///< number of cache hits
+    mutable size_t m_cache_misses = 0; ///< number of cache misses
+
+public:
+    static bool CreateBrickFile(
+        const std::string& filename,
+        const kvs::StructuredVolumeObject* volume,
+        const size_t brick_size = 64 );
+    static bool CreateBrickFile(
+        const std::string& filename,
+        const std::string& raw_filename,
+        const kvs::Vec3ui& resolution,
+        const size_t veclen,
+        const kvs::Type::TypeID type_id,
+        const size_t brick_size = 64 );
+
+public:
+    BrickedVolumeObject() = default;
+    BrickedVolumeObject( const std::string& filename ) { this->open( filename ); }
+    BrickedVolumeObject( const BrickedVolumeObject& ) = delete;
+    BrickedVolumeObject& operator =( const BrickedVolumeObject& ) = delete;
+    virtual ~BrickedVolumeObject() { this->close(); }
+
+    bool open( const std::string& filename );
+    void close();
+    bool isOpen() const { return m_file != nullptr; }
+    void print( std::ostream& os, const kvs::Indent& indent = kvs::Indent(0) ) const;
+
+    void setCacheSize( const size_t nbricks );
+    void clearCache();
+
+    const std::string& filename() const { return m_filename; }
+    kvs::Type::TypeID valueTypeID() const { return m_type_id; }
+    size_t cacheSize() const { return m_cache_size; }
+    size_t brickSize() const { return m_brick_size; }
+    const kvs::Vec3ui& brickResolution() const { return m_brick_resolution; }
+    size_t numberOfBricks() const;
+    size_t numberOfBrickNodesPerLine() const;
+    size_t numberOfBrickNodesPerSlice() const;
+    size_t numberOfBrickNodes() const;
+    size_t numberOfCachedBricks() const;
+    size_t numberOfCacheHits() const;
+    size_t numberOfCacheMisses() const;
+
+    kvs::AnyValueArray brick( const kvs::Vec3ui& brick_index ) const;
+    kvs::AnyValueArray readRegion( const kvs::Vec3ui& min_index, const kvs::Vec3ui& max_index ) const;
+
+    void updateMinMaxValues() const override;
+
+private:
+    kvs::AnyValueArray load_brick( const size_t index ) const;
+};
+
+} // end of namespace kvs
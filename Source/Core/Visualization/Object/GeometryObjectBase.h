@@ -62,17 +62,17 @@ public:
     void setColor( const kvs::RGBColor& color );
 
     GeometryType geometryType() const { return m_geometry_type; }
-    size_t numberOfVertices() const;
-    size_t numberOfColors() const;
-    size_t numberOfNormals() const;
+    virtual size_t numberOfVertices() const;
+    virtual size_t numberOfColors() const;
+    virtual size_t numberOfNormals() const;
 
     const kvs::ValueArray<kvs::Real32>& coords() const { return m_coords; }
     const kvs::ValueArray<kvs::UInt8>& colors() const { return m_colors; }
     const kvs::ValueArray<kvs::Real32>& normals() const { return m_normals; }
 
-    const kvs::Vec3 coord( const size_t index = 0 ) const;
-    const kvs::RGBColor color( const size_t index = 0 ) const;
-    const kvs::Vec3 normal( const size_t index = 0 ) const;
+    virtual const kvs::Vec3 coord( const size_t index = 0 ) const;
+    virtual const kvs::RGBColor color( const size_t index = 0 ) const;
+    virtual const kvs::Vec3 normal( const size_t index = 0 ) const;
 
     void updateMinMaxCoords();
 
@@ -10,6 +10,10 @@
 #include <kvs/LineObject>
 #include <kvs/PolygonObject>
 #include <kvs/Assert>
+#include <kvs/OpenMP>
+#include <cmath>
+#include <vector>
+#include <unordered_map>
 
 
 namespace
@@ -36,6 +40,24 @@ kvs::KVSMLPointObject::WritingDataType GetWritingDataType( const bool ascii, con
     }
 }
 
+/// Max. value of the 16-bit quantized coordinates.
+const float QuantizationLevel = 65535.0f;
+
+/*===========================================================================*/
+/**
+ *  @brief  Folds a point of the lower hemisphere of the octahedron over.
+ *  @param  u [in/out] first component
+ *  @param  v [in/out] second component
+ */
+/*===========================================================================*/
+inline void FoldOctahedron( float& u, float& v )
+{
+    const float fu = ( 1.0f - std::abs( v ) ) * ( u >= 0.0f ? 1.0f : -1.0f );
+    const float fv = ( 1.0f - std::abs( u ) ) * ( v >= 0.0f ? 1.0f : -1.0f );
+    u = fu;
+    v = fv;
+}
+
 }
 
 namespace kvs
@@ -127,6 +149,17 @@ PointObject::PointObject( const kvs::PolygonObject& polygon )
 /*===========================================================================*/
 void PointObject::add( const PointObject& other )
 {
+    if ( other.isCompressed() )
+    {
+        PointObject decompressed;
+        decompressed.shallowCopy( other );
+        decompressed.decompress();
+        this->add( decompressed );
+        return;
+    }
+
+    if ( this->isCompressed() ) { this->decompress(); }
+
     if ( this->coords().size() == 0 )
     {
         // Copy the object.
@@ -382,6 +415,12 @@ void PointObject::shallowCopy( const PointObject& other )
 {
     BaseClass::shallowCopy( other );
     m_sizes = other.sizes();
+    m_quantized_coords = other.quantizedCoords();
+    m_min_quantization_coord = other.minQuantizationCoord();
+    m_max_quantization_coord = other.maxQuantizationCoord();
+    m_packed_normals = other.packedNormals();
+    m_color_indices = other.colorIndices();
+    m_color_palette = other.colorPalette();
 }
 
 /*===========================================================================*/
@@ -394,6 +433,12 @@ void PointObject::deepCopy( const PointObject& other )
 {
     BaseClass::deepCopy( other );
     m_sizes = other.sizes().clone();
+    m_quantized_coords = other.quantizedCoords().clone();
+    m_min_quantization_coord = other.minQuantizationCoord();
+    m_max_quantization_coord = other.maxQuantizationCoord();
+    m_packed_normals = other.packedNormals().clone();
+    m_color_indices = other.colorIndices().clone();
+    m_color_palette = other.colorPalette().clone();
 }
 
 /*===========================================================================*/
@@ -405,6 +450,12 @@ void PointObject::clear()
 {
     BaseClass::clear();
     m_sizes.release();
+    m_quantized_coords.release();
+    m_min_quantization_coord = kvs::Vec3::Zero();
+    m_max_quantization_coord = kvs::Vec3::Zero();
+    m_packed_normals.release();
+    m_color_indices.release();
+    m_color_palette.release();
 }
 
 /*===========================================================================*/
@@ -419,6 +470,14 @@ void PointObject::print( std::ostream& os, const kvs::Indent& indent ) const
     os << indent << "Object type : " << "point object" << std::endl;
     BaseClass::print( os, indent );
     os << indent << "Number of sizes : " << this->numberOfSizes() << std::endl;
+    if ( this->isCompressed() )
+    {
+        os << indent << "Compressed attributes :";
+        if ( this->hasQuantizedCoords() ) { os << " coords (16-bit quantized)"; }
+        if ( this->hasPackedNormals() ) { os << " normals (16-bit octahedral)"; }
+        if ( this->hasColorIndices() ) { os << " colors (" << m_color_palette.size() / 3 << "-color palette)"; }
+        os << std::endl;
+    }
 }
 
 /*===========================================================================*/
@@ -443,6 +502,9 @@ bool PointObject::read( const std::string& filename )
     this->setColors( kvsml.colors() );
     this->setNormals( kvsml.normals() );
     this->setSizes( kvsml.sizes() );
+    this->setPackedNormals( kvsml.packedNormals() );
+    this->setColorIndices( kvsml.colorIndices(), kvsml.colorPalette() );
+    if ( this->hasColorIndices() ) { this->setColors( kvs::ValueArray<kvs::UInt8>() ); }
 
     if ( kvsml.hasExternalCoord() )
     {
@@ -456,6 +518,12 @@ bool PointObject::read( const std::string& filename )
         const kvs::Vec3 min_coord( kvsml.minObjectCoord() );
         const kvs::Vec3 max_coord( kvsml.maxObjectCoord() );
         this->setMinMaxObjectCoords( min_coord, max_coord );
+
+        // The quantized coordinates are stored relative to the object bounds.
+        if ( kvsml.quantizedCoords().size() > 0 )
+        {
+            this->setQuantizedCoords( kvsml.quantizedCoords(), min_coord, max_coord );
+        }
     }
     else
     {
@@ -482,8 +550,17 @@ bool PointObject::write( const std::string& filename, const bool ascii, const bo
     kvsml.setColors( this->colors() );
     kvsml.setNormals( this->normals() );
     kvsml.setSizes( this->sizes() );
+    kvsml.setQuantizedCoords( this->quantizedCoords() );
+    kvsml.setPackedNormals( this->packedNormals() );
+    kvsml.setColorIndices( this->colorIndices(), this->colorPalette() );
 
-    if ( this->hasMinMaxObjectCoords() )
+    // The quantized coordinates are stored relative to the object bounds, so
+    // the quantization bounds are written as the object bounds.
+    if ( this->hasQuantizedCoords() )
+    {
+        kvsml.setMinMaxObjectCoords( this->minQuantizationCoord(), this->maxQuantizationCoord() );
+    }
+    else if ( this->hasMinMaxObjectCoords() )
     {
         kvsml.setMinMaxObjectCoords( this->minObjectCoord(), this->maxObjectCoord() );
     }
@@ -508,6 +585,352 @@ void PointObject::setSize( const kvs::Real32 size )
     m_sizes[0] = size;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Encodes a normal vector in 16 bits by the octahedral mapping.
+ *  @param  normal [in] normal vector
+ *  @return packed normal vector (8-bit u in the lower byte, 8-bit v in the upper)
+ */
+/*===========================================================================*/
+kvs::UInt16 PointObject::PackNormal( const kvs::Vec3& normal )
+{
+    float u = 0.0f;
+    float v = 0.0f;
+    const float length = std::abs( normal.x() ) + std::abs( normal.y() ) + std::abs( normal.z() );
+    if ( length > 0.0f )
+    {
+        u = normal.x() / length;
+        v = normal.y() / length;
+        if ( normal.z() < 0.0f ) { ::FoldOctahedron( u, v ); }
+    }
+
+    const kvs::UInt16 iu = static_cast<kvs::UInt16>( ( u * 0.5f + 0.5f ) * 255.0f + 0.5f );
+    const kvs::UInt16 iv = static_cast<kvs::UInt16>( ( v * 0.5f + 0.5f ) * 255.0f + 0.5f );
+    return static_cast<kvs::UInt16>( iu | ( iv << 8 ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Decodes a normal vector packed by PackNormal.
+ *  @param  packed_normal [in] packed normal vector
+ *  @return unit normal vector
+ */
+/*===========================================================================*/
+kvs::Vec3 PointObject::UnpackNormal( const kvs::UInt16 packed_normal )
+{
+    float u = ( packed_normal & 0xff ) / 255.0f * 2.0f - 1.0f;
+    float v = ( packed_normal >> 8 ) / 255.0f * 2.0f - 1.0f;
+    const float w = 1.0f - std::abs( u ) - std::abs( v );
+    if ( w < 0.0f ) { ::FoldOctahedron( u, v ); }
+    return kvs::Vec3( u, v, w ).normalized();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets the 16-bit quantized coordinates.
+ *  @param  coords [in] quantized coordinate array
+ *  @param  min_coord [in] min coord of the quantization bounds
+ *  @param  max_coord [in] max coord of the quantization bounds
+ */
+/*===========================================================================*/
+void PointObject::setQuantizedCoords(
+    const kvs::ValueArray<kvs::UInt16>& coords,
+    const kvs::Vec3& min_coord,
+    const kvs::Vec3& max_coord )
+{
+    m_quantized_coords = coords;
+    m_min_quantization_coord = min_coord;
+    m_max_quantization_coord = max_coord;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Sets palette-indexed colors.
+ *  @param  indices [in] palette index of each point
+ *  @param  palette [in] color palette (r,g,b) of up to 256 colors
+ */
+/*===========================================================================*/
+void PointObject::setColorIndices(
+    const kvs::ValueArray<kvs::UInt8>& indices,
+    const kvs::ValueArray<kvs::UInt8>& palette )
+{
+    m_color_indices = indices;
+    m_color_palette = palette;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Quantizes the coordinates to 16 bits relative to the object bounds.
+ *
+ *  The bounds (calculated here if not yet set) are kept as the quantization
+ *  bounds, so the object bounds can be changed after the quantization.
+ */
+/*===========================================================================*/
+void PointObject::quantizeCoords()
+{
+    const kvs::ValueArray<kvs::Real32>& coords = BaseClass::coords();
+    if ( coords.size() == 0 ) { return; }
+    if ( !BaseClass::hasMinMaxObjectCoords() ) { BaseClass::updateMinMaxCoords(); }
+
+    const kvs::Vec3 min_coord = BaseClass::minObjectCoord();
+    const kvs::Vec3 width = BaseClass::maxObjectCoord() - min_coord;
+    const kvs::Vec3 scale(
+        width.x() > 0.0f ? ::QuantizationLevel / width.x() : 0.0f,
+        width.y() > 0.0f ? ::QuantizationLevel / width.y() : 0.0f,
+        width.z() > 0.0f ? ::QuantizationLevel / width.z() : 0.0f );
+
+    const size_t nelements = coords.size();
+    kvs::ValueArray<kvs::UInt16> quantized_coords( nelements );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nelements ); i++ )
+    {
+        const size_t j = i % 3;
+        const float q = ( coords[i] - min_coord[j] ) * scale[j] + 0.5f;
+        quantized_coords[i] = static_cast<kvs::UInt16>( kvs::Math::Clamp( q, 0.0f, ::QuantizationLevel ) );
+    }
+
+    m_quantized_coords = quantized_coords;
+    m_min_quantization_coord = min_coord;
+    m_max_quantization_coord = BaseClass::maxObjectCoord();
+    BaseClass::setCoords( kvs::ValueArray<kvs::Real32>() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Packs the normal vectors in 16 bits each.
+ */
+/*===========================================================================*/
+void PointObject::packNormals()
+{
+    const kvs::ValueArray<kvs::Real32>& normals = BaseClass::normals();
+    if ( normals.size() == 0 ) { return; }
+
+    const size_t nnormals = normals.size() / 3;
+    kvs::ValueArray<kvs::UInt16> packed_normals( nnormals );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nnormals ); i++ )
+    {
+        packed_normals[i] = PackNormal( kvs::Vec3( normals.data() + 3 * i ) );
+    }
+
+    m_packed_normals = packed_normals;
+    BaseClass::setNormals( kvs::ValueArray<kvs::Real32>() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Replaces the per-point colors with palette indices.
+ *  @return false if the colors cannot be indexed (more than 256 colors)
+ */
+/*===========================================================================*/
+bool PointObject::indexColors()
+{
+    const kvs::ValueArray<kvs::UInt8>& colors = BaseClass::colors();
+    const size_t ncolors = colors.size() / 3;
+    if ( ncolors <= 1 ) { return false; }
+
+    std::unordered_map<kvs::UInt32,kvs::UInt8> palette_indices;
+    std::vector<kvs::UInt8> palette;
+    kvs::ValueArray<kvs::UInt8> indices( ncolors );
+    for ( size_t i = 0; i < ncolors; i++ )
+    {
+        const kvs::UInt8* c = colors.data() + 3 * i;
+        const kvs::UInt32 key = kvs::UInt32( c[0] ) | kvs::UInt32( c[1] ) << 8 | kvs::UInt32( c[2] ) << 16;
+        auto found = palette_indices.find( key );
+        if ( found == palette_indices.end() )
+        {
+            if ( palette_indices.size() == 256 ) { return false; }
+            const kvs::UInt8 index = static_cast<kvs::UInt8>( palette_indices.size() );
+            found = palette_indices.emplace( key, index ).first;
+            palette.insert( palette.end(), c, c + 3 );
+        }
+        indices[i] = found->second;
+    }
+
+    m_color_indices = indices;
+    m_color_palette = kvs::ValueArray<kvs::UInt8>( palette );
+    BaseClass::setColors( kvs::ValueArray<kvs::UInt8>() );
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Restores the full-precision arrays of the compressed attributes.
+ */
+/*===========================================================================*/
+void PointObject::decompress()
+{
+    if ( this->hasQuantizedCoords() )
+    {
+        BaseClass::setCoords( this->decompressedCoords() );
+        m_quantized_coords.release();
+    }
+
+    if ( this->hasPackedNormals() )
+    {
+        BaseClass::setNormals( this->decompressedNormals() );
+        m_packed_normals.release();
+    }
+
+    if ( this->hasColorIndices() )
+    {
+        BaseClass::setColors( this->decompressedColors() );
+        m_color_indices.release();
+        m_color_palette.release();
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the full-precision coordinate array.
+ *  @return coordinate array (shared with the object if not quantized)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> PointObject::decompressedCoords() const
+{
+    if ( !this->hasQuantizedCoords() ) { return BaseClass::coords(); }
+
+    const kvs::Vec3 min_coord = m_min_quantization_coord;
+    const kvs::Vec3 step = ( m_max_quantization_coord - min_coord ) / ::QuantizationLevel;
+    const size_t nelements = m_quantized_coords.size();
+    kvs::ValueArray<kvs::Real32> coords( nelements );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nelements ); i++ )
+    {
+        const size_t j = i % 3;
+        coords[i] = min_coord[j] + m_quantized_coords[i] * step[j];
+    }
+
+    return coords;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the full color array.
+ *  @return color array (shared with the object if not indexed)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::UInt8> PointObject::decompressedColors() const
+{
+    if ( !this->hasColorIndices() ) { return BaseClass::colors(); }
+
+    const size_t ncolors = m_color_indices.size();
+    kvs::ValueArray<kvs::UInt8> colors( 3 * ncolors );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( ncolors ); i++ )
+    {
+        const kvs::UInt8* c = m_color_palette.data() + 3 * m_color_indices[i];
+        colors[ 3 * i + 0 ] = c[0];
+        colors[ 3 * i + 1 ] = c[1];
+        colors[ 3 * i + 2 ] = c[2];
+    }
+
+    return colors;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the full-precision normal vector array.
+ *  @return normal vector array (shared with the object if not packed)
+ */
+/*===========================================================================*/
+kvs::ValueArray<kvs::Real32> PointObject::decompressedNormals() const
+{
+    if ( !this->hasPackedNormals() ) { return BaseClass::normals(); }
+
+    const size_t nnormals = m_packed_normals.size();
+    kvs::ValueArray<kvs::Real32> normals( 3 * nnormals );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nnormals ); i++ )
+    {
+        const kvs::Vec3 n = UnpackNormal( m_packed_normals[i] );
+        normals[ 3 * i + 0 ] = n.x();
+        normals[ 3 * i + 1 ] = n.y();
+        normals[ 3 * i + 2 ] = n.z();
+    }
+
+    return normals;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the vertices.
+ *  @return number of vertices
+ */
+/*===========================================================================*/
+size_t PointObject::numberOfVertices() const
+{
+    return this->hasQuantizedCoords() ? m_quantized_coords.size() / 3 : BaseClass::numberOfVertices();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the colors.
+ *  @return number of colors
+ */
+/*===========================================================================*/
+size_t PointObject::numberOfColors() const
+{
+    return this->hasColorIndices() ? m_color_indices.size() : BaseClass::numberOfColors();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of the normal vectors.
+ *  @return number of normal vectors
+ */
+/*===========================================================================*/
+size_t PointObject::numberOfNormals() const
+{
+    return this->hasPackedNormals() ? m_packed_normals.size() : BaseClass::numberOfNormals();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the coordinate value.
+ *  @param  index [in] index of the vertex
+ *  @return coordinate value
+ */
+/*===========================================================================*/
+const kvs::Vec3 PointObject::coord( const size_t index ) const
+{
+    if ( !this->hasQuantizedCoords() ) { return BaseClass::coord( index ); }
+
+    const kvs::Vec3 min_coord = m_min_quantization_coord;
+    const kvs::Vec3 step = ( m_max_quantization_coord - min_coord ) / ::QuantizationLevel;
+    const kvs::UInt16* q = m_quantized_coords.data() + 3 * index;
+    return kvs::Vec3(
+        min_coord.x() + q[0] * step.x(),
+        min_coord.y() + q[1] * step.y(),
+        min_coord.z() + q[2] * step.z() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the color value.
+ *  @param  index [in] index of the vertex
+ *  @return color value
+ */
+/*===========================================================================*/
+const kvs::RGBColor PointObject::color( const size_t index ) const
+{
+    if ( !this->hasColorIndices() ) { return BaseClass::color( index ); }
+    return kvs::RGBColor( m_color_palette.data() + 3 * m_color_indices[index] );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the normal vector.
+ *  @param  index [in] index of the vertex
+ *  @return normal vector
+ */
+/*===========================================================================*/
+const kvs::Vec3 PointObject::normal( const size_t index ) const
+{
+    if ( !this->hasPackedNormals() ) { return BaseClass::normal( index ); }
+    return UnpackNormal( m_packed_normals[index] );
+}
+
 /*===========================================================================*/
 /**
  *  @brief  '<<' operator
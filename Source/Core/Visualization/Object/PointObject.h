@@ -34,6 +34,16 @@ class PointObject : public kvs::GeometryObjectBase
 
 private:
     kvs::ValueArray<kvs::Real32> m_sizes{}; ///< size array
+    kvs::ValueArray<kvs::UInt16> m_quantized_coords{}; ///< 16-bit coords relative to the quantization bounds
+    kvs::Vec3 m_min_quantization_coord{ 0.0f, 0.0f, 0.0f }; ///< min coord of the quantization bounds
+    kvs::Vec3 m_max_quantization_coord{ 0.0f, 0.0f, 0.0f }; ///< max coord of the quantization bounds
+    kvs::ValueArray<kvs::UInt16> m_packed_normals{}; ///< 16-bit octahedral normals
+    kvs::ValueArray<kvs::UInt8> m_color_indices{}; ///< color palette indices
+    kvs::ValueArray<kvs::UInt8> m_color_palette{}; ///< color palette (r,g,b) of up to 256 colors
+
+public:
+    static kvs::UInt16 PackNormal( const kvs::Vec3& normal );
+    static kvs::Vec3 UnpackNormal( const kvs::UInt16 packed_normal );
 
 public:
     PointObject();
@@ -57,6 +67,40 @@ public:
     kvs::Real32 size( const size_t index = 0 ) const { return m_sizes[index]; }
     const kvs::ValueArray<kvs::Real32>& sizes() const { return m_sizes; }
 
+    // Compact attribute encodings. An encoded attribute takes the place of the
+    // full-precision array, which is released when the attribute is encoded.
+    void setQuantizedCoords( const kvs::ValueArray<kvs::UInt16>& coords, const kvs::Vec3& min_coord, const kvs::Vec3& max_coord );
+    void setPackedNormals( const kvs::ValueArray<kvs::UInt16>& normals ) { m_packed_normals = normals; }
+    void setColorIndices( const kvs::ValueArray<kvs::UInt8>& indices, const kvs::ValueArray<kvs::UInt8>& palette );
+
+    bool hasQuantizedCoords() const { return m_quantized_coords.size() > 0; }
+    bool hasPackedNormals() const { return m_packed_normals.size() > 0; }
+    bool hasColorIndices() const { return m_color_indices.size() > 0; }
+    bool isCompressed() const { return this->hasQuantizedCoords() || this->hasPackedNormals() || this->hasColorIndices(); }
+
+    const kvs::ValueArray<kvs::UInt16>& quantizedCoords() const { return m_quantized_coords; }
+    const kvs::Vec3& minQuantizationCoord() const { return m_min_quantization_coord; }
+    const kvs::Vec3& maxQuantizationCoord() const { return m_max_quantization_coord; }
+    const kvs::ValueArray<kvs::UInt16>& packedNormals() const { return m_packed_normals; }
+    const kvs::ValueArray<kvs::UInt8>& colorIndices() const { return m_color_indices; }
+    const kvs::ValueArray<kvs::UInt8>& colorPalette() const { return m_color_palette; }
+
+    void quantizeCoords();
+    void packNormals();
+    bool indexColors();
+    void decompress();
+
+    kvs::ValueArray<kvs::Real32> decompressedCoords() const;
+    kvs::ValueArray<kvs::UInt8> decompressedColors() const;
+    kvs::ValueArray<kvs::Real32> decompressedNormals() const;
+
+    size_t numberOfVertices() const;
+    size_t numberOfColors() const;
+    size_t numberOfNormals() const;
+    const kvs::Vec3 coord( const size_t index = 0 ) const;
+    const kvs::RGBColor color( const size_t index = 0 ) const;
+    const kvs::Vec3 normal( const size_t index = 0 ) const;
+
 public:
     KVS_DEPRECATED( PointObject(
                         const kvs::ValueArray<kvs::Real32>& coords,
@@ -7,6 +7,9 @@
 #include "StructuredVolumeObject.h"
 #include <kvs/KVSMLStructuredVolumeObject>
 #include <kvs/Range>
+#include <kvs/OpenMP>
+#include <cmath>
+#include <type_traits>
 
 
 namespace
@@ -42,6 +45,30 @@ const std::string GetGridTypeName( const kvs::StructuredVolumeObject::GridType t
     }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Converts to the level reduction method from the given string.
+ *  @param  reduction [in] reduction method string
+ *  @return level reduction method
+ */
+/*===========================================================================*/
+kvs::StructuredVolumeObject::LevelReduction GetLevelReduction( const std::string& reduction )
+{
+    if (      reduction == "max" ) { return kvs::StructuredVolumeObject::MaxReduction; }
+    else if ( reduction == "min" ) { return kvs::StructuredVolumeObject::MinReduction; }
+    else { return kvs::StructuredVolumeObject::BoxReduction; }
+}
+
+const std::string GetLevelReductionName( const kvs::StructuredVolumeObject::LevelReduction reduction )
+{
+    switch( reduction )
+    {
+    case kvs::StructuredVolumeObject::MaxReduction: return "max";
+    case kvs::StructuredVolumeObject::MinReduction: return "min";
+    default: return "box";
+    }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns a writing data type.
@@ -63,50 +90,200 @@ kvs::KVSMLStructuredVolumeObject::WritingDataType GetWritingDataType( const bool
     }
 }
 
-template<typename T>
-kvs::Range GetMinMaxValues( const kvs::VolumeObjectBase* volume )
+/*===========================================================================*/
+/**
+ *  @brief  Returns the node resolution of the next coarser level.
+ *  @param  resolution [in] node resolution of the finer level
+ *  @return node resolution of the coarser level
+ */
+/*===========================================================================*/
+kvs::Vec3ui CoarseResolution( const kvs::Vec3ui& resolution )
 {
-    KVS_ASSERT( volume->values().size() != 0 );
-    KVS_ASSERT( volume->values().size() == volume->veclen() * volume->numberOfNodes() );
+    kvs::Vec3ui coarse( resolution );
+    for ( int i = 0; i < 3; ++i )
+    {
+        // The number of cells is halved (rounded up) in each axis.
+        if ( resolution[i] > 2 ) { coarse[i] = resolution[i] / 2 + 1; }
+    }
+    return coarse;
+}
 
-    const T* value = reinterpret_cast<const T*>( volume->values().data() );
-    const T* const end = value + volume->numberOfNodes() * volume->veclen();
+/*===========================================================================*/
+/**
+ *  @brief  Calculates the range of the fine nodes covered by each coarse node.
+ *  @param  nfine [in] number of fine nodes
+ *  @param  ncoarse [in] number of coarse nodes
+ *  @param  begin [out] first fine node for each coarse node
+ *  @param  end [out] last fine node for each coarse node
+ */
+/*===========================================================================*/
+void FootprintRange(
+    const size_t nfine,
+    const size_t ncoarse,
+    std::vector<size_t>* begin,
+    std::vector<size_t>* end )
+{
+    begin->resize( ncoarse );
+    end->resize( ncoarse );
 
-    if ( volume->veclen() == 1 )
+    const double ratio = ncoarse > 1 ? double( nfine - 1 ) / double( ncoarse - 1 ) : 1.0;
+    const double half = ratio * 0.5;
+    for ( size_t i = 0; i < ncoarse; ++i )
     {
-        T min_value = *value;
-        T max_value = *value;
+        const double center = i * ratio;
+        const double lower = std::ceil( center - half - 1.0e-6 );
+        const double upper = std::floor( center + half + 1.0e-6 );
+        (*begin)[i] = static_cast<size_t>( kvs::Math::Max( lower, 0.0 ) );
+        (*end)[i] = static_cast<size_t>( kvs::Math::Min( upper, double( nfine - 1 ) ) );
+    }
+}
 
-        while ( value < end )
-        {
-            min_value = kvs::Math::Min( *value, min_value );
-            max_value = kvs::Math::Max( *value, max_value );
-            ++value;
-        }
+/*===========================================================================*/
+/**
+ *  @brief  Reducer calculating the average of the values (box filter).
+ */
+/*===========================================================================*/
+template <typename T>
+class BoxReducer
+{
+    kvs::Real64 m_sum = 0.0; ///< sum of the values
+    size_t m_counter = 0; ///< number of the values
 
-        return kvs::Range( static_cast<double>( min_value ), static_cast<double>( max_value ) );
+public:
+    BoxReducer( const T ) {}
+    void add( const T value ) { m_sum += static_cast<kvs::Real64>( value ); m_counter++; }
+    T value() const
+    {
+        const kvs::Real64 average = m_sum / m_counter;
+        return static_cast<T>( std::is_integral<T>::value ? std::floor( average + 0.5 ) : average );
     }
-    else
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Reducer calculating the maximum of the values.
+ */
+/*===========================================================================*/
+template <typename T>
+class MaxReducer
+{
+    T m_max; ///< maximum value
+
+public:
+    MaxReducer( const T first ): m_max( first ) {}
+    void add( const T value ) { m_max = kvs::Math::Max( m_max, value ); }
+    T value() const { return m_max; }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Reducer calculating the minimum of the values.
+ */
+/*===========================================================================*/
+template <typename T>
+class MinReducer
+{
+    T m_min; ///< minimum value
+
+public:
+    MinReducer( const T first ): m_min( first ) {}
+    void add( const T value ) { m_min = kvs::Math::Min( m_min, value ); }
+    T value() const { return m_min; }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Reduces the node values to the coarser level with the reducer.
+ *  @param  resolution [in] node resolution of the finer level
+ *  @param  coarse_resolution [in] node resolution of the coarser level
+ *  @param  veclen [in] vector length
+ *  @param  values [in] node values of the finer level
+ *  @return node values of the coarser level
+ */
+/*===========================================================================*/
+template <typename T, typename Reducer>
+kvs::AnyValueArray ReduceLevel(
+    const kvs::Vec3ui& resolution,
+    const kvs::Vec3ui& coarse_resolution,
+    const size_t veclen,
+    const kvs::AnyValueArray& values )
+{
+    std::vector<size_t> begin[3];
+    std::vector<size_t> end[3];
+    for ( int i = 0; i < 3; ++i )
     {
-        kvs::Real64 min_value = kvs::Value<kvs::Real64>::Max();
-        kvs::Real64 max_value = kvs::Value<kvs::Real64>::Min();
+        FootprintRange( resolution[i], coarse_resolution[i], &begin[i], &end[i] );
+    }
+
+    const size_t nx = coarse_resolution.x();
+    const size_t ny = coarse_resolution.y();
+    const size_t nz = coarse_resolution.z();
+    const size_t line_size = resolution.x();
+    const size_t slice_size = resolution.x() * resolution.y();
 
-        const size_t veclen = volume->veclen();
+    const T* src = static_cast<const T*>( values.data() );
+    kvs::ValueArray<T> coarse_values( nx * ny * nz * veclen );
+    T* dst = coarse_values.data();
 
-        while ( value < end )
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( long k = 0; k < long( nz ); ++k )
+    {
+        for ( size_t j = 0; j < ny; ++j )
         {
-            kvs::Real64 magnitude = 0.0;
-            for ( size_t i = 0; i < veclen; ++i )
+            for ( size_t i = 0; i < nx; ++i )
             {
-                magnitude += static_cast<kvs::Real64>( ( *value ) * ( *value ) );
-                ++value;
+                T* value = dst + ( ( k * ny + j ) * nx + i ) * veclen;
+                for ( size_t c = 0; c < veclen; ++c )
+                {
+                    Reducer reducer( src[ ( begin[2][k] * slice_size + begin[1][j] * line_size + begin[0][i] ) * veclen + c ] );
+                    for ( size_t z = begin[2][k]; z <= end[2][k]; ++z )
+                    {
+                        for ( size_t y = begin[1][j]; y <= end[1][j]; ++y )
+                        {
+                            const T* v = src + ( z * slice_size + y * line_size ) * veclen + c;
+                            for ( size_t x = begin[0][i]; x <= end[0][i]; ++x )
+                            {
+                                reducer.add( v[ x * veclen ] );
+                            }
+                        }
+                    }
+                    value[c] = reducer.value();
+                }
             }
-
-            min_value = kvs::Math::Min( magnitude, min_value );
-            max_value = kvs::Math::Max( magnitude, max_value );
         }
+    }
+
+    return kvs::AnyValueArray( coarse_values );
+}
 
-        return kvs::Range( std::sqrt( min_value ), std::sqrt( max_value ) );
+/*===========================================================================*/
+/**
+ *  @brief  Reduces the node values to the coarser level.
+ *  @param  resolution [in] node resolution of the finer level
+ *  @param  coarse_resolution [in] node resolution of the coarser level
+ *  @param  veclen [in] vector length
+ *  @param  values [in] node values of the finer level
+ *  @param  reduction [in] reduction method
+ *  @return node values of the coarser level
+ */
+/*===========================================================================*/
+template <typename T>
+kvs::AnyValueArray ReduceLevel(
+    const kvs::Vec3ui& resolution,
+    const kvs::Vec3ui& coarse_resolution,
+    const size_t veclen,
+    const kvs::AnyValueArray& values,
+    const kvs::StructuredVolumeObject::LevelReduction reduction )
+{
+    // The reduction is selected once, out of the loops over the nodes.
+    switch ( reduction )
+    {
+    case kvs::StructuredVolumeObject::MaxReduction:
+        return ::ReduceLevel<T, ::MaxReducer<T>>( resolution, coarse_resolution, veclen, values );
+    case kvs::StructuredVolumeObject::MinReduction:
+        return ::ReduceLevel<T, ::MinReducer<T>>( resolution, coarse_resolution, veclen, values );
+    default:
+        return ::ReduceLevel<T, ::BoxReducer<T>>( resolution, coarse_resolution, veclen, values );
     }
 }
 
@@ -127,6 +304,9 @@ void StructuredVolumeObject::shallowCopy( const StructuredVolumeObject& object )
     BaseClass::shallowCopy( object );
     m_grid_type = object.gridType();
     m_resolution = object.resolution();
+    m_level_reduction = object.m_level_reduction;
+    m_level_resolutions = object.m_level_resolutions;
+    m_level_values = object.m_level_values;
 }
 
 /*===========================================================================*/
@@ -140,6 +320,10 @@ void StructuredVolumeObject::deepCopy( const StructuredVolumeObject& object )
     BaseClass::deepCopy( object );
     m_grid_type = object.gridType();
     m_resolution = object.resolution();
+    m_level_reduction = object.m_level_reduction;
+    m_level_resolutions = object.m_level_resolutions;
+    m_level_values.clear();
+    for ( const auto& values : object.m_level_values ) { m_level_values.push_back( values.clone() ); }
 }
 
 /*===========================================================================*/
@@ -159,6 +343,10 @@ void StructuredVolumeObject::print( std::ostream& os, const kvs::Indent& indent
     os << indent << "Number of nodes : " << this->numberOfNodes() << std::endl;
     os << indent << "Min. value : " << this->minValue() << std::endl;
     os << indent << "Max. value : " << this->maxValue() << std::endl;
+    if ( this->numberOfLevels() > 1 )
+    {
+        os << indent << "Number of levels : " << this->numberOfLevels() << std::endl;
+    }
 }
 
 /*===========================================================================*/
@@ -211,6 +399,13 @@ bool StructuredVolumeObject::read( const std::string& filename )
     if ( kvsml.hasLabel() ) { this->setLabel( kvsml.label() ); }
     if ( kvsml.hasUnit() ) { this->setUnit( kvsml.unit() ); }
 
+    this->clearLevels();
+    this->setLevelReduction( ::GetLevelReduction( kvsml.levelReduction() ) );
+    for ( size_t i = 0; i < kvsml.levelValues().size(); ++i )
+    {
+        this->addLevel( kvsml.levelResolutions()[i], kvsml.levelValues()[i] );
+    }
+
     if ( kvsml.hasMinValue() && kvsml.hasMaxValue() )
     {
         const double min_value = kvsml.minValue();
@@ -280,6 +475,15 @@ bool StructuredVolumeObject::write( const std::string& filename, const bool asci
     kvsml.setResolution( this->resolution() );
     kvsml.setValues( this->values() );
 
+    if ( this->numberOfLevels() > 1 )
+    {
+        kvsml.setLevelReduction( ::GetLevelReductionName( this->levelReduction() ) );
+        for ( size_t level = 1; level < this->numberOfLevels(); ++level )
+        {
+            kvsml.addLevel( this->levelResolution( level ), this->levelValues( level ) );
+        }
+    }
+
     if ( this->hasMinMaxValues() )
     {
         kvsml.setMinValue( this->minValue() );
@@ -423,30 +627,175 @@ void StructuredVolumeObject::updateMinMaxCoords()
     }
 }
 
-/*==========================================================================*/
+/*===========================================================================*/
 /**
- *  @brief  Updates the min/max node value.
+ *  @brief  Generates the coarse levels (multi-resolution pyramid) of the volume.
+ *  @param  reduction [in] reduction method
+ *  @param  max_nlevels [in] max. number of levels including the finest level (0: unlimited)
+ *
+ *  Each level halves the number of cells of the previous level in each axis
+ *  until the resolution cannot be reduced anymore. The coarse levels cover the
+ *  same region as the finest level. Only the uniform grid is supported.
  */
-/*==========================================================================*/
-void StructuredVolumeObject::updateMinMaxValues() const
+/*===========================================================================*/
+void StructuredVolumeObject::updateLevels( const LevelReduction reduction, const size_t max_nlevels )
 {
-    kvs::Range range;
-    switch ( this->values().typeID() )
+    this->clearLevels();
+    m_level_reduction = reduction;
+
+    if ( m_grid_type != Uniform )
     {
-    case kvs::Type::TypeInt8:   { range = ::GetMinMaxValues<kvs::Int8  >( this ); break; }
-    case kvs::Type::TypeInt16:  { range = ::GetMinMaxValues<kvs::Int16 >( this ); break; }
-    case kvs::Type::TypeInt32:  { range = ::GetMinMaxValues<kvs::Int32 >( this ); break; }
-    case kvs::Type::TypeInt64:  { range = ::GetMinMaxValues<kvs::Int64 >( this ); break; }
-    case kvs::Type::TypeUInt8:  { range = ::GetMinMaxValues<kvs::UInt8 >( this ); break; }
-    case kvs::Type::TypeUInt16: { range = ::GetMinMaxValues<kvs::UInt16>( this ); break; }
-    case kvs::Type::TypeUInt32: { range = ::GetMinMaxValues<kvs::UInt32>( this ); break; }
-    case kvs::Type::TypeUInt64: { range = ::GetMinMaxValues<kvs::UInt64>( this ); break; }
-    case kvs::Type::TypeReal32: { range = ::GetMinMaxValues<kvs::Real32>( this ); break; }
-    case kvs::Type::TypeReal64: { range = ::GetMinMaxValues<kvs::Real64>( this ); break; }
-    default: break;
+        kvsMessageError( "Multi-resolution levels are supported for the uniform grid only." );
+        return;
+    }
+
+    if ( this->values().size() != this->numberOfNodes() * this->veclen() )
+    {
+        kvsMessageError( "The number of values is not equal to the number of nodes." );
+        return;
+    }
+
+    kvs::Vec3ui resolution = m_resolution;
+    Values values = this->values();
+    while ( max_nlevels == 0 || this->numberOfLevels() < max_nlevels )
+    {
+        const kvs::Vec3ui coarse_resolution = ::CoarseResolution( resolution );
+        if ( coarse_resolution == resolution ) { break; }
+
+        const size_t veclen = this->veclen();
+        Values coarse_values;
+        switch ( values.typeID() )
+        {
+        case kvs::Type::TypeInt8:   { coarse_values = ::ReduceLevel<kvs::Int8  >( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeInt16:  { coarse_values = ::ReduceLevel<kvs::Int16 >( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeInt32:  { coarse_values = ::ReduceLevel<kvs::Int32 >( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeInt64:  { coarse_values = ::ReduceLevel<kvs::Int64 >( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeUInt8:  { coarse_values = ::ReduceLevel<kvs::UInt8 >( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeUInt16: { coarse_values = ::ReduceLevel<kvs::UInt16>( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeUInt32: { coarse_values = ::ReduceLevel<kvs::UInt32>( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeUInt64: { coarse_values = ::ReduceLevel<kvs::UInt64>( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeReal32: { coarse_values = ::ReduceLevel<kvs::Real32>( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        case kvs::Type::TypeReal64: { coarse_values = ::ReduceLevel<kvs::Real64>( resolution, coarse_resolution, veclen, values, reduction ); break; }
+        default:
+        {
+            kvsMessageError( "Unsupported value type." );
+            return;
+        }
+        }
+
+        this->addLevel( coarse_resolution, coarse_values );
+        resolution = coarse_resolution;
+        values = coarse_values;
     }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Adds a coarse level.
+ *  @param  resolution [in] node resolution of the level
+ *  @param  values [in] node values of the level
+ */
+/*===========================================================================*/
+void StructuredVolumeObject::addLevel( const kvs::Vec3ui& resolution, const Values& values )
+{
+    m_level_resolutions.push_back( resolution );
+    m_level_values.push_back( values );
+}
 
-    this->setMinMaxValues( range.lower(), range.upper() );
+/*===========================================================================*/
+/**
+ *  @brief  Removes all of the coarse levels.
+ */
+/*===========================================================================*/
+void StructuredVolumeObject::clearLevels()
+{
+    m_level_resolutions.clear();
+    m_level_values.clear();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the node resolution of the specified level.
+ *  @param  level [in] level (0: finest level)
+ *  @return node resolution
+ */
+/*===========================================================================*/
+const kvs::Vec3ui& StructuredVolumeObject::levelResolution( const size_t level ) const
+{
+    KVS_ASSERT( level < this->numberOfLevels() );
+    return level == 0 ? m_resolution : m_level_resolutions[ level - 1 ];
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the node values of the specified level.
+ *  @param  level [in] level (0: finest level)
+ *  @return node values
+ */
+/*===========================================================================*/
+const StructuredVolumeObject::Values& StructuredVolumeObject::levelValues( const size_t level ) const
+{
+    KVS_ASSERT( level < this->numberOfLevels() );
+    return level == 0 ? this->values() : m_level_values[ level - 1 ];
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the finest level whose number of nodes is within the budget.
+ *  @param  max_nnodes [in] max. number of nodes
+ *  @return level (the coarsest level if no level is within the budget)
+ */
+/*===========================================================================*/
+size_t StructuredVolumeObject::levelForBudget( const size_t max_nnodes ) const
+{
+    for ( size_t level = 0; level < this->numberOfLevels(); ++level )
+    {
+        const kvs::Vec3ui& r = this->levelResolution( level );
+        if ( size_t( r.x() ) * r.y() * r.z() <= max_nnodes ) { return level; }
+    }
+    return this->numberOfLevels() - 1;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the coarsest level whose cell size does not exceed the footprint.
+ *  @param  footprint [in] footprint size in cells of the finest level (e.g. per pixel)
+ *  @return level
+ */
+/*===========================================================================*/
+size_t StructuredVolumeObject::levelForFootprint( const float footprint ) const
+{
+    size_t selected = 0;
+    for ( size_t level = 1; level < this->numberOfLevels(); ++level )
+    {
+        const kvs::Vec3ui& r = this->levelResolution( level );
+        float ratio = 0.0f;
+        for ( int i = 0; i < 3; ++i )
+        {
+            if ( r[i] > 1 ) { ratio = kvs::Math::Max( ratio, float( m_resolution[i] - 1 ) / ( r[i] - 1 ) ); }
+        }
+        if ( ratio > footprint ) { break; }
+        selected = level;
+    }
+    return selected;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Shallow copies the specified level as a single-level volume object.
+ *  @param  level [in] level (0: finest level)
+ *  @param  object [out] pointer to the volume object
+ *
+ *  The level volume shares the node values and has the same min/max object
+ *  and external coordinates as this volume.
+ */
+/*===========================================================================*/
+void StructuredVolumeObject::shallowCopyLevel( const size_t level, StructuredVolumeObject* object ) const
+{
+    object->shallowCopy( *this );
+    object->setResolution( this->levelResolution( level ) );
+    object->setValues( this->levelValues( level ) );
+    object->clearLevels();
 }
 
 std::ostream& operator << ( std::ostream& os, const StructuredVolumeObject& object )
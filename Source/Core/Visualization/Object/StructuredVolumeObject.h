@@ -6,6 +6,7 @@
 /****************************************************************************/
 #pragma once
 #include <ostream>
+#include <vector>
 #include <kvs/Module>
 #include <kvs/VolumeObjectBase>
 #include <kvs/Indent>
@@ -34,9 +35,19 @@ public:
         Curvilinear,         ///< Curvilinear grid.
     };
 
+    enum LevelReduction
+    {
+        BoxReduction = 0, ///< average of the fine nodes covered by the coarse node
+        MaxReduction,     ///< maximum of the fine nodes covered by the coarse node
+        MinReduction      ///< minimum of the fine nodes covered by the coarse node
+    };
+
 private:
     GridType m_grid_type = UnknownGridType; ///< grid type
     kvs::Vec3ui m_resolution{ 0, 0, 0 }; ///< Node resolution.
+    LevelReduction m_level_reduction = BoxReduction; ///< reduction method of the levels
+    std::vector<kvs::Vec3ui> m_level_resolutions{}; ///< node resolutions of the coarse levels
+    std::vector<Values> m_level_values{}; ///< node values of the coarse levels
 
 public:
     StructuredVolumeObject(): BaseClass( Structured ) {}
@@ -62,7 +73,19 @@ public:
     size_t numberOfCells() const;
 
     void updateMinMaxCoords();
-    void updateMinMaxValues() const;
+
+    void updateLevels( const LevelReduction reduction = BoxReduction, const size_t max_nlevels = 0 );
+    void addLevel( const kvs::Vec3ui& resolution, const Values& values );
+    void clearLevels();
+    void setLevelReduction( const LevelReduction reduction ) { m_level_reduction = reduction; }
+
+    LevelReduction levelReduction() const { return m_level_reduction; }
+    size_t numberOfLevels() const { return m_level_values.size() + 1; }
+    const kvs::Vec3ui& levelResolution( const size_t level ) const;
+    const Values& levelValues( const size_t level ) const;
+    size_t levelForBudget( const size_t max_nnodes ) const;
+    size_t levelForFootprint( const float footprint ) const;
+    void shallowCopyLevel( const size_t level, StructuredVolumeObject* object ) const;
 
 public:
     KVS_DEPRECATED( StructuredVolumeObject(
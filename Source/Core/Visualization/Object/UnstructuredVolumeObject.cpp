@@ -7,6 +7,7 @@
 #include "UnstructuredVolumeObject.h"
 #include <kvs/KVSMLUnstructuredVolumeObject>
 #include <kvs/Range>
+#include <vector>
 
 
 namespace
@@ -83,32 +84,40 @@ kvs::Range GetMinMaxValues( const kvs::UnstructuredVolumeObject* volume )
 {
     KVS_ASSERT( volume->values().size() != 0 );
 
+    // Only the nodes referred by the cells are taken into account.
     const auto* values = reinterpret_cast<const T*>( volume->values().data() );
     const auto veclen = volume->veclen();
-    if ( volume->connections().empty() )
+    const auto* connections = volume->connections().data();
+    const auto ncells = volume->numberOfCells();
+    const auto cell_nnodes = volume->numberOfCellNodes();
+    if ( veclen == 1 )
     {
-        const auto nnodes = volume->numberOfNodes();
-        if ( veclen == 1 )
+        T min_value = *values;
+        T max_value = *values;
+        for ( size_t i = 0; i < ncells; ++i )
         {
-            T min_value = *values;
-            T max_value = *values;
-            for ( size_t i = 0; i < nnodes; ++i )
+            for ( size_t j = 0; j < cell_nnodes; ++j )
             {
-                const T value = *values++;
+                const auto index = *connections++;
+                const T value = values[ index ];
                 min_value = kvs::Math::Min( value, min_value );
                 max_value = kvs::Math::Max( value, max_value );
             }
-            return kvs::Range( static_cast<double>( min_value ), static_cast<double>( max_value ) );
         }
-        else
+        return kvs::Range( static_cast<double>( min_value ), static_cast<double>( max_value ) );
+    }
+    else
+    {
+        kvs::Real64 min_value = kvs::Value<kvs::Real64>::Max();
+        kvs::Real64 max_value = kvs::Value<kvs::Real64>::Min();
+        for ( size_t i = 0; i < ncells; ++i )
         {
-            kvs::Real64 min_value = kvs::Value<kvs::Real64>::Max();
-            kvs::Real64 max_value = kvs::Value<kvs::Real64>::Min();
-            for ( size_t i = 0; i < nnodes; ++i )
+            for ( size_t j = 0; j < cell_nnodes; ++j )
             {
-                const T* value = values + veclen * i;
+                const auto index = *connections++;
+                const T* value = values + veclen * index;
                 kvs::Real64 magnitude = 0.0;
-                for ( size_t j = 0; j < veclen; ++j )
+                for ( size_t k = 0; k < veclen; ++k )
                 {
                     magnitude += static_cast<kvs::Real64>( ( *value ) * ( *value ) );
                     ++value;
@@ -116,53 +125,8 @@ kvs::Range GetMinMaxValues( const kvs::UnstructuredVolumeObject* volume )
                 min_value = kvs::Math::Min( magnitude, min_value );
                 max_value = kvs::Math::Max( magnitude, max_value );
             }
-            return kvs::Range( std::sqrt( min_value ), std::sqrt( max_value ) );
-
-        }
-    }
-    else
-    {
-        const auto* connections = volume->connections().data();
-        const auto ncells = volume->numberOfCells();
-        const auto cell_nnodes = volume->numberOfCellNodes();
-        if ( veclen == 1 )
-        {
-            T min_value = *values;
-            T max_value = *values;
-            for ( size_t i = 0; i < ncells; ++i )
-            {
-                for ( size_t j = 0; j < cell_nnodes; ++j )
-                {
-                    const auto index = *connections++;
-                    const T value = values[ index ];
-                    min_value = kvs::Math::Min( value, min_value );
-                    max_value = kvs::Math::Max( value, max_value );
-                }
-            }
-            return kvs::Range( static_cast<double>( min_value ), static_cast<double>( max_value ) );
-        }
-        else
-        {
-            kvs::Real64 min_value = kvs::Value<kvs::Real64>::Max();
-            kvs::Real64 max_value = kvs::Value<kvs::Real64>::Min();
-            for ( size_t i = 0; i < ncells; ++i )
-            {
-                for ( size_t j = 0; j < cell_nnodes; ++j )
-                {
-                    const auto index = *connections++;
-                    const T* value = values + veclen * index;
-                    kvs::Real64 magnitude = 0.0;
-                    for ( size_t k = 0; k < veclen; ++k )
-                    {
-                        magnitude += static_cast<kvs::Real64>( ( *value ) * ( *value ) );
-                        ++value;
-                    }
-                    min_value = kvs::Math::Min( magnitude, min_value );
-                    max_value = kvs::Math::Max( magnitude, max_value );
-                }
-            }
-            return kvs::Range( std::sqrt( min_value ), std::sqrt( max_value ) );
         }
+        return kvs::Range( std::sqrt( min_value ), std::sqrt( max_value ) );
     }
 }
 
@@ -185,6 +149,9 @@ void UnstructuredVolumeObject::shallowCopy( const UnstructuredVolumeObject& obje
     m_nnodes = object.numberOfNodes();
     m_ncells = object.numberOfCells();
     m_connections = object.connections();
+    m_node_to_cell_offsets = object.nodeToCellOffsets();
+    m_node_to_cell_indices = object.nodeToCellIndices();
+    m_vertex_attribute_cache = object.vertexAttributeCache();
 }
 
 /*===========================================================================*/
@@ -200,6 +167,8 @@ void UnstructuredVolumeObject::deepCopy( const UnstructuredVolumeObject& object
     m_nnodes = object.numberOfNodes();
     m_ncells = object.numberOfCells();
     m_connections = object.connections().clone();
+    m_node_to_cell_offsets = object.nodeToCellOffsets().clone();
+    m_node_to_cell_indices = object.nodeToCellIndices().clone();
 }
 
 /*===========================================================================*/
@@ -388,6 +357,74 @@ size_t UnstructuredVolumeObject::numberOfCellNodes() const
     return ::NumberOfCellNodes[ size_t( m_cell_type ) ];
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Updates the node-to-cell adjacency in the compressed sparse row format.
+ *
+ *  The indices of the cells sharing the i-th node are stored in ascending order
+ *  in nodeToCellIndices() from nodeToCellOffsets()[i] to nodeToCellOffsets()[i+1].
+ *  The adjacency is built once and kept until the cell type, the number of
+ *  nodes or cells, or the connections are changed, so that the filters and
+ *  renderers can gather the cell values for each node in parallel without
+ *  write conflicts. This method is not thread-safe and should be called
+ *  before the parallel region. If a node ID in the connections is out of
+ *  range, an error is reported and the adjacency is not built.
+ */
+/*===========================================================================*/
+void UnstructuredVolumeObject::updateNodeToCellAdjacency() const
+{
+    if ( this->hasNodeToCellAdjacency() ) { return; }
+
+    const size_t nnodes = this->numberOfNodes();
+    const size_t ncells = this->numberOfCells();
+    const size_t cell_nnodes = this->numberOfCellNodes();
+    const kvs::UInt32* connections = this->connections().data();
+    if ( nnodes == 0 || ncells * cell_nnodes > this->connections().size() ) { return; }
+
+    // Count the adjacent cells of each node.
+    kvs::ValueArray<kvs::UInt32> offsets( nnodes + 1 );
+    offsets.fill( 0 );
+    for ( size_t i = 0; i < ncells * cell_nnodes; i++ )
+    {
+        if ( connections[i] >= nnodes )
+        {
+            kvsMessageError( "Node ID %u of the connections is out of range.", connections[i] );
+            return;
+        }
+        offsets[ connections[i] + 1 ]++;
+    }
+
+    for ( size_t i = 0; i < nnodes; i++ )
+    {
+        offsets[ i + 1 ] += offsets[i];
+    }
+
+    // Fill the cell indices in ascending order.
+    kvs::ValueArray<kvs::UInt32> indices( offsets[ nnodes ] );
+    std::vector<kvs::UInt32> counters( offsets.begin(), offsets.end() - 1 );
+    for ( size_t i = 0, index = 0; i < ncells; i++ )
+    {
+        for ( size_t j = 0; j < cell_nnodes; j++, index++ )
+        {
+            indices[ counters[ connections[ index ] ]++ ] = static_cast<kvs::UInt32>( i );
+        }
+    }
+
+    m_node_to_cell_offsets = offsets;
+    m_node_to_cell_indices = indices;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Clears the node-to-cell adjacency.
+ */
+/*===========================================================================*/
+void UnstructuredVolumeObject::clearNodeToCellAdjacency() const
+{
+    m_node_to_cell_offsets.release();
+    m_node_to_cell_indices.release();
+}
+
 /*==========================================================================*/
 /**
  *  @brief  Updates the min/max node coordinates.
@@ -466,8 +503,19 @@ void UnstructuredVolumeObject::updateMinMaxCoords()
     }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Updates the min/max node values.
+ *
+ *  The volume without the connections (point cloud) is scanned in parallel
+ *  by the base class, and otherwise the nodes referred by the cells are
+ *  scanned.
+ */
+/*===========================================================================*/
 void UnstructuredVolumeObject::updateMinMaxValues() const
 {
+    if ( this->connections().empty() ) { BaseClass::updateMinMaxValues(); return; }
+
     kvs::Range range;
     switch ( this->values().typeID() )
     {
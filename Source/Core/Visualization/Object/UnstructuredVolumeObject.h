@@ -40,11 +40,31 @@ public:
         Prism ///< Prism cell.
     };
 
+    /*  Vertex attributes derived from the volume by the renderers, which are
+     *  kept with the volume so that re-creating a renderer does not recompute
+     *  them. The source arrays are held as shallow copies, so their buffers
+     *  cannot be released and reused while they are compared by address. */
+    struct VertexAttributeCache
+    {
+        Values values{}; ///< value array used for the attributes (shallow copy)
+        Coords coords{}; ///< coordinate array used for the attributes (shallow copy)
+        Connections connections{}; ///< connection array used for the attributes (shallow copy)
+        kvs::Real64 min_value = 0.0; ///< min. value used for the normalized values
+        kvs::Real64 max_value = 0.0; ///< max. value used for the normalized values
+        size_t random_texture_size = 0; ///< random texture size used for the random indices
+        kvs::ValueArray<kvs::UInt16> random_indices{}; ///< random index array
+        kvs::ValueArray<kvs::Real32> normalized_values{}; ///< normalized value array
+        kvs::ValueArray<kvs::Real32> normals{}; ///< vertex normal array
+    };
+
 private:
     CellType m_cell_type = UnknownCellType; ///< Cell type.
     size_t m_nnodes = 0; ///< Number of nodes.
     size_t m_ncells = 0; ///< Number of cells.
     Connections m_connections{}; ///< Connection ( Node ID ) array.
+    mutable kvs::ValueArray<kvs::UInt32> m_node_to_cell_offsets{}; ///< offsets of the cell lists for each node (CSR)
+    mutable kvs::ValueArray<kvs::UInt32> m_node_to_cell_indices{}; ///< cell indices adjacent to the nodes (CSR)
+    mutable VertexAttributeCache m_vertex_attribute_cache{}; ///< vertex attributes for the renderers (cache)
 
 public:
     UnstructuredVolumeObject(): BaseClass( Unstructured ) {}
@@ -56,7 +76,7 @@ public:
     bool read( const std::string& filename );
     bool write( const std::string& filename, const bool ascii = true, const bool external = false ) const;
 
-    void setCellType( CellType cell_type ) { m_cell_type = cell_type; }
+    void setCellType( CellType cell_type ) { m_cell_type = cell_type; this->clearNodeToCellAdjacency(); }
     void setCellTypeToTetrahedra() { this->setCellType( Tetrahedra ); }
     void setCellTypeToHexahedra() { this->setCellType( Hexahedra ); }
     void setCellTypeToQuadraticTetrahedra() { this->setCellType( QuadraticTetrahedra ); }
@@ -64,9 +84,9 @@ public:
     void setCellTypeToPyramid() { this->setCellType( Pyramid ); }
     void setCellTypeToPoint() { this->setCellType( Point ); }
     void setCellTypeToPrism() { this->setCellType( Prism ); }
-    void setNumberOfNodes( const size_t nnodes ) { m_nnodes = nnodes; }
-    void setNumberOfCells( const size_t ncells ) { m_ncells = ncells; }
-    void setConnections( const Connections& connections ) { m_connections = connections; }
+    void setNumberOfNodes( const size_t nnodes ) { m_nnodes = nnodes; this->clearNodeToCellAdjacency(); }
+    void setNumberOfCells( const size_t ncells ) { m_ncells = ncells; this->clearNodeToCellAdjacency(); }
+    void setConnections( const Connections& connections ) { m_connections = connections; this->clearNodeToCellAdjacency(); }
 
     CellType cellType() const { return m_cell_type; }
     size_t numberOfNodes() const { return m_nnodes; }
@@ -77,6 +97,15 @@ public:
     void updateMinMaxCoords();
     void updateMinMaxValues() const;
 
+    bool hasNodeToCellAdjacency() const { return !m_node_to_cell_offsets.empty(); }
+    const kvs::ValueArray<kvs::UInt32>& nodeToCellOffsets() const { return m_node_to_cell_offsets; }
+    const kvs::ValueArray<kvs::UInt32>& nodeToCellIndices() const { return m_node_to_cell_indices; }
+    void updateNodeToCellAdjacency() const;
+    void clearNodeToCellAdjacency() const;
+
+    VertexAttributeCache& vertexAttributeCache() const { return m_vertex_attribute_cache; }
+    void clearVertexAttributeCache() const { m_vertex_attribute_cache = VertexAttributeCache(); }
+
 public:
     KVS_DEPRECATED( UnstructuredVolumeObject(
                         const CellType cell_type,
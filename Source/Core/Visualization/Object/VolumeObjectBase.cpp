@@ -5,6 +5,207 @@
  */
 /****************************************************************************/
 #include "VolumeObjectBase.h"
+#include <kvs/TaskScheduler>
+#include <kvs/Type>
+#include <kvs/Message>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+
+const size_t MinNodesPerTask = 65536; ///< min. number of nodes scanned by a task
+
+/*===========================================================================*/
+/**
+ *  @brief  Result of the value scan for a range of nodes.
+ */
+/*===========================================================================*/
+struct ScanResult
+{
+    kvs::Range range{}; ///< range of the values (magnitudes for the vectors)
+    std::vector<kvs::Range> component_ranges{}; ///< ranges of the components
+    std::vector<size_t> bins{}; ///< counts of the bins
+    size_t total_count = 0; ///< number of the counted values
+
+    void merge( const ScanResult& other )
+    {
+        range.extend( other.range );
+        if ( component_ranges.empty() ) { component_ranges = other.component_ranges; }
+        else
+        {
+            for ( size_t i = 0; i < other.component_ranges.size(); ++i )
+            {
+                component_ranges[i].extend( other.component_ranges[i] );
+            }
+        }
+        if ( bins.empty() ) { bins = other.bins; }
+        else
+        {
+            for ( size_t i = 0; i < other.bins.size(); ++i ) { bins[i] += other.bins[i]; }
+        }
+        total_count += other.total_count;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Bin counter of the histogram.
+ */
+/*===========================================================================*/
+class BinCounter
+{
+private:
+    const kvs::VolumeObjectBase::Histogram* m_histogram; ///< histogram parameters
+    size_t m_nbins; ///< number of bins
+    kvs::Real64 m_width; ///< bin width
+
+public:
+    BinCounter( const kvs::VolumeObjectBase::Histogram* histogram ):
+        m_histogram( histogram ),
+        m_nbins( histogram ? histogram->bins.size() : 0 ),
+        m_width( m_nbins > 1 ? ( histogram->max_range - histogram->min_range ) / kvs::Real64( m_nbins - 1 ) : 0.0 ) {}
+
+    size_t numberOfBins() const { return m_nbins; }
+
+    void count( const kvs::Real64 value, ScanResult* result ) const
+    {
+        for ( const auto ignore_value : m_histogram->ignore_values )
+        {
+            if ( kvs::Math::Equal( value, ignore_value ) ) { return; }
+        }
+
+        // The values out of the range (and NaN) are counted in the end bins.
+        kvs::Real64 t = m_width > 0.0 ? ( value - m_histogram->min_range ) / m_width : 0.0;
+        if ( !( t >= 0.0 ) ) { t = 0.0; }
+        if ( t > kvs::Real64( m_nbins - 1 ) ) { t = kvs::Real64( m_nbins - 1 ); }
+        result->bins[ static_cast<size_t>( t ) ]++;
+        result->total_count++;
+    }
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Scans the values of the nodes [begin, end).
+ *  @param  values [in] pointer to the values
+ *  @param  begin [in] first node index
+ *  @param  end [in] last node index (not included)
+ *  @param  veclen [in] vector length
+ *  @param  counter [in] bin counter (no bins: min/max values only)
+ *  @return scan result
+ */
+/*===========================================================================*/
+template <typename T>
+ScanResult ScanValues(
+    const T* values,
+    const size_t begin,
+    const size_t end,
+    const size_t veclen,
+    const BinCounter& counter )
+{
+    ScanResult result;
+    if ( begin >= end ) { return result; }
+
+    result.bins.assign( counter.numberOfBins(), 0 );
+    const T* value = values + begin * veclen;
+    const size_t nnodes = end - begin;
+    if ( veclen == 1 )
+    {
+        T min_value = value[0];
+        T max_value = value[0];
+        if ( counter.numberOfBins() == 0 )
+        {
+            for ( size_t i = 0; i < nnodes; ++i )
+            {
+                min_value = kvs::Math::Min( value[i], min_value );
+                max_value = kvs::Math::Max( value[i], max_value );
+            }
+        }
+        else
+        {
+            for ( size_t i = 0; i < nnodes; ++i )
+            {
+                min_value = kvs::Math::Min( value[i], min_value );
+                max_value = kvs::Math::Max( value[i], max_value );
+                counter.count( static_cast<kvs::Real64>( value[i] ), &result );
+            }
+        }
+
+        result.range = kvs::Range( static_cast<double>( min_value ), static_cast<double>( max_value ) );
+        result.component_ranges.assign( 1, result.range );
+    }
+    else
+    {
+        std::vector<T> min_values( value, value + veclen );
+        std::vector<T> max_values( value, value + veclen );
+        kvs::Real64 min_magnitude = kvs::Value<kvs::Real64>::Max();
+        kvs::Real64 max_magnitude = 0.0;
+        for ( size_t i = 0; i < nnodes; ++i )
+        {
+            kvs::Real64 magnitude = 0.0;
+            for ( size_t j = 0; j < veclen; ++j )
+            {
+                const T v = *value++;
+                min_values[j] = kvs::Math::Min( v, min_values[j] );
+                max_values[j] = kvs::Math::Max( v, max_values[j] );
+                magnitude += kvs::Math::Square( static_cast<kvs::Real64>( v ) );
+            }
+            min_magnitude = kvs::Math::Min( magnitude, min_magnitude );
+            max_magnitude = kvs::Math::Max( magnitude, max_magnitude );
+            if ( counter.numberOfBins() > 0 ) { counter.count( std::sqrt( magnitude ), &result ); }
+        }
+
+        result.range = kvs::Range( std::sqrt( min_magnitude ), std::sqrt( max_magnitude ) );
+        for ( size_t j = 0; j < veclen; ++j )
+        {
+            result.component_ranges.push_back(
+                kvs::Range( static_cast<double>( min_values[j] ), static_cast<double>( max_values[j] ) ) );
+        }
+    }
+
+    return result;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Scans the values of all the nodes in parallel.
+ *
+ *  The nodes are divided into one range per thread, so that each thread
+ *  counts its own bins, and the bins are merged at the end.
+ *
+ *  @param  values [in] value array
+ *  @param  nnodes [in] number of nodes
+ *  @param  veclen [in] vector length
+ *  @param  counter [in] bin counter
+ *  @return scan result
+ */
+/*===========================================================================*/
+template <typename T>
+ScanResult Scan(
+    const kvs::AnyValueArray& values,
+    const size_t nnodes,
+    const size_t veclen,
+    const BinCounter& counter )
+{
+    const T* data = static_cast<const T*>( values.data() );
+    kvs::TaskScheduler& scheduler = kvs::TaskScheduler::Instance();
+    const size_t nthreads = scheduler.numberOfThreads();
+    const size_t grain = std::max( ( nnodes + nthreads - 1 ) / nthreads, MinNodesPerTask );
+    return scheduler.parallelReduce( size_t(0), nnodes, ScanResult(),
+        [&] ( const size_t begin, const size_t end, const ScanResult& )
+        {
+            return ::ScanValues<T>( data, begin, end, veclen, counter );
+        },
+        [] ( ScanResult result, const ScanResult& partial )
+        {
+            result.merge( partial );
+            return result;
+        },
+        grain );
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -26,6 +227,125 @@ void VolumeObjectBase::setMinMaxValues(
     m_has_min_max_values = true;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the histogram of the values (magnitudes for the vectors).
+ *
+ *  The histogram is cached, and the cached one is returned while the
+ *  parameters are the same. The returned histogram stays valid after the
+ *  cache is replaced by a call with other parameters. Otherwise, the values are scanned in parallel,
+ *  and the min/max values (if not set) and the component ranges are also
+ *  updated by the same scan.
+ *
+ *  @param  nbins [in] number of bins
+ *  @param  min_range [in] lower bound of the bins
+ *  @param  max_range [in] upper bound of the bins (center of the last bin)
+ *  @param  ignore_values [in] values that are not counted
+ *  @return histogram
+ */
+/*===========================================================================*/
+std::shared_ptr<const VolumeObjectBase::Histogram> VolumeObjectBase::histogram(
+    const size_t nbins,
+    const kvs::Real64 min_range,
+    const kvs::Real64 max_range,
+    const std::vector<kvs::Real64>& ignore_values ) const
+{
+    if ( m_histogram &&
+         m_histogram->bins.size() == nbins &&
+         m_histogram->min_range == min_range &&
+         m_histogram->max_range == max_range &&
+         m_histogram->ignore_values == ignore_values )
+    {
+        return m_histogram;
+    }
+
+    auto histogram = std::make_shared<Histogram>();
+    histogram->min_range = min_range;
+    histogram->max_range = max_range;
+    histogram->ignore_values = ignore_values;
+    histogram->bins.allocate( nbins );
+    this->scan_values( histogram.get() );
+    m_histogram = histogram;
+    return m_histogram;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Clears the cached component ranges and histogram.
+ */
+/*===========================================================================*/
+void VolumeObjectBase::clearValueStatistics() const
+{
+    m_component_ranges.clear();
+    m_histogram.reset();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Updates the min/max values and the component ranges by a parallel scan.
+ */
+/*===========================================================================*/
+void VolumeObjectBase::updateMinMaxValues() const
+{
+    this->scan_values( nullptr );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Scans the node values.
+ *  @param  histogram [in/out] histogram to be counted (NULL: min/max values only)
+ *
+ *  The node values must be in memory. For a volume without the node values,
+ *  such as kvs::BrickedVolumeObject, an error is reported, and the histogram
+ *  is left empty.
+ */
+/*===========================================================================*/
+void VolumeObjectBase::scan_values( Histogram* histogram ) const
+{
+    if ( m_values.size() == 0 )
+    {
+        kvsMessageError( "Cannot scan the node values, which are not in memory." );
+        return;
+    }
+    KVS_ASSERT( m_values.size() == m_veclen * this->numberOfNodes() );
+
+    const size_t nnodes = this->numberOfNodes();
+    const ::BinCounter counter( histogram );
+    ::ScanResult result;
+    switch ( m_values.typeID() )
+    {
+    case kvs::Type::TypeInt8:   { result = ::Scan<kvs::Int8  >( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeInt16:  { result = ::Scan<kvs::Int16 >( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeInt32:  { result = ::Scan<kvs::Int32 >( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeInt64:  { result = ::Scan<kvs::Int64 >( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeUInt8:  { result = ::Scan<kvs::UInt8 >( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeUInt16: { result = ::Scan<kvs::UInt16>( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeUInt32: { result = ::Scan<kvs::UInt32>( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeUInt64: { result = ::Scan<kvs::UInt64>( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeReal32: { result = ::Scan<kvs::Real32>( m_values, nnodes, m_veclen, counter ); break; }
+    case kvs::Type::TypeReal64: { result = ::Scan<kvs::Real64>( m_values, nnodes, m_veclen, counter ); break; }
+    default: break;
+    }
+
+    m_component_ranges = result.component_ranges;
+    if ( histogram )
+    {
+        for ( size_t i = 0; i < histogram->bins.size(); ++i )
+        {
+            histogram->bins[i] = i < result.bins.size() ? result.bins[i] : 0;
+        }
+        histogram->total_count = result.total_count;
+        histogram->max_count = result.bins.empty() ? 0 : *std::max_element( result.bins.begin(), result.bins.end() );
+
+        // The min/max values given by the user (e.g. from the file) are kept.
+        if ( !m_has_min_max_values ) { this->setMinMaxValues( result.range.lower(), result.range.upper() ); }
+    }
+    else
+    {
+        this->setMinMaxValues( result.range.lower(), result.range.upper() );
+    }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Shallow copys from the specified volume object.
@@ -39,6 +359,8 @@ void VolumeObjectBase::shallowCopy( const VolumeObjectBase& object )
     m_has_min_max_values = object.hasMinMaxValues();
     m_min_value = object.minValue();
     m_max_value = object.maxValue();
+    m_component_ranges = object.m_component_ranges;
+    m_histogram = object.m_histogram;
     m_label = object.label();
     m_veclen = object.veclen();
     m_coords = object.coords();
@@ -58,6 +380,8 @@ void VolumeObjectBase::deepCopy( const VolumeObjectBase& object )
     m_has_min_max_values = object.hasMinMaxValues();
     m_min_value = object.minValue();
     m_max_value = object.maxValue();
+    m_component_ranges = object.m_component_ranges;
+    m_histogram = object.m_histogram;
     m_label = object.label();
     m_veclen = object.veclen();
     m_coords = object.coords().clone();
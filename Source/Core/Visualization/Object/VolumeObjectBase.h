@@ -7,10 +7,13 @@
 #pragma once
 #include <string>
 #include <ostream>
+#include <vector>
+#include <memory>
 #include <kvs/ObjectBase>
 #include <kvs/Value>
 #include <kvs/ValueArray>
 #include <kvs/AnyValueArray>
+#include <kvs/Range>
 #include <kvs/Math>
 #include <kvs/Indent>
 #include <kvs/Deprecated>
@@ -41,6 +44,16 @@ public:
         UnknownVolumeType ///< Unknow volume type.
     };
 
+    struct Histogram
+    {
+        kvs::Real64 min_range = 0.0; ///< lower bound of the bins
+        kvs::Real64 max_range = 0.0; ///< upper bound of the bins (center of the last bin)
+        std::vector<kvs::Real64> ignore_values{}; ///< values that are not counted
+        kvs::ValueArray<size_t> bins{}; ///< counts of the bins
+        size_t max_count = 0; ///< max. count of the bins
+        size_t total_count = 0; ///< number of the counted values
+    };
+
 private:
     VolumeType m_volume_type = UnknownVolumeType; ///< volume type
     std::string m_label = ""; ///< data label
@@ -51,6 +64,8 @@ private:
     mutable bool m_has_min_max_values = false; ///< Whether includes min/max values or not
     mutable kvs::Real64 m_min_value = 0.0; ///< Minimum field value
     mutable kvs::Real64 m_max_value = 0.0; ///< Maximum field value
+    mutable std::vector<kvs::Range> m_component_ranges{}; ///< min/max values of each component (cache)
+    mutable std::shared_ptr<const Histogram> m_histogram{}; ///< histogram of the last scan (cache)
 
 public:
     VolumeObjectBase( const VolumeType type = UnknownVolumeType ):
@@ -66,7 +81,7 @@ public:
     void setUnit( const std::string& unit ) { m_unit = unit; }
     void setVeclen( const size_t veclen ) { m_veclen = veclen; }
     void setCoords( const Coords& coords ) { m_coords = coords; }
-    void setValues( const Values& values ) { m_values = values; }
+    void setValues( const Values& values ) { m_values = values; this->clearValueStatistics(); }
     void setMinMaxValues( const kvs::Real64 min_value, const kvs::Real64 max_value ) const;
 
     const std::string& label() const { return m_label; }
@@ -77,15 +92,26 @@ public:
     bool hasMinMaxValues() const { return m_has_min_max_values; }
     kvs::Real64 minValue() const { return m_min_value; }
     kvs::Real64 maxValue() const { return m_max_value; }
+    bool hasComponentRanges() const { return !m_component_ranges.empty(); }
+    const std::vector<kvs::Range>& componentRanges() const { return m_component_ranges; }
+    std::shared_ptr<const Histogram> histogram(
+        const size_t nbins,
+        const kvs::Real64 min_range,
+        const kvs::Real64 max_range,
+        const std::vector<kvs::Real64>& ignore_values = std::vector<kvs::Real64>() ) const;
+    void clearValueStatistics() const;
 
     VolumeType volumeType() const { return m_volume_type; }
     virtual size_t numberOfNodes() const = 0;
     virtual size_t numberOfCells() const = 0;
-    virtual void updateMinMaxValues() const {}
+    virtual void updateMinMaxValues() const;
 
 protected:
     void setVolumeType( VolumeType volume_type ) { m_volume_type = volume_type; }
 
+private:
+    void scan_values( Histogram* histogram ) const;
+
 public:
     KVS_DEPRECATED( VolumeObjectBase(
                         const size_t veclen,
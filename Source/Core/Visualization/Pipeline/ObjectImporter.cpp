@@ -35,6 +35,8 @@
 #include <kvs/StructuredVolumeImporter>
 #include <kvs/UnstructuredVolumeImporter>
 #include <kvs/ImageImporter>
+#include <kvs/Profiler>
+#include <kvs/AllocationProfiler>
 
 
 namespace kvs
@@ -71,6 +73,8 @@ ObjectImporter::~ObjectImporter()
 /*===========================================================================*/
 kvs::ObjectBase* ObjectImporter::import()
 {
+    KVS_PROFILER_ZONE( "importer", "kvs::ObjectImporter::import" );
+
     if ( !this->estimate_file_format() )
     {
         kvsMessageError()
@@ -87,14 +91,23 @@ kvs::ObjectBase* ObjectImporter::import()
         return nullptr;
     }
 
-    if ( !m_file_format->read( m_filename ) )
+    // The arrays read and imported are labeled with the importer class name.
+    kvs::AllocationProfiler::Scope scope( m_importer->moduleName() );
     {
-        kvsMessageError()
-            << "Cannot read a '" << m_filename << "'." << std::endl;
-        return nullptr;
+        KVS_PROFILER_ZONE( "importer", "kvs::FileFormatBase::read" );
+        if ( !m_file_format->read( m_filename ) )
+        {
+            kvsMessageError()
+                << "Cannot read a '" << m_filename << "'." << std::endl;
+            return nullptr;
+        }
     }
 
-    kvs::ObjectBase* object = m_importer->exec( m_file_format );
+    kvs::ObjectBase* object = nullptr;
+    {
+        KVS_PROFILER_ZONE( "importer", m_importer->moduleName() );
+        object = m_importer->exec( m_file_format );
+    }
     if ( !object )
     {
         kvsMessageError() << "Cannot import a object." << std::endl;
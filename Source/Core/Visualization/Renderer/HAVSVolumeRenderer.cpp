@@ -24,7 +24,6 @@
 #include <kvs/OpenGL>
 #include <kvs/VertexShader>
 #include <kvs/FragmentShader>
-#include <kvs/PreIntegrationTable3D>
 
 
 namespace
@@ -251,11 +250,14 @@ void HAVSVolumeRenderer::initialize_table()
     const float max_size_of_cell = m_meshes->depthScale() * 2.0f;
     const size_t dim_scalar = 128;
     const size_t dim_depth = 128;
-    kvs::PreIntegrationTable3D table;
-    table.setScalarResolution( dim_scalar );
-    table.setDepthResolution( dim_depth );
-    table.setTransferFunction( BaseClass::transferFunction(), min_value, max_value );
-    table.create( max_size_of_cell );
+    // The table is kept for updating only the entries affected by the
+    // modified range of the transfer function.
+    m_preintegration_table.setScalarResolution( dim_scalar );
+    m_preintegration_table.setDepthResolution( dim_depth );
+    m_preintegration_table.setTransferFunction( BaseClass::transferFunction(), min_value, max_value );
+    m_preintegration_table.update( max_size_of_cell );
+
+    if ( m_preintegration_texture.isCreated() ) { m_preintegration_texture.release(); }
 
     m_preintegration_texture.setWrapS( GL_CLAMP_TO_EDGE );
     m_preintegration_texture.setWrapT( GL_CLAMP_TO_EDGE );
@@ -263,7 +265,7 @@ void HAVSVolumeRenderer::initialize_table()
     m_preintegration_texture.setMagFilter( GL_LINEAR );
     m_preintegration_texture.setMinFilter( GL_LINEAR );
     m_preintegration_texture.setPixelFormat( GL_RGBA8, GL_RGBA, GL_FLOAT );
-    m_preintegration_texture.create( dim_scalar, dim_scalar, dim_depth, table.table().data() );
+    m_preintegration_texture.create( dim_scalar, dim_scalar, dim_depth, m_preintegration_table.table().data() );
 }
 
 void HAVSVolumeRenderer::initialize_framebuffer()
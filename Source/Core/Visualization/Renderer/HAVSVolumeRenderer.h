@@ -24,6 +24,7 @@
 #include <kvs/UnstructuredVolumeObject>
 #include <kvs/Texture2D>
 #include <kvs/Texture3D>
+#include <kvs/PreIntegrationTable3D>
 #include <kvs/FragmentShader>
 #include <kvs/VertexShader>
 #include <kvs/ProgramObject>
@@ -59,6 +60,7 @@ private:
     // Reference data (NOTE: not allocated in thie class).
     const kvs::UnstructuredVolumeObject* m_ref_volume; ///< pointer to the volume data
 
+    kvs::PreIntegrationTable3D m_preintegration_table{}; ///< pre-integration table
     kvs::Texture3D m_preintegration_texture; ///< pre-integration texture
     size_t m_k_size; ///< k-buffer size (2 or 6)
     Meshes* m_meshes; ///< tetrahedral meshes for HAVS
@@ -9,6 +9,71 @@
 #include <kvs/PointObject>
 #include <kvs/Camera>
 #include <kvs/Assert>
+#include <kvs/Xform>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Projects the particles to the window and stores them in the buffer.
+ *  @param  v [in] pointer to the coordinate array
+ *  @param  nv [in] number of particles
+ *  @param  t [in] transformation matrix from the coordinates to the clip space
+ *  @param  w [in] half width of the window
+ *  @param  h [in] half height of the window
+ *  @param  bounds_width [in] maximum x coordinate of the window
+ *  @param  bounds_height [in] maximum y coordinate of the window
+ *  @param  buffer [in/out] pointer to the particle buffer
+ */
+/*===========================================================================*/
+template <typename T>
+void ProjectParticles(
+    const T* v,
+    const size_t nv,
+    const float t[16],
+    const size_t w,
+    const size_t h,
+    const size_t bounds_width,
+    const size_t bounds_height,
+    kvs::ParticleBuffer* buffer )
+{
+    size_t index3 = 0;
+    for ( size_t index = 0; index < nv; index++, index3 += 3 )
+    {
+        /* Calculate the projected point position in the window coordinate system.
+         * Ex.) Camera::projectObjectToWindow().
+         */
+        const float x = static_cast<float>( v[index3] );
+        const float y = static_cast<float>( v[index3+1] );
+        const float z = static_cast<float>( v[index3+2] );
+        float p_tmp[4] = {
+            x*t[0] + y*t[4] + z*t[ 8] + t[12],
+            x*t[1] + y*t[5] + z*t[ 9] + t[13],
+            x*t[2] + y*t[6] + z*t[10] + t[14],
+            x*t[3] + y*t[7] + z*t[11] + t[15] };
+        p_tmp[3] = 1.0f / p_tmp[3];
+        p_tmp[0] *= p_tmp[3];
+        p_tmp[1] *= p_tmp[3];
+        p_tmp[2] *= p_tmp[3];
+
+        const float p_win_x = ( 1.0f + p_tmp[0] ) * w;
+        const float p_win_y = ( 1.0f + p_tmp[1] ) * h;
+        const float depth   = ( 1.0f + p_tmp[2] ) * 0.5f;
+
+        // Store the projected point in the point buffer.
+        if ( ( 0 < p_win_x ) & ( 0 < p_win_y ) )
+        {
+            if ( ( p_win_x < bounds_width ) & ( p_win_y < bounds_height ) )
+            {
+                buffer->add( p_win_x, p_win_y, depth, index );
+            }
+        }
+    }
+}
+
+} // end of namespace
 
 
 namespace kvs
@@ -75,7 +140,7 @@ void ParticleBasedRenderer::exec(
 
     kvs::PointObject* point = kvs::PointObject::DownCast( object );
     if ( !m_ref_point ) this->attachPointObject( point );
-    if ( point->normals().size() == 0 ) BaseClass::disableShading();
+    if ( point->numberOfNormals() == 0 ) BaseClass::disableShading();
 
     BaseClass::startTimer();
     {
@@ -180,6 +245,15 @@ void ParticleBasedRenderer::project_particle(
     const kvs::Light* light )
 {
     kvs::Xform pvm( camera->projectionMatrix() * camera->viewingMatrix() * point->modelingMatrix() );
+
+    // The dequantization of the 16-bit coordinates is folded into the matrix.
+    if ( point->hasQuantizedCoords() )
+    {
+        const kvs::Vec3 min_coord = point->minQuantizationCoord();
+        const kvs::Vec3 step = ( point->maxQuantizationCoord() - min_coord ) / 65535.0f;
+        pvm = pvm * kvs::Xform::Translation( min_coord ) * kvs::Xform::Scaling( step );
+    }
+
     float t[16]; pvm.toArray( t );
 
     const size_t w = camera->windowWidth() / 2;
@@ -194,38 +268,17 @@ void ParticleBasedRenderer::project_particle(
 
     // Aliases.
     const size_t nv = point->numberOfVertices();
-    const kvs::Real32* v = point->coords().data();
-
-    size_t index3 = 0;
     const size_t bounds_width = BaseClass::windowWidth() - 1;
     const size_t bounds_height = BaseClass::windowHeight() - 1;
-    for ( size_t index = 0; index < nv; index++, index3 += 3 )
+    if ( point->hasQuantizedCoords() )
     {
-        /* Calculate the projected point position in the window coordinate system.
-         * Ex.) Camera::projectObjectToWindow().
-         */
-        float p_tmp[4] = {
-            v[index3]*t[0] + v[index3+1]*t[4] + v[index3+2]*t[ 8] + t[12],
-            v[index3]*t[1] + v[index3+1]*t[5] + v[index3+2]*t[ 9] + t[13],
-            v[index3]*t[2] + v[index3+1]*t[6] + v[index3+2]*t[10] + t[14],
-            v[index3]*t[3] + v[index3+1]*t[7] + v[index3+2]*t[11] + t[15] };
-        p_tmp[3] = 1.0f / p_tmp[3];
-        p_tmp[0] *= p_tmp[3];
-        p_tmp[1] *= p_tmp[3];
-        p_tmp[2] *= p_tmp[3];
-
-        const float p_win_x = ( 1.0f + p_tmp[0] ) * w;
-        const float p_win_y = ( 1.0f + p_tmp[1] ) * h;
-        const float depth   = ( 1.0f + p_tmp[2] ) * 0.5f;
-
-        // Store the projected point in the point buffer.
-        if ( ( 0 < p_win_x ) & ( 0 < p_win_y ) )
-        {
-            if ( ( p_win_x < bounds_width ) & ( p_win_y < bounds_height ) )
-            {
-                m_buffer->add( p_win_x, p_win_y, depth, index );
-            }
-        }
+        const kvs::UInt16* v = point->quantizedCoords().data();
+        ::ProjectParticles( v, nv, t, w, h, bounds_width, bounds_height, m_buffer );
+    }
+    else
+    {
+        const kvs::Real32* v = point->coords().data();
+        ::ProjectParticles( v, nv, t, w, h, bounds_width, bounds_height, m_buffer );
     }
 
     // Shading calculation.
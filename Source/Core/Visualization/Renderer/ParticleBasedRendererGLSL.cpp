@@ -220,18 +220,19 @@ void ParticleBasedRenderer::Engine::BufferObject::create(
     const size_t nmanagers )
 {
     const auto* point = kvs::PointObject::DownCast( object );
-    KVS_ASSERT( point->coords().size() == point->colors().size() );
+    KVS_ASSERT( point->numberOfVertices() == point->numberOfColors() );
 
-    const bool has_normal = point->normals().size() > 0;
-    auto coords = point->coords();
-    auto colors = point->colors();
-    auto normals = point->normals();
+    // Compressed attributes are decoded once here when uploaded to the VBOs.
+    const bool has_normal = point->numberOfNormals() > 0;
+    auto coords = point->decompressedCoords();
+    auto colors = point->decompressedColors();
+    auto normals = point->decompressedNormals();
     if ( m_enable_shuffle )
     {
         kvs::UInt32 seed = 12345678;
-        coords = ::ShuffleArray<3>( point->coords(), seed );
-        colors = ::ShuffleArray<3>( point->colors(), seed );
-        if ( has_normal ) { normals = ::ShuffleArray<3>( point->normals(), seed ); }
+        coords = ::ShuffleArray<3>( coords, seed );
+        colors = ::ShuffleArray<3>( colors, seed );
+        if ( has_normal ) { normals = ::ShuffleArray<3>( normals, seed ); }
     }
 
     if ( !m_managers ) { delete [] m_managers; }
@@ -148,9 +148,15 @@ void ParticleBuffer::create_image_with_shading(
     kvs::ValueArray<kvs::UInt8>* color,
     kvs::ValueArray<kvs::Real32>* depth )
 {
-    const kvs::Real32* point_coords = m_ref_point_object->coords().data();
-    const kvs::UInt8* point_color = m_ref_point_object->colors().data();
-    const kvs::Real32* point_normal = m_ref_point_object->normals().data();
+    const kvs::PointObject* point = m_ref_point_object;
+    const kvs::Real32* point_coords = point->coords().data();
+    const kvs::Real32* point_normal = point->normals().data();
+    const bool quantized_coords = point->hasQuantizedCoords();
+    const bool packed_normals = point->hasPackedNormals();
+
+    // Indexed colors are looked up in the palette.
+    const kvs::UInt8* color_indices = point->hasColorIndices() ? point->colorIndices().data() : NULL;
+    const kvs::UInt8* point_color = color_indices ? point->colorPalette().data() : point->colors().data();
 
     const float inv_ssize = 1.0f / ( m_subpixel_level * m_subpixel_level );
     const float normalize_alpha = 255.0f * inv_ssize;
@@ -178,10 +184,12 @@ void ParticleBuffer::create_image_with_shading(
                     const size_t bindex = bindex_start + bx;
                     if ( m_depth_buffer[bindex] > 0.0f )
                     {
-                        const size_t point_index3 = 3 * m_index_buffer[ bindex ];
-                        const kvs::Vec3 vertex( point_coords + point_index3 );
-                        const kvs::Vec3 normal( point_normal + point_index3 );
-                        kvs::RGBColor color( point_color + point_index3 );
+                        const size_t point_index = m_index_buffer[ bindex ];
+                        const size_t point_index3 = 3 * point_index;
+                        const size_t color_index3 = color_indices ? 3 * color_indices[ point_index ] : point_index3;
+                        const kvs::Vec3 vertex = quantized_coords ? point->coord( point_index ) : kvs::Vec3( point_coords + point_index3 );
+                        const kvs::Vec3 normal = packed_normals ? point->normal( point_index ) : kvs::Vec3( point_normal + point_index3 );
+                        kvs::RGBColor color( point_color + color_index3 );
                         color = m_ref_shader->shadedColor( color, vertex, normal );
                         R += color.r();
                         G += color.g();
@@ -216,7 +224,9 @@ void ParticleBuffer::create_image_without_shading(
     kvs::ValueArray<kvs::UInt8>* color,
     kvs::ValueArray<kvs::Real32>* depth )
 {
-    const kvs::UInt8* point_color = m_ref_point_object->colors().data();
+    const kvs::PointObject* point = m_ref_point_object;
+    const kvs::UInt8* color_indices = point->hasColorIndices() ? point->colorIndices().data() : NULL;
+    const kvs::UInt8* point_color = color_indices ? point->colorPalette().data() : point->colors().data();
 
     const float inv_ssize = 1.0f / ( m_subpixel_level * m_subpixel_level );
     const float normalize_alpha = 255.0f * inv_ssize;
@@ -244,10 +254,11 @@ void ParticleBuffer::create_image_without_shading(
                     const size_t bindex = bindex_start + bx;
                     if ( m_depth_buffer[bindex] > 0.0f )
                     {
-                        const size_t point_index3 = 3 * m_index_buffer[ bindex ];
-                        R += point_color[ point_index3 + 0 ];
-                        G += point_color[ point_index3 + 1 ];
-                        B += point_color[ point_index3 + 2 ];
+                        const size_t point_index = m_index_buffer[ bindex ];
+                        const size_t color_index3 = color_indices ? 3 * color_indices[ point_index ] : 3 * point_index;
+                        R += point_color[ color_index3 + 0 ];
+                        G += point_color[ color_index3 + 1 ];
+                        B += point_color[ color_index3 + 2 ];
                         D = kvs::Math::Max( D, m_depth_buffer[ bindex ] );
                         npoints++;
                     }
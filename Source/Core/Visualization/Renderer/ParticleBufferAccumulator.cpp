@@ -184,14 +184,17 @@ void ParticleBufferAccumulator::createImage(
                         const kvs::PointObject*            object   = object_list[id];
                         const kvs::ParticleVolumeRenderer* renderer = renderer_list[id];
 
-                        const size_t point_index3 = 3 * m_index_buffer[bindex];
+                        const size_t point_index = m_index_buffer[bindex];
+                        const size_t point_index3 = 3 * point_index;
 
-                        kvs::RGBColor color( object->colors().data() + point_index3 );
+                        // Compressed attributes are decoded per particle.
+                        const bool compressed = object->isCompressed();
+                        kvs::RGBColor color = compressed ? object->color( point_index ) : kvs::RGBColor( object->colors().data() + point_index3 );
                         if( renderer->isShadingEnabled() )
                         {
                             const kvs::Shader::ShadingModel* shader = renderer->particleBuffer()->shader();
-                            const kvs::Vector3f vertex( object->coords().data() + point_index3 );
-                            const kvs::Vector3f normal( object->normals().data() + point_index3 );
+                            const kvs::Vector3f vertex = compressed ? object->coord( point_index ) : kvs::Vector3f( object->coords().data() + point_index3 );
+                            const kvs::Vector3f normal = compressed ? object->normal( point_index ) : kvs::Vector3f( object->normals().data() + point_index3 );
                             color = shader->shadedColor( color, vertex, normal );
                         }
 
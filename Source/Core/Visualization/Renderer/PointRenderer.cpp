@@ -33,14 +33,57 @@ void PointRenderer::exec( ObjectBase* object, Camera* camera, Light* light )
     kvs::OpenGL::WithPushedAttrib p( GL_ALL_ATTRIB_BITS );
 
     auto* point = kvs::PointObject::DownCast( object );
-    if ( point->normals().size() == 0 ) { BaseClass::disableShading(); }
+    if ( point->numberOfNormals() == 0 ) { BaseClass::disableShading(); }
 
     this->initialize();
-    ::PointRenderingFunction( point, camera->devicePixelRatio() );
+    ::PointRenderingFunction( this->decompressed_object( point ), camera->devicePixelRatio() );
 
     BaseClass::stopTimer();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns the point object with the full-precision arrays.
+ *  @param  point [in] pointer to the point object
+ *  @return pointer to the decompressed point object (the input if not compressed)
+ *
+ *  The rendering functions access the full-precision arrays directly, so the
+ *  compressed object is decompressed. The decompressed object is cached while
+ *  the arrays of the input object are the same ones, which are kept by a
+ *  shallow copy, so the object is decompressed only once.
+ */
+/*===========================================================================*/
+const kvs::PointObject* PointRenderer::decompressed_object( const kvs::PointObject* point )
+{
+    if ( !point->isCompressed() )
+    {
+        m_compressed_object = kvs::PointObject();
+        m_decompressed_object = kvs::PointObject();
+        return point;
+    }
+
+    const auto& cached = m_compressed_object;
+    const bool is_cached =
+        cached.coords().data() == point->coords().data() &&
+        cached.colors().data() == point->colors().data() &&
+        cached.normals().data() == point->normals().data() &&
+        cached.sizes().data() == point->sizes().data() &&
+        cached.quantizedCoords().data() == point->quantizedCoords().data() &&
+        cached.packedNormals().data() == point->packedNormals().data() &&
+        cached.colorIndices().data() == point->colorIndices().data() &&
+        cached.colorPalette().data() == point->colorPalette().data() &&
+        cached.minQuantizationCoord() == point->minQuantizationCoord() &&
+        cached.maxQuantizationCoord() == point->maxQuantizationCoord();
+    if ( !is_cached )
+    {
+        m_compressed_object.shallowCopy( *point );
+        m_decompressed_object.shallowCopy( *point );
+        m_decompressed_object.decompress();
+    }
+
+    return &m_decompressed_object;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Sets depth offset.
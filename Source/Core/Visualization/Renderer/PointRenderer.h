@@ -8,6 +8,7 @@
 #include <kvs/RendererBase>
 #include <kvs/Module>
 #include <kvs/Vector2>
+#include <kvs/PointObject>
 #include <kvs/Deprecated>
 
 
@@ -33,6 +34,8 @@ private:
     mutable bool m_enable_multisample_anti_aliasing = false; ///< flag for multisample anti-aliasing (MSAA)
     mutable bool m_enable_two_side_lighting = false; ///< flag for two-side lighting
     kvs::Vec2 m_depth_offset{ 0.0f, 0.0f }; ///< depth offset {factor, units}
+    kvs::PointObject m_compressed_object{}; ///< shallow copy of the compressed object
+    kvs::PointObject m_decompressed_object{}; ///< decompressed object (cache)
 
 public:
     PointRenderer() = default;
@@ -53,6 +56,7 @@ public:
 
 private:
     void initialize();
+    const kvs::PointObject* decompressed_object( const kvs::PointObject* point );
 
 public:
     KVS_DEPRECATED( bool isTwoSideLighting() const ) { return this->isTwoSideLightingEnabled(); }
@@ -24,7 +24,7 @@ namespace
 /*===========================================================================*/
 kvs::ValueArray<kvs::UInt8> VertexColors( const kvs::PointObject* point )
 {
-    if ( point->numberOfVertices() == point->numberOfColors() ) return point->colors();
+    if ( point->numberOfVertices() == point->numberOfColors() ) return point->decompressedColors();
 
     const size_t nvertices = point->numberOfVertices();
     const kvs::RGBColor color = point->color();
@@ -58,10 +58,10 @@ namespace glsl
 void PointRenderer::BufferObject::create( const kvs::ObjectBase* object )
 {
     const auto* point = kvs::PointObject::DownCast( object );
-    const bool has_normal = point->normals().size() > 0;
-    auto coords = point->coords();
+    const bool has_normal = point->numberOfNormals() > 0;
+    auto coords = point->decompressedCoords();
     auto colors = ::VertexColors( point );
-    auto normals = point->normals();
+    auto normals = point->decompressedNormals();
 
     m_manager.setVertexArray( coords, 3 );
     m_manager.setColorArray( colors, 3 );
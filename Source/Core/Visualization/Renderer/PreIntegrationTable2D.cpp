@@ -7,6 +7,7 @@
 #include "PreIntegrationTable2D.h"
 #include <kvs/Assert>
 #include <kvs/Math>
+#include <kvs/OpenMP>
 
 
 namespace
@@ -140,6 +141,30 @@ void PreIntegrationTable2D::setTransferFunction( const kvs::TransferFunction& tr
         tau0 = tau1;
     }
 
+    // Widen the modified scalar range, in which the tau values are changed.
+    if ( m_tau.size() != resolution )
+    {
+        m_dirty_begin = 0;
+        m_dirty_end = resolution;
+    }
+    else
+    {
+        size_t begin = 0;
+        size_t end = resolution;
+        while ( begin < end && tau[ begin ] == m_tau[ begin ] ) { begin++; }
+        while ( end > begin && tau[ end - 1 ] == m_tau[ end - 1 ] ) { end--; }
+        if ( begin < end )
+        {
+            if ( m_dirty_begin < m_dirty_end )
+            {
+                begin = kvs::Math::Min( begin, m_dirty_begin );
+                end = kvs::Math::Max( end, m_dirty_end );
+            }
+            m_dirty_begin = begin;
+            m_dirty_end = end;
+        }
+    }
+
     m_tau = tau;
     m_T = T;
 }
@@ -151,29 +176,78 @@ void PreIntegrationTable2D::setTransferFunction( const kvs::TransferFunction& tr
 /*===========================================================================*/
 void PreIntegrationTable2D::create()
 {
-    kvs::ValueArray<kvs::Real64> T = m_T;
-    kvs::ValueArray<kvs::Real64> tau = m_tau;
+    const size_t resolution = m_tau.size();
+    m_table.allocate( resolution * resolution );
+    this->compute_table( 0, resolution );
+
+    m_dirty_begin = 0;
+    m_dirty_end = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Updates pre-integration table for the modified transfer function.
+ *
+ *  Only the entries whose scalar interval overlaps the range of the opacity
+ *  map modified by setTransferFunction() since the last creation or update
+ *  are recalculated. The table is created if it has not been created yet.
+ */
+/*===========================================================================*/
+void PreIntegrationTable2D::update()
+{
+    const size_t resolution = m_tau.size();
+    if ( m_table.size() != resolution * resolution ) { this->create(); return; }
+    if ( m_dirty_begin >= m_dirty_end ) { return; }
+
+    this->compute_table( m_dirty_begin, m_dirty_end );
 
-    const size_t resolution = tau.size();
-    kvs::ValueArray<kvs::Real32> table( resolution * resolution );
-    for ( size_t i = 0, index = 0; i < resolution; i++ )
+    m_dirty_begin = 0;
+    m_dirty_end = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Calculates the table entries depending on the specified scalar range.
+ *  @param  begin [in] first index of the scalar range
+ *  @param  end [in] end index (exclusive) of the scalar range
+ *
+ *  Each entry is the average of tau between the front and back scalars, which
+ *  is given by the difference of the integral of tau, T, in constant time. An
+ *  entry (i,j) depends on the scalars in [min(i,j),max(i,j)], so that the
+ *  entries whose interval overlaps the given range are calculated.
+ */
+/*===========================================================================*/
+void PreIntegrationTable2D::compute_table( const size_t begin, const size_t end )
+{
+    const kvs::Real64* T = m_T.data();
+    const kvs::Real64* tau = m_tau.data();
+    kvs::Real32* table = m_table.data();
+
+    const size_t resolution = m_tau.size();
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long ii = 0; ii < long( resolution ); ii++ )
     {
-        for ( size_t j = 0; j < resolution; j++, index++ )
+        const size_t i = static_cast<size_t>( ii );
+
+        // Columns j such that [min(i,j),max(i,j)] overlaps [begin,end).
+        const size_t jmin = ( i < begin ) ? begin : 0;
+        const size_t jmax = ( i >= end ) ? end : resolution;
+
+        kvs::Real32* row = table + i * resolution;
+        for ( size_t j = jmin; j < jmax; j++ )
         {
             if ( i == j )
             {
-                table[index] = tau[i];
+                row[j] = tau[i];
             }
             else
             {
                 const double sf = j / static_cast<double>( resolution - 1 );
                 const double sb = i / static_cast<double>( resolution - 1 );
-                table[index] = ( T[i] - T[j] ) / ( sb - sf );
+                row[j] = ( T[i] - T[j] ) / ( sb - sf );
             }
         }
     }
-
-    m_table = table;
 }
 
 } // end of namespace kvs
@@ -32,6 +32,8 @@ private:
     kvs::ValueArray<kvs::Real64> m_tau; ///< extinction densities
     kvs::ValueArray<kvs::Real64> m_T; ///< integral of the tau
     kvs::ValueArray<kvs::Real32> m_table; ///< 2D pre-integration table
+    size_t m_dirty_begin = 0; ///< first index of the modified scalar range
+    size_t m_dirty_end = 0; ///< end index (exclusive) of the modified scalar range
 
 public:
 
@@ -44,6 +46,11 @@ public:
 
     void setTransferFunction( const kvs::TransferFunction& transfer_function );
     void create();
+    void update();
+
+private:
+
+    void compute_table( const size_t begin, const size_t end );
 };
 
 } // end of namespace kvs
@@ -12,8 +12,10 @@
 /*****************************************************************************/
 #include "PreIntegrationTable3D.h"
 #include <vector>
+#include <algorithm>
 #include <kvs/Math>
 #include <kvs/ValueArray>
+#include <kvs/OpenMP>
 
 
 namespace
@@ -201,7 +203,10 @@ namespace kvs
  *  @brief  Constructs a new PreIntegrationTable3D class.
  */
 /*===========================================================================*/
-PreIntegrationTable3D::PreIntegrationTable3D()
+PreIntegrationTable3D::PreIntegrationTable3D():
+    m_max_size_of_cell( 0.0f ),
+    m_dirty_begin( 0 ),
+    m_dirty_end( 0 )
 {
     this->setScalarResolution( 128 );
     this->setDepthResolution( 128 );
@@ -216,7 +221,10 @@ PreIntegrationTable3D::PreIntegrationTable3D()
 /*===========================================================================*/
 PreIntegrationTable3D::PreIntegrationTable3D( const size_t scalar_resolution, const size_t depth_resolution ):
     m_scalar_resolution( scalar_resolution ),
-    m_depth_resolution( depth_resolution )
+    m_depth_resolution( depth_resolution ),
+    m_max_size_of_cell( 0.0f ),
+    m_dirty_begin( 0 ),
+    m_dirty_end( 0 )
 {
 }
 
@@ -236,7 +244,35 @@ void PreIntegrationTable3D::setTransferFunction(
     const float S0 = min_scalar;
     const float S1 = max_scalar;
     const size_t N = m_scalar_resolution;
-    m_transfer_function = ::Serialize( transfer_function, S0, S1, N );
+    const kvs::ValueArray<kvs::Real32> serialized = ::Serialize( transfer_function, S0, S1, N );
+
+    // Widen the modified scalar range, in which the colors or opacities are changed.
+    if ( m_transfer_function.size() != serialized.size() )
+    {
+        m_dirty_begin = 0;
+        m_dirty_end = N;
+    }
+    else
+    {
+        const kvs::Real32* prev = m_transfer_function.data();
+        const kvs::Real32* curr = serialized.data();
+        size_t begin = 0;
+        size_t end = N;
+        while ( begin < end && std::equal( curr + 4 * begin, curr + 4 * begin + 4, prev + 4 * begin ) ) { begin++; }
+        while ( end > begin && std::equal( curr + 4 * end - 4, curr + 4 * end, prev + 4 * end - 4 ) ) { end--; }
+        if ( begin < end )
+        {
+            if ( m_dirty_begin < m_dirty_end )
+            {
+                begin = kvs::Math::Min( begin, m_dirty_begin );
+                end = kvs::Math::Max( end, m_dirty_end );
+            }
+            m_dirty_begin = begin;
+            m_dirty_end = end;
+        }
+    }
+
+    m_transfer_function = serialized;
 }
 
 /*===========================================================================*/
@@ -251,19 +287,54 @@ void PreIntegrationTable3D::create( const float max_size_of_cell )
     const size_t slice_size = 4 * m_scalar_resolution * m_scalar_resolution;
     m_table.allocate( slice_size * m_depth_resolution );
     m_table.fill( 0.0f );
+    m_max_size_of_cell = max_size_of_cell;
 
     const float dl = max_size_of_cell / float( m_depth_resolution - 1 );
-    kvs::Real32* slice0 = m_table.data();
-    this->compute_exact_level( slice0, dl );
+    this->compute_exact_level( m_table.data(), dl, 0, m_scalar_resolution );
+    this->compute_incremental_levels( dl );
 
-    float l = dl;
-    for ( size_t i = 1; i < m_depth_resolution; i++ )
+    m_dirty_begin = 0;
+    m_dirty_end = 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Updates pre-integration table for the modified transfer function.
+ *  @param  max_size_of_cell [in] maximum size of the cell
+ *
+ *  In the first slice, which is calculated by the numerical integration, only
+ *  the entries whose scalar interval overlaps the range of the transfer
+ *  function modified by setTransferFunction() since the last creation or
+ *  update are recalculated. The other slices are approximated from the first
+ *  slice in O(1) per entry and are recalculated entirely. The table is
+ *  created if the resolutions or the cell size are changed.
+ *
+ *  The cell size must match the one of the table exactly (not within a
+ *  tolerance) for the incremental update, since the kept entries of the first
+ *  slice were integrated with the slice thickness derived from it. With the
+ *  same cell size, each recalculated entry is computed by the same operations
+ *  as in create(), so the table is identical to the one created from scratch.
+ */
+/*===========================================================================*/
+void PreIntegrationTable3D::update( const float max_size_of_cell )
+{
+    const size_t slice_size = 4 * m_scalar_resolution * m_scalar_resolution;
+    const bool same_size = m_table.size() == slice_size * m_depth_resolution;
+    const bool same_cell = m_max_size_of_cell == max_size_of_cell; // exact match
+    if ( !same_size || !same_cell )
     {
-        l += dl;
-        kvs::Real32* slice = slice0 + i * slice_size;
-        const kvs::Real32* slicep = slice0 + ( i - 1 ) * slice_size;
-        this->compute_incremental_level( slice, slicep, slice0, l, dl );
+        this->create( max_size_of_cell );
+        return;
     }
+
+    if ( m_dirty_begin >= m_dirty_end ) { return; }
+
+    const float dl = max_size_of_cell / float( m_depth_resolution - 1 );
+    this->compute_exact_level( m_table.data(), dl, m_dirty_begin, m_dirty_end );
+    this->compute_incremental_levels( dl );
+
+    m_dirty_begin = 0;
+    m_dirty_end = 0;
 }
 
 /*===========================================================================*/
@@ -271,15 +342,29 @@ void PreIntegrationTable3D::create( const float max_size_of_cell )
  *  @brief  Computes 2D pre-integration table by numerical integration.
  *  @param  slice0 [in/out] pointer to the head of the first slice
  *  @param  dl [in] thickness of a slice
+ *  @param  begin [in] first index of the scalar range to be updated
+ *  @param  end [in] end index (exclusive) of the scalar range to be updated
+ *
+ *  An entry (sb,sf) depends only on the transfer function in [smin,smax],
+ *  where smin = min(sb,sf) and smax = max(sb,sf), so that the table is
+ *  symmetric. The entries whose interval overlaps [begin,end) are computed
+ *  for sf <= sb, and copied to the symmetric positions.
  */
 /*===========================================================================*/
-void PreIntegrationTable3D::compute_exact_level( float* slice0, const float dl )
+void PreIntegrationTable3D::compute_exact_level(
+    float* slice0,
+    const float dl,
+    const size_t begin,
+    const size_t end )
 {
     const size_t N = m_scalar_resolution;
     const kvs::ValueArray<kvs::Real32>& TF = m_transfer_function;
-    for ( size_t sb = 0, index = 0; sb < N; sb++ )
+    KVS_OMP_PARALLEL_FOR( schedule(dynamic) )
+    for ( long b = long( begin ); b < long( N ); b++ )
     {
-        for ( size_t sf = 0; sf < N; sf++, index++ )
+        const size_t sb = static_cast<size_t>( b );
+        const size_t sf_end = kvs::Math::Min( sb + 1, end );
+        for ( size_t sf = 0; sf < sf_end; sf++ )
         {
             kvs::Vec4 c( 0.0f, 0.0f, 0.0f, 0.0f );
 
@@ -290,8 +375,8 @@ void PreIntegrationTable3D::compute_exact_level( float* slice0, const float dl )
             }
             else
             {
-                const size_t smin = kvs::Math::Min( sb, sf );
-                const size_t smax = kvs::Math::Max( sb, sf );
+                const size_t smin = sf;
+                const size_t smax = sb;
 
                 const size_t M = 32; // supersampling factor
                 const float dw = 1.0f / static_cast<float>( M - 1 );
@@ -312,14 +397,38 @@ void PreIntegrationTable3D::compute_exact_level( float* slice0, const float dl )
                 }
             }
 
-            slice0[ 4 * index + 0 ] = c[0];
-            slice0[ 4 * index + 1 ] = c[1];
-            slice0[ 4 * index + 2 ] = c[2];
-            slice0[ 4 * index + 3 ] = c[3];
+            const size_t index0 = sb * N + sf;
+            const size_t index1 = sf * N + sb;
+            for ( int e = 0; e < 4; e++ )
+            {
+                slice0[ 4 * index0 + e ] = c[e];
+                slice0[ 4 * index1 + e ] = c[e];
+            }
         }
     }
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Computes approximate levels from the first slice.
+ *  @param  dl [in] thickness of a slice
+ */
+/*===========================================================================*/
+void PreIntegrationTable3D::compute_incremental_levels( const float dl )
+{
+    const size_t slice_size = 4 * m_scalar_resolution * m_scalar_resolution;
+    kvs::Real32* slice0 = m_table.data();
+
+    float l = dl;
+    for ( size_t i = 1; i < m_depth_resolution; i++ )
+    {
+        l += dl;
+        kvs::Real32* slice = slice0 + i * slice_size;
+        const kvs::Real32* slicep = slice0 + ( i - 1 ) * slice_size;
+        this->compute_incremental_level( slice, slicep, slice0, l, dl );
+    }
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Computes approximate level using previous levels.
@@ -338,9 +447,11 @@ void PreIntegrationTable3D::compute_incremental_level(
     const float dl )
 {
     const size_t N = m_scalar_resolution;
-    for ( size_t i = 0, index = 0; i < N; i++ )
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long ii = 0; ii < long( N ); ii++ )
     {
-        for ( size_t j = 0; j < N; j++, index++ )
+        const size_t i = static_cast<size_t>( ii );
+        for ( size_t j = 0, index = i * N; j < N; j++, index++ )
         {
             const float sf = ( 2.0f * j + 1.0f ) / ( 2.0f * N );
             const float sb = ( 2.0f * i + 1.0f ) / ( 2.0f * N );
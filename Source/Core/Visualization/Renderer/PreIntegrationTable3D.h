@@ -34,6 +34,9 @@ private:
     kvs::ValueArray<kvs::Real32> m_table; ///< 3D pre-integration table
     size_t m_scalar_resolution; ///< resolution of the scalar axis
     size_t m_depth_resolution; ///< resolution of the depth axis
+    float m_max_size_of_cell; ///< maximum size of the cell used for the table
+    size_t m_dirty_begin; ///< first index of the modified scalar range
+    size_t m_dirty_end; ///< end index (exclusive) of the modified scalar range
 
 public:
 
@@ -50,10 +53,12 @@ public:
     void setTransferFunction( const kvs::TransferFunction& transfer_function, const float min_scalar, const float max_scalar );
 
     void create( const float max_size_of_cell );
+    void update( const float max_size_of_cell );
 
 private:
 
-    void compute_exact_level( float* slice0, const float dl );
+    void compute_exact_level( float* slice0, const float dl, const size_t begin, const size_t end );
+    void compute_incremental_levels( const float dl );
     void compute_incremental_level( float* slice, const float* slicep, const float* slice0, const float l, const float dl );
 };
 
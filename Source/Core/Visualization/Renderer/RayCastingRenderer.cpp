@@ -6,6 +6,7 @@
 /****************************************************************************/
 #include "RayCastingRenderer.h"
 #include <cstring>
+#include <cmath>
 #include <kvs/Math>
 #include <kvs/Type>
 #include <kvs/Message>
@@ -15,6 +16,66 @@
 #include <kvs/OpenGL>
 
 
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the diagonal length of the bounding box projected onto the screen.
+ *  @param  volume [in] pointer to the volume object
+ *  @param  modelview [in] modelview matrix
+ *  @param  projection [in] projection matrix
+ *  @param  viewport [in] viewport
+ *  @return diagonal length in pixels
+ */
+/*===========================================================================*/
+float ProjectedDiagonal(
+    const kvs::StructuredVolumeObject* volume,
+    const float modelview[16],
+    const float projection[16],
+    const int viewport[4] )
+{
+    float pm[16];
+    for ( int c = 0; c < 4; c++ )
+    {
+        for ( int r = 0; r < 4; r++ )
+        {
+            pm[ c * 4 + r ] = 0.0f;
+            for ( int k = 0; k < 4; k++ ) { pm[ c * 4 + r ] += projection[ k * 4 + r ] * modelview[ c * 4 + k ]; }
+        }
+    }
+
+    const kvs::Vec3& min_coord = volume->minExternalCoord();
+    const kvs::Vec3& max_coord = volume->maxExternalCoord();
+    kvs::Vec2 min_window( kvs::Value<float>::Max(), kvs::Value<float>::Max() );
+    kvs::Vec2 max_window( kvs::Value<float>::Min(), kvs::Value<float>::Min() );
+    for ( int i = 0; i < 8; i++ )
+    {
+        const float x = ( i & 1 ) ? max_coord.x() : min_coord.x();
+        const float y = ( i & 2 ) ? max_coord.y() : min_coord.y();
+        const float z = ( i & 4 ) ? max_coord.z() : min_coord.z();
+        float clip[4];
+        for ( int r = 0; r < 4; r++ )
+        {
+            clip[r] = pm[ r ] * x + pm[ 4 + r ] * y + pm[ 8 + r ] * z + pm[ 12 + r ];
+        }
+        if ( clip[3] <= 0.0f ) { continue; }
+
+        const kvs::Vec2 window(
+            viewport[0] + ( clip[0] / clip[3] + 1.0f ) * 0.5f * viewport[2],
+            viewport[1] + ( clip[1] / clip[3] + 1.0f ) * 0.5f * viewport[3] );
+        min_window.x() = kvs::Math::Min( min_window.x(), window.x() );
+        min_window.y() = kvs::Math::Min( min_window.y(), window.y() );
+        max_window.x() = kvs::Math::Max( max_window.x(), window.x() );
+        max_window.y() = kvs::Math::Max( max_window.y(), window.y() );
+    }
+
+    return min_window.x() < max_window.x() ? ( max_window - min_window ).length() : 0.0f;
+}
+
+} // end of namespace
+
+
 namespace kvs
 {
 
@@ -169,22 +230,50 @@ void RayCastingRenderer::rasterize(
         memcpy( m_modelview, modelview, sizeof( modelview ) );
     }
 
-    // Set the trilinear interpolator.
-    kvs::TrilinearInterpolator interpolator( volume );
-
     // Calculate the ray in the object coordinate system.
     float modelview[16]; kvs::OpenGL::GetModelViewMatrix( static_cast<GLfloat*>( modelview ) );
     float projection[16]; kvs::OpenGL::GetProjectionMatrix( static_cast<GLfloat*>( projection ) );
     int viewport[4]; kvs::OpenGL::GetViewport( static_cast<GLint*>( viewport ) );
     kvs::VolumeRayIntersector ray( volume, modelview, projection, viewport );
 
+    // Select the resolution level from the screen-space footprint of the ray
+    // during the LOD interaction, if the volume has the coarse levels.
+    size_t level = 0;
+    if ( ray_width > 1 && volume->numberOfLevels() > 1 )
+    {
+        const float diagonal = ::ProjectedDiagonal( volume, modelview, projection, viewport );
+        if ( diagonal > 0.0f )
+        {
+            const kvs::Vec3 ncells( kvs::Vec3( volume->resolution() ) - kvs::Vec3::Constant( 1.0f ) );
+            const float footprint = ray_width * ncells.length() / diagonal;
+            level = volume->levelForFootprint( footprint );
+        }
+    }
+
+    // Set the trilinear interpolator.
+    kvs::StructuredVolumeObject level_volume;
+    if ( level > 0 ) { volume->shallowCopyLevel( level, &level_volume ); }
+    kvs::TrilinearInterpolator interpolator( level > 0 ? &level_volume : volume );
+
+    // Scale from the index coordinates of the finest level to those of the
+    // selected level. The sampling step is enlarged in proportion to the cell
+    // size, and the opacity is corrected for the enlarged step.
+    kvs::Vec3 level_scale( 1.0f, 1.0f, 1.0f );
+    float level_ratio = 1.0f;
+    for ( int i = 0; level > 0 && i < 3; i++ )
+    {
+        const float n0 = static_cast<float>( volume->resolution()[i] ) - 1.0f;
+        const float n = static_cast<float>( level_volume.resolution()[i] ) - 1.0f;
+        if ( n0 > 0.0f ) { level_scale[i] = n / n0; level_ratio = kvs::Math::Max( level_ratio, n0 / n ); }
+    }
+
     // Execute ray casting.
     const size_t width = BaseClass::framebufferWidth();
     const size_t height = BaseClass::framebufferHeight();
     const auto& shader = BaseClass::shader();
     const auto& cmap = BaseClass::transferFunction().colorMap();
     const auto& omap = BaseClass::transferFunction().opacityMap();
-    const float step = m_step;
+    const float step = m_step * level_ratio;
     const float opaque = m_opaque;
     size_t depth_index = 0;
     size_t pixel_index = 0;
@@ -209,11 +298,13 @@ void RayCastingRenderer::rasterize(
                 do
                 {
                     // Interpolation.
-                    interpolator.attachPoint( ray.point() );
+                    interpolator.attachPoint( level > 0 ? ray.point() * level_scale : ray.point() );
 
                     // Classification.
                     const float s = interpolator.template scalar<T>();
-                    const float opacity = omap.at(s);
+                    const float opacity = level > 0 ?
+                        1.0f - std::pow( 1.0f - omap.at(s), level_ratio ) :
+                        omap.at(s);
                     if ( !kvs::Math::IsZero( opacity ) )
                     {
                         // Shading.
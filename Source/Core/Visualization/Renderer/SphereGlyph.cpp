@@ -159,13 +159,13 @@ void SphereGlyph::attach_point( const kvs::PointObject* point )
 
     const size_t nvertices = point->numberOfVertices();
 
-    BaseClass::setCoords( point->coords() );
+    BaseClass::setCoords( point->decompressedCoords() );
 
     if ( BaseClass::directionMode() == BaseClass::DirectionByNormal )
     {
         if ( point->numberOfNormals() != 0 )
         {
-            BaseClass::setDirections( point->normals() );
+            BaseClass::setDirections( point->decompressedNormals() );
         }
     }
 
@@ -195,7 +195,7 @@ void SphereGlyph::attach_point( const kvs::PointObject* point )
     }
     else
     {
-        BaseClass::setColors( point->colors() );
+        BaseClass::setColors( point->decompressedColors() );
     }
 
     const kvs::UInt8 opacity = static_cast<kvs::UInt8>( 255 );
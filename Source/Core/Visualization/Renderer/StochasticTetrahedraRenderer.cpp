@@ -24,6 +24,8 @@
 #include <kvs/TetrahedralCell>
 #include <kvs/ProjectedTetrahedraTable>
 #include <kvs/PreIntegrationTable2D>
+#include <kvs/OpenMP>
+#include <vector>
 
 
 namespace
@@ -42,6 +44,21 @@ int RandomNumber()
     return C * R.randInteger();
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Returns a hashed value of the given integer value.
+ *  @param  x [in] integer value
+ *  @return hashed value
+ */
+/*===========================================================================*/
+inline kvs::UInt32 Hash( kvs::UInt32 x )
+{
+    x ^= x >> 16; x *= 0x7feb352dU;
+    x ^= x >> 15; x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
 /*===========================================================================*/
 /**
  *  @brief  Returns random index array.
@@ -53,11 +70,15 @@ kvs::ValueArray<kvs::UInt16> RandomIndices(
     const kvs::UnstructuredVolumeObject* volume,
     const size_t size )
 {
+    // The random number for each node is given by hashing the node index,
+    // so that the indices can be generated in parallel with the same result.
+    const int C = 12347;
     const size_t nnodes = volume->numberOfNodes();
     kvs::ValueArray<kvs::UInt16> indices( nnodes * 2 );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
     for ( size_t i = 0; i < nnodes; i++ )
     {
-        const unsigned int count = i * RandomNumber();
+        const unsigned int count = i * ( C * ::Hash( static_cast<kvs::UInt32>( i ) ) );
         indices[ 2 * i + 0 ] = static_cast<kvs::UInt16>( ( count ) % size );
         indices[ 2 * i + 1 ] = static_cast<kvs::UInt16>( ( count / size ) % size );
     }
@@ -83,6 +104,7 @@ kvs::ValueArray<kvs::Real32> NormalizedValuesForType(
     const T* src = static_cast<const T*>( volume->values().data() );
     const size_t nvalues = volume->values().size();
     kvs::ValueArray<kvs::Real32> dst( nvalues );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
     for ( size_t i = 0; i < nvalues; i++ )
     {
         dst[i] = static_cast<kvs::Real32>( ( src[i] - min_value ) * normalized_factor );
@@ -122,47 +144,39 @@ kvs::ValueArray<kvs::Real32> VertexNormalsForType(
 {
     const size_t nnodes = volume->numberOfNodes();
     const size_t ncells = volume->numberOfCells();
-    kvs::TetrahedralCell cell( volume );
-    kvs::ValueArray<kvs::Int32> counter( nnodes );
-    kvs::ValueArray<kvs::Real32> normals( nnodes * 3 );
-    counter.fill(0);
-    normals.fill(0);
-    for ( size_t i = 0; i < ncells; i++ )
+
+    // The adjacency is not built if the connections have invalid node IDs.
+    volume->updateNodeToCellAdjacency();
+    if ( !volume->hasNodeToCellAdjacency() ) { return kvs::ValueArray<kvs::Real32>(); }
+
+    // Gradient vectors of the cells.
+    std::vector<kvs::Vec3> gradients( ncells );
+    KVS_OMP_PARALLEL()
     {
-        cell.bindCell( i );
-        const kvs::Vec3 g = -cell.gradientVector();
-        const kvs::UInt32 index0 = volume->connections()[ 4 * i + 0 ];
-        const kvs::UInt32 index1 = volume->connections()[ 4 * i + 1 ];
-        const kvs::UInt32 index2 = volume->connections()[ 4 * i + 2 ];
-        const kvs::UInt32 index3 = volume->connections()[ 4 * i + 3 ];
-
-        counter[ index0 ]++;
-        counter[ index1 ]++;
-        counter[ index2 ]++;
-        counter[ index3 ]++;
-
-        normals[ 3 * index0 + 0 ] += g.x();
-        normals[ 3 * index0 + 1 ] += g.y();
-        normals[ 3 * index0 + 2 ] += g.z();
-
-        normals[ 3 * index1 + 0 ] += g.x();
-        normals[ 3 * index1 + 1 ] += g.y();
-        normals[ 3 * index1 + 2 ] += g.z();
-
-        normals[ 3 * index2 + 0 ] += g.x();
-        normals[ 3 * index2 + 1 ] += g.y();
-        normals[ 3 * index2 + 2 ] += g.z();
-
-        normals[ 3 * index3 + 0 ] += g.x();
-        normals[ 3 * index3 + 1 ] += g.y();
-        normals[ 3 * index3 + 2 ] += g.z();
+        kvs::TetrahedralCell cell( volume );
+        KVS_OMP_FOR( schedule(static) )
+        for ( long i = 0; i < long( ncells ); i++ )
+        {
+            cell.bindCell( kvs::UInt32( i ) );
+            gradients[i] = -cell.gradientVector();
+        }
     }
 
-    for ( size_t i = 0; i < nnodes; i++ )
+    // The gradient vectors of the cells sharing each node are averaged by
+    // using the node-to-cell adjacency, so that there are no write conflicts.
+    const kvs::UInt32* offsets = volume->nodeToCellOffsets().data();
+    const kvs::UInt32* indices = volume->nodeToCellIndices().data();
+
+    kvs::ValueArray<kvs::Real32> normals( nnodes * 3 );
+    KVS_OMP_PARALLEL_FOR( schedule(static) )
+    for ( long i = 0; i < long( nnodes ); i++ )
     {
-        const kvs::Real32 c = static_cast<kvs::Real32>( counter[i] );
-        const kvs::Vec3 v( normals.data() + 3 * i );
-        const kvs::Vec3 n = ( v / c ).normalized();
+        const kvs::UInt32 first = offsets[i];
+        const kvs::UInt32 last = offsets[ i + 1 ];
+        kvs::Vec3 v( 0.0f, 0.0f, 0.0f );
+        for ( kvs::UInt32 j = first; j < last; j++ ) { v += gradients[ indices[j] ]; }
+
+        const kvs::Vec3 n = ( v / static_cast<kvs::Real32>( last - first ) ).normalized();
         normals[ 3 * i + 0 ] = n.x();
         normals[ 3 * i + 1 ] = n.y();
         normals[ 3 * i + 2 ] = n.z();
@@ -304,12 +318,13 @@ int StochasticTetrahedraRenderer::Engine::PreIntegrationBuffer::inverseTextureSi
 void StochasticTetrahedraRenderer::Engine::PreIntegrationBuffer::create(
     const kvs::TransferFunction& tfunc )
 {
-    kvs::PreIntegrationTable2D table;
-    table.setTransferFunction( tfunc );
-    table.create();
+    // The table is kept for updating only the entries affected by the
+    // modified range of the transfer function.
+    m_table.setTransferFunction( tfunc );
+    m_table.update();
 
-    auto T = table.T();
-    auto T_inv = table.inverseT( this->inverseTextureSize() );
+    auto T = m_table.T();
+    auto T_inv = m_table.inverseT( this->inverseTextureSize() );
     const auto resolution = T.size();
 
     m_T_max = T.back();
@@ -331,7 +346,7 @@ void StochasticTetrahedraRenderer::Engine::PreIntegrationBuffer::create(
     m_texture.setMagFilter( GL_LINEAR );
     m_texture.setMinFilter( GL_LINEAR );
     m_texture.setPixelFormat( GL_R32F, GL_RED, GL_FLOAT );
-    m_texture.create( resolution, resolution, table.table().data() );
+    m_texture.create( resolution, resolution, m_table.table().data() );
 }
 
 void StochasticTetrahedraRenderer::Engine::PreIntegrationBuffer::update(
@@ -386,18 +401,49 @@ void StochasticTetrahedraRenderer::Engine::BufferObject::create(
         return;
     }
 
-    const auto indices = ::RandomIndices( volume, m_engine->randomTextureSize() );
-    const auto values = ::NormalizedValues( volume );
+    // The vertex attributes are cached on the volume.
+    if ( !this->is_cached( volume ) ) { this->update_cache( volume ); }
+
+    const auto& cache = volume->vertexAttributeCache();
     const auto coords = volume->coords();
-    const auto normals = ::VertexNormals( volume );
-    m_manager.setVertexAttribArray( indices, shader_program.attributeLocation("random_index"), 2 );
-    m_manager.setVertexAttribArray( values, shader_program.attributeLocation("value"), 1 );
+    m_manager.setVertexAttribArray( cache.random_indices, shader_program.attributeLocation("random_index"), 2 );
+    m_manager.setVertexAttribArray( cache.normalized_values, shader_program.attributeLocation("value"), 1 );
     m_manager.setVertexArray( coords, 3 );
-    m_manager.setNormalArray( normals );
+    m_manager.setNormalArray( cache.normals );
     m_manager.setIndexArray( volume->connections() );
     m_manager.create();
 }
 
+bool StochasticTetrahedraRenderer::Engine::BufferObject::is_cached(
+    const kvs::UnstructuredVolumeObject* volume ) const
+{
+    // The cache holds the source arrays, so the addresses are not reused.
+    const auto& cache = volume->vertexAttributeCache();
+    return
+        !cache.normals.empty() &&
+        cache.values.data() == volume->values().data() &&
+        cache.coords.data() == volume->coords().data() &&
+        cache.connections.data() == volume->connections().data() &&
+        cache.min_value == volume->minValue() &&
+        cache.max_value == volume->maxValue() &&
+        cache.random_texture_size == m_engine->randomTextureSize();
+}
+
+void StochasticTetrahedraRenderer::Engine::BufferObject::update_cache(
+    const kvs::UnstructuredVolumeObject* volume ) const
+{
+    auto& cache = volume->vertexAttributeCache();
+    cache.random_indices = ::RandomIndices( volume, m_engine->randomTextureSize() );
+    cache.normalized_values = ::NormalizedValues( volume );
+    cache.normals = ::VertexNormals( volume );
+    cache.values = volume->values();
+    cache.coords = volume->coords();
+    cache.connections = volume->connections();
+    cache.min_value = volume->minValue();
+    cache.max_value = volume->maxValue();
+    cache.random_texture_size = m_engine->randomTextureSize();
+}
+
 void StochasticTetrahedraRenderer::Engine::BufferObject::draw(
     const kvs::UnstructuredVolumeObject* volume )
 {
@@ -13,9 +13,11 @@
 /*****************************************************************************/
 #pragma once
 #include <kvs/Module>
+#include <kvs/ValueArray>
 #include <kvs/TransferFunction>
 #include <kvs/Texture1D>
 #include <kvs/Texture2D>
+#include <kvs/PreIntegrationTable2D>
 #include <kvs/ProgramObject>
 #include <kvs/VertexBufferObjectManager>
 #include <kvs/StochasticRenderingEngine>
@@ -81,6 +83,7 @@ public:
         kvs::Texture1D m_T_texture{}; ///< T function for pre-integration
         kvs::Texture1D m_T_inv_texture{}; ///< inverse function of T for pre-integration
         kvs::Real32 m_T_max = 0.0f; ///< maximum value of T
+        kvs::PreIntegrationTable2D m_table{}; ///< pre-integration table
     public:
         PreIntegrationBuffer() = default;
         virtual ~PreIntegrationBuffer() { this->release(); }
@@ -118,6 +121,9 @@ public:
             const kvs::UnstructuredVolumeObject* volume,
             const kvs::ProgramObject& shader_program );
         void draw( const kvs::UnstructuredVolumeObject* volume );
+    private:
+        bool is_cached( const kvs::UnstructuredVolumeObject* volume ) const;
+        void update_cache( const kvs::UnstructuredVolumeObject* volume ) const;
     };
 
     class RenderPass
@@ -19,6 +19,7 @@
 #include <kvs/VisualizationPipeline>
 #include <kvs/Coordinate>
 #include <kvs/UIColor>
+#include <kvs/Profiler>
 
 
 namespace
@@ -703,6 +704,8 @@ void Scene::initializeFunction()
 /*==========================================================================*/
 void Scene::paintFunction()
 {
+    KVS_PROFILER_ZONE( "scene", "kvs::Scene::paintFunction" );
+
     this->updateGLProjectionMatrix();
     this->updateGLViewingMatrix();
     this->updateGLLightParameters();
@@ -723,6 +726,7 @@ void Scene::paintFunction()
             {
                 kvs::OpenGL::PushMatrix();
                 this->updateGLModelingMatrix( object );
+                KVS_PROFILER_ZONE( "renderer", renderer->moduleName() );
                 renderer->exec( object, m_camera, m_light );
                 kvs::OpenGL::PopMatrix();
             }
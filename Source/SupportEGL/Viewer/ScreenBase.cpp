@@ -28,10 +28,16 @@ ScreenBase::ScreenBase():
         kvsMessageError( "Cannot create EGL display connection." );
         return;
     }
+
+    // Frames are read bottom-up and written top-down.
+    m_readback.enableFlip();
 }
 
 ScreenBase::~ScreenBase()
 {
+    if ( m_context.isValid() ) { this->waitForCaptures(); }
+    m_readback.release();
+
     m_display.terminate();
     m_context.destroy();
     m_surface.destroy();
@@ -59,6 +65,62 @@ kvs::ValueArray<kvs::Real32> ScreenBase::readbackDepthBuffer( GLenum mode ) cons
     return buffer;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Sets the number of pixel pack buffers used by captureAsync.
+ *  @param  nbuffers [in] number of buffers (1: synchronous, 2: double, 3: triple)
+ */
+/*===========================================================================*/
+void ScreenBase::setNumberOfReadbackBuffers( const size_t nbuffers )
+{
+    this->waitForCaptures();
+    m_readback.setNumberOfBuffers( nbuffers );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Queues the current frame to be written in the background.
+ *  @param  filename [in] output filename (PNG, BMP, PPM, etc.)
+ *
+ *  The frame is read into a pixel pack buffer without waiting for the GPU,
+ *  and the frame read some frames before is mapped, flipped while copying
+ *  and queued to the worker threads, which encode it while the next frame
+ *  is rendered. The remaining frames are written by waitForCaptures().
+ */
+/*===========================================================================*/
+void ScreenBase::captureAsync( const std::string& filename )
+{
+    kvs::OpenGL::SetReadBuffer( GL_FRONT );
+
+    kvs::ValueArray<kvs::UInt8> pixels;
+    m_capture_filenames.push_back( filename );
+    if ( m_readback.read( BaseClass::width(), BaseClass::height(), &pixels ) )
+    {
+        m_writer.write( m_readback.width(), m_readback.height(), pixels, m_capture_filenames.front() );
+    }
+
+    while ( m_capture_filenames.size() > m_readback.numberOfPendingFrames() ) { m_capture_filenames.pop_front(); }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads back the pending frames and waits until all are written.
+ */
+/*===========================================================================*/
+void ScreenBase::waitForCaptures()
+{
+    kvs::ValueArray<kvs::UInt8> pixels;
+    while ( !m_capture_filenames.empty() )
+    {
+        if ( m_readback.flush( &pixels ) )
+        {
+            m_writer.write( m_readback.width(), m_readback.height(), pixels, m_capture_filenames.front() );
+        }
+        m_capture_filenames.pop_front();
+    }
+    m_writer.wait();
+}
+
 void ScreenBase::displayInfo()
 {
   /*
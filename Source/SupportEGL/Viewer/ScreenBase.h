@@ -14,6 +14,10 @@
 #include <kvs/ValueArray>
 #include <kvs/ColorImage>
 #include <kvs/OpenGL>
+#include <kvs/FrameReadbackBuffer>
+#include <kvs/AsyncImageWriter>
+#include <string>
+#include <deque>
 
 
 namespace kvs
@@ -31,6 +35,9 @@ private:
     kvs::egl::Context m_context; ///< EGL rendering context
     kvs::egl::Config m_config; ///< EGL configulation
     kvs::egl::Surface m_surface; ///< EGL drawing surface
+    kvs::FrameReadbackBuffer m_readback; ///< multi-buffered frame readback
+    kvs::AsyncImageWriter m_writer; ///< background image writer
+    std::deque<std::string> m_capture_filenames; ///< filenames of the frames being read back
 
 public:
     ScreenBase();
@@ -38,6 +45,9 @@ public:
 
     kvs::ValueArray<kvs::UInt8> readbackColorBuffer( GLenum mode = GL_FRONT ) const;
     kvs::ValueArray<kvs::Real32> readbackDepthBuffer( GLenum mode = GL_FRONT ) const;
+    void setNumberOfReadbackBuffers( const size_t nbuffers );
+    void captureAsync( const std::string& filename );
+    void waitForCaptures();
     void displayInfo();
 
     virtual void create();
@@ -8,7 +8,9 @@
 #include <kvs/ColorImage>
 #include <kvs/OpenGL>
 #include <cstdio>
+#include <cstring>
 #include <cfenv>
+#include <vector>
 
 
 namespace
@@ -40,18 +42,17 @@ inline void Flip( T* data, const size_t width, const size_t height, const size_t
     if ( y_flip )
     {
         const size_t stride = width * ncomps;
+        const size_t bytes = stride * sizeof( T );
 
-        T* pdata = data;
+        std::vector<T> row( stride );
         const size_t end_line = height / 2;
         for ( size_t i = 0; i < end_line; i++ )
         {
-            T* src = pdata + ( i * stride );
-            T* dst = pdata + ( ( height - i - 1 ) * stride );
-            for ( size_t j = 0; j < stride; j++ )
-            {
-                std::swap( *src, *dst );
-                src++; dst++;
-            }
+            T* top = data + ( i * stride );
+            T* bottom = data + ( ( height - i - 1 ) * stride );
+            std::memcpy( row.data(), top, bytes );
+            std::memcpy( top, bottom, bytes );
+            std::memcpy( bottom, row.data(), bytes );
         }
     }
 }
@@ -93,6 +94,26 @@ kvs::ValueArray<kvs::Real32> ScreenBase::readbackDepthBuffer( GLenum mode ) cons
     return buffer;
 }
 
+/*===========================================================================*/
+/**
+ *  @brief  Queues the current frame to be written in the background.
+ *  @param  filename [in] output filename (PNG, BMP, PPM, etc.)
+ *
+ *  The OSMesa color buffer is the client memory of the drawing surface with
+ *  the Y axis downward, so the frame is copied as it is without a readback,
+ *  and the RGBA to RGB conversion and the encoding are done on the worker
+ *  threads while the next frame is rendered.
+ */
+/*===========================================================================*/
+void ScreenBase::captureAsync( const std::string& filename )
+{
+    kvs::OpenGL::Finish();
+
+    const size_t width = BaseClass::width();
+    const size_t height = BaseClass::height();
+    m_writer.write( width, height, m_surface.buffer().clone(), filename );
+}
+
 void ScreenBase::create()
 {
     // Create OSMesa context
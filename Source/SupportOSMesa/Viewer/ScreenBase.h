@@ -11,6 +11,8 @@
 #include <kvs/ScreenBase>
 #include <kvs/ValueArray>
 #include <kvs/ColorImage>
+#include <kvs/AsyncImageWriter>
+#include <string>
 
 
 namespace kvs
@@ -27,6 +29,7 @@ public:
 private:
     kvs::osmesa::Context m_context{}; ///< OSMesa rendering context
     kvs::osmesa::Surface m_surface{}; ///< OSMesa drawing surface
+    kvs::AsyncImageWriter m_writer{}; ///< background image writer
 
 public:
     ScreenBase() = default;
@@ -35,6 +38,8 @@ public:
     const kvs::ValueArray<kvs::UInt8>& buffer() const { return m_surface.buffer(); }
     kvs::ValueArray<kvs::UInt8> readbackColorBuffer( GLenum mode = GL_FRONT ) const;
     kvs::ValueArray<kvs::Real32> readbackDepthBuffer( GLenum mode = GL_FRONT ) const;
+    void captureAsync( const std::string& filename );
+    void waitForCaptures() { m_writer.wait(); }
 
     virtual void create();
     virtual void show();
@@ -0,0 +1,109 @@
+/*****************************************************************************/
+/**
+ *  @file   Argument.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Argument.h"
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Argument class.
+ *  @param  argc [in] argument count
+ *  @param  argv [in] argument values
+ */
+/*===========================================================================*/
+Argument::Argument( int argc, char** argv ):
+    kvs::CommandLine( argc, argv, kvsbench::CommandName )
+{
+    addHelpOption();
+    addOption( "r", "Resolution of the structured volumes. (default: 64)", 1, false );
+    addOption( "u", "Number of nodes along each axis of the random tetrahedral mesh. (default: 32)", 1, false );
+    addOption( "s", "Number of streamline seeds along each axis. (default: 8)", 1, false );
+    addOption( "seed", "Random seed of the tetrahedral mesh. (default: 1)", 1, false );
+    addOption( "screen_size", "Screen width and height for the renderers. (default: 512)", 1, false );
+    addOption( "n", "Number of measured iterations. (default: 10)", 1, false );
+    addOption( "w", "Number of warm-up iterations. (default: 1)", 1, false );
+    addOption( "t", "Number of OpenMP threads. (default: OpenMP default)", 1, false );
+    addOption( "filter", "Run the benchmarks whose names contain the string. (optional)", 1, false );
+    addOption( "list", "Output the benchmark names. (optional)", 0, false );
+    addOption( "output", "Output JSON filename. (default: standard output)", 1, false );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the suite parameters.
+ *  @return suite parameters
+ */
+/*===========================================================================*/
+Suite::Parameters Argument::parameters() const
+{
+    Suite::Parameters p;
+    if ( this->hasOption("r") ) { p.resolution = this->optionValue<size_t>("r"); }
+    if ( this->hasOption("u") ) { p.unstructured_resolution = this->optionValue<size_t>("u"); }
+    if ( this->hasOption("s") ) { p.seed_resolution = this->optionValue<size_t>("s"); }
+    if ( this->hasOption("seed") ) { p.seed = this->optionValue<unsigned long>("seed"); }
+    if ( this->hasOption("screen_size") ) { p.screen_size = this->optionValue<size_t>("screen_size"); }
+    return p;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of warm-up iterations.
+ *  @return number of warm-up iterations
+ */
+/*===========================================================================*/
+size_t Argument::numberOfWarmups() const
+{
+    return this->hasOption("w") ? this->optionValue<size_t>("w") : 1;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of measured iterations.
+ *  @return number of measured iterations
+ */
+/*===========================================================================*/
+size_t Argument::numberOfIterations() const
+{
+    return this->hasOption("n") ? this->optionValue<size_t>("n") : 10;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of OpenMP threads.
+ *  @return number of threads (0: OpenMP default)
+ */
+/*===========================================================================*/
+int Argument::numberOfThreads() const
+{
+    return this->hasOption("t") ? this->optionValue<int>("t") : 0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the filter string of the benchmark names.
+ *  @return filter string (empty: all the benchmarks)
+ */
+/*===========================================================================*/
+std::string Argument::filter() const
+{
+    return this->hasOption("filter") ? this->optionValue<std::string>("filter") : "";
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the output JSON filename.
+ *  @return output filename (empty: standard output)
+ */
+/*===========================================================================*/
+std::string Argument::output() const
+{
+    return this->hasOption("output") ? this->optionValue<std::string>("output") : "";
+}
+
+} // end of namespace kvsbench
@@ -0,0 +1,36 @@
+/*****************************************************************************/
+/**
+ *  @file   Argument.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <kvs/CommandLine>
+#include "Suite.h"
+
+
+namespace kvsbench
+{
+
+const std::string CommandName("kvsbench");
+
+/*===========================================================================*/
+/**
+ *  @brief  Argument class.
+ */
+/*===========================================================================*/
+class Argument : public kvs::CommandLine
+{
+public:
+    Argument( int argc, char** argv );
+
+    Suite::Parameters parameters() const;
+    size_t numberOfWarmups() const;
+    size_t numberOfIterations() const;
+    int numberOfThreads() const;
+    std::string filter() const;
+    std::string output() const;
+};
+
+} // end of namespace kvsbench
@@ -0,0 +1,177 @@
+/*****************************************************************************/
+/**
+ *  @file   Benchmark.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Benchmark.h"
+#include <kvs/Timer>
+#include <kvs/SystemInformation>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <cmath>
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Result class.
+ *  @param  name [in] benchmark name
+ *  @param  unit [in] unit of the processed items
+ *  @param  nitems [in] number of items processed in an iteration
+ *  @param  times [in] elapsed times in msec
+ *  @param  peak_memory [in] peak resident memory size in bytes
+ */
+/*===========================================================================*/
+Benchmark::Result::Result(
+    const std::string& name,
+    const std::string& unit,
+    const size_t nitems,
+    const std::vector<double>& times,
+    const size_t peak_memory ):
+    m_name( name ),
+    m_unit( unit ),
+    m_nitems( nitems ),
+    m_times( times ),
+    m_peak_memory( peak_memory )
+{
+    std::sort( m_times.begin(), m_times.end() );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the minimum elapsed time.
+ *  @return minimum time in msec
+ */
+/*===========================================================================*/
+double Benchmark::Result::min() const
+{
+    return m_times.empty() ? 0.0 : m_times.front();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the maximum elapsed time.
+ *  @return maximum time in msec
+ */
+/*===========================================================================*/
+double Benchmark::Result::max() const
+{
+    return m_times.empty() ? 0.0 : m_times.back();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the mean elapsed time.
+ *  @return mean time in msec
+ */
+/*===========================================================================*/
+double Benchmark::Result::mean() const
+{
+    if ( m_times.empty() ) { return 0.0; }
+    return std::accumulate( m_times.begin(), m_times.end(), 0.0 ) / m_times.size();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the standard deviation of the elapsed times.
+ *  @return standard deviation in msec
+ */
+/*===========================================================================*/
+double Benchmark::Result::stddev() const
+{
+    if ( m_times.size() < 2 ) { return 0.0; }
+    const double m = this->mean();
+    double sum = 0.0;
+    for ( const auto t : m_times ) { sum += ( t - m ) * ( t - m ); }
+    return std::sqrt( sum / ( m_times.size() - 1 ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the percentile of the elapsed times.
+ *  @param  p [in] percentile in [0,100]
+ *  @return elapsed time in msec (linearly interpolated between the ranks)
+ */
+/*===========================================================================*/
+double Benchmark::Result::percentile( const double p ) const
+{
+    if ( m_times.empty() ) { return 0.0; }
+
+    const double r = std::min( std::max( p, 0.0 ), 100.0 ) / 100.0 * ( m_times.size() - 1 );
+    const size_t i = static_cast<size_t>( r );
+    if ( i + 1 >= m_times.size() ) { return m_times.back(); }
+    return m_times[i] + ( r - i ) * ( m_times[i+1] - m_times[i] );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the throughput for the median time.
+ *  @return number of processed items per second
+ */
+/*===========================================================================*/
+double Benchmark::Result::throughput() const
+{
+    const double median = this->percentile( 50 );
+    return median > 0.0 ? m_nitems / ( median * 1.0e-3 ) : 0.0;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Benchmark class.
+ *  @param  name [in] benchmark name
+ *  @param  unit [in] unit of the processed items
+ *  @param  nitems [in] number of items processed in an iteration
+ *  @param  function [in] benchmarked function
+ *  @param  setup [in] setup function called before the warm-up
+ */
+/*===========================================================================*/
+Benchmark::Benchmark(
+    const std::string& name,
+    const std::string& unit,
+    const size_t nitems,
+    Function function,
+    Setup setup ):
+    m_name( name ),
+    m_unit( unit ),
+    m_nitems( nitems ),
+    m_function( function ),
+    m_setup( setup )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Runs the benchmark.
+ *  @param  nwarmups [in] number of warm-up iterations (not measured)
+ *  @param  niterations [in] number of measured iterations
+ *  @return result
+ */
+/*===========================================================================*/
+Benchmark::Result Benchmark::run( const size_t nwarmups, const size_t niterations ) const
+{
+    if ( m_setup ) { m_setup(); }
+
+    for ( size_t i = 0; i < nwarmups; i++ )
+    {
+        std::unique_ptr<kvs::ObjectBase> object( m_function() );
+    }
+
+    std::vector<double> times;
+    times.reserve( niterations );
+    for ( size_t i = 0; i < niterations; i++ )
+    {
+        kvs::Timer timer( kvs::Timer::Start );
+        std::unique_ptr<kvs::ObjectBase> object( m_function() );
+        timer.stop();
+        times.push_back( timer.msec() );
+    }
+
+    const size_t peak_memory = kvs::SystemInformation::PeakMemoryUsage();
+    return Result( m_name, m_unit, m_nitems, times, peak_memory );
+}
+
+} // end of namespace kvsbench
@@ -0,0 +1,93 @@
+/*****************************************************************************/
+/**
+ *  @file   Benchmark.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <kvs/ObjectBase>
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Benchmark class.
+ *
+ *  The function is called for the warm-up and the measured iterations. The
+ *  object returned by the function (if any) is deleted outside the measured
+ *  region, so that only the processing itself is timed. The setup function
+ *  is called once before the warm-up, e.g. to create an off-screen context.
+ */
+/*===========================================================================*/
+class Benchmark
+{
+public:
+    using Function = std::function<kvs::ObjectBase*(void)>;
+    using Setup = std::function<void(void)>;
+
+    /*=======================================================================*/
+    /**
+     *  @brief  Result of the benchmark.
+     */
+    /*=======================================================================*/
+    class Result
+    {
+    private:
+        std::string m_name = ""; ///< benchmark name
+        std::string m_unit = ""; ///< unit of the processed items
+        size_t m_nitems = 0; ///< number of items processed in an iteration
+        std::vector<double> m_times{}; ///< elapsed times in msec (sorted)
+        size_t m_peak_memory = 0; ///< peak resident memory size in bytes
+
+    public:
+        Result() = default;
+        Result(
+            const std::string& name,
+            const std::string& unit,
+            const size_t nitems,
+            const std::vector<double>& times,
+            const size_t peak_memory );
+
+        const std::string& name() const { return m_name; }
+        const std::string& unit() const { return m_unit; }
+        size_t numberOfItems() const { return m_nitems; }
+        size_t numberOfIterations() const { return m_times.size(); }
+        const std::vector<double>& times() const { return m_times; }
+        size_t peakMemoryUsage() const { return m_peak_memory; }
+
+        double min() const;
+        double max() const;
+        double mean() const;
+        double stddev() const;
+        double percentile( const double p ) const;
+        double throughput() const;
+    };
+
+private:
+    std::string m_name = ""; ///< benchmark name
+    std::string m_unit = ""; ///< unit of the processed items
+    size_t m_nitems = 0; ///< number of items processed in an iteration
+    Function m_function{}; ///< benchmarked function
+    Setup m_setup{}; ///< setup function called before the warm-up
+
+public:
+    Benchmark(
+        const std::string& name,
+        const std::string& unit,
+        const size_t nitems,
+        Function function,
+        Setup setup = nullptr );
+
+    const std::string& name() const { return m_name; }
+    const std::string& unit() const { return m_unit; }
+    size_t numberOfItems() const { return m_nitems; }
+
+    Result run( const size_t nwarmups, const size_t niterations ) const;
+};
+
+} // end of namespace kvsbench
@@ -0,0 +1,208 @@
+/*****************************************************************************/
+/**
+ *  @file   Dataset.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Dataset.h"
+#include <kvs/HydrogenVolumeData>
+#include <kvs/TornadoVolumeData>
+#include <kvs/MersenneTwister>
+#include <kvs/ValueArray>
+#include <kvs/Vector3>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the scalar value of the two-lobe function at the point.
+ *  @param  p [in] point in the normalized coordinates [0,1]^3
+ *  @return value in [0,1]
+ */
+/*===========================================================================*/
+inline kvs::Real32 TwoLobe( const kvs::Vec3& p )
+{
+    const kvs::Vec3 c0( 0.35f, 0.5f, 0.5f );
+    const kvs::Vec3 c1( 0.65f, 0.5f, 0.5f );
+    const float s = 0.04f;
+    const float v = float( std::exp( -( p - c0 ).squaredLength() / s ) + std::exp( -( p - c1 ).squaredLength() / s ) );
+    return std::min( v, 1.0f );
+}
+
+}
+
+
+namespace kvsbench
+{
+
+namespace Dataset
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the hydrogen volume data.
+ *  @param  resolution [in] grid resolution along each axis
+ *  @return pointer to the structured volume object (UInt8 scalar)
+ */
+/*===========================================================================*/
+kvs::StructuredVolumeObject* Hydrogen( const size_t resolution )
+{
+    const kvs::UInt32 n = static_cast<kvs::UInt32>( std::max( resolution, size_t(2) ) );
+    return new kvs::HydrogenVolumeData( kvs::Vec3ui( n, n, n ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the tornado volume data.
+ *  @param  resolution [in] grid resolution along each axis
+ *  @return pointer to the structured volume object (Real32 vector)
+ */
+/*===========================================================================*/
+kvs::StructuredVolumeObject* Tornado( const size_t resolution )
+{
+    const kvs::UInt32 n = static_cast<kvs::UInt32>( std::max( resolution, size_t(2) ) );
+    return new kvs::TornadoVolumeData( kvs::Vec3ui( n, n, n ) );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the random tetrahedral mesh.
+ *
+ *  The interior nodes of a regular grid are jittered with the Mersenne twister
+ *  of the given seed, and each grid cell is split into six tetrahedra sharing
+ *  its main diagonal, which keeps the mesh conforming.
+ *
+ *  @param  resolution [in] number of nodes along each axis
+ *  @param  seed [in] random seed
+ *  @return pointer to the unstructured volume object (Real32 scalar)
+ */
+/*===========================================================================*/
+kvs::UnstructuredVolumeObject* RandomTetrahedra( const size_t resolution, const unsigned long seed )
+{
+    const size_t n = std::max( resolution, size_t(2) );
+    const size_t nnodes = n * n * n;
+    const size_t ncells = 6 * ( n - 1 ) * ( n - 1 ) * ( n - 1 );
+    const float scale = 1.0f / ( n - 1 );
+
+    kvs::MersenneTwister random( seed );
+    kvs::ValueArray<kvs::Real32> coords( nnodes * 3 );
+    kvs::ValueArray<kvs::Real32> values( nnodes );
+    for ( size_t k = 0, index = 0; k < n; k++ )
+    {
+        for ( size_t j = 0; j < n; j++ )
+        {
+            for ( size_t i = 0; i < n; i++, index++ )
+            {
+                kvs::Vec3 p( static_cast<float>( i ), static_cast<float>( j ), static_cast<float>( k ) );
+                const bool interior = i > 0 && j > 0 && k > 0 && i < n - 1 && j < n - 1 && k < n - 1;
+                for ( int d = 0; d < 3; d++ )
+                {
+                    // The random numbers are drawn for all the nodes to keep the sequence
+                    // independent of the boundary test.
+                    const float jitter = static_cast<float>( random() - 0.5 ) * 0.2f;
+                    if ( interior ) { p[d] += jitter; }
+                }
+                coords[ 3 * index + 0 ] = p.x();
+                coords[ 3 * index + 1 ] = p.y();
+                coords[ 3 * index + 2 ] = p.z();
+                values[ index ] = ::TwoLobe( p * scale );
+            }
+        }
+    }
+
+    // Tetrahedra of the cube (corner index: x + 2y + 4z) along the diagonal 0-7.
+    const int tets[6][4] = {
+        { 0, 1, 3, 7 }, { 0, 1, 5, 7 }, { 0, 2, 3, 7 },
+        { 0, 2, 6, 7 }, { 0, 4, 5, 7 }, { 0, 4, 6, 7 } };
+
+    kvs::ValueArray<kvs::UInt32> connections( ncells * 4 );
+    kvs::UInt32* connection = connections.data();
+    for ( size_t k = 0; k < n - 1; k++ )
+    {
+        for ( size_t j = 0; j < n - 1; j++ )
+        {
+            for ( size_t i = 0; i < n - 1; i++ )
+            {
+                kvs::UInt32 corners[8];
+                for ( int c = 0; c < 8; c++ )
+                {
+                    const size_t x = i + ( c & 1 );
+                    const size_t y = j + ( ( c >> 1 ) & 1 );
+                    const size_t z = k + ( ( c >> 2 ) & 1 );
+                    corners[c] = static_cast<kvs::UInt32>( x + n * ( y + n * z ) );
+                }
+
+                for ( int t = 0; t < 6; t++, connection += 4 )
+                {
+                    for ( int v = 0; v < 4; v++ ) { connection[v] = corners[ tets[t][v] ]; }
+
+                    // Every tetrahedron is oriented to have a positive volume.
+                    const kvs::Vec3 p0( coords.data() + 3 * connection[0] );
+                    const kvs::Vec3 p1( coords.data() + 3 * connection[1] );
+                    const kvs::Vec3 p2( coords.data() + 3 * connection[2] );
+                    const kvs::Vec3 p3( coords.data() + 3 * connection[3] );
+                    if ( ( p1 - p0 ).cross( p2 - p0 ).dot( p3 - p0 ) < 0.0f )
+                    {
+                        std::swap( connection[2], connection[3] );
+                    }
+                }
+            }
+        }
+    }
+
+    auto* volume = new kvs::UnstructuredVolumeObject();
+    volume->setCellTypeToTetrahedra();
+    volume->setVeclen( 1 );
+    volume->setNumberOfNodes( nnodes );
+    volume->setNumberOfCells( ncells );
+    volume->setCoords( coords );
+    volume->setConnections( connections );
+    volume->setValues( values );
+    volume->updateMinMaxCoords();
+    volume->updateMinMaxValues();
+    return volume;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the seed points on a regular lattice inside the volume.
+ *  @param  volume [in] pointer to the structured volume object
+ *  @param  dim [in] number of seed points along each axis
+ *  @return pointer to the point object
+ */
+/*===========================================================================*/
+kvs::PointObject* SeedPoints( const kvs::StructuredVolumeObject* volume, const size_t dim )
+{
+    const size_t d = std::max( dim, size_t(1) );
+    const kvs::Vec3 size( volume->resolution() - kvs::Vec3ui::Constant(1) );
+    const kvs::Vec3 min_coord( size.x() * 0.25f, size.y() * 0.25f, size.z() * 0.05f );
+    const kvs::Vec3 max_coord( size.x() * 0.75f, size.y() * 0.75f, size.z() * 0.95f );
+    const kvs::Vec3 delta = ( max_coord - min_coord ) / float( std::max( d - 1, size_t(1) ) );
+
+    kvs::ValueArray<kvs::Real32> coords( d * d * d * 3 );
+    kvs::Real32* coord = coords.data();
+    for ( size_t k = 0; k < d; k++ )
+    {
+        for ( size_t j = 0; j < d; j++ )
+        {
+            for ( size_t i = 0; i < d; i++ )
+            {
+                *(coord++) = min_coord.x() + i * delta.x();
+                *(coord++) = min_coord.y() + j * delta.y();
+                *(coord++) = min_coord.z() + k * delta.z();
+            }
+        }
+    }
+
+    auto* point = new kvs::PointObject();
+    point->setCoords( coords );
+    return point;
+}
+
+} // end of namespace Dataset
+
+} // end of namespace kvsbench
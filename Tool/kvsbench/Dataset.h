@@ -0,0 +1,34 @@
+/*****************************************************************************/
+/**
+ *  @file   Dataset.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <kvs/StructuredVolumeObject>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/PointObject>
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Deterministic synthetic datasets for the benchmarks.
+ *
+ *  The same parameters always produce the same data, so that the results of
+ *  different runs (and different builds) are comparable.
+ */
+/*===========================================================================*/
+namespace Dataset
+{
+
+kvs::StructuredVolumeObject* Hydrogen( const size_t resolution );
+kvs::StructuredVolumeObject* Tornado( const size_t resolution );
+kvs::UnstructuredVolumeObject* RandomTetrahedra( const size_t resolution, const unsigned long seed );
+kvs::PointObject* SeedPoints( const kvs::StructuredVolumeObject* volume, const size_t dim );
+
+} // end of namespace Dataset
+
+} // end of namespace kvsbench
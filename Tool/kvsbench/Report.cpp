@@ -0,0 +1,152 @@
+/*****************************************************************************/
+/**
+ *  @file   Report.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Report.h"
+#include <kvs/Version>
+#include <kvs/Date>
+#include <kvs/Time>
+#include <kvs/SystemInformation>
+#include <kvs/OpenMP>
+#include <kvs/Message>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the quoted and escaped JSON string.
+ *  @param  s [in] string
+ *  @return JSON string
+ */
+/*===========================================================================*/
+std::string Quote( const std::string& s )
+{
+    std::string result = "\"";
+    for ( const char c : s )
+    {
+        if ( c == '"' || c == '\\' ) { result += '\\'; }
+        result += c;
+    }
+    return result + "\"";
+}
+
+}
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Report class.
+ *  @param  parameters [in] suite parameters
+ *  @param  nwarmups [in] number of warm-up iterations
+ *  @param  niterations [in] number of measured iterations
+ */
+/*===========================================================================*/
+Report::Report(
+    const Suite::Parameters& parameters,
+    const size_t nwarmups,
+    const size_t niterations ):
+    m_parameters( parameters ),
+    m_nwarmups( nwarmups ),
+    m_niterations( niterations )
+{
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Prints the summary of the result in a line.
+ *  @param  os [in] output stream
+ *  @param  result [in] benchmark result
+ */
+/*===========================================================================*/
+void Report::print( std::ostream& os, const Benchmark::Result& result ) const
+{
+    os << std::left << std::setw( 48 ) << result.name() << std::right << std::fixed << std::setprecision( 3 )
+       << " p50: " << std::setw( 10 ) << result.percentile( 50 ) << " msec"
+       << " p90: " << std::setw( 10 ) << result.percentile( 90 ) << " msec"
+       << "  " << std::setprecision( 0 ) << result.throughput() << " " << result.unit() << "/sec"
+       << std::defaultfloat << std::endl;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the report in JSON.
+ *  @param  os [in] output stream
+ */
+/*===========================================================================*/
+void Report::write( std::ostream& os ) const
+{
+    const std::string date = kvs::Date().toString( "-" ) + " " + kvs::Time().toString( ":" );
+    const int nthreads = std::max( kvs::OpenMP::GetMaxThreads(), 1 );
+
+    os << std::setprecision( 9 );
+    os << "{" << std::endl;
+    os << "  \"kvs_version\": " << ::Quote( kvs::Version::Name() ) << "," << std::endl;
+    os << "  \"date\": " << ::Quote( date ) << "," << std::endl;
+    os << "  \"number_of_processors\": " << kvs::SystemInformation::NumberOfProcessors() << "," << std::endl;
+    os << "  \"number_of_threads\": " << nthreads << "," << std::endl;
+    os << "  \"parameters\": {" << std::endl;
+    os << "    \"resolution\": " << m_parameters.resolution << "," << std::endl;
+    os << "    \"unstructured_resolution\": " << m_parameters.unstructured_resolution << "," << std::endl;
+    os << "    \"seed_resolution\": " << m_parameters.seed_resolution << "," << std::endl;
+    os << "    \"seed\": " << m_parameters.seed << "," << std::endl;
+    os << "    \"screen_size\": " << m_parameters.screen_size << "," << std::endl;
+    os << "    \"warmups\": " << m_nwarmups << "," << std::endl;
+    os << "    \"iterations\": " << m_niterations << std::endl;
+    os << "  }," << std::endl;
+    os << "  \"benchmarks\": [";
+    for ( size_t i = 0; i < m_results.size(); i++ )
+    {
+        const auto& r = m_results[i];
+        os << ( i == 0 ? "" : "," ) << std::endl;
+        os << "    {" << std::endl;
+        os << "      \"name\": " << ::Quote( r.name() ) << "," << std::endl;
+        os << "      \"unit\": " << ::Quote( r.unit() ) << "," << std::endl;
+        os << "      \"items\": " << r.numberOfItems() << "," << std::endl;
+        os << "      \"iterations\": " << r.numberOfIterations() << "," << std::endl;
+        os << "      \"time_msec\": {"
+           << " \"min\": " << r.min() << ","
+           << " \"mean\": " << r.mean() << ","
+           << " \"stddev\": " << r.stddev() << ","
+           << " \"p50\": " << r.percentile( 50 ) << ","
+           << " \"p90\": " << r.percentile( 90 ) << ","
+           << " \"p99\": " << r.percentile( 99 ) << ","
+           << " \"max\": " << r.max() << " }," << std::endl;
+        os << "      \"throughput_per_sec\": " << r.throughput() << "," << std::endl;
+        os << "      \"peak_rss_bytes\": " << r.peakMemoryUsage() << std::endl;
+        os << "    }";
+    }
+    os << std::endl << "  ]" << std::endl;
+    os << "}" << std::endl;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Writes the report in JSON to the file.
+ *  @param  filename [in] output filename
+ *  @return true if the report has been written
+ */
+/*===========================================================================*/
+bool Report::write( const std::string& filename ) const
+{
+    std::ofstream ofs( filename.c_str() );
+    if ( !ofs.is_open() )
+    {
+        kvsMessageError() << "Cannot open " << filename << "." << std::endl;
+        return false;
+    }
+
+    this->write( ofs );
+    return true;
+}
+
+} // end of namespace kvsbench
@@ -0,0 +1,47 @@
+/*****************************************************************************/
+/**
+ *  @file   Report.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <iostream>
+#include "Benchmark.h"
+#include "Suite.h"
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Report class that writes the benchmark results in JSON.
+ *
+ *  The times are in milliseconds, the throughput is the number of processed
+ *  items per second for the median time, and the peak RSS is the peak
+ *  resident memory size of the process measured after each benchmark (run
+ *  a single benchmark per process with -filter for the isolated peak).
+ */
+/*===========================================================================*/
+class Report
+{
+private:
+    Suite::Parameters m_parameters{}; ///< suite parameters
+    size_t m_nwarmups = 0; ///< number of warm-up iterations
+    size_t m_niterations = 0; ///< number of measured iterations
+    std::vector<Benchmark::Result> m_results{}; ///< benchmark results
+
+public:
+    Report( const Suite::Parameters& parameters, const size_t nwarmups, const size_t niterations );
+
+    void add( const Benchmark::Result& result ) { m_results.push_back( result ); }
+    const std::vector<Benchmark::Result>& results() const { return m_results; }
+
+    void print( std::ostream& os, const Benchmark::Result& result ) const;
+    void write( std::ostream& os ) const;
+    bool write( const std::string& filename ) const;
+};
+
+} // end of namespace kvsbench
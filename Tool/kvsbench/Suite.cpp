@@ -0,0 +1,241 @@
+/*****************************************************************************/
+/**
+ *  @file   Suite.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Suite.h"
+#include <kvs/MarchingCubes>
+#include <kvs/SlicePlane>
+#include <kvs/ExternalFaces>
+#include <kvs/Streamline>
+#include <kvs/CellByCellUniformSampling>
+#include <kvs/CellByCellMetropolisSampling>
+#include <kvs/CellByCellRejectionSampling>
+#include <kvs/CellByCellLayeredSampling>
+#include <kvs/RayCastingRenderer>
+#include <kvs/File>
+#include <kvs/Directory>
+#include <cstdio>
+#include "Dataset.h"
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the number of cells of the structured volume.
+ *  @param  volume [in] pointer to the structured volume object
+ *  @return number of cells
+ */
+/*===========================================================================*/
+inline size_t NumberOfCells( const kvs::StructuredVolumeObject* volume )
+{
+    const kvs::Vec3ui r = volume->resolution();
+    return size_t( r.x() - 1 ) * ( r.y() - 1 ) * ( r.z() - 1 );
+}
+
+}
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Suite class.
+ *  @param  parameters [in] parameters
+ */
+/*===========================================================================*/
+Suite::Suite( const Parameters& parameters ):
+    m_parameters( parameters ),
+    m_tfunc( 256 )
+{
+    m_hydrogen.reset( Dataset::Hydrogen( m_parameters.resolution ) );
+    m_tornado.reset( Dataset::Tornado( m_parameters.resolution ) );
+    m_tetrahedra.reset( Dataset::RandomTetrahedra( m_parameters.unstructured_resolution, m_parameters.seed ) );
+    m_seeds.reset( Dataset::SeedPoints( m_tornado.get(), m_parameters.seed_resolution ) );
+    m_hydrogen->updateMinMaxValues();
+    m_tornado->updateMinMaxValues();
+
+    this->register_mappers();
+    this->register_samplers();
+    this->register_renderers();
+    this->register_io();
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Destroys the Suite class and removes the temporary files.
+ */
+/*===========================================================================*/
+Suite::~Suite()
+{
+    const kvs::File file( m_parameters.temporary_file );
+    if ( file.exists() )
+    {
+        const std::string data = file.pathName() + kvs::Directory::Separator() + file.baseName() + "_value.dat";
+        std::remove( data.c_str() );
+        std::remove( m_parameters.temporary_file.c_str() );
+    }
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Registers the benchmarks of the geometry mappers.
+ */
+/*===========================================================================*/
+void Suite::register_mappers()
+{
+    const kvs::StructuredVolumeObject* hydrogen = m_hydrogen.get();
+    const kvs::StructuredVolumeObject* tornado = m_tornado.get();
+    const kvs::UnstructuredVolumeObject* tetrahedra = m_tetrahedra.get();
+    const kvs::PointObject* seeds = m_seeds.get();
+    const kvs::TransferFunction& tfunc = m_tfunc;
+    const size_t ncells = ::NumberOfCells( hydrogen );
+
+    const double isolevel = hydrogen->minValue() + ( hydrogen->maxValue() - hydrogen->minValue() ) * 0.25;
+    m_benchmarks.emplace_back( "MarchingCubes/Hydrogen", "cells", ncells, [=,&tfunc]
+    {
+        const auto normal = kvs::PolygonObject::PolygonNormal;
+        return new kvs::MarchingCubes( hydrogen, isolevel, normal, false, tfunc );
+    } );
+
+    const kvs::Vec3 center = ( hydrogen->minObjectCoord() + hydrogen->maxObjectCoord() ) * 0.5f;
+    m_benchmarks.emplace_back( "SlicePlane/Hydrogen", "cells", ncells, [=,&tfunc]
+    {
+        return new kvs::SlicePlane( hydrogen, center, kvs::Vec3( 1, 1, 1 ).normalized(), tfunc );
+    } );
+
+    m_benchmarks.emplace_back( "ExternalFaces/Hydrogen", "cells", ncells, [=,&tfunc]
+    {
+        return new kvs::ExternalFaces( hydrogen, tfunc );
+    } );
+
+    m_benchmarks.emplace_back( "ExternalFaces/RandomTetrahedra", "cells", tetrahedra->numberOfCells(), [=,&tfunc]
+    {
+        return new kvs::ExternalFaces( tetrahedra, tfunc );
+    } );
+
+    m_benchmarks.emplace_back( "Streamline/Tornado", "seeds", seeds->numberOfVertices(), [=,&tfunc]
+    {
+        return new kvs::Streamline( tornado, seeds, tfunc );
+    } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Registers the benchmarks of the cell-by-cell particle samplers.
+ */
+/*===========================================================================*/
+void Suite::register_samplers()
+{
+    const kvs::StructuredVolumeObject* hydrogen = m_hydrogen.get();
+    const kvs::UnstructuredVolumeObject* tetrahedra = m_tetrahedra.get();
+    const kvs::TransferFunction& tfunc = m_tfunc;
+    const size_t repetitions = 1;
+    const float step = 0.5f;
+
+    const size_t nhcells = ::NumberOfCells( hydrogen );
+    const size_t ntcells = tetrahedra->numberOfCells();
+    m_benchmarks.emplace_back( "CellByCellUniformSampling/Hydrogen", "cells", nhcells, [=,&tfunc]
+    {
+        return new kvs::CellByCellUniformSampling( hydrogen, repetitions, step, tfunc );
+    } );
+
+    m_benchmarks.emplace_back( "CellByCellUniformSampling/RandomTetrahedra", "cells", ntcells, [=,&tfunc]
+    {
+        return new kvs::CellByCellUniformSampling( tetrahedra, repetitions, step, tfunc );
+    } );
+
+    m_benchmarks.emplace_back( "CellByCellMetropolisSampling/Hydrogen", "cells", nhcells, [=,&tfunc]
+    {
+        return new kvs::CellByCellMetropolisSampling( hydrogen, repetitions, step, tfunc );
+    } );
+
+    m_benchmarks.emplace_back( "CellByCellMetropolisSampling/RandomTetrahedra", "cells", ntcells, [=,&tfunc]
+    {
+        return new kvs::CellByCellMetropolisSampling( tetrahedra, repetitions, step, tfunc );
+    } );
+
+    m_benchmarks.emplace_back( "CellByCellRejectionSampling/Hydrogen", "cells", nhcells, [=,&tfunc]
+    {
+        return new kvs::CellByCellRejectionSampling( hydrogen, repetitions, step, tfunc );
+    } );
+
+    m_benchmarks.emplace_back( "CellByCellRejectionSampling/RandomTetrahedra", "cells", ntcells, [=,&tfunc]
+    {
+        return new kvs::CellByCellRejectionSampling( tetrahedra, repetitions, step, tfunc );
+    } );
+
+    // The layered sampling supports only the tetrahedral cells.
+    m_benchmarks.emplace_back( "CellByCellLayeredSampling/RandomTetrahedra", "cells", ntcells, [=,&tfunc]
+    {
+        return new kvs::CellByCellLayeredSampling( tetrahedra, repetitions, step, tfunc );
+    } );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Registers the benchmarks of the renderers on the off-screen viewer.
+ */
+/*===========================================================================*/
+void Suite::register_renderers()
+{
+#if defined( KVS_SUPPORT_OSMESA ) || defined( KVS_SUPPORT_EGL )
+    const size_t size = m_parameters.screen_size;
+    auto setup = [this,size]
+    {
+        // The context is created once and the volume is shared with the scene.
+        if ( m_screen ) { return; }
+        m_screen.reset( new kvs::OffScreen() );
+        m_screen->setSize( int( size ), int( size ) );
+
+        auto* volume = new kvs::StructuredVolumeObject();
+        volume->shallowCopy( *m_hydrogen );
+        auto* renderer = new kvs::RayCastingRenderer();
+        renderer->setTransferFunction( m_tfunc );
+        m_screen->registerObject( volume, renderer );
+    };
+
+    m_benchmarks.emplace_back( "RayCastingRenderer/Hydrogen", "pixels", size * size, [this]
+    {
+        m_screen->draw();
+        return nullptr;
+    }, setup );
+#endif
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Registers the benchmarks of the KVSML reader and writer.
+ */
+/*===========================================================================*/
+void Suite::register_io()
+{
+    const kvs::StructuredVolumeObject* hydrogen = m_hydrogen.get();
+    const std::string filename = m_parameters.temporary_file;
+    const size_t nbytes = hydrogen->values().byteSize();
+
+    // The values are written in the external binary file.
+    m_benchmarks.emplace_back( "KVSMLWrite/Hydrogen", "bytes", nbytes, [=]
+    {
+        hydrogen->write( filename, false, true );
+        return nullptr;
+    } );
+
+    auto setup = [=]
+    {
+        if ( !kvs::File( filename ).exists() ) { hydrogen->write( filename, false, true ); }
+    };
+
+    m_benchmarks.emplace_back( "KVSMLRead/Hydrogen", "bytes", nbytes, [=]
+    {
+        auto* volume = new kvs::StructuredVolumeObject();
+        volume->read( filename );
+        return volume;
+    }, setup );
+}
+
+} // end of namespace kvsbench
@@ -0,0 +1,69 @@
+/*****************************************************************************/
+/**
+ *  @file   Suite.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/UnstructuredVolumeObject>
+#include <kvs/PointObject>
+#include <kvs/TransferFunction>
+#include <kvs/OffScreen>
+#include "Benchmark.h"
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Benchmark suite class.
+ *
+ *  The suite generates the datasets once and registers the benchmarks of
+ *  the mappers, the renderer and the KVSML reader/writer on them.
+ */
+/*===========================================================================*/
+class Suite
+{
+public:
+    struct Parameters
+    {
+        size_t resolution = 64; ///< resolution of the structured volumes
+        size_t unstructured_resolution = 32; ///< number of nodes along each axis of the tetrahedral mesh
+        size_t seed_resolution = 8; ///< number of streamline seeds along each axis
+        unsigned long seed = 1; ///< random seed of the tetrahedral mesh
+        size_t screen_size = 512; ///< screen width and height for the renderer
+        std::string temporary_file = "kvsbench.kvsml"; ///< temporary KVSML filename
+    };
+
+private:
+    Parameters m_parameters{}; ///< parameters
+    std::unique_ptr<kvs::StructuredVolumeObject> m_hydrogen{}; ///< hydrogen volume
+    std::unique_ptr<kvs::StructuredVolumeObject> m_tornado{}; ///< tornado volume
+    std::unique_ptr<kvs::UnstructuredVolumeObject> m_tetrahedra{}; ///< random tetrahedral mesh
+    std::unique_ptr<kvs::PointObject> m_seeds{}; ///< seed points for the streamlines
+    kvs::TransferFunction m_tfunc{}; ///< transfer function
+    std::unique_ptr<kvs::OffScreen> m_screen{}; ///< off-screen viewer for the renderers
+    std::vector<Benchmark> m_benchmarks{}; ///< registered benchmarks
+
+public:
+    Suite( const Parameters& parameters );
+    ~Suite();
+    Suite( const Suite& ) = delete;
+    Suite& operator =( const Suite& ) = delete;
+
+    const Parameters& parameters() const { return m_parameters; }
+    const std::vector<Benchmark>& benchmarks() const { return m_benchmarks; }
+
+private:
+    void register_mappers();
+    void register_samplers();
+    void register_renderers();
+    void register_io();
+};
+
+} // end of namespace kvsbench
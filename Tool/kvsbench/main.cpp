@@ -0,0 +1,87 @@
+/*****************************************************************************/
+/**
+ *  @file   main.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include <kvs/MemoryDebugger>
+#include <kvs/OpenMP>
+#include <kvs/Message>
+#include <iostream>
+#include "main.h"
+#include "Argument.h"
+#include "Suite.h"
+#include "Report.h"
+
+KVS_MEMORY_DEBUGGER;
+
+
+namespace kvsbench
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Execute main process.
+ */
+/*===========================================================================*/
+bool Main::exec()
+{
+    // Read the argument.
+    Argument arg( m_argc, m_argv );
+    if ( !arg.read() ) return false;
+
+    if ( arg.numberOfThreads() > 0 )
+    {
+        kvs::OpenMP::SetNumberOfThreads( arg.numberOfThreads() );
+    }
+
+    // The datasets are generated before running the benchmarks.
+    Suite suite( arg.parameters() );
+    const std::string filter = arg.filter();
+    if ( arg.hasOption("list") )
+    {
+        for ( const auto& benchmark : suite.benchmarks() )
+        {
+            if ( benchmark.name().find( filter ) == std::string::npos ) { continue; }
+            std::cout << benchmark.name() << std::endl;
+        }
+        return true;
+    }
+
+    // The progress is output to the standard error to keep the JSON clean.
+    Report report( suite.parameters(), arg.numberOfWarmups(), arg.numberOfIterations() );
+    for ( const auto& benchmark : suite.benchmarks() )
+    {
+        if ( benchmark.name().find( filter ) == std::string::npos ) { continue; }
+        report.add( benchmark.run( arg.numberOfWarmups(), arg.numberOfIterations() ) );
+        report.print( std::cerr, report.results().back() );
+    }
+
+    if ( report.results().empty() )
+    {
+        kvsMessageError() << "No benchmark matches '" << filter << "'." << std::endl;
+        return false;
+    }
+
+    const std::string output = arg.output();
+    if ( output.empty() ) { report.write( std::cout ); return true; }
+    return report.write( output );
+}
+
+} // end of namespace kvsbench
+
+
+/*===========================================================================*/
+/**
+ *  @brief  Main function.
+ *  @param  argc [in] argument count
+ *  @param  argv [in] argument values
+ */
+/*===========================================================================*/
+int main( int argc, char** argv )
+{
+    KVS_MEMORY_DEBUGGER__SET_ARGUMENT( argc, argv );
+
+    kvsbench::Main m( argc, argv );
+    return m.exec() ? 0 : 1;
+}
@@ -0,0 +1,458 @@
+/*****************************************************************************/
+/**
+ *  @file   Batch.cpp
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#include "Batch.h"
+#include <kvs/DebugNew>
+#include <kvs/VisualizationPipeline>
+#include <kvs/VolumeObjectBase>
+#include <kvs/StructuredVolumeObject>
+#include <kvs/TransferFunction>
+#include <kvs/Isosurface>
+#include <kvs/RayCastingRenderer>
+#include <kvs/Camera>
+#include <kvs/Scene>
+#include <kvs/Timer>
+#include <kvs/Message>
+#include <kvs/OffScreen>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include "CommandName.h"
+#include "FileChecker.h"
+
+
+namespace
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the keyframe interval containing the frame.
+ *  @param  keys [in] keyframes sorted by the frame index
+ *  @param  frame [in] frame index
+ *  @param  t [out] interpolation parameter in the interval
+ *  @return index of the first keyframe of the interval
+ */
+/*===========================================================================*/
+template <typename Key>
+size_t FindInterval( const std::vector<Key>& keys, const size_t frame, float* t )
+{
+    *t = 0.0f;
+    if ( frame <= keys.front().frame ) { return 0; }
+    for ( size_t i = 0; i + 1 < keys.size(); i++ )
+    {
+        if ( frame < keys[ i + 1 ].frame )
+        {
+            *t = float( frame - keys[i].frame ) / float( keys[ i + 1 ].frame - keys[i].frame );
+            return i;
+        }
+    }
+    return keys.size() - 1;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the output filename of the frame.
+ *  @param  basename [in] basename
+ *  @param  extension [in] extension
+ *  @param  frame [in] frame index
+ *  @return output filename
+ */
+/*===========================================================================*/
+std::string OutputFilename( const std::string& basename, const std::string& extension, const size_t frame )
+{
+    std::ostringstream filename;
+    filename << basename << "_" << std::setw(5) << std::setfill('0') << frame << "." << extension;
+    return filename.str();
+}
+
+} // end of namespace
+
+
+namespace kvsview
+{
+
+namespace Batch
+{
+
+/*===========================================================================*/
+/**
+ *  @brief  Reads the batch script.
+ *  @param  filename [in] script filename
+ *  @return true, if the script is read successfully
+ */
+/*===========================================================================*/
+bool Script::read( const std::string& filename )
+{
+    std::ifstream ifs( filename.c_str() );
+    if ( !ifs )
+    {
+        kvsMessageError() << "Cannot open " << filename << "." << std::endl;
+        return false;
+    }
+
+    std::string line;
+    size_t line_number = 0;
+    while ( std::getline( ifs, line ) )
+    {
+        line_number++;
+        const size_t comment = line.find('#');
+        if ( comment != std::string::npos ) { line.erase( comment ); }
+
+        std::istringstream is( line );
+        std::string command;
+        if ( !( is >> command ) ) { continue; }
+
+        bool success = false;
+        if ( command == "frames" )
+        {
+            success = static_cast<bool>( is >> m_nframes ) && m_nframes > 0;
+        }
+        else if ( command == "method" )
+        {
+            std::string method;
+            success = static_cast<bool>( is >> method );
+            if ( method == "isosurface" ) { m_method = IsosurfaceMethod; }
+            else if ( method == "raycasting" ) { m_method = RayCastingMethod; }
+            else { success = false; }
+        }
+        else if ( command == "camera" )
+        {
+            CameraKey key;
+            success = static_cast<bool>(
+                is >> key.frame
+                   >> key.position[0] >> key.position[1] >> key.position[2]
+                   >> key.look_at[0] >> key.look_at[1] >> key.look_at[2]
+                   >> key.up[0] >> key.up[1] >> key.up[2] );
+            if ( success ) { m_camera_keys.push_back( key ); }
+        }
+        else if ( command == "isolevel" )
+        {
+            IsolevelKey key;
+            success = static_cast<bool>( is >> key.frame >> key.level );
+            if ( success ) { m_isolevel_keys.push_back( key ); }
+        }
+        else if ( command == "tfunc" )
+        {
+            TransferFunctionKey key;
+            success = static_cast<bool>( is >> key.frame >> key.filename );
+            if ( success ) { m_tfunc_keys.push_back( key ); }
+        }
+
+        if ( !success )
+        {
+            kvsMessageError() << filename << ":" << line_number << ": Invalid command '" << line << "'." << std::endl;
+            return false;
+        }
+    }
+
+    auto by_frame = [] ( const auto& a, const auto& b ) { return a.frame < b.frame; };
+    std::stable_sort( m_camera_keys.begin(), m_camera_keys.end(), by_frame );
+    std::stable_sort( m_isolevel_keys.begin(), m_isolevel_keys.end(), by_frame );
+    std::stable_sort( m_tfunc_keys.begin(), m_tfunc_keys.end(), by_frame );
+
+    return true;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the camera interpolated at the frame.
+ *  @param  frame [in] frame index
+ *  @return camera keyframe at the frame
+ */
+/*===========================================================================*/
+Script::CameraKey Script::camera( const size_t frame ) const
+{
+    float t = 0.0f;
+    const size_t i = ::FindInterval( m_camera_keys, frame, &t );
+    if ( t == 0.0f ) { return m_camera_keys[i]; }
+
+    const CameraKey& k0 = m_camera_keys[i];
+    const CameraKey& k1 = m_camera_keys[ i + 1 ];
+    CameraKey key;
+    key.frame = frame;
+    key.position = k0.position * ( 1.0f - t ) + k1.position * t;
+    key.look_at = k0.look_at * ( 1.0f - t ) + k1.look_at * t;
+    key.up = ( k0.up * ( 1.0f - t ) + k1.up * t ).normalized();
+    return key;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the isolevel interpolated at the frame.
+ *  @param  frame [in] frame index
+ *  @param  default_level [in] isolevel without keyframes
+ *  @return isolevel at the frame
+ */
+/*===========================================================================*/
+double Script::isolevel( const size_t frame, const double default_level ) const
+{
+    if ( m_isolevel_keys.empty() ) { return default_level; }
+
+    float t = 0.0f;
+    const size_t i = ::FindInterval( m_isolevel_keys, frame, &t );
+    if ( t == 0.0f ) { return m_isolevel_keys[i].level; }
+    return m_isolevel_keys[i].level * ( 1.0 - t ) + m_isolevel_keys[ i + 1 ].level * t;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the transfer function filename at the frame.
+ *  @param  frame [in] frame index
+ *  @return transfer function filename ("default" without keyframes)
+ */
+/*===========================================================================*/
+std::string Script::transferFunction( const size_t frame ) const
+{
+    std::string filename( "default" );
+    for ( const auto& key : m_tfunc_keys )
+    {
+        if ( key.frame > frame ) { break; }
+        filename = key.filename;
+    }
+    return filename;
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Constructs a new Argument class.
+ *  @param  argc [in] argument count
+ *  @param  argv [in] argument values
+ */
+/*===========================================================================*/
+Argument::Argument( int argc, char** argv ):
+    kvsview::Argument::Common( argc, argv, "Batch")
+{
+    // Parameters for the batch mode.
+    addOption( Batch::CommandName, Batch::Description, 0 );
+    addOption( "s", "Batch script file. (<filename>)", 1, true );
+    addOption( "e", "Output image format; 'png' 'bmp' 'ppm'. (default: png)", 1, false );
+    addOption( "timing", "Output per-frame timings in CSV. (default: standard output)", 1, false );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the script filename.
+ *  @return script filename
+ */
+/*===========================================================================*/
+std::string Argument::script()
+{
+    return this->optionValue<std::string>("s");
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the basename of the output images.
+ *  @return basename
+ */
+/*===========================================================================*/
+std::string Argument::basename()
+{
+    return this->valueAs<std::string>( "output", "frame" );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the extension of the output images.
+ *  @return extension
+ */
+/*===========================================================================*/
+std::string Argument::extension()
+{
+    return this->valueAs<std::string>( "e", "png" );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Returns the filename of the per-frame timings.
+ *  @return filename (empty for the standard output)
+ */
+/*===========================================================================*/
+std::string Argument::timing()
+{
+    return this->valueAs<std::string>( "timing", "" );
+}
+
+/*===========================================================================*/
+/**
+ *  @brief  Executes main process.
+ */
+/*===========================================================================*/
+int Main::exec()
+{
+    // Parse specified arguments.
+    Batch::Argument arg( m_argc, m_argv );
+    if ( !arg.parse() ) return ( false );
+
+#if !defined( KVS_SUPPORT_OSMESA ) && !defined( KVS_SUPPORT_EGL )
+    kvsMessageError() << "Batch mode requires OSMesa or EGL support." << std::endl;
+    return ( false );
+#else
+    // Read the script.
+    Batch::Script script;
+    if ( !script.read( arg.script() ) ) return ( false );
+
+    // Check the input data.
+    m_input_name = arg.value<std::string>();
+    if ( !( kvsview::FileChecker::ImportableStructuredVolume( m_input_name ) ||
+            kvsview::FileChecker::ImportableUnstructuredVolume( m_input_name ) ) )
+    {
+        kvsMessageError() << m_input_name << " is not volume data." << std::endl;
+        return ( false );
+    }
+
+    // The data is imported once and stays resident for all the frames.
+    kvs::VisualizationPipeline pipe( m_input_name );
+    if ( !pipe.import() ) return ( false );
+
+    auto* volume = const_cast<kvs::VolumeObjectBase*>( kvs::VolumeObjectBase::DownCast( pipe.object() ) );
+    if ( !volume->hasMinMaxValues() ) volume->updateMinMaxValues();
+
+    const kvs::Indent indent(4);
+    if ( arg.verboseMode() )
+    {
+        volume->print( std::cout << std::endl << "IMPORTED OBJECT" << std::endl, indent );
+    }
+
+    // Off-screen viewer.
+    kvs::OffScreen screen;
+    const auto size = arg.valueAsVec2<int>( "screen_size", kvs::Vec2i( 512, 512 ) );
+    screen.setSize( size[0], size[1] );
+    if ( arg.hasOption("background_color") )
+    {
+        screen.setBackgroundColor( arg.valueAsRGBColor( "background_color" ) );
+    }
+
+    // Transfer functions are read once per file.
+    std::map<std::string,kvs::TransferFunction> tfuncs;
+    auto transfer_function = [&] ( const std::string& filename ) -> const kvs::TransferFunction&
+    {
+        auto tfunc = tfuncs.find( filename );
+        if ( tfunc == tfuncs.end() )
+        {
+            const size_t resolution = 256;
+            kvs::TransferFunction t = ( filename == "default" ) ?
+                kvs::TransferFunction( resolution ) :
+                kvs::TransferFunction( filename );
+            tfunc = tfuncs.insert( std::make_pair( filename, t ) ).first;
+        }
+        return tfunc->second;
+    };
+
+    std::unique_ptr<kvs::VolumeObjectBase> volume_holder;
+    kvs::glsl::RayCastingRenderer* ray_casting = nullptr;
+    if ( script.method() == Batch::Script::RayCastingMethod )
+    {
+        if ( !kvs::StructuredVolumeObject::DownCast( volume ) )
+        {
+            kvsMessageError() << "Ray casting requires structured volume data." << std::endl;
+            delete volume;
+            return ( false );
+        }
+
+        // The volume is owned by the scene.
+        ray_casting = new kvs::glsl::RayCastingRenderer();
+        ray_casting->setTransferFunction( transfer_function( script.transferFunction( 0 ) ) );
+        screen.registerObject( volume, ray_casting );
+    }
+    else
+    {
+        // The volume is only referred by the isosurfaces.
+        volume_holder.reset( volume );
+    }
+
+    std::ofstream timing_file;
+    if ( !arg.timing().empty() )
+    {
+        timing_file.open( arg.timing().c_str() );
+        if ( !timing_file )
+        {
+            kvsMessageError() << "Cannot open " << arg.timing() << "." << std::endl;
+            return ( false );
+        }
+    }
+    std::ostream& timing = timing_file.is_open() ? timing_file : std::cout;
+    timing << "frame,update [msec],render [msec],capture [msec],filename" << std::endl;
+
+    const double default_level = ( volume->minValue() + volume->maxValue() ) * 0.5;
+    const std::string basename = arg.basename();
+    const std::string extension = arg.extension();
+    const size_t nframes = script.numberOfFrames();
+
+    int object_id = -1;
+    double current_level = 0.0;
+    std::string current_tfunc( "" );
+    kvs::Timer total( kvs::Timer::Start );
+    for ( size_t frame = 0; frame < nframes; frame++ )
+    {
+        // Update the isosurface or the transfer function when changed.
+        kvs::Timer timer( kvs::Timer::Start );
+        const std::string tfunc = script.transferFunction( frame );
+        if ( ray_casting )
+        {
+            if ( tfunc != current_tfunc && frame > 0 )
+            {
+                ray_casting->setTransferFunction( transfer_function( tfunc ) );
+            }
+        }
+        else
+        {
+            const double level = script.isolevel( frame, default_level );
+            if ( object_id < 0 || level != current_level || tfunc != current_tfunc )
+            {
+                const auto normal = kvs::PolygonObject::PolygonNormal;
+                const bool duplication = false;
+                auto* object = new kvs::Isosurface( volume, level, normal, duplication, transfer_function( tfunc ) );
+                if ( object_id < 0 ) { object_id = screen.registerObject( object ).first; }
+                else { screen.scene()->replaceObject( object_id, object ); }
+            }
+            current_level = level;
+        }
+        current_tfunc = tfunc;
+        timer.stop();
+        const double update_time = timer.msec();
+
+        // Render the frame.
+        if ( script.hasCameraKeys() )
+        {
+            const auto camera = script.camera( frame );
+            screen.scene()->camera()->setPosition( camera.position, camera.look_at, camera.up );
+        }
+        timer.start();
+        screen.draw();
+        timer.stop();
+        const double render_time = timer.msec();
+
+        // The previous frames are written in the background.
+        const std::string filename = ::OutputFilename( basename, extension, frame );
+        timer.start();
+        screen.captureAsync( filename );
+        timer.stop();
+        const double capture_time = timer.msec();
+
+        timing << frame << "," << update_time << "," << render_time << "," << capture_time << "," << filename << std::endl;
+    }
+    screen.waitForCaptures();
+    total.stop();
+
+    if ( arg.verboseMode() )
+    {
+        std::cout << std::endl << "TOTAL" << std::endl;
+        std::cout << indent << "Number of frames: " << nframes << std::endl;
+        std::cout << indent << "Total time: " << total.sec() << " [sec]" << std::endl;
+        std::cout << indent << "Frames per second: " << nframes / total.sec() << std::endl;
+    }
+
+    return ( arg.clear(), 0 );
+#endif
+}
+
+} // end of namespace Batch
+
+} // end of namespace kvsview
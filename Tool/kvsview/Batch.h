@@ -0,0 +1,128 @@
+/*****************************************************************************/
+/**
+ *  @file   Batch.h
+ *  @author Naohisa Sakamoto
+ */
+/*****************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <kvs/Type>
+#include <kvs/Vector3>
+#include <kvs/CommandLine>
+#include <kvs/Program>
+#include "Argument.h"
+
+
+namespace kvsview
+{
+
+namespace Batch
+{
+
+const std::string CommandName("Batch");
+const std::string Description("Headless batch rendering with a script. (optional)");
+
+/*===========================================================================*/
+/**
+ *  @brief  Batch script class.
+ *
+ *  The script is a text file with one command per line ('#' starts a comment).
+ *      frames <n>                          number of output frames
+ *      method <isosurface|raycasting>      visualization method
+ *      camera <frame> <px py pz> <lx ly lz> <ux uy uz>
+ *                                          camera keyframe (position, look-at, up)
+ *      isolevel <frame> <value>            isolevel keyframe
+ *      tfunc <frame> <filename|default>    transfer function from the frame
+ *  The camera and the isolevel are linearly interpolated between the
+ *  keyframes, and the transfer function is switched at the keyframes.
+ */
+/*===========================================================================*/
+class Script
+{
+public:
+    enum Method
+    {
+        IsosurfaceMethod,
+        RayCastingMethod
+    };
+
+    struct CameraKey
+    {
+        size_t frame; ///< frame index
+        kvs::Vec3 position; ///< camera position
+        kvs::Vec3 look_at; ///< look-at point
+        kvs::Vec3 up; ///< up vector
+    };
+
+    struct IsolevelKey
+    {
+        size_t frame; ///< frame index
+        double level; ///< isolevel
+    };
+
+    struct TransferFunctionKey
+    {
+        size_t frame; ///< frame index
+        std::string filename; ///< transfer function file ("default": default transfer function)
+    };
+
+private:
+    size_t m_nframes = 1; ///< number of frames
+    Method m_method = IsosurfaceMethod; ///< visualization method
+    std::vector<CameraKey> m_camera_keys{}; ///< camera keyframes
+    std::vector<IsolevelKey> m_isolevel_keys{}; ///< isolevel keyframes
+    std::vector<TransferFunctionKey> m_tfunc_keys{}; ///< transfer function keyframes
+
+public:
+    Script() = default;
+
+    size_t numberOfFrames() const { return m_nframes; }
+    Method method() const { return m_method; }
+    bool hasCameraKeys() const { return !m_camera_keys.empty(); }
+    bool hasIsolevelKeys() const { return !m_isolevel_keys.empty(); }
+
+    bool read( const std::string& filename );
+    CameraKey camera( const size_t frame ) const;
+    double isolevel( const size_t frame, const double default_level ) const;
+    std::string transferFunction( const size_t frame ) const;
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Argument class for Batch.
+ */
+/*===========================================================================*/
+class Argument : public kvsview::Argument::Common
+{
+public:
+    Argument( int argc, char** argv );
+
+public:
+    std::string script();
+    std::string basename();
+    std::string extension();
+    std::string timing();
+};
+
+/*===========================================================================*/
+/**
+ *  @brief  Main class for Batch.
+ */
+/*===========================================================================*/
+class Main : public kvs::Program
+{
+private:
+    std::string m_input_name; ///< input filename
+    std::string m_output_name; ///< output filename
+    int m_argc;
+    char** m_argv;
+
+public:
+    Main( int argc, char** argv ): m_argc( argc ), m_argv( argv ) {}
+    int exec();
+};
+
+} // end of namespace Batch
+
+} // end of namespace kvsview
@@ -22,6 +22,7 @@
 #include "RayCastingRenderer.h"
 #include "ParticleBasedRenderer.h"
 #include "Histogram.h"
+#include "Batch.h"
 
 KVS_MEMORY_DEBUGGER;
 
@@ -65,6 +66,7 @@ int32_t Main::exec( int argc, char** argv )
         KVSVIEW_HELP( RayCastingRenderer );
         KVSVIEW_HELP( ParticleBasedRenderer );
         KVSVIEW_HELP( Histogram );
+        KVSVIEW_HELP( Batch );
         kvsMessageError( "Unknown visualization method '%s'.", help.c_str() );
         return 1;
     }
@@ -86,6 +88,7 @@ int32_t Main::exec( int argc, char** argv )
         KVSVIEW_EXEC( RayCastingRenderer );
         KVSVIEW_EXEC( ParticleBasedRenderer );
         KVSVIEW_EXEC( Histogram );
+        KVSVIEW_EXEC( Batch );
         return ( arg.clear(), Default::Main( argc, argv ).run() );
     }
 }